@@ -2,14 +2,17 @@
 
 // Include concrete implementations (creation moved to main)
 #include "config/json_config_loader.h"
-#include "drivers/input_device_source_impl.h"
+#include "drivers/evdev_input_device_source.h"
 #include "drivers/telemetry_handler_impl.h"
 #include "drivers/web_command_handler_impl.h"
+#include "metrics/static_metrics.h"
 #include "network_manager/connection_monitor_impl.h"
 #include "transport/websocket_transport_server.h"
+#include "webrtc/message_batcher.h"
 #include "webrtc/webrtc_manager_impl.h"
 
 // Include Protobuf messages that need deserialization in the app
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <csignal>
@@ -18,7 +21,7 @@
 #include <memory>
 #include <thread>
 
-#include "chassis/proto/chassis.pb.h"  // For handleWebrtcDataChannelMessageReceived
+#include "chassis/proto/chassis.pb.h"  // For handleTelemetryMessage
 
 // Include event loop library (e.g., Asio)
 // #include <boost/asio.hpp>
@@ -144,6 +147,10 @@ bool CockpitClientApp::init(
     state_ = AppState::Uninitialized;
     return false;
   }
+  // The manager publishes the connection statistics of every peer here
+  metricsRegistry_ =
+      std::make_shared<autodev::remote::metrics::MetricsRegistry>();
+  webrtcManager_->setMetricsRegistry(metricsRegistry_);
   std::cout
       << "CockpitClientApp: WebRTC manager initialized and callbacks setup."
       << std::endl;
@@ -227,7 +234,29 @@ int CockpitClientApp::run() {
   }
   std::cout << "CockpitClientApp: WebRTC manager started." << std::endl;
 
-  // 3. Start input device polling/sending loop
+  // Metrics endpoint (optional: driving works without it)
+  if (config_.metrics_port != 0) {
+    metricsExporter_ =
+        std::make_unique<autodev::remote::metrics::PrometheusExporter>(
+            metricsRegistry_, config_.metrics_address, config_.metrics_port);
+    if (!metricsExporter_->start()) {
+      std::cerr << "CockpitClientApp: Failed to start metrics endpoint; "
+                   "continuing without it."
+                << std::endl;
+      metricsExporter_.reset();
+    }
+  }
+
+  // 3. Start the command arbiter (sends the merged command stream), then
+  // input device polling
+  if (!commandArbiter_->start()) {
+    std::cerr << "CockpitClientApp: Failed to start command arbiter."
+              << std::endl;
+    webrtcManager_->stop();
+    transportServer_->stop();
+    state_ = AppState::Stopped;  // Transition to stopped on major failure
+    return 1;
+  }
   if (!inputDeviceSource_->startPolling()) {
     std::cerr
         << "CockpitClientApp: Failed to start input device source polling."
@@ -235,6 +264,7 @@ int CockpitClientApp::run() {
     // Decide failure policy: continue without device input? or stop?
     // For critical input, maybe stop. For non-critical, maybe log and continue.
     // Let's assume it's critical for remote driving and stop.
+    commandArbiter_->stop();
     webrtcManager_->stop();
     transportServer_->stop();
     state_ = AppState::Stopped;  // Transition to stopped on major failure
@@ -243,6 +273,21 @@ int CockpitClientApp::run() {
   std::cout << "CockpitClientApp: Input device source polling started."
             << std::endl;
 
+  // Connect to the vehicles; the initial one is taken over once connected
+  if (!sessionManager_->start()) {
+    std::cerr << "CockpitClientApp: Failed to start vehicle sessions."
+              << std::endl;
+    inputDeviceSource_->stopPolling();
+    commandArbiter_->stop();
+    webrtcManager_->stop();
+    transportServer_->stop();
+    state_ = AppState::Stopped;  // Transition to stopped on major failure
+    return 1;
+  }
+
+  // Files can be sent from now on
+  fileSender_->start();
+
   // 4. Start connection monitor (if used)
   if (connectionMonitor_) {
     connectionMonitor_->start();
@@ -333,20 +378,47 @@ void CockpitClientApp::stop() {
     inputDeviceSource_->stopPolling();
     std::cout << "CockpitClientApp: Input Device Source stopped." << std::endl;
   }
+  // Stop retrying session requests (uses the arbiter and the manager)
+  if (sessionManager_) {
+    sessionManager_->stop();
+    std::cout << "CockpitClientApp: Session Manager stopped." << std::endl;
+  }
+  // Stop sending commands (the sources above are its producers)
+  if (commandArbiter_) {
+    commandArbiter_->stop();
+    std::cout << "CockpitClientApp: Command Arbiter stopped." << std::endl;
+  }
+  // Stop sending files (queued transfers end as cancelled; the vehicles
+  // keep what they got)
+  if (fileSender_) {
+    fileSender_->stop();
+    std::cout << "CockpitClientApp: File Sender stopped." << std::endl;
+  }
   // Stop WebRTC manager (closes connections, stops threads/tasks)
   if (webrtcManager_) {
     webrtcManager_->stop();
     std::cout << "CockpitClientApp: WebRTC Manager stopped." << std::endl;
   }
+  // Stop serving metrics (nothing updates them any more)
+  if (metricsExporter_) {
+    metricsExporter_->stop();
+    std::cout << "CockpitClientApp: Metrics endpoint stopped." << std::endl;
+  }
+  // Release video sinks/forwarders before the transport they send to stops
+  releaseVideoSinks();
+  // Stop telemetry publishing (sends via the transport server)
+  if (telemetryHandler_) {
+    telemetryHandler_->stop();
+    std::cout << "CockpitClientApp: Telemetry Handler stopped." << std::endl;
+  }
   // Stop local transport server (closes WS, stops HTTP, stops threads/tasks)
   if (transportServer_) {
     transportServer_->stop();
     std::cout << "CockpitClientApp: Transport Server stopped." << std::endl;
   }
 
-  // Handlers (webCommandHandler_, telemetryHandler_) don't typically have
-  // explicit stop methods; they just become inactive when their dependencies
-  // (TransportServer, WebrtcManager) stop.
+  // webCommandHandler_ has no explicit stop method; it just becomes inactive
+  // when its dependencies (TransportServer, CommandArbiter) stop.
 
   // 3. Join event loop thread if it was started in run()
   // TODO: if (ioThread_ && ioThread_->joinable()) {
@@ -358,6 +430,19 @@ void CockpitClientApp::stop() {
   state_ = AppState::Stopped;  // Final state
 }
 
+// --- Sending Files ---
+
+uint32_t CockpitClientApp::sendFile(const std::string& vehicle_id,
+                                    const std::string& path) {
+  if (!fileSender_) {
+    std::cerr << "CockpitClientApp: Not initialized; cannot send " << path
+              << std::endl;
+    return 0;
+  }
+  // The sender logs how the transfer ends
+  return fileSender_->sendFile(vehicle_id, path, nullptr);
+}
+
 // --- Component Setup Methods ---
 
 bool CockpitClientApp::setupWebrtcManagerCallbacks() {
@@ -374,23 +459,76 @@ bool CockpitClientApp::setupWebrtcManagerCallbacks() {
         // Ensure this method is thread-safe! Called from WebRTC thread.
         handlePeerDisconnected(peer_id, reason);
       });
-  // Route DataChannel messages based on label
-  webrtcManager_->onDataChannelMessage(
-      [this](const std::string& peer_id, const std::string& label,
-             const std::vector<char>& message) {
-        // Ensure this method is thread-safe! Called from WebRTC thread.
-        handleWebrtcDataChannelMessageReceived(peer_id, label, message);
+  // Declare the DataChannels once (same labels, priorities and reliability
+  // as the vehicle); messages are routed by the channel id resolved at
+  // channel open. The control and session channels only carry commands to
+  // the vehicle: nothing is handled on them.
+  using autodev::remote::webrtc::ChannelPriority;
+  using autodev::remote::webrtc::ChannelReliability;
+  using autodev::remote::webrtc::DataChannelMessage;
+  using autodev::remote::webrtc::DataChannelMessageView;
+  auto channels =
+      std::make_shared<autodev::remote::webrtc::DataChannelRegistry>();
+  channels->declare<DataChannelMessage>({config_.control_channel_label,
+                                         ChannelPriority::High,
+                                         ChannelReliability::Reliable()});
+  auto telemetry_channel = channels->declare<DataChannelMessage>(
+      {config_.telemetry_channel_label, ChannelPriority::Medium,
+       ChannelReliability::Reliable()});
+  channels->declare<DataChannelMessage>({config_.session_channel_label,
+                                         ChannelPriority::High,
+                                         ChannelReliability::Reliable()});
+  // Files: Low priority, so chunks wait behind control commands; the
+  // sender only hands a chunk over while the channel's buffer has room.
+  autodev::remote::webrtc::DataChannelSpec file_spec{
+      config_.file_channel_label, ChannelPriority::Low,
+      ChannelReliability::Reliable()};
+  file_spec.buffered_amount_low_threshold =
+      config_.file_buffered_amount_low_threshold;
+  auto file_channel = channels->declare<DataChannelMessage>(file_spec);
+  channelDispatcher_.on(telemetry_channel, [this](const std::string& peer_id,
+                                                  DataChannelMessageView m) {
+    // Ensure this method is thread-safe! Called from WebRTC thread.
+    handleTelemetryChannelMessage(peer_id, m);
+  });
+  fileSender_ =
+      std::make_unique<autodev::remote::webrtc::ChunkedTransferSender>(
+          autodev::remote::webrtc::ChunkedTransferSender::Config{},
+          [this](const std::string& peer_id, const DataChannelMessage& frame) {
+            return webrtcManager_->trySendDataChannelMessage(
+                peer_id, config_.file_channel_label, frame,
+                config_.file_max_buffered_bytes);
+          });
+  // Low-rate acknowledgements: a copy per frame is fine here.
+  channelDispatcher_.on(file_channel, [this](const std::string& peer_id,
+                                             DataChannelMessageView m) {
+    fileSender_->handleFrame(peer_id, m.copy());
+  });
+  if (!webrtcManager_->setDataChannels(std::move(channels))) {
+    return false;
+  }
+  webrtcManager_->onBufferedAmountLow(
+      [this, file_channel](const std::string& peer_id,
+                           autodev::remote::webrtc::ChannelId channel,
+                           uint64_t /*buffered_amount*/) {
+        if (channel == file_channel.id) fileSender_->notifyWritable(peer_id);
+      });
+  webrtcManager_->onChannelMessage(
+      [this](const std::string& peer_id,
+             autodev::remote::webrtc::ChannelId channel,
+             DataChannelMessageView message) {
+        channelDispatcher_.dispatch(peer_id, channel, message);
       });
   webrtcManager_->onError([this](const std::string& error_msg) {
     // Ensure this method is thread-safe! Called from WebRTC thread.
     handleWebrtcError(error_msg);
   });
-  // TODO: If C++ handles video, register video track handler:
-  // webrtcManager_->onVideoTrackReceived([this](const std::string& peer_id,
-  // rtc::scoped_refptr<webrtc::VideoTrackInterface> track) {
-  // // Ensure this method is thread-safe! Called from WebRTC thread.
-  // handleWebrtcVideoTrackReceived(peer_id, track);
-  // });
+  webrtcManager_->onVideoTrackReceived(
+      [this](const std::string& peer_id,
+             rtc::scoped_refptr<::webrtc::RtpReceiverInterface> receiver) {
+        // Ensure this method is thread-safe! Called from WebRTC thread.
+        handleWebrtcVideoTrackReceived(peer_id, receiver);
+      });
 
   std::cout << "CockpitClientApp: WebrtcManager callbacks setup complete."
             << std::endl;
@@ -413,15 +551,19 @@ bool CockpitClientApp::setupTransportServerCallbacks() {
         handleWsDisconnected(conn_id);
       });
   transportServer_->onWebSocketMessageReceived(
-      [this](WebSocketConnectionId conn_id, const std::vector<char>& message) {
+      [this](WebSocketConnectionId conn_id, char* data, size_t size) {
         // Ensure this method is thread-safe! Called from TransportServer
         // thread.
-        handleWsMessageReceived(conn_id, message);
+        handleWsMessageReceived(conn_id, data, size);
       });
   transportServer_->onServerError([this](const std::string& error_msg) {
     // Ensure this method is thread-safe! Called from TransportServer thread.
     handleTransportServerError(error_msg);
   });
+  transportServer_->onVideoKeyFrameRequested([this]() {
+    // Ensure this method is thread-safe! Called from TransportServer thread.
+    handleVideoKeyFrameRequested();
+  });
 
   std::cout << "CockpitClientApp: Transport Server callbacks setup complete."
             << std::endl;
@@ -432,12 +574,38 @@ bool CockpitClientApp::setupCommandAndInputHandlers() {
   std::cout
       << "CockpitClientApp: Setting up Command and Input Handlers/Sources..."
       << std::endl;
-  // Handlers/Sources require shared_ptrs to WebrtcManager and config, which are
-  // injected. webrtcManager_ is validated in init before this is called.
+  // Handlers/Sources submit their commands to the CommandArbiter, the only
+  // component sending commands to the vehicle. webrtcManager_ is validated in
+  // init before this is called.
+  autodev::remote::drivers::CommandArbiterConfig arbiter_config;
+  arbiter_config.send_rate_hz = config_.command_send_rate_hz;
+  arbiter_config.source_timeout_ms = config_.command_source_timeout_ms;
+  arbiter_config.emergency_hold_ms = config_.emergency_hold_ms;
+  // The session manager sets the arbiter's target on take-over.
+  commandArbiter_ = std::make_shared<autodev::remote::drivers::CommandArbiter>(
+      webrtcManager_, config_.control_channel_label, "", arbiter_config);
+
+  autodev::remote::drivers::VehicleSessionConfig session_config;
+  std::vector<std::string>& vehicle_ids = session_config.vehicle_ids;
+  vehicle_ids = config_.vehicle_ids;
+  if (!config_.target_vehicle_id.empty() &&
+      std::find(vehicle_ids.begin(), vehicle_ids.end(),
+                config_.target_vehicle_id) == vehicle_ids.end()) {
+    vehicle_ids.insert(vehicle_ids.begin(), config_.target_vehicle_id);
+  }
+  session_config.initial_vehicle_id = config_.target_vehicle_id;
+  session_config.session_channel_label = config_.session_channel_label;
+  sessionManager_ =
+      std::make_shared<autodev::remote::drivers::VehicleSessionManager>(
+          webrtcManager_, commandArbiter_, session_config);
+  sessionManager_->onSessionChanged(
+      [this](const std::string& vehicle_id, const std::string& mode) {
+        // Called from WebRTC/TransportServer threads. MUST BE THREAD-SAFE.
+        telemetryHandler_->notifyConnectionStatus(vehicle_id, mode, "");
+      });
 
   // Initialize WebCommandHandler
-  if (!webCommandHandler_->init(webrtcManager_, config_.control_channel_label,
-                                config_.target_vehicle_id)) {
+  if (!webCommandHandler_->init(commandArbiter_, sessionManager_)) {
     std::cerr << "CockpitClientApp: Failed to initialize Web Command Handler."
               << std::endl;
     return false;
@@ -446,10 +614,7 @@ bool CockpitClientApp::setupCommandAndInputHandlers() {
             << std::endl;
 
   // Initialize InputDeviceSource
-  // TODO: Pass specific input device config from CockpitConfig
-  if (!inputDeviceSource_->init(
-          webrtcManager_, config_.control_channel_label,
-          config_.target_vehicle_id /*, config_.input_device_config */)) {
+  if (!inputDeviceSource_->init(commandArbiter_, config_.input_device)) {
     std::cerr << "CockpitClientApp: Failed to initialize Input Device Source."
               << std::endl;
     return false;
@@ -515,9 +680,9 @@ void CockpitClientApp::handlePeerConnected(const std::string& peer_id) {
             << std::endl;
   // Role: Getting vehicle state -> Notify UI via TelemetryHandler
   // Role: Sending commands -> Maybe enable controls in UI?
-  // TODO: Update UI status via TelemetryHandler
-  // telemetryHandler_->notifyConnectionStatus(peer_id, true); // Assuming
-  // TelemetryHandler has this method
+  telemetryHandler_->notifyConnectionStatus(peer_id, "connected", "");
+  // Sends the vehicle its stream mode (preview unless taken over)
+  sessionManager_->handlePeerConnected(peer_id);
 
   // If using ConnectionMonitor, it might trigger NetworkUp handler
   // If the app auto-connects, maybe trigger offer/answer here?
@@ -532,75 +697,138 @@ void CockpitClientApp::handlePeerDisconnected(const std::string& peer_id,
             << " (Vehicle) disconnected. Reason: " << reason << std::endl;
   // Role: Getting vehicle state -> Notify UI via TelemetryHandler
   // Role: Sending commands -> Disable controls in UI?
-  // TODO: Update UI status via TelemetryHandler
-  // telemetryHandler_->notifyConnectionStatus(peer_id, false); // Assuming
-  // TelemetryHandler has this method
+  telemetryHandler_->notifyConnectionStatus(peer_id, "disconnected", reason);
+  // Losing the controlled vehicle releases control
+  sessionManager_->handlePeerDisconnected(peer_id);
+  // Its transfers end; sending the files again resumes them
+  fileSender_->removePeer(peer_id);
   // TODO: Maybe try to reconnect?
 
   // If using ConnectionMonitor, it might trigger NetworkDown handler
 }
 
-void CockpitClientApp::handleWebrtcDataChannelMessageReceived(
-    const std::string& peer_id, const std::string& label,
-    const std::vector<char>& message) {
+void CockpitClientApp::handleTelemetryChannelMessage(
+    const std::string& peer_id,
+    autodev::remote::webrtc::DataChannelMessageView message) {
   // This handler is called from a WebRTC internal thread. MUST BE THREAD-SAFE.
   // Role: Getting vehicle state -> Receives raw data, deserializes, and routes
-  // to TelemetryHandler std::cout << "App: Received DataChannel message from "
-  // << peer_id << ", label=" << label << ", size=" << message.size() <<
-  // std::endl;
-
-  if (label == config_.telemetry_channel_label) {
-    // Deserialize Protobuf and pass to TelemetryHandler
-    autodev::remote::chassis::Chassis telemetry_data;
-    if (telemetry_data.ParseFromArray(message.data(), message.size())) {
-      // std::cout << "App: Parsed incoming telemetry." << std::endl;
-      // Call TelemetryHandler to process and forward to UI.
-      // TelemetryHandler::processIncomingTelemetry MUST BE THREAD-SAFE.
-      telemetryHandler_->processIncomingTelemetry(peer_id, telemetry_data);
-    } else {
-      std::cerr << "App: Failed to parse telemetry message from " << peer_id
-                << " on label " << label << std::endl;
-      // TODO: Handle parsing error (log, notify UI?)
+  // to TelemetryHandler.
+
+  // The vehicle may pack several updates into one message (telemetry
+  // batching); each record is a Chassis message of its own.
+  if (autodev::remote::webrtc::IsMessageBatch(message.data(),
+                                               message.size())) {
+    autodev::remote::metrics::Increment(
+        autodev::remote::metrics::CounterId::webrtc_dc_batches_received_total);
+    if (!autodev::remote::webrtc::ForEachBatchedMessage(
+            message.data(), message.size(),
+            [this, &peer_id](const char* data, size_t size) {
+              handleTelemetryMessage(peer_id, data, size);
+            })) {
+      autodev::remote::metrics::Increment(
+          autodev::remote::metrics::CounterId::
+              webrtc_dc_batch_parse_failures_total);
+      std::cerr << "App: Malformed telemetry batch from " << peer_id << " ("
+                << message.size() << " bytes)." << std::endl;
     }
-  } else if (label == config_.control_channel_label) {
-    // This might be loopback if the vehicle echoes control commands
-    // Role: Sending commands -> Is this an echo of commands we sent?
-    // TODO: Decide if loopback needs processing or can be ignored. Typically
-    // ignored. std::cout << "App: Received loopback control message from " <<
-    // peer_id << " (ignored)." << std::endl;
   } else {
-    std::cout << "App: Received DataChannel message on unknown label: " << label
-              << " from " << peer_id << std::endl;
-    // TODO: Log unexpected message
+    handleTelemetryMessage(peer_id, message.data(), message.size());
+  }
+}
+
+void CockpitClientApp::handleTelemetryMessage(const std::string& peer_id,
+                                              const char* data, size_t size) {
+  // Deserialize Protobuf and pass to TelemetryHandler
+  autodev::remote::chassis::Chassis telemetry_data;
+  if (telemetry_data.ParseFromArray(data, static_cast<int>(size))) {
+    // std::cout << "App: Parsed incoming telemetry." << std::endl;
+    // Call TelemetryHandler to process and forward to UI.
+    // TelemetryHandler::processIncomingTelemetry MUST BE THREAD-SAFE.
+    telemetryHandler_->processIncomingTelemetry(peer_id, telemetry_data);
+    // Force feedback on the input devices follows the state of the driven
+    // vehicle only; preview vehicles must not move the wheel.
+    if (peer_id == sessionManager_->getControlledVehicle()) {
+      inputDeviceSource_->processVehicleTelemetry(telemetry_data);
+    }
+  } else {
+    std::cerr << "App: Failed to parse telemetry message from " << peer_id
+              << std::endl;
+    // TODO: Handle parsing error (log, notify UI?)
   }
 }
 
 void CockpitClientApp::handleWebrtcError(const std::string& error_msg) {
   // This handler is called from a WebRTC internal thread. MUST BE THREAD-SAFE.
   std::cerr << "App: WebRTC Error: " << error_msg << std::endl;
-  // TODO: Handle errors (logging, updating UI status, retry logic).
+  // TODO: Handle errors (retry logic).
   // Critical errors might warrant stopping the app or attempting reconnection.
-  // telemetryHandler_->notifyWebrtcError(error_msg); // Assuming
-  // TelemetryHandler can notify UI
+  telemetryHandler_->notifyError("webrtc", error_msg);
 }
 
-// --- Optional: Handler for incoming video tracks if C++ processes them (Called
-// by WebRTC threads) --- Role: Serving UI/Video/Telemetry -> Receive video
-// track and send frames to UI void
-// CockpitClientApp::handleWebrtcVideoTrackReceived(const std::string& peer_id,
-// rtc::scoped_refptr<webrtc::VideoTrackInterface> track) {
-//     // This handler is called from a WebRTC internal thread. MUST BE
-//     THREAD-SAFE. std::cout << "App: Received video track from " << peer_id <<
-//     std::endl;
-//     // TODO: Implement logic to get frames from the track and send them to
-//     // the display via TransportServer. This is complex and often involves a
-//     custom
-//     // VideoSink implementation that attaches to the track and uses the
-//     TransportServer
-//     // (or a dedicated video streaming part of it) to send frames to the UI.
-//     // telemetryHandler_->addVehicleVideoTrack(peer_id, track); // Assuming
-//     TelemetryHandler handles video display via TransportServer
-// }
+// --- Handler for incoming video tracks (Called by WebRTC threads) ---
+// Role: Serving UI/Video -> Deliver the vehicle video to the UI via the
+// TransportServer, either as JPEG or as the original encoded frames.
+
+void CockpitClientApp::handleWebrtcVideoTrackReceived(
+    const std::string& peer_id,
+    rtc::scoped_refptr<::webrtc::RtpReceiverInterface> receiver) {
+  // This handler is called from the WebRTC signaling thread. MUST BE
+  // THREAD-SAFE.
+  auto track = rtc::scoped_refptr<::webrtc::VideoTrackInterface>(
+      static_cast<::webrtc::VideoTrackInterface*>(receiver->track().get()));
+  if (!track) {
+    std::cerr << "App: Video receiver from " << peer_id << " has no track."
+              << std::endl;
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(videoMutex_);
+  if (state_ == AppState::Stopping || state_ == AppState::Stopped) return;
+  const uint32_t stream_id = nextVideoStreamId_++;
+  const std::string stream_name = peer_id + "/" + track->id();
+
+  if (config_.video_display_mode == VideoDisplayMode::Passthrough) {
+    // Encoded frames go straight to the browser (WebCodecs decode). The
+    // transformer consumes them, so libwebrtc never decodes this track.
+    auto forwarder =
+        rtc::make_ref_counted<autodev::remote::drivers::EncodedVideoForwarder>(
+            transportServer_, stream_name, stream_id);
+    forwarder->setKeyFrameRequester([track]() {
+      // Sends a PLI/FIR to the vehicle for this track.
+      if (auto source = track->GetSource()) {
+        source->GenerateKeyFrame();
+      }
+    });
+    receiver->SetDepacketizerToDecoderFrameTransformer(forwarder);
+    videoForwarders_.push_back(forwarder);
+    std::cout << "App: Forwarding encoded video " << stream_name
+              << " to the UI (stream " << stream_id << ")." << std::endl;
+    return;
+  }
+
+  auto sink = std::make_unique<autodev::remote::drivers::WebSocketVideoSink>(
+      transportServer_, stream_name, stream_id);
+  track->AddOrUpdateSink(sink.get(), rtc::VideoSinkWants());
+  videoSinks_.push_back(VideoSinkEntry{track, std::move(sink)});
+  std::cout << "App: Sending video " << stream_name
+            << " to the UI as JPEG (stream " << stream_id << ")." << std::endl;
+}
+
+void CockpitClientApp::releaseVideoSinks() {
+  std::lock_guard<std::mutex> lock(videoMutex_);
+  for (auto& entry : videoSinks_) {
+    // Detach first so WebRTC no longer calls OnFrame on the sink.
+    entry.track->RemoveSink(entry.sink.get());
+    entry.sink->stop();
+  }
+  videoSinks_.clear();
+  for (auto& forwarder : videoForwarders_) {
+    // Drops the track reference held by the requester; the receiver keeps
+    // the forwarder itself until the PeerConnection is closed.
+    forwarder->setKeyFrameRequester(nullptr);
+  }
+  videoForwarders_.clear();
+}
 
 // --- Handlers for TransportServer (WebSocket) Events (Called by
 // TransportServer threads) --- These methods receive events from the local UI
@@ -611,14 +839,9 @@ void CockpitClientApp::handleWsConnected(WebSocketConnectionId conn_id) {
   // THREAD-SAFE.
   std::cout << "App: WebSocket client connected (ID " << conn_id << ")"
             << std::endl;
-  // Role: Serving UI/Video/Telemetry -> Manage connected UI clients, send
-  // initial state
-  // TODO: If only one display client is supported, store this ID. If multiple,
-  // track them (e.g., in TelemetryHandler).
-  // telemetryHandler_->addClient(conn_id); // Assuming TelemetryHandler tracks
-  // clients Send initial state/config to the newly connected UI client via
-  // TelemetryHandler. telemetryHandler_->sendInitialState(conn_id); // Assuming
-  // TelemetryHandler has this method
+  // Role: Serving UI/Video/Telemetry -> Subscribe the UI client to telemetry.
+  // The TelemetryHandler sends it the latest vehicle state with its next push.
+  telemetryHandler_->addClient(conn_id);
 }
 
 void CockpitClientApp::handleWsDisconnected(WebSocketConnectionId conn_id) {
@@ -626,21 +849,19 @@ void CockpitClientApp::handleWsDisconnected(WebSocketConnectionId conn_id) {
   // THREAD-SAFE.
   std::cout << "App: WebSocket client disconnected (ID " << conn_id << ")"
             << std::endl;
-  // Role: Serving UI/Video/Telemetry -> Manage connected UI clients
-  // TODO: Remove from active connections map in
-  // TelemetryHandler/TransportServer. telemetryHandler_->removeClient(conn_id);
-  // // Assuming TelemetryHandler tracks clients
+  // Role: Serving UI/Video/Telemetry -> Stop pushing telemetry to the client
+  telemetryHandler_->removeClient(conn_id);
 }
 
-void CockpitClientApp::handleWsMessageReceived(
-    WebSocketConnectionId conn_id, const std::vector<char>& message) {
+void CockpitClientApp::handleWsMessageReceived(WebSocketConnectionId conn_id,
+                                               char* data, size_t size) {
   // This handler is called from a TransportServer internal thread. MUST BE
   // THREAD-SAFE. Role: Sending commands -> Receives raw message from UI and
   // routes to WebCommandHandler std::cout << "App: Received WebSocket message
-  // from " << conn_id << ", size=" << message.size() << std::endl; Call
+  // from " << conn_id << ", size=" << size << std::endl; Call
   // WebCommandHandler to process the raw message.
   // WebCommandHandler::processRawWebCommand MUST BE THREAD-SAFE.
-  webCommandHandler_->processRawWebCommand(conn_id, message);
+  webCommandHandler_->processRawWebCommand(conn_id, data, size);
 }
 
 void CockpitClientApp::handleTransportServerError(
@@ -649,12 +870,22 @@ void CockpitClientApp::handleTransportServerError(
   // THREAD-SAFE.
   std::cerr << "App: Transport Server Error: " << error_msg << std::endl;
   // Role: Serving UI/Video/Telemetry -> Report critical server errors
-  // TODO: Handle server errors (logging, attempt restart? Notify UI?).
-  // A critical transport server error might mean the UI can no longer connect.
-  // Consider stopping the application gracefully or transitioning to an error
-  // state. telemetryHandler_->notifyServerError(error_msg); // Assuming
-  // TelemetryHandler can notify UI stop(); // Example: stop the app on severe
-  // server error
+  // Clients that are still connected get the error; a critical transport
+  // error might mean the UI can no longer connect at all.
+  telemetryHandler_->notifyError("transport", error_msg);
+  // TODO: Decide whether to attempt a restart or stop the app on severe
+  // server errors.
+}
+
+void CockpitClientApp::handleVideoKeyFrameRequested() {
+  // This handler is called from a TransportServer internal thread. MUST BE
+  // THREAD-SAFE.
+  // A browser needs a key frame to start/resume decoding the encoded stream.
+  // The forwarders only set a flag and rate-limit the actual request.
+  std::lock_guard<std::mutex> lock(videoMutex_);
+  for (auto& forwarder : videoForwarders_) {
+    forwarder->requestKeyFrame();
+  }
 }
 
 // --- Handlers for ConnectionMonitor Events (Optional, Called by
@@ -666,8 +897,7 @@ void CockpitClientApp::handleNetworkUp(const std::string& peer_id) {
   // THREAD-SAFE.
   std::cout << "App: Network is UP with peer " << peer_id << std::endl;
   // Role: Getting vehicle state -> Update UI status via TelemetryHandler
-  // telemetryHandler_->notifyNetworkStatus(peer_id, true); // Assuming
-  // TelemetryHandler has this method
+  telemetryHandler_->notifyConnectionStatus(peer_id, "network_up", "");
 }
 
 void CockpitClientApp::handleNetworkDown(const std::string& peer_id,
@@ -681,9 +911,8 @@ void CockpitClientApp::handleNetworkDown(const std::string& peer_id,
   // safety action on vehicle? The safety action should ideally be handled by
   // the vehicle itself based on heartbeat loss, but the cockpit might also
   // signal it or update UI state.
-  // telemetryHandler_->notifyNetworkStatus(peer_id, false, reason); // Assuming
-  // TelemetryHandler has this method commandHandler_->disableControls("Network
-  // Down"); // Assuming CommandHandler can send a safety command or disable UI
+  telemetryHandler_->notifyConnectionStatus(peer_id, "network_down", reason);
+  // commandHandler_->disableControls("Network Down"); // Assuming CommandHandler can send a safety command or disable UI
   // controls internally - Note: This would call webCommandHandler_ or
   // inputDeviceSource_ depending on which can trigger safety actions? Or
   // perhaps a new safety_handler? Rethink safety action trigger flow.
@@ -695,8 +924,7 @@ void CockpitClientApp::handleHeartbeatLost(const std::string& peer_id) {
   std::cerr << "App: Heartbeat lost from peer " << peer_id << std::endl;
   // Role: Getting vehicle state -> Update UI status via TelemetryHandler
   // Role: Sending commands -> Trigger safety action, disable controls
-  // telemetryHandler_->notifyHeartbeatStatus(peer_id, false); // Assuming
-  // TelemetryHandler has this method
+  telemetryHandler_->notifyConnectionStatus(peer_id, "heartbeat_lost", "");
   // commandHandler_->triggerEmergencyStop("Heartbeat Lost"); // Assuming
   // CommandHandler can send emergency command or disable UI controls internally
   // - Similar note as NetworkDown regarding safety trigger.
@@ -771,15 +999,18 @@ int main(int argc, char* argv[]) {
       autodev::remote::drivers::WebCommandHandlerImpl>();  // Needs
                                                            // webrtc_manager,
                                                            // config
-  // TODO: Create InputDeviceSourceImpl based on config_.input_device_config
-  auto input_device_source = std::make_unique<
-      autodev::remote::drivers::InputDeviceSourceImpl>();  // Needs
-                                                           // webrtc_manager,
-                                                           // config, specific
-                                                           // device config
-  auto telemetry_handler = std::make_unique<
-      autodev::remote::drivers::TelemetryHandlerImpl>();  // Needs
-                                                          // transport_server
+  // Reads the evdev devices of app_config.input_device (passed in init)
+  auto input_device_source =
+      std::make_unique<autodev::remote::drivers::EvdevInputDeviceSource>();
+  autodev::remote::drivers::TelemetryHandlerConfig telemetry_config;
+  telemetry_config.publish_rate_hz = app_config.telemetry_publish_rate_hz;
+  telemetry_config.format =
+      app_config.telemetry_binary_format
+          ? autodev::remote::drivers::TelemetryFormat::Binary
+          : autodev::remote::drivers::TelemetryFormat::Json;
+  auto telemetry_handler =
+      std::make_unique<autodev::remote::drivers::TelemetryHandlerImpl>(
+          telemetry_config);  // Needs transport_server (passed in init)
 
   // Create Connection Monitor only if heartbeat is configured and WebrtcManager
   // is available
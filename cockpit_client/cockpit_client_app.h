@@ -5,6 +5,7 @@
 #include <csignal>   // For signal handling
 #include <iostream>  // Temporarily for debug prints
 #include <memory>    // For unique_ptr, shared_ptr
+#include <mutex>     // For videoMutex_
 #include <string>
 #include <thread>  // For running event loop in a thread (if needed)
 #include <vector>
@@ -13,11 +14,19 @@
 #include "config/cockpit_config.h"  // Configuration structure
 
 // Include component interfaces with their namespaces
+#include "drivers/command_arbiter.h"  // autodev::remote::drivers::CommandArbiter
+#include "drivers/vehicle_session_manager.h"  // autodev::remote::drivers::VehicleSessionManager
+#include "drivers/encoded_video_forwarder.h"  // autodev::remote::drivers::EncodedVideoForwarder
 #include "drivers/input_device_source.h"  // autodev::remote::drivers::IInputDeviceSource
 #include "drivers/telemetry_handler.h"  // autodev::remote::drivers::ITelemetryHandler
 #include "drivers/web_command_handler.h"  // autodev::remote::drivers::IWebCommandHandler
+#include "drivers/websocket_video_sink.h"  // autodev::remote::drivers::WebSocketVideoSink
+#include "metrics/metrics_registry.h"  // autodev::remote::metrics::MetricsRegistry
+#include "metrics/prometheus_exporter.h"  // autodev::remote::metrics::PrometheusExporter
 #include "network_manager/connection_monitor.h"  // autodev::remote::network_manager::IConnectionMonitor (Optional)
 #include "transport/transport_server.h"  // autodev::remote::transport::ITransportServer
+#include "webrtc/chunked_transfer.h"  // ChunkedTransferSender
+#include "webrtc/data_channel_registry.h"  // DataChannelDispatcher
 #include "webrtc/webrtc_manager.h"  // autodev::remote::webrtc::WebrtcManager
 
 // Include Protobuf messages used directly or indirectly
@@ -96,6 +105,13 @@ class CockpitClientApp {
   friend void ::signal_handler(
       int signal);  // Assumes signal_handler is in global namespace
 
+  // Sends a file (e.g., map tiles, a calibration) to a connected vehicle
+  // configured to receive files, in the background; a file sent again after
+  // an interruption resumes. Returns the transfer id (the outcome is
+  // logged), or 0 if the file cannot be read or the app is not running.
+  // MUST BE THREAD-SAFE.
+  uint32_t sendFile(const std::string& vehicle_id, const std::string& path);
+
  private:
   // Application State
   std::atomic<AppState> state_{
@@ -110,6 +126,14 @@ class CockpitClientApp {
   std::shared_ptr<autodev::remote::transport::ITransportServer>
       transportServer_;  // Shared because TelemetryHandler uses it
 
+  // Merges the commands of the handlers/sources below into the single
+  // stream sent to the vehicle. Created in setupCommandAndInputHandlers.
+  std::shared_ptr<autodev::remote::drivers::CommandArbiter> commandArbiter_;
+  // Connections to the supervised vehicles and the take-over switch (which
+  // vehicle the CommandArbiter targets). Created with the arbiter.
+  std::shared_ptr<autodev::remote::drivers::VehicleSessionManager>
+      sessionManager_;
+
   // Handlers/Sources based on input type
   std::unique_ptr<autodev::remote::drivers::IWebCommandHandler>
       webCommandHandler_;  // Processes raw commands from WebSocket
@@ -118,9 +142,37 @@ class CockpitClientApp {
   std::unique_ptr<autodev::remote::drivers::ITelemetryHandler>
       telemetryHandler_;  // Processes telemetry from vehicle
 
+  // Handlers of the received messages by DataChannel; set up with the
+  // WebrtcManager callbacks, before any message arrives, read-only after.
+  autodev::remote::webrtc::DataChannelDispatcher channelDispatcher_;
+
+  // Streams files to the vehicles on the file channel; created with the
+  // WebrtcManager callbacks, runs between run() and stop().
+  std::unique_ptr<autodev::remote::webrtc::ChunkedTransferSender> fileSender_;
+
   std::unique_ptr<autodev::remote::network_manager::IConnectionMonitor>
       connectionMonitor_;  // Optional
 
+  // Metrics (WebRTC connection statistics) and their HTTP endpoint
+  // (config_.metrics_port; not created when 0).
+  std::shared_ptr<autodev::remote::metrics::MetricsRegistry> metricsRegistry_;
+  std::unique_ptr<autodev::remote::metrics::PrometheusExporter>
+      metricsExporter_;
+
+  // Received video delivery to the UI (see CockpitConfig::video_display_mode).
+  // One entry per received video track, created in
+  // handleWebrtcVideoTrackReceived and released in stop().
+  struct VideoSinkEntry {
+    rtc::scoped_refptr<::webrtc::VideoTrackInterface> track;
+    std::unique_ptr<autodev::remote::drivers::WebSocketVideoSink> sink;
+  };
+  std::mutex videoMutex_;
+  std::vector<VideoSinkEntry> videoSinks_;  // Guarded by videoMutex_ (Jpeg)
+  std::vector<
+      rtc::scoped_refptr<autodev::remote::drivers::EncodedVideoForwarder>>
+      videoForwarders_;  // Guarded by videoMutex_ (Passthrough)
+  uint32_t nextVideoStreamId_ = 1;  // Guarded by videoMutex_
+
   // Event loop context (e.g., boost::asio::io_context) - owned by the app or
   // shared All async operations (WebRTC, WebSocket server, timers) should use
   // this context. std::shared_ptr<boost::asio::io_context> ioContext_; // Use
@@ -145,14 +197,23 @@ class CockpitClientApp {
   void handlePeerConnected(const std::string& peer_id);
   void handlePeerDisconnected(const std::string& peer_id,
                               const std::string& reason);
-  void handleWebrtcDataChannelMessageReceived(
-      const std::string& peer_id, const std::string& label,
-      const std::vector<char>&
-          message);  // Deserializes and routes to TelemetryHandler
+  // Unpacks telemetry batches and routes each message to
+  // handleTelemetryMessage.
+  void handleTelemetryChannelMessage(
+      const std::string& peer_id,
+      autodev::remote::webrtc::DataChannelMessageView message);
+  // Parses one Chassis message and hands it to the TelemetryHandler and the
+  // input devices (called per record of a telemetry batch).
+  void handleTelemetryMessage(const std::string& peer_id, const char* data,
+                              size_t size);
   void handleWebrtcError(const std::string& error_msg);
-  // TODO: Add handleWebrtcVideoTrackReceived(const std::string& peer_id,
-  // rtc::scoped_refptr<webrtc::VideoTrackInterface> track); // If C++ handles
-  // video, routes to TelemetryHandler or VideoHandler
+  // Attaches a WebSocketVideoSink (Jpeg mode) or an EncodedVideoForwarder
+  // (Passthrough mode) to the received video track.
+  void handleWebrtcVideoTrackReceived(
+      const std::string& peer_id,
+      rtc::scoped_refptr<::webrtc::RtpReceiverInterface> receiver);
+  // Releases all video sinks/forwarders (called from stop()).
+  void releaseVideoSinks();
 
   // --- Handlers for TransportServer (WebSocket) Events (Called by
   // TransportServer threads) --- These methods are called from TransportServer
@@ -164,11 +225,11 @@ class CockpitClientApp {
       WebSocketConnectionId
           conn_id);  // Notifies TelemetryHandler or manages client list
   void handleWsMessageReceived(
-      WebSocketConnectionId conn_id,
-      const std::vector<char>&
-          message);  // Routes raw message to WebCommandHandler
+      WebSocketConnectionId conn_id, char* data,
+      size_t size);  // Routes raw message to WebCommandHandler
   void handleTransportServerError(
       const std::string& error_msg);  // Logs or triggers application shutdown
+  void handleVideoKeyFrameRequested();  // Forwards to EncodedVideoForwarders
 
   // --- Handlers for ConnectionMonitor Events (Optional, Called by
   // ConnectionMonitor thread) --- These methods are called from
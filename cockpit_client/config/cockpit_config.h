@@ -5,14 +5,30 @@
 #include <string>
 #include <vector>
 
+#include "config/input_device_config.h"
+
 // Reuse WebRtcServerConfig and IceServer from VehicleConfig if identical
 // struct WebRtcServerConfig { ... };
 // struct IceServer { ... };
 
+// How received vehicle video reaches the browser UI.
+enum class VideoDisplayMode {
+  // Decode natively, re-encode each frame as JPEG (WebSocketVideoSink).
+  // Works in every browser.
+  Jpeg,
+  // Forward the encoded H.264/VP8 frames unchanged (EncodedVideoForwarder);
+  // the browser decodes them with WebCodecs. No native decode or re-encode.
+  Passthrough,
+};
+
 struct CockpitConfig {
   WebRtcServerConfig signaling;   // Signaling server URI, JWT
   std::string client_id;          // Unique ID for this cockpit client
   std::string target_vehicle_id;  // ID of the vehicle to connect to
+  // Further vehicles supervised at the same time: all of them stay
+  // connected with preview video and telemetry, and the operator takes over
+  // one at a time. target_vehicle_id (if set) is taken over once connected.
+  std::vector<std::string> vehicle_ids;
 
   // Local transport server config
   std::string transport_server_address = "127.0.0.1";
@@ -23,10 +39,44 @@ struct CockpitConfig {
   // DataChannel labels (should match vehicle client)
   std::string control_channel_label = "control";
   std::string telemetry_channel_label = "telemetry";
+  std::string session_channel_label = "session";
+
+  // Files sent to a vehicle (CockpitClientApp::sendFile) go in chunks on a
+  // low priority channel. At most file_max_buffered_bytes wait in its send
+  // buffer, so a transfer never queues much in front of control commands;
+  // more chunks follow when it drains below the low threshold.
+  std::string file_channel_label = "file";
+  uint64_t file_max_buffered_bytes = 64 * 1024;
+  uint64_t file_buffered_amount_low_threshold = 16 * 1024;
+
+  // Control commands of the web UI and the input devices are merged into
+  // one stream (input devices win over the web UI) sent at this rate. A
+  // source without a command for command_source_timeout_ms is inactive;
+  // after an emergency command no control commands are sent for
+  // emergency_hold_ms.
+  double command_send_rate_hz = 50.0;
+  int command_source_timeout_ms = 200;
+  int emergency_hold_ms = 2000;
 
   std::vector<IceServer> ice_servers;  // WebRTC ICE server config
 
-  // Add other configurations as needed (e.g., input device mapping)
+  // Telemetry pushes to the UI: at most this many per second per vehicle
+  // (latest state wins), as JSON text or compact binary messages.
+  double telemetry_publish_rate_hz = 30.0;
+  bool telemetry_binary_format = false;
+
+  // Received video
+  VideoDisplayMode video_display_mode = VideoDisplayMode::Jpeg;
+
+  // Steering wheel / pedals / shifter mapping (empty: no device input)
+  InputDeviceConfig input_device;
+
+  // Prometheus text endpoint (http://<address>:<port>/metrics) for the
+  // WebRTC connection statistics; port 0 disables it.
+  std::string metrics_address = "127.0.0.1";
+  uint16_t metrics_port = 9464;
+
+  // Add other configurations as needed
   int heartbeat_interval_ms = 5000;  // milliseconds
 };
 
@@ -0,0 +1,108 @@
+#ifndef INPUT_DEVICE_CONFIG_H
+#define INPUT_DEVICE_CONFIG_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Configuration of the physical input devices (steering wheel, pedals,
+// shifter) read through Linux evdev. Event codes are the ABS_* / BTN_* /
+// KEY_* values of <linux/input-event-codes.h>; `evtest <device>` lists them.
+
+// Which ControlCommand field an axis drives.
+enum class InputAxisTarget {
+  Steering,      // Bipolar: -1..1, scaled by max_steering_angle
+  Acceleration,  // Unipolar: 0..1
+  Braking,       // Unipolar: 0..1
+};
+
+struct InputAxisConfig {
+  std::string device_path;  // e.g. /dev/input/by-id/usb-...-event-joystick
+  uint16_t code = 0;        // ABS_* event code
+  InputAxisTarget target = InputAxisTarget::Steering;
+
+  // Raw range. If raw_min == raw_max, the range reported by the device
+  // (EVIOCGABS) is used.
+  int32_t raw_min = 0;
+  int32_t raw_max = 0;
+  bool invert = false;  // E.g. pedals reporting max when released
+
+  // Fraction of the normalized range around rest (center for steering,
+  // released for pedals) that maps to 0. The rest is rescaled to stay
+  // continuous.
+  double deadzone = 0.0;
+
+  // Calibration curve applied after the deadzone, on the magnitude in 0..1:
+  // if curve_points is non-empty it is a piecewise-linear map given as
+  // (input, output) pairs with increasing input (outside them the nearest
+  // output is held); otherwise
+  // output = input ^ curve_exponent (1.0 = linear, > 1 = finer control near
+  // rest).
+  double curve_exponent = 1.0;
+  std::vector<std::pair<double, double>> curve_points;
+};
+
+// What a button does while pressed.
+enum class InputButtonAction {
+  SetGear,    // Selects `gear` on press
+  HandBrake,  // Hand brake engaged while held
+};
+
+struct InputButtonConfig {
+  std::string device_path;
+  uint16_t code = 0;  // BTN_* / KEY_* event code
+  InputButtonAction action = InputButtonAction::SetGear;
+  int32_t gear = 0;  // For SetGear (chassis enum: 0 N, 1 D, 2 R, 3 P)
+};
+
+// Steering force feedback computed from the vehicle telemetry (Chassis)
+// and played on the wheel through evdev FF effects.
+struct ForceFeedbackConfig {
+  bool enabled = false;
+  // FF-capable event device; empty: the device of the first steering axis.
+  std::string device_path;
+  // Maximum effect updates per second; newer telemetry replaces older
+  // telemetry that was not applied yet.
+  double update_rate_hz = 60.0;
+  // Global device gain, 0..1 (FF_GAIN).
+  double gain = 1.0;
+
+  // Self-centering spring strength (0..1 of the device maximum), rising
+  // linearly with speed from centering_at_standstill to centering_at_speed
+  // at full_speed_mps and above.
+  double centering_at_standstill = 0.1;
+  double centering_at_speed = 0.6;
+  double full_speed_mps = 25.0;
+  // Damper strength (0..1) at full_speed_mps, scaled like the spring.
+  double damping_at_speed = 0.2;
+  // Flips the constant force (wheels without spring support) for drivers
+  // using the opposite direction convention.
+  bool invert_constant_force = false;
+
+  // Without telemetry for this long the forces are released; the wheel
+  // must not keep simulating a vehicle that may be gone.
+  int telemetry_timeout_ms = 500;
+  // Changes smaller than this (0..1) are not sent to the device.
+  double min_change = 0.01;
+};
+
+struct InputDeviceConfig {
+  std::vector<InputAxisConfig> axes;
+  std::vector<InputButtonConfig> buttons;
+
+  // ControlCommands with the latest values are submitted to the command
+  // arbiter at this fixed rate, independent of the device event rate. Keep
+  // it above 1000 / CockpitConfig::command_source_timeout_ms.
+  double send_rate_hz = 100.0;
+  // Steering angle sent for full lock (|normalized| == 1).
+  double max_steering_angle = 1.0;
+  int32_t initial_gear = 0;  // Neutral
+  // Take exclusive access (EVIOCGRAB) so other programs (e.g. the desktop)
+  // do not also act on the devices.
+  bool grab_devices = false;
+
+  ForceFeedbackConfig force_feedback;
+};
+
+#endif  // INPUT_DEVICE_CONFIG_H
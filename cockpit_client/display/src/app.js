@@ -17,6 +17,38 @@ const APP_CONFIG = {
    // Add other config like heartbeat interval, etc.
 };
 
+// Binary telemetry message written by the C++ TelemetryHandlerImpl.
+// MUST match kTelemetryBinary* in cockpit_client/drivers/telemetry_handler_impl.h (little-endian).
+const TELEMETRY_BINARY_MAGIC = 0x314D5457; // 'W','T','M','1' read as little-endian uint32
+const TELEMETRY_BINARY_MIN_HEADER_SIZE = 36;
+
+/**
+ * Parses a binary telemetry message into the same shape as the JSON
+ * 'telemetry' message.
+ * @param {ArrayBuffer} buffer - The raw WebSocket message.
+ * @returns {object|null} { vehicle_id, seq, timestamp_us, data }, or null if malformed.
+ */
+function parseBinaryTelemetry(buffer) {
+  if (buffer.byteLength < TELEMETRY_BINARY_MIN_HEADER_SIZE) {
+      return null;
+  }
+  const view = new DataView(buffer);
+  const headerSize = view.getUint16(4, true);
+  const vehicleIdLength = view.getUint16(12, true);
+  if (headerSize < TELEMETRY_BINARY_MIN_HEADER_SIZE || headerSize + vehicleIdLength > buffer.byteLength) {
+      return null;
+  }
+  return {
+      vehicle_id: new TextDecoder().decode(new Uint8Array(buffer, headerSize, vehicleIdLength)),
+      seq: view.getUint32(8, true),
+      timestamp_us: Number(view.getBigInt64(16, true)),
+      data: {
+          speed_mps: view.getFloat64(24, true),
+          gear: view.getInt32(32, true),
+      },
+  };
+}
+
 // --- Global instances ---
 let statusPanel;
 let videoPlayer;
@@ -44,6 +76,8 @@ console.error = function(message) { appendLog("ERROR: " + message); };
 function connectWebSocket() {
   appendLog(`Attempting to connect WebSocket to ${APP_CONFIG.WEBSOCKET_URL}`);
   websocket = new WebSocket(APP_CONFIG.WEBSOCKET_URL);
+  // Video frames arrive as binary messages (header + JPEG), see video_player.js
+  websocket.binaryType = 'arraybuffer';
 
   websocket.onopen = () => {
       appendLog('WebSocket connection opened.');
@@ -64,7 +98,22 @@ function connectWebSocket() {
   };
 
   websocket.onmessage = (event) => {
-      // Messages from backend could be signaling or telemetry
+      // Binary messages are video frames or (binary format) telemetry,
+      // told apart by their magic
+      if (event.data instanceof ArrayBuffer) {
+          if (event.data.byteLength >= 4 &&
+              new DataView(event.data).getUint32(0, true) === TELEMETRY_BINARY_MAGIC) {
+              const telemetry = parseBinaryTelemetry(event.data);
+              if (telemetry && statusPanel) {
+                  statusPanel.updateStatus(telemetry.data);
+              }
+          } else if (videoPlayer) {
+              videoPlayer.handleBinaryVideoFrame(event.data);
+          }
+          return;
+      }
+
+      // Text messages from backend could be signaling or telemetry
       try {
           const message = JSON.parse(event.data);
           // appendLog(`WebSocket message received: ${JSON.stringify(message)}`); // Log all messages (can be noisy)
@@ -78,6 +127,14 @@ function connectWebSocket() {
                if (statusPanel) {
                    statusPanel.updateStatus(message.data); // Assume data is the telemetry object
                }
+          } else if (message.type === 'status') {
+              // Link state to a vehicle changed (connected, network_down, ...)
+              appendLog(`Vehicle ${message.vehicle_id}: ${message.status}${message.detail ? ' (' + message.detail + ')' : ''}`);
+              if (statusPanel) {
+                  statusPanel.setTelemetryStatus(message.status);
+              }
+          } else if (message.type === 'error') {
+              appendLog(`Cockpit error (${message.source}): ${message.message}`);
           } else if (message.type === 'control_ack') {
                // Optional: Acknowledge for control commands
                appendLog(`Control command acknowledged by backend/vehicle.`);
@@ -262,6 +319,23 @@ function sendEmergencyCommand(commandData) {
   }
 }
 
+/**
+* Asks the cockpit backend to take over a vehicle (multi-vehicle cockpit).
+* The vehicle switches to full-rate video and receives the control commands;
+* the previously controlled vehicle goes back to preview. The backend
+* confirms with status messages ('control' / 'preview') per vehicle.
+* @param {string} vehicleId - ID of a configured, connected vehicle.
+*/
+function takeControl(vehicleId) {
+  sendWebSocketMessage({ type: 'take_control', data: { vehicle_id: vehicleId } });
+}
+
+/**
+* Puts the controlled vehicle back to preview; no vehicle is controlled.
+*/
+function releaseControl() {
+  sendWebSocketMessage({ type: 'release_control' });
+}
 
 // --- Initialize App ---
 document.addEventListener('DOMContentLoaded', () => {
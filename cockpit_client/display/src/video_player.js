@@ -1,11 +1,52 @@
 // display/public/js/video_player.js
 
+// Binary video frame header written by the C++ WebSocketVideoSink and
+// EncodedVideoForwarder.
+// MUST match cockpit_client/drivers/video_frame_header.h (little-endian).
+const VIDEO_FRAME_MAGIC = 0x31465657; // 'W','V','F','1' read as little-endian uint32
+const VIDEO_FRAME_MIN_HEADER_SIZE = 32; // Version 1 header (no flags field)
+const VIDEO_FRAME_FLAGS_HEADER_SIZE = 36; // Version 2+ headers carry flags at offset 32
+const VIDEO_PAYLOAD_TYPE_JPEG = 1;
+const VIDEO_PAYLOAD_TYPE_H264 = 2; // Annex B access unit
+const VIDEO_PAYLOAD_TYPE_VP8 = 3;
+const VIDEO_FRAME_FLAG_KEY_FRAME = 1;
+// Encoded frames queued in a WebCodecs decoder beyond this mean the decoder
+// cannot keep up; it is reset and restarts at the next key frame.
+const VIDEO_MAX_DECODE_QUEUE = 4;
+
+/**
+ * Builds the WebCodecs codec string ('avc1.PPCCLL') from the SPS of an H.264
+ * Annex B access unit.
+ * @param {Uint8Array} data - The access unit.
+ * @returns {string|null} The codec string, or null if no SPS was found.
+ */
+function h264CodecString(data) {
+    for (let i = 0; i + 3 < data.length; i++) {
+        // Start code 00 00 01 (the 4-byte form ends with the same 3 bytes)
+        if (data[i] !== 0 || data[i + 1] !== 0 || data[i + 2] !== 1) {
+            continue;
+        }
+        const nalStart = i + 3;
+        if ((data[nalStart] & 0x1f) === 7 && nalStart + 3 < data.length) { // SPS
+            const hex = b => b.toString(16).padStart(2, '0');
+            return 'avc1.' + hex(data[nalStart + 1]) + hex(data[nalStart + 2]) + hex(data[nalStart + 3]);
+        }
+        i = nalStart - 1;
+    }
+    return null;
+}
+
 /**
  * Manages the WebRTC PeerConnection for receiving video and handling signaling.
  */
 class VideoPlayer {
-  constructor(videoElementId = 'vehicleVideo', connectionStatusId = 'connectionStatus') {
+  constructor(videoElementId = 'vehicleVideo', connectionStatusId = 'connectionStatus', canvasElementId = 'vehicleVideoCanvas') {
       this.videoElement = document.getElementById(videoElementId);
+      this.canvasElement = document.getElementById(canvasElementId); // Target for binary (JPEG) frames
+      this.canvasContext = this.canvasElement ? this.canvasElement.getContext('2d') : null;
+      this.lastFrameSequence = new Map(); // stream_id -> last rendered sequence
+      this.decodingFrame = false; // True while a JPEG is being decoded
+      this.videoDecoders = new Map(); // stream_id -> WebCodecs decoder state (passthrough mode)
       this.connectionStatusElement = document.getElementById(connectionStatusId);
       this.peerConnection = null; // RTCPeerConnection instance
       this.localDataChannel = null; // Optional: if browser creates data channels
@@ -213,6 +254,192 @@ class VideoPlayer {
       }
   }
 
+  /**
+   * Renders a binary video frame received over the WebSocket.
+   * Layout (little-endian): magic u32, header_size u16, version u8, payload_type u8,
+   * stream_id u32, sequence u32, capture_timestamp_us i64, width u16, height u16,
+   * payload_size u32, flags u32 (version 2+), followed by the payload.
+   * JPEG frames are decoded with createImageBitmap; encoded H.264/VP8 frames
+   * (passthrough mode) are decoded with WebCodecs.
+   * @param {ArrayBuffer} buffer - The raw WebSocket message.
+   */
+  handleBinaryVideoFrame(buffer) {
+      if (!this.canvasContext || buffer.byteLength < VIDEO_FRAME_MIN_HEADER_SIZE) {
+          return;
+      }
+      const view = new DataView(buffer);
+      if (view.getUint32(0, true) !== VIDEO_FRAME_MAGIC) {
+          console.warn('VideoPlayer: Dropping binary message with unknown magic.');
+          return;
+      }
+      const headerSize = view.getUint16(4, true);
+      const payloadType = view.getUint8(7);
+      const payloadSize = view.getUint32(28, true);
+      if (headerSize + payloadSize > buffer.byteLength) {
+          return;
+      }
+      const frame = {
+          streamId: view.getUint32(8, true),
+          sequence: view.getUint32(12, true),
+          timestampUs: Number(view.getBigInt64(16, true)),
+          flags: headerSize >= VIDEO_FRAME_FLAGS_HEADER_SIZE ? view.getUint32(32, true) : 0,
+          payload: new Uint8Array(buffer, headerSize, payloadSize),
+      };
+
+      if (payloadType === VIDEO_PAYLOAD_TYPE_JPEG) {
+          this.renderJpegFrame(frame);
+      } else if (payloadType === VIDEO_PAYLOAD_TYPE_H264 || payloadType === VIDEO_PAYLOAD_TYPE_VP8) {
+          this.decodeEncodedFrame(payloadType, frame);
+      }
+  }
+
+  /**
+   * Decodes and draws a JPEG frame. Frames arriving while the previous one is
+   * still decoding are skipped so the display always shows the freshest frame
+   * instead of queuing behind the decoder.
+   * @param {object} frame - Parsed frame from handleBinaryVideoFrame.
+   */
+  renderJpegFrame(frame) {
+      // Ignore frames older than the last rendered one (sequence wraps at 2^32).
+      const lastSequence = this.lastFrameSequence.get(frame.streamId);
+      if (lastSequence !== undefined && ((frame.sequence - lastSequence) >>> 0) >= 0x80000000) {
+          return;
+      }
+      if (this.decodingFrame) {
+          return;
+      }
+      this.decodingFrame = true;
+      this.lastFrameSequence.set(frame.streamId, frame.sequence);
+
+      const jpeg = new Blob([frame.payload], { type: 'image/jpeg' });
+      createImageBitmap(jpeg).then(bitmap => {
+          this.drawToCanvas(bitmap, bitmap.width, bitmap.height);
+          bitmap.close();
+      }).catch(e => {
+          console.error('VideoPlayer: Failed to decode JPEG frame:', e);
+      }).finally(() => {
+          this.decodingFrame = false;
+      });
+  }
+
+  /**
+   * Feeds an encoded H.264/VP8 frame to the stream's WebCodecs VideoDecoder.
+   * Unlike JPEG, delta frames cannot be skipped: after any loss (or decoder
+   * overload) the stream resumes at the next key frame. The cockpit already
+   * skips slow clients to a key frame and asks the vehicle for one.
+   * @param {number} payloadType - VIDEO_PAYLOAD_TYPE_H264 or VIDEO_PAYLOAD_TYPE_VP8.
+   * @param {object} frame - Parsed frame from handleBinaryVideoFrame.
+   */
+  decodeEncodedFrame(payloadType, frame) {
+      if (typeof VideoDecoder === 'undefined') {
+          if (!this.webCodecsWarningShown) {
+              this.webCodecsWarningShown = true;
+              console.error('VideoPlayer: WebCodecs is not available; use the JPEG video display mode.');
+          }
+          return;
+      }
+      const isKeyFrame = (frame.flags & VIDEO_FRAME_FLAG_KEY_FRAME) !== 0;
+      let state = this.videoDecoders.get(frame.streamId);
+
+      if (state && state.lastSequence !== undefined &&
+          frame.sequence !== ((state.lastSequence + 1) >>> 0)) {
+          state.waitingForKeyFrame = true; // Missed a frame, references are gone
+      }
+      if (state) {
+          state.lastSequence = frame.sequence;
+      }
+      if (!isKeyFrame && (!state || state.waitingForKeyFrame)) {
+          return;
+      }
+
+      if (isKeyFrame) {
+          const codec = payloadType === VIDEO_PAYLOAD_TYPE_H264 ? h264CodecString(frame.payload) : 'vp8';
+          if (!codec) {
+              return; // Key frame without SPS, wait for the next one
+          }
+          if (!state || state.decoder.state === 'closed' || state.codec !== codec) {
+              if (state && state.decoder.state !== 'closed') {
+                  state.decoder.close();
+              }
+              state = this.createVideoDecoder(frame.streamId, codec);
+              if (!state) {
+                  return;
+              }
+          }
+          state.lastSequence = frame.sequence;
+          state.waitingForKeyFrame = false;
+      }
+
+      if (state.decoder.decodeQueueSize > VIDEO_MAX_DECODE_QUEUE) {
+          console.warn('VideoPlayer: Decoder overloaded, waiting for the next key frame.');
+          state.decoder.reset();
+          state.configured = false;
+          state.waitingForKeyFrame = true;
+          return;
+      }
+      if (!state.configured) {
+          state.decoder.configure({ codec: state.codec, optimizeForLatency: true });
+          state.configured = true;
+      }
+      try {
+          state.decoder.decode(new EncodedVideoChunk({
+              type: isKeyFrame ? 'key' : 'delta',
+              timestamp: frame.timestampUs,
+              data: frame.payload,
+          }));
+      } catch (e) {
+          console.error('VideoPlayer: Failed to queue encoded frame:', e);
+          state.waitingForKeyFrame = true;
+      }
+  }
+
+  /**
+   * Creates the WebCodecs decoder for one stream.
+   * @param {number} streamId - The stream_id from the frame header.
+   * @param {string} codec - WebCodecs codec string (e.g., 'avc1.42e01f', 'vp8').
+   * @returns {object|null} The decoder state, or null if creation failed.
+   */
+  createVideoDecoder(streamId, codec) {
+      const state = { codec, configured: false, waitingForKeyFrame: true, lastSequence: undefined, decoder: null };
+      try {
+          state.decoder = new VideoDecoder({
+              output: videoFrame => {
+                  this.drawToCanvas(videoFrame, videoFrame.displayWidth, videoFrame.displayHeight);
+                  videoFrame.close(); // Release the decoder's buffer immediately
+              },
+              error: e => {
+                  // The decoder is closed after an error; recreate it at the next key frame.
+                  console.error('VideoPlayer: Video decoder error:', e);
+                  state.waitingForKeyFrame = true;
+              },
+          });
+      } catch (e) {
+          console.error('VideoPlayer: Failed to create video decoder:', e);
+          return null;
+      }
+      this.videoDecoders.set(streamId, state);
+      console.log(`VideoPlayer: Decoding stream ${streamId} with WebCodecs (${codec}).`);
+      return state;
+  }
+
+  /**
+   * Draws a decoded image (ImageBitmap or VideoFrame) to the video canvas.
+   * @param {CanvasImageSource} image - The decoded image.
+   * @param {number} width - Image width in pixels.
+   * @param {number} height - Image height in pixels.
+   */
+  drawToCanvas(image, width, height) {
+      if (this.canvasElement.width !== width || this.canvasElement.height !== height) {
+          this.canvasElement.width = width;
+          this.canvasElement.height = height;
+      }
+      this.canvasContext.drawImage(image, 0, 0);
+      if (this.canvasElement.hidden) {
+          this.canvasElement.hidden = false;
+          this.setConnectionStatus('Receiving Video (WebSocket)');
+      }
+  }
+
   /**
    * Helper to update the connection status display.
    * @param {string} statusText - The status text.
@@ -228,6 +455,12 @@ class VideoPlayer {
     * Closes the PeerConnection and cleans up resources.
     */
    close() {
+       for (const state of this.videoDecoders.values()) {
+           if (state.decoder.state !== 'closed') {
+               state.decoder.close();
+           }
+       }
+       this.videoDecoders.clear();
        if (this.peerConnection) {
            console.log("VideoPlayer: Closing PeerConnection.");
             this.peerConnection.close();
@@ -0,0 +1,100 @@
+// WebCommandParser cost per browser message, and what the per-message
+// std::vector<char> copy the transport used to make added on top of it.
+//
+// Parsing is in place, so each iteration first restores the message into a
+// reused buffer (as websocketpp holds it in its payload); the "restore only"
+// row is that memcpy alone and can be subtracted from the others.
+//
+// Build, then run, from the repository root:
+//   g++ -std=c++17 -O2 -I. -Icockpit_client
+//       -o /tmp/web_command_parser_benchmark
+//       cockpit_client/drivers/benchmarks/web_command_parser_benchmark.cc
+//       cockpit_client/drivers/web_command_parser.cc
+//   /tmp/web_command_parser_benchmark
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "drivers/web_command_parser.h"
+#include "testing/allocation_counter.h"
+#include "testing/benchmark.h"
+
+namespace {
+
+using autodev::remote::drivers::WebCommand;
+using autodev::remote::drivers::WebCommandParser;
+using autodev::remote::testing::Allocations;
+using autodev::remote::testing::DoNotOptimize;
+using autodev::remote::testing::NanosPerOp;
+
+constexpr uint64_t kIterations = 2000000;
+
+// A control message as display/src/app.js sends it at input-device rate.
+const char kControl[] =
+    "{\"type\":\"control\",\"data\":{\"acceleration\":0.372,"
+    "\"braking\":0,\"steering_angle\":-14.25,\"gear\":1,"
+    "\"hand_brake\":false}}";
+const char kEmergency[] =
+    "{\"type\":\"emergency\",\"data\":{\"type\":1,"
+    "\"reason\":\"Manual Emergency Stop Button \\u2013 operator\"}}";
+// A signaling message: not a command, validated and skipped.
+const char kSignaling[] =
+    "{\"type\":\"signaling\",\"data\":{\"sdp\":{\"type\":\"answer\","
+    "\"sdp\":\"v=0\\r\\no=- 4611731400430051336 2 IN IP4 127.0.0.1\\r\\n"
+    "s=-\\r\\nt=0 0\\r\\na=group:BUNDLE 0 1\\r\\n"
+    "m=application 9 UDP/DTLS/SCTP webrtc-datachannel\\r\\n\"},"
+    "\"target\":\"vehicle-042\"}}";
+
+// Runs one case and prints its time and heap allocations per message.
+template <typename Op>
+void Run(const char* name, Op&& op) {
+  const uint64_t allocations_before = Allocations();
+  const double ns = NanosPerOp(kIterations, op);
+  const double allocations =
+      static_cast<double>(Allocations() - allocations_before) /
+      static_cast<double>(kIterations + kIterations / 10);
+  std::printf("%-44s %8.1f ns/msg %6.2f allocs/msg\n", name, ns,
+              allocations);
+}
+
+void RunMessage(const char* label, const char* message) {
+  const size_t size = std::strlen(message);
+  std::string payload(message);  // Stands in for the transport's buffer
+  WebCommandParser parser;
+  WebCommand command;
+  // Every case must parse, or the numbers would measure the error path.
+  if (!parser.parse(payload.data(), size, &command)) {
+    std::fprintf(stderr, "%s: %s\n", label, parser.error());
+    std::exit(1);
+  }
+
+  std::string name = std::string(label) + ": restore only";
+  Run(name.c_str(), [&] {
+    std::memcpy(payload.data(), message, size);
+    DoNotOptimize(payload);
+  });
+  name = std::string(label) + ": in place (current)";
+  Run(name.c_str(), [&] {
+    std::memcpy(payload.data(), message, size);
+    DoNotOptimize(parser.parse(payload.data(), size, &command));
+  });
+  name = std::string(label) + ": vector copy + parse";
+  Run(name.c_str(), [&] {
+    std::memcpy(payload.data(), message, size);
+    std::vector<char> copy(payload.begin(), payload.end());
+    DoNotOptimize(parser.parse(copy.data(), copy.size(), &command));
+  });
+}
+
+}  // namespace
+
+int main() {
+  RunMessage("control", kControl);
+  RunMessage("emergency", kEmergency);
+  RunMessage("signaling (skipped)", kSignaling);
+  return 0;
+}
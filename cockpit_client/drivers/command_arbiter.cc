@@ -0,0 +1,259 @@
+#include "drivers/command_arbiter.h"
+
+#include <iostream>
+
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+namespace {
+
+size_t SourceIndex(CommandSource source) {
+  return static_cast<size_t>(source);
+}
+
+}  // namespace
+
+CommandArbiter::CommandArbiter(
+    std::shared_ptr<autodev::remote::webrtc::WebrtcManager> webrtc_manager,
+    const std::string& control_channel_label,
+    const std::string& target_peer_id, const CommandArbiterConfig& config)
+    : webrtcManager_(std::move(webrtc_manager)),
+      controlChannelLabel_(control_channel_label),
+      config_(config),
+      sourceTimeout_(std::chrono::milliseconds(config.source_timeout_ms)),
+      targetPeerId_(target_peer_id) {
+  std::cout << "CommandArbiter created." << std::endl;
+}
+
+CommandArbiter::~CommandArbiter() { stop(); }
+
+bool CommandArbiter::start() {
+  if (!webrtcManager_) {
+    std::cerr << "CommandArbiter: WebrtcManager is null." << std::endl;
+    return false;
+  }
+  if (!(config_.send_rate_hz > 0.0)) {
+    std::cerr << "CommandArbiter: send_rate_hz must be > 0." << std::endl;
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (running_) {
+    std::cerr << "CommandArbiter: Already running." << std::endl;
+    return false;
+  }
+  running_ = true;
+  haveSent_ = false;
+  senderThread_ = std::thread(&CommandArbiter::senderThreadMain, this);
+  std::cout << "CommandArbiter: Sending control commands at "
+            << config_.send_rate_hz << " Hz." << std::endl;
+  return true;
+}
+
+void CommandArbiter::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) return;
+    running_ = false;
+  }
+  cv_.notify_all();
+  if (senderThread_.joinable()) senderThread_.join();
+
+  const CommandArbiterStats stats = getStats();
+  std::cout << "CommandArbiter: Stopped. " << stats.commands_sent
+            << " commands sent (" << stats.send_failures << " failed), "
+            << stats.web_overridden << " web commands overridden, "
+            << stats.suppressed_by_emergency
+            << " suppressed by emergency, " << stats.emergencies_sent
+            << " emergencies sent." << std::endl;
+}
+
+// --- Implementation of ICommandSink Interface ---
+
+bool CommandArbiter::submitControlCommand(
+    CommandSource source,
+    const autodev::remote::control::ControlCommand& command) {
+  // Called from source threads. MUST BE THREAD-SAFE.
+  const Clock::time_point now = Clock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!running_ || targetPeerId_.empty()) return false;
+  ++stats_.control_submitted[SourceIndex(source)];
+  if (now < emergencyHoldUntil_) {
+    ++stats_.suppressed_by_emergency;
+  } else if (source == CommandSource::WebUi &&
+             isActiveLocked(CommandSource::InputDevice, now)) {
+    ++stats_.web_overridden;
+  }
+  SourceSlot& slot = sources_[SourceIndex(source)];
+  if (slot.unsent) ++stats_.coalesced;
+  // CopyFrom reuses the slot's storage.
+  slot.command.CopyFrom(command);
+  slot.received = now;
+  slot.has_command = true;
+  slot.unsent = true;
+  return true;
+}
+
+bool CommandArbiter::submitEmergencyCommand(
+    CommandSource source,
+    const autodev::remote::control::EmergencyCommand& command) {
+  // Called from source threads. MUST BE THREAD-SAFE.
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.emergencies_submitted[SourceIndex(source)];
+    // Hold control commands first, so none selected from now on is sent
+    // after the emergency (the sender rechecks under sendMutex_). Accepted
+    // even when stopped: an emergency must never be dropped here.
+    emergencyHoldUntil_ =
+        Clock::now() + std::chrono::milliseconds(config_.emergency_hold_ms);
+  }
+  std::cout << "CommandArbiter: Emergency command from "
+            << CommandSourceName(source) << "; holding control commands for "
+            << config_.emergency_hold_ms << " ms." << std::endl;
+
+  bool sent;
+  {
+    std::lock_guard<std::mutex> send_lock(sendMutex_);
+    sent = sendLocked(command);
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (sent) {
+    ++stats_.emergencies_sent;
+  } else {
+    ++stats_.send_failures;
+    // Without a target no vehicle would act on it: a vehicle only executes
+    // the control channel messages of its controller.
+    std::cerr << "CommandArbiter: FAILED to send emergency command"
+              << (targetPeerId_.empty() ? " (no vehicle is controlled)" : "")
+              << "!" << std::endl;
+  }
+  return sent;
+}
+
+CommandArbiterStats CommandArbiter::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void CommandArbiter::setTargetPeer(const std::string& peer_id) {
+  // Lock order: sendMutex_, then mutex_. Holding sendMutex_ waits for a send
+  // to the previous target in progress.
+  std::lock_guard<std::mutex> send_lock(sendMutex_);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (peer_id == targetPeerId_) return;
+  // A command meant for one vehicle must never reach another.
+  for (SourceSlot& slot : sources_) {
+    slot.has_command = false;
+    slot.unsent = false;
+  }
+  haveSent_ = false;
+  targetPeerId_ = peer_id;
+  controlChannel_ = autodev::remote::webrtc::ChannelHandle();
+  ++targetGeneration_;
+  std::cout << "CommandArbiter: Commands now go to "
+            << (peer_id.empty() ? "no vehicle" : peer_id) << "." << std::endl;
+}
+
+// --- Sender thread ---
+
+void CommandArbiter::senderThreadMain() {
+  const auto period = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(1.0 / config_.send_rate_hz));
+  Clock::time_point next_send = Clock::now();
+  uint64_t failures_in_row = 0;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    next_send += period;
+    cv_.wait_until(lock, next_send, [this] { return !running_; });
+    if (!running_) return;
+    const Clock::time_point now = Clock::now();
+    // After a stall, continue from now instead of sending a burst.
+    if (now - next_send > period) next_send = now;
+    if (!selectCommandLocked(now)) continue;
+    const uint64_t target_generation = targetGeneration_;
+    lock.unlock();
+
+    bool sent = false;
+    bool held = false;
+    bool retargeted = false;
+    {
+      std::lock_guard<std::mutex> send_lock(sendMutex_);
+      {
+        // An emergency may have been submitted since the selection, or the
+        // command was selected for the previous target.
+        std::lock_guard<std::mutex> check_lock(mutex_);
+        held = Clock::now() < emergencyHoldUntil_;
+        retargeted = targetGeneration_ != target_generation;
+      }
+      if (!held && !retargeted) sent = sendLocked(outgoing_);
+    }
+
+    lock.lock();
+    if (retargeted) {
+      // Dropped; setTargetPeer() discarded the commands as well.
+    } else if (held) {
+      ++stats_.suppressed_by_emergency;
+    } else if (sent) {
+      ++stats_.commands_sent;
+      failures_in_row = 0;
+    } else {
+      ++stats_.send_failures;
+      // Expected while the vehicle is not connected; log sparsely.
+      if (++failures_in_row == 1 || failures_in_row % 1000 == 0) {
+        std::cerr << "CommandArbiter: Failed to send control command ("
+                  << failures_in_row << " in a row)." << std::endl;
+      }
+    }
+  }
+}
+
+bool CommandArbiter::selectCommandLocked(Clock::time_point now) {
+  if (now < emergencyHoldUntil_) return false;
+  // Hardware over web.
+  CommandSource chosen;
+  if (isActiveLocked(CommandSource::InputDevice, now)) {
+    chosen = CommandSource::InputDevice;
+  } else if (isActiveLocked(CommandSource::WebUi, now)) {
+    chosen = CommandSource::WebUi;
+  } else {
+    return false;
+  }
+  if (!haveSent_ || chosen != lastSentSource_) {
+    std::cout << "CommandArbiter: Control source is now "
+              << CommandSourceName(chosen) << "." << std::endl;
+  }
+  haveSent_ = true;
+  lastSentSource_ = chosen;
+
+  outgoing_.CopyFrom(sources_[SourceIndex(chosen)].command);
+  for (SourceSlot& slot : sources_) slot.unsent = false;
+  return true;
+}
+
+bool CommandArbiter::isActiveLocked(CommandSource source,
+                                    Clock::time_point now) const {
+  const SourceSlot& slot = sources_[SourceIndex(source)];
+  return slot.has_command && now - slot.received <= sourceTimeout_;
+}
+
+bool CommandArbiter::sendLocked(const google::protobuf::MessageLite& message) {
+  if (targetPeerId_.empty()) return false;
+  sendBuffer_.resize(message.ByteSizeLong());
+  if (!message.SerializeToArray(sendBuffer_.data(),
+                                static_cast<int>(sendBuffer_.size()))) {
+    std::cerr << "CommandArbiter: Failed to serialize command." << std::endl;
+    return false;
+  }
+  // Resolves the peer and the channel once per connection instead of once
+  // per command.
+  if (controlChannel_.expired()) {
+    controlChannel_ =
+        webrtcManager_->acquireChannel(targetPeerId_, controlChannelLabel_);
+  }
+  return controlChannel_.send(sendBuffer_);
+}
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
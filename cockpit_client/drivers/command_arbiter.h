@@ -0,0 +1,150 @@
+#ifndef COMMAND_ARBITER_H
+#define COMMAND_ARBITER_H
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "drivers/command_sink.h"   // Interface
+#include "webrtc/webrtc_manager.h"  // Dependency
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+struct CommandArbiterConfig {
+  // Rate of the merged control command stream sent to the vehicle.
+  double send_rate_hz = 50.0;
+  // A source counts as active while its last command is at most this old.
+  // Sources MUST submit at least this often while in use (the input device
+  // source resubmits at its send rate even without input changes).
+  int source_timeout_ms = 200;
+  // After an emergency command, control commands from every source are
+  // held back for this long.
+  int emergency_hold_ms = 2000;
+};
+
+struct CommandArbiterStats {
+  // Per CommandSource (indexed by its value)
+  std::array<uint64_t, kCommandSourceCount> control_submitted{};
+  std::array<uint64_t, kCommandSourceCount> emergencies_submitted{};
+  // Web UI commands ignored because an input device was active.
+  uint64_t web_overridden = 0;
+  // Control commands ignored during the emergency hold.
+  uint64_t suppressed_by_emergency = 0;
+  // Commands replaced by a newer one of the same source before a send.
+  uint64_t coalesced = 0;
+  uint64_t commands_sent = 0;
+  uint64_t emergencies_sent = 0;
+  uint64_t send_failures = 0;
+};
+
+// The single path from the cockpit's command sources to the vehicle.
+//
+// Sources submit their latest control state at their own pace; a sender
+// thread emits one coalesced ControlCommand stream at send_rate_hz on the
+// control DataChannel, taken from the highest-priority active source:
+//   1. Emergency: sent immediately when submitted, then no control commands
+//      for emergency_hold_ms.
+//   2. Input devices (hardware).
+//   3. Web UI.
+// When no source is active nothing is sent; the vehicle's own command
+// watchdog handles the silence. Everything goes to one vehicle, the target
+// peer, which a multi-vehicle cockpit switches with setTargetPeer().
+class CommandArbiter : public ICommandSink {
+ public:
+  CommandArbiter(
+      std::shared_ptr<autodev::remote::webrtc::WebrtcManager> webrtc_manager,
+      const std::string& control_channel_label,
+      const std::string& target_peer_id,
+      const CommandArbiterConfig& config = CommandArbiterConfig());
+  ~CommandArbiter() override;
+
+  // Starts the sender thread.
+  bool start();
+  // Stops the sender thread; later submissions are rejected.
+  void stop();
+
+  // --- Implementation of ICommandSink Interface ---
+  bool submitControlCommand(
+      CommandSource source,
+      const autodev::remote::control::ControlCommand& command) override;
+  bool submitEmergencyCommand(
+      CommandSource source,
+      const autodev::remote::control::EmergencyCommand& command) override;
+
+  // MUST BE THREAD-SAFE.
+  CommandArbiterStats getStats() const;
+
+  // Switches the vehicle the commands go to (take-over in a multi-vehicle
+  // cockpit); empty: no vehicle, control and emergency commands are not
+  // sent (vehicles drop them from peers not controlling them). Commands
+  // submitted for the previous vehicle are discarded, and none is sent to
+  // it once this returns. MUST BE THREAD-SAFE.
+  void setTargetPeer(const std::string& peer_id);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct SourceSlot {
+    autodev::remote::control::ControlCommand command;  // Reused
+    Clock::time_point received;
+    bool has_command = false;
+    bool unsent = false;  // Submitted since the last send
+  };
+
+  void senderThreadMain();
+  // Copies the command to send into outgoing_; mutex_ MUST be held.
+  // Returns false if no source is active.
+  bool selectCommandLocked(Clock::time_point now);
+  bool isActiveLocked(CommandSource source, Clock::time_point now) const;
+  // Serializes into sendBuffer_ and sends; sendMutex_ MUST be held.
+  bool sendLocked(const google::protobuf::MessageLite& message);
+
+  const std::shared_ptr<autodev::remote::webrtc::WebrtcManager> webrtcManager_;
+  const std::string controlChannelLabel_;
+  const CommandArbiterConfig config_;
+  const Clock::duration sourceTimeout_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  // --- Guarded by mutex_ ---
+  std::array<SourceSlot, kCommandSourceCount> sources_;
+  Clock::time_point emergencyHoldUntil_;
+  CommandSource lastSentSource_ = CommandSource::WebUi;
+  bool haveSent_ = false;
+  bool running_ = false;
+  uint64_t targetGeneration_ = 0;  // Incremented by setTargetPeer()
+  CommandArbiterStats stats_;
+  std::thread senderThread_;
+
+  autodev::remote::control::ControlCommand outgoing_;  // Sender thread only
+
+  // Orders the sender thread's sends against emergency sends: once an
+  // emergency is submitted, no control command selected before it is sent
+  // after it. Lock order: sendMutex_, then mutex_.
+  std::mutex sendMutex_;
+  std::vector<char> sendBuffer_;  // Guarded by sendMutex_
+  // The target's control channel, acquired at the first send and again
+  // after a target switch or a reconnection. Guarded by sendMutex_.
+  autodev::remote::webrtc::ChannelHandle controlChannel_;
+  // Written with sendMutex_ and mutex_ held; read with either.
+  std::string targetPeerId_;
+
+  // Prevent copying
+  CommandArbiter(const CommandArbiter&) = delete;
+  CommandArbiter& operator=(const CommandArbiter&) = delete;
+};
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // COMMAND_ARBITER_H
@@ -0,0 +1,53 @@
+#ifndef COMMAND_SINK_H
+#define COMMAND_SINK_H
+
+#include <cstddef>
+
+// Include generated protobuf headers for the commands
+#include "control/proto/control_command.pb.h"
+#include "control/proto/emergency_command.pb.h"
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+// Producers of vehicle commands in the cockpit.
+enum class CommandSource {
+  WebUi,        // IWebCommandHandler (browser controls)
+  InputDevice,  // IInputDeviceSource (wheel, pedals, ...)
+};
+
+constexpr size_t kCommandSourceCount = 2;
+
+inline const char* CommandSourceName(CommandSource source) {
+  return source == CommandSource::WebUi ? "web_ui" : "input_device";
+}
+
+// Destination of the commands produced by the cockpit's command sources.
+// Sources hand their commands here instead of sending them to the vehicle
+// themselves, so one component decides what is actually sent.
+class ICommandSink {
+ public:
+  virtual ~ICommandSink() = default;
+
+  // Submits the latest control state of a source. The sink copies the
+  // command; the caller may reuse it immediately.
+  // Returns false if the sink does not accept commands (e.g., stopped).
+  // MUST BE THREAD-SAFE and must not block on the network.
+  virtual bool submitControlCommand(
+      CommandSource source,
+      const autodev::remote::control::ControlCommand& command) = 0;
+
+  // Submits an emergency command; it is forwarded without delay.
+  // Returns false if it could not be sent. MUST BE THREAD-SAFE.
+  virtual bool submitEmergencyCommand(
+      CommandSource source,
+      const autodev::remote::control::EmergencyCommand& command) = 0;
+};
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // COMMAND_SINK_H
@@ -0,0 +1,198 @@
+#include "drivers/encoded_video_forwarder.h"
+
+#include <chrono>
+#include <iostream>  // Logging
+#include <utility>
+
+#include "webrtc/api/video/video_codec_type.h"      // For webrtc::VideoCodecType
+#include "webrtc/api/video/video_frame_metadata.h"  // For webrtc::VideoFrameMetadata
+
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+namespace {
+
+// RTP video clock rate (RFC 6184 / RFC 7741).
+constexpr int64_t kRtpVideoClockHz = 90000;
+
+VideoPayloadType ToPayloadType(::webrtc::VideoCodecType codec) {
+  switch (codec) {
+    case ::webrtc::kVideoCodecH264:
+      return VideoPayloadType::H264;
+    case ::webrtc::kVideoCodecVP8:
+      return VideoPayloadType::Vp8;
+    default:
+      return VideoPayloadType::Unknown;
+  }
+}
+
+int64_t NowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+EncodedVideoForwarder::EncodedVideoForwarder(
+    std::shared_ptr<autodev::remote::transport::ITransportServer>
+        transport_server,
+    const std::string& stream_name, uint32_t stream_id)
+    : transport_server_(transport_server),
+      stream_name_(stream_name),
+      stream_id_(stream_id),
+      buffer_pool_(8) {
+  std::cout << "EncodedVideoForwarder created for stream: " << stream_name_
+            << " (id " << stream_id_ << ")" << std::endl;
+}
+
+EncodedVideoForwarder::~EncodedVideoForwarder() {
+  std::cout << "EncodedVideoForwarder destroyed for stream: " << stream_name_
+            << std::endl;
+}
+
+// --- Implementation of webrtc::FrameTransformerInterface ---
+
+void EncodedVideoForwarder::Transform(
+    std::unique_ptr<::webrtc::TransformableFrameInterface>
+        transformable_frame) {
+  // Called on a libwebrtc worker thread, one frame at a time.
+  if (!transformable_frame) return;
+  const int64_t now_us = NowUs();
+  maybeRequestKeyFrame(now_us);
+
+  auto* frame = static_cast<::webrtc::TransformableVideoFrameInterface*>(
+      transformable_frame.get());
+  const ::webrtc::VideoFrameMetadata metadata = frame->Metadata();
+  const VideoPayloadType payload_type = ToPayloadType(metadata.GetCodec());
+  if (payload_type == VideoPayloadType::Unknown) {
+    // e.g. VP9/AV1: the browser path only handles H.264 and VP8. Negotiate
+    // those codecs (or use the JPEG display mode) for this stream.
+    if (frames_unsupported_.fetch_add(1, std::memory_order_relaxed) == 0) {
+      std::cerr << "EncodedVideoForwarder (" << stream_name_
+                << "): Unsupported codec, frames are not forwarded."
+                << std::endl;
+    }
+    return;
+  }
+
+  const rtc::ArrayView<const uint8_t> data = frame->GetData();
+  const bool is_key_frame = frame->IsKeyFrame();
+
+  VideoFrameHeader header;
+  header.payload_type = payload_type;
+  header.stream_id = stream_id_;
+  header.sequence = sequence_++;
+  header.capture_timestamp_us = unwrapTimestampUs(frame->GetTimestamp());
+  header.width = metadata.GetWidth();
+  header.height = metadata.GetHeight();
+  header.payload_size = static_cast<uint32_t>(data.size());
+  header.flags = is_key_frame ? kVideoFrameFlagKeyFrame : kVideoFrameFlagNone;
+
+  auto message = buffer_pool_.acquire(kVideoFrameHeaderSize + data.size());
+  message->resize(kVideoFrameHeaderSize);
+  WriteVideoFrameHeader(header, message->data());
+  message->insert(message->end(), reinterpret_cast<const char*>(data.data()),
+                  reinterpret_cast<const char*>(data.data()) + data.size());
+
+  // The frame itself is dropped here: nothing is passed on to the decoder.
+  if (!transport_server_->broadcastVideoFrame(
+          message,
+          is_key_frame
+              ? autodev::remote::transport::VideoFrameType::KeyFrame
+              : autodev::remote::transport::VideoFrameType::DeltaFrame)) {
+    send_failures_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  frames_forwarded_.fetch_add(1, std::memory_order_relaxed);
+  if (is_key_frame) {
+    key_frames_forwarded_.fetch_add(1, std::memory_order_relaxed);
+  }
+  bytes_sent_.fetch_add(message->size(), std::memory_order_relaxed);
+}
+
+void EncodedVideoForwarder::RegisterTransformedFrameCallback(
+    rtc::scoped_refptr<::webrtc::TransformedFrameCallback> callback) {
+  std::lock_guard<std::mutex> lock(callbacks_mutex_);
+  callback_ = std::move(callback);
+}
+
+void EncodedVideoForwarder::RegisterTransformedFrameSinkCallback(
+    rtc::scoped_refptr<::webrtc::TransformedFrameCallback> callback,
+    uint32_t ssrc) {
+  std::lock_guard<std::mutex> lock(callbacks_mutex_);
+  sink_callbacks_[ssrc] = std::move(callback);
+}
+
+void EncodedVideoForwarder::UnregisterTransformedFrameCallback() {
+  std::lock_guard<std::mutex> lock(callbacks_mutex_);
+  callback_ = nullptr;
+}
+
+void EncodedVideoForwarder::UnregisterTransformedFrameSinkCallback(
+    uint32_t ssrc) {
+  std::lock_guard<std::mutex> lock(callbacks_mutex_);
+  sink_callbacks_.erase(ssrc);
+}
+
+// --- Key frame requests ---
+
+void EncodedVideoForwarder::setKeyFrameRequester(KeyFrameRequester requester) {
+  std::lock_guard<std::mutex> lock(requester_mutex_);
+  key_frame_requester_ = std::move(requester);
+}
+
+void EncodedVideoForwarder::requestKeyFrame() {
+  key_frame_requested_.store(true, std::memory_order_relaxed);
+}
+
+void EncodedVideoForwarder::maybeRequestKeyFrame(int64_t now_us) {
+  if (!key_frame_requested_.load(std::memory_order_relaxed)) return;
+  if (has_requested_key_frame_ &&
+      now_us - last_key_frame_request_us_ < kMinKeyFrameRequestIntervalUs) {
+    return;  // Keep the flag; retried on a later frame.
+  }
+  KeyFrameRequester requester;
+  {
+    std::lock_guard<std::mutex> lock(requester_mutex_);
+    requester = key_frame_requester_;
+  }
+  if (!requester) return;
+  key_frame_requested_.store(false, std::memory_order_relaxed);
+  has_requested_key_frame_ = true;
+  last_key_frame_request_us_ = now_us;
+  key_frames_requested_.fetch_add(1, std::memory_order_relaxed);
+  requester();
+}
+
+int64_t EncodedVideoForwarder::unwrapTimestampUs(uint32_t rtp_timestamp) {
+  if (!has_rtp_timestamp_) {
+    has_rtp_timestamp_ = true;
+    unwrapped_rtp_timestamp_ = rtp_timestamp;
+  } else {
+    // Signed difference handles both wrap-around and reordered frames.
+    unwrapped_rtp_timestamp_ +=
+        static_cast<int32_t>(rtp_timestamp - last_rtp_timestamp_);
+  }
+  last_rtp_timestamp_ = rtp_timestamp;
+  return unwrapped_rtp_timestamp_ * 1000000 / kRtpVideoClockHz;
+}
+
+EncodedVideoStats EncodedVideoForwarder::getStats() const {
+  EncodedVideoStats stats;
+  stats.frames_forwarded = frames_forwarded_.load(std::memory_order_relaxed);
+  stats.key_frames_forwarded =
+      key_frames_forwarded_.load(std::memory_order_relaxed);
+  stats.frames_unsupported =
+      frames_unsupported_.load(std::memory_order_relaxed);
+  stats.send_failures = send_failures_.load(std::memory_order_relaxed);
+  stats.bytes_sent = bytes_sent_.load(std::memory_order_relaxed);
+  stats.key_frames_requested =
+      key_frames_requested_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
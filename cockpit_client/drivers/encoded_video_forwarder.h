@@ -0,0 +1,143 @@
+#ifndef ENCODED_VIDEO_FORWARDER_H
+#define ENCODED_VIDEO_FORWARDER_H
+
+#include <atomic>  // For std::atomic
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>  // For shared_ptr
+#include <mutex>
+#include <string>
+
+#include "drivers/frame_buffer_pool.h"   // Pooled output buffers
+#include "drivers/video_frame_header.h"  // Binary frame header layout
+#include "transport/transport_server.h"  // Dependency
+#include "webrtc/api/frame_transformer_interface.h"  // For webrtc::FrameTransformerInterface
+#include "webrtc/api/scoped_refptr.h"  // For rtc::scoped_refptr
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+// Snapshot of the forwarder's counters.
+struct EncodedVideoStats {
+  uint64_t frames_forwarded = 0;  // Frames handed to the transport
+  uint64_t key_frames_forwarded = 0;
+  uint64_t frames_unsupported = 0;  // Codec the browser path cannot decode
+  uint64_t send_failures = 0;
+  uint64_t bytes_sent = 0;  // Total bytes handed to the transport (with header)
+  uint64_t key_frames_requested = 0;  // Requests passed on to the sender
+};
+
+// Forwards the encoded H.264/VP8 frames of a received video track to the
+// browser without decoding them ("passthrough" display mode). The browser
+// decodes them with WebCodecs (see display/src/video_player.js), so the
+// cockpit process never touches pixels.
+//
+// Installed on the RtpReceiver with SetDepacketizerToDecoderFrameTransformer:
+// libwebrtc hands every assembled frame to Transform() right after
+// depacketization. Each frame is sent as one binary WebSocket message, a
+// VideoFrameHeader followed by the raw access unit (Annex B for H.264), as a
+// KeyFrame/DeltaFrame so the transport can skip slow clients to the next key
+// frame. Frames are NOT passed on to the native decoder.
+//
+// Create with rtc::make_ref_counted<EncodedVideoForwarder>(...).
+class EncodedVideoForwarder : public ::webrtc::FrameTransformerInterface {
+ public:
+  // Asks the remote sender for a new key frame. Called on the thread that
+  // runs Transform(). Typically wraps VideoTrackSourceInterface::
+  // GenerateKeyFrame() of the received track.
+  using KeyFrameRequester = std::function<void()>;
+
+  // stream_name: Human-readable identifier used for logging.
+  // stream_id: Numeric identifier written into every frame header.
+  EncodedVideoForwarder(
+      std::shared_ptr<autodev::remote::transport::ITransportServer>
+          transport_server,
+      const std::string& stream_name, uint32_t stream_id);
+
+  ~EncodedVideoForwarder() override;
+
+  // --- Implementation of webrtc::FrameTransformerInterface ---
+  // Called by libwebrtc for every received frame on its worker thread.
+  void Transform(std::unique_ptr<::webrtc::TransformableFrameInterface>
+                     transformable_frame) override;
+  void RegisterTransformedFrameCallback(
+      rtc::scoped_refptr<::webrtc::TransformedFrameCallback> callback)
+      override;
+  void RegisterTransformedFrameSinkCallback(
+      rtc::scoped_refptr<::webrtc::TransformedFrameCallback> callback,
+      uint32_t ssrc) override;
+  void UnregisterTransformedFrameCallback() override;
+  void UnregisterTransformedFrameSinkCallback(uint32_t ssrc) override;
+
+  // Sets the function used to ask the sender for a key frame. Thread-safe.
+  void setKeyFrameRequester(KeyFrameRequester requester);
+
+  // Requests a key frame from the sender, e.g. because a browser connected or
+  // skipped a frame. Thread-safe and cheap: it only sets a flag; the request
+  // is issued from the next Transform() call, at most once per
+  // kMinKeyFrameRequestIntervalUs.
+  void requestKeyFrame();
+
+  // Returns a snapshot of the counters. Thread-safe.
+  EncodedVideoStats getStats() const;
+
+ private:
+  // Several viewers connecting at once must not turn into a burst of key
+  // frames, which are many times larger than delta frames.
+  static constexpr int64_t kMinKeyFrameRequestIntervalUs = 500 * 1000;
+
+  // Issues a pending key frame request if allowed (Transform() thread).
+  void maybeRequestKeyFrame(int64_t now_us);
+  // Extends the 32-bit 90 kHz RTP timestamp to a monotonic microsecond
+  // timestamp (Transform() thread).
+  int64_t unwrapTimestampUs(uint32_t rtp_timestamp);
+
+  std::shared_ptr<autodev::remote::transport::ITransportServer>
+      transport_server_;
+  const std::string stream_name_;
+  const uint32_t stream_id_;
+
+  FrameBufferPool buffer_pool_;
+
+  // Callbacks registered by libwebrtc. Kept so unregistering is symmetric;
+  // frames are never returned to them (no native decode).
+  std::mutex callbacks_mutex_;
+  rtc::scoped_refptr<::webrtc::TransformedFrameCallback>
+      callback_;  // Guarded by callbacks_mutex_
+  std::map<uint32_t, rtc::scoped_refptr<::webrtc::TransformedFrameCallback>>
+      sink_callbacks_;  // Guarded by callbacks_mutex_
+
+  std::mutex requester_mutex_;
+  KeyFrameRequester key_frame_requester_;  // Guarded by requester_mutex_
+  // Start with a request so the first browser does not wait a full GOP.
+  std::atomic<bool> key_frame_requested_{true};
+
+  // --- State only touched on the Transform() thread ---
+  uint32_t sequence_ = 0;
+  bool has_rtp_timestamp_ = false;
+  uint32_t last_rtp_timestamp_ = 0;
+  int64_t unwrapped_rtp_timestamp_ = 0;
+  int64_t last_key_frame_request_us_ = 0;
+  bool has_requested_key_frame_ = false;
+
+  // --- Stats ---
+  std::atomic<uint64_t> frames_forwarded_{0};
+  std::atomic<uint64_t> key_frames_forwarded_{0};
+  std::atomic<uint64_t> frames_unsupported_{0};
+  std::atomic<uint64_t> send_failures_{0};
+  std::atomic<uint64_t> bytes_sent_{0};
+  std::atomic<uint64_t> key_frames_requested_{0};
+
+  // Prevent copying
+  EncodedVideoForwarder(const EncodedVideoForwarder&) = delete;
+  EncodedVideoForwarder& operator=(const EncodedVideoForwarder&) = delete;
+};
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // ENCODED_VIDEO_FORWARDER_H
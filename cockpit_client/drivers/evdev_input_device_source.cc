@@ -0,0 +1,682 @@
+#include "drivers/evdev_input_device_source.h"
+
+#include <fcntl.h>
+#include <linux/input.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+namespace {
+
+// epoll_event.data.u64 tags; devices use kDeviceTagBase + index.
+constexpr uint64_t kStopTag = 0;
+constexpr uint64_t kTimerTag = 1;
+constexpr uint64_t kDeviceTagBase = 2;
+
+// Events per read(); the loop repeats until the device is drained.
+constexpr size_t kEventBatchSize = 64;
+
+constexpr double kMaxSendRateHz = 1000.0;
+
+int64_t MonotonicNowUs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+int64_t EventTimeUs(const input_event& event) {
+  return static_cast<int64_t>(event.input_event_sec) * 1000000 +
+         event.input_event_usec;
+}
+
+bool IsBipolar(InputAxisTarget target) {
+  return target == InputAxisTarget::Steering;
+}
+
+bool ValidateAxis(const InputAxisConfig& axis, std::string* error) {
+  if (axis.device_path.empty()) {
+    *error = "axis without device_path";
+  } else if (axis.code >= ABS_CNT) {
+    *error = "axis code out of range";
+  } else if (!(axis.deadzone >= 0.0 && axis.deadzone < 1.0)) {
+    *error = "deadzone must be in [0, 1)";
+  } else if (!(axis.curve_exponent > 0.0)) {
+    *error = "curve_exponent must be > 0";
+  } else {
+    for (size_t i = 0; i < axis.curve_points.size(); ++i) {
+      if (i > 0 && !(axis.curve_points[i].first >
+                     axis.curve_points[i - 1].first)) {
+        *error = "curve_points inputs must be strictly increasing";
+        return false;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+EvdevInputDeviceSource::EvdevInputDeviceSource() {
+  std::cout << "EvdevInputDeviceSource created." << std::endl;
+}
+
+EvdevInputDeviceSource::~EvdevInputDeviceSource() { stopPolling(); }
+
+// --- Implementation of IInputDeviceSource Interface ---
+
+bool EvdevInputDeviceSource::init(std::shared_ptr<ICommandSink> command_sink,
+                                  const InputDeviceConfig& config) {
+  if (polling_) {
+    std::cerr << "EvdevInputDeviceSource: Cannot init while polling."
+              << std::endl;
+    return false;
+  }
+  if (!command_sink) {
+    std::cerr << "EvdevInputDeviceSource: Command sink is null." << std::endl;
+    return false;
+  }
+  if (!(config.send_rate_hz > 0.0 && config.send_rate_hz <= kMaxSendRateHz)) {
+    std::cerr << "EvdevInputDeviceSource: send_rate_hz must be in (0, "
+              << kMaxSendRateHz << "]." << std::endl;
+    return false;
+  }
+
+  devices_.clear();
+  axes_.clear();
+  buttons_.clear();
+  auto device_index = [this](const std::string& path) {
+    for (size_t i = 0; i < devices_.size(); ++i) {
+      if (devices_[i].path == path) return i;
+    }
+    Device device;
+    device.path = path;
+    device.axis_by_code.assign(ABS_CNT, -1);
+    device.button_by_code.assign(KEY_CNT, -1);
+    devices_.push_back(std::move(device));
+    return devices_.size() - 1;
+  };
+
+  for (const InputAxisConfig& axis_config : config.axes) {
+    std::string error;
+    if (!ValidateAxis(axis_config, &error)) {
+      std::cerr << "EvdevInputDeviceSource: Invalid axis " << axis_config.code
+                << " on '" << axis_config.device_path << "': " << error
+                << std::endl;
+      return false;
+    }
+    Axis axis;
+    axis.config = axis_config;
+    axis.device = device_index(axis_config.device_path);
+    int& slot = devices_[axis.device].axis_by_code[axis_config.code];
+    if (slot >= 0) {
+      std::cerr << "EvdevInputDeviceSource: Axis " << axis_config.code
+                << " on '" << axis_config.device_path
+                << "' is configured twice." << std::endl;
+      return false;
+    }
+    slot = static_cast<int>(axes_.size());
+    axes_.push_back(std::move(axis));
+  }
+  for (const InputButtonConfig& button_config : config.buttons) {
+    if (button_config.device_path.empty() || button_config.code >= KEY_CNT) {
+      std::cerr << "EvdevInputDeviceSource: Invalid button "
+                << button_config.code << " on '" << button_config.device_path
+                << "'." << std::endl;
+      return false;
+    }
+    Button button;
+    button.config = button_config;
+    button.device = device_index(button_config.device_path);
+    int& slot = devices_[button.device].button_by_code[button_config.code];
+    if (slot >= 0) {
+      std::cerr << "EvdevInputDeviceSource: Button " << button_config.code
+                << " on '" << button_config.device_path
+                << "' is configured twice." << std::endl;
+      return false;
+    }
+    slot = static_cast<int>(buttons_.size());
+    buttons_.push_back(button);
+  }
+
+  stopForceFeedback();
+  forceFeedback_.reset();
+  forceFeedbackDevicePath_.clear();
+  if (config.force_feedback.enabled) {
+    forceFeedbackDevicePath_ = config.force_feedback.device_path;
+    for (const Axis& axis : axes_) {
+      if (!forceFeedbackDevicePath_.empty()) break;
+      if (axis.config.target == InputAxisTarget::Steering) {
+        forceFeedbackDevicePath_ = axis.config.device_path;
+      }
+    }
+    if (forceFeedbackDevicePath_.empty()) {
+      std::cerr << "EvdevInputDeviceSource: Force feedback enabled without "
+                   "device_path or steering axis."
+                << std::endl;
+      return false;
+    }
+    forceFeedback_ =
+        std::make_unique<ForceFeedbackController>(config.force_feedback);
+  }
+
+  commandSink_ = command_sink;
+  config_ = config;
+  gear_ = config.initial_gear;
+  std::cout << "EvdevInputDeviceSource: Initialized with " << axes_.size()
+            << " axes and " << buttons_.size() << " buttons on "
+            << devices_.size() << " devices, submitting at "
+            << config_.send_rate_hz << " Hz." << std::endl;
+  return true;
+}
+
+bool EvdevInputDeviceSource::startPolling() {
+  if (polling_) {
+    std::cerr << "EvdevInputDeviceSource: Already polling." << std::endl;
+    return false;
+  }
+  if (!commandSink_) {
+    std::cerr << "EvdevInputDeviceSource: Not initialized." << std::endl;
+    return false;
+  }
+  if (devices_.empty()) {
+    std::cout << "EvdevInputDeviceSource: No input devices configured."
+              << std::endl;
+    startForceFeedback();
+    return true;
+  }
+
+  epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+  timerFd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  stopFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (epollFd_ < 0 || timerFd_ < 0 || stopFd_ < 0) {
+    std::cerr << "EvdevInputDeviceSource: Failed to create polling fds: "
+              << std::strerror(errno) << std::endl;
+    closePollingFds();
+    return false;
+  }
+  // Without either the thread could not be stopped, or would never tick.
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.u64 = kStopTag;
+  if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, stopFd_, &event) != 0) {
+    std::cerr << "EvdevInputDeviceSource: Failed to watch stop event: "
+              << std::strerror(errno) << std::endl;
+    closePollingFds();
+    return false;
+  }
+  event.data.u64 = kTimerTag;
+  if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, timerFd_, &event) != 0) {
+    std::cerr << "EvdevInputDeviceSource: Failed to watch send timer: "
+              << std::strerror(errno) << std::endl;
+    closePollingFds();
+    return false;
+  }
+
+  // A device missing at start (e.g. pedals not plugged in yet) is handled
+  // like one lost later: reopened once per second, no commands until then.
+  // The web UI keeps working meanwhile.
+  lostDevices_ = 0;
+  for (size_t i = 0; i < devices_.size(); ++i) {
+    if (!openDevice(i)) ++lostDevices_;
+  }
+  if (lostDevices_ > 0) {
+    std::cerr << "EvdevInputDeviceSource: " << lostDevices_ << " of "
+              << devices_.size()
+              << " devices unavailable; not submitting commands until they "
+                 "are opened."
+              << std::endl;
+  }
+  oldestUnsentEventUs_ = 0;
+
+  const int64_t period_ns =
+      static_cast<int64_t>(std::llround(1e9 / config_.send_rate_hz));
+  itimerspec period{};
+  period.it_interval.tv_sec = period_ns / 1000000000;
+  period.it_interval.tv_nsec = period_ns % 1000000000;
+  period.it_value = period.it_interval;
+  if (timerfd_settime(timerFd_, 0, &period, nullptr) != 0) {
+    std::cerr << "EvdevInputDeviceSource: Failed to arm send timer: "
+              << std::strerror(errno) << std::endl;
+    closePollingFds();
+    return false;
+  }
+
+  polling_ = true;
+  pollingThread_ = std::thread(&EvdevInputDeviceSource::pollingThreadMain, this);
+  std::cout << "EvdevInputDeviceSource: Polling started." << std::endl;
+  startForceFeedback();
+  return true;
+}
+
+void EvdevInputDeviceSource::stopPolling() {
+  stopForceFeedback();
+  if (!polling_) return;
+  const uint64_t one = 1;
+  if (write(stopFd_, &one, sizeof(one)) != sizeof(one)) {
+    std::cerr << "EvdevInputDeviceSource: Failed to signal stop: "
+              << std::strerror(errno) << std::endl;
+  }
+  if (pollingThread_.joinable()) pollingThread_.join();
+  closePollingFds();
+  polling_ = false;
+
+  const InputLatencyStats stats = getLatencyStats();
+  std::cout << "EvdevInputDeviceSource: Polling stopped. " << stats.events_read
+            << " events, " << stats.commands_submitted
+            << " commands submitted (" << stats.submit_failures
+            << " failed), event-to-send latency mean "
+            << stats.mean_us << " us, max " << stats.max_us << " us."
+            << std::endl;
+}
+
+void EvdevInputDeviceSource::processVehicleTelemetry(
+    const autodev::remote::chassis::Chassis& telemetry_data) {
+  // Called from a WebRTC thread. MUST BE THREAD-SAFE.
+  ForceFeedbackController* force_feedback =
+      activeForceFeedback_.load(std::memory_order_acquire);
+  if (!force_feedback) return;
+  // steering_percentage: -100 (full left) .. 100 (full right)
+  force_feedback->updateVehicleState(
+      telemetry_data.speed_mps(), telemetry_data.steering_percentage() / 100.0);
+}
+
+InputLatencyStats EvdevInputDeviceSource::getLatencyStats() const {
+  InputLatencyStats stats;
+  stats.events_read = eventsRead_.load(std::memory_order_relaxed);
+  stats.commands_submitted =
+      commandsSubmitted_.load(std::memory_order_relaxed);
+  stats.submit_failures = submitFailures_.load(std::memory_order_relaxed);
+  stats.samples = latencySamples_.load(std::memory_order_relaxed);
+  if (stats.samples > 0) {
+    stats.mean_us =
+        static_cast<double>(latencySumUs_.load(std::memory_order_relaxed)) /
+        static_cast<double>(stats.samples);
+  }
+  stats.max_us = latencyMaxUs_.load(std::memory_order_relaxed);
+  stats.last_us = latencyLastUs_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void EvdevInputDeviceSource::startForceFeedback() {
+  if (!forceFeedback_) return;
+  if (!forceFeedback_->start(forceFeedbackDevicePath_)) {
+    std::cerr << "EvdevInputDeviceSource: Force feedback unavailable; "
+                 "continuing without it."
+              << std::endl;
+    return;
+  }
+  activeForceFeedback_.store(forceFeedback_.get(), std::memory_order_release);
+}
+
+void EvdevInputDeviceSource::stopForceFeedback() {
+  if (!activeForceFeedback_.exchange(nullptr)) return;
+  // A telemetry call that loaded the pointer just before may still be in
+  // updateVehicleState(); that is safe, the controller outlives stop().
+  forceFeedback_->stop();
+}
+
+// --- Polling thread ---
+
+void EvdevInputDeviceSource::pollingThreadMain() {
+  epoll_event events[16];
+  const uint64_t reopen_interval_ticks =
+      std::max<uint64_t>(1, static_cast<uint64_t>(config_.send_rate_hz));
+  uint64_t ticks_since_reopen = 0;
+  while (true) {
+    const int count = epoll_wait(epollFd_, events, 16, -1);
+    if (count < 0) {
+      if (errno == EINTR) continue;
+      std::cerr << "EvdevInputDeviceSource: epoll_wait failed: "
+                << std::strerror(errno) << std::endl;
+      return;
+    }
+    // Drain the devices first so a tick in the same wakeup submits the
+    // freshest values.
+    bool tick = false;
+    for (int i = 0; i < count; ++i) {
+      const uint64_t tag = events[i].data.u64;
+      if (tag == kStopTag) return;
+      if (tag == kTimerTag) {
+        tick = true;
+        continue;
+      }
+      const size_t index = static_cast<size_t>(tag - kDeviceTagBase);
+      if (devices_[index].fd < 0) continue;  // Lost earlier in this batch
+      if (!readDevice(index)) {
+        std::cerr << "EvdevInputDeviceSource: Lost device '"
+                  << devices_[index].path
+                  << "'; not submitting commands until it is back."
+                  << std::endl;
+        closeDevice(devices_[index]);
+        ++lostDevices_;
+      }
+    }
+    if (!tick) continue;
+
+    uint64_t expirations;
+    if (read(timerFd_, &expirations, sizeof(expirations)) < 0) continue;
+    if (lostDevices_ > 0) {
+      if (++ticks_since_reopen >= reopen_interval_ticks) {
+        ticks_since_reopen = 0;
+        reopenLostDevices();
+      }
+      continue;
+    }
+    submitCommand();
+  }
+}
+
+bool EvdevInputDeviceSource::openDevice(size_t index) {
+  Device& device = devices_[index];
+  device.fd = open(device.path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+  if (device.fd < 0) {
+    std::cerr << "EvdevInputDeviceSource: Failed to open '" << device.path
+              << "': " << std::strerror(errno) << std::endl;
+    return false;
+  }
+  // Event timestamps on the same clock as MonotonicNowUs() for the latency.
+  int clock_id = CLOCK_MONOTONIC;
+  device.monotonic_timestamps = ioctl(device.fd, EVIOCSCLOCKID, &clock_id) == 0;
+  if (config_.grab_devices && ioctl(device.fd, EVIOCGRAB, 1) != 0) {
+    std::cerr << "EvdevInputDeviceSource: Failed to grab '" << device.path
+              << "': " << std::strerror(errno) << std::endl;
+  }
+
+  for (Axis& axis : axes_) {
+    if (axis.device != index) continue;
+    if (axis.config.raw_min != axis.config.raw_max) {
+      axis.raw_min = axis.config.raw_min;
+      axis.raw_max = axis.config.raw_max;
+      continue;
+    }
+    input_absinfo info{};
+    if (ioctl(device.fd, EVIOCGABS(axis.config.code), &info) != 0 ||
+        info.minimum == info.maximum) {
+      std::cerr << "EvdevInputDeviceSource: '" << device.path
+                << "' has no usable range for axis " << axis.config.code
+                << "; set raw_min/raw_max." << std::endl;
+      closeDevice(device);
+      return false;
+    }
+    axis.raw_min = info.minimum;
+    axis.raw_max = info.maximum;
+  }
+
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.u64 = kDeviceTagBase + index;
+  if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, device.fd, &event) != 0) {
+    std::cerr << "EvdevInputDeviceSource: Failed to watch '" << device.path
+              << "': " << std::strerror(errno) << std::endl;
+    closeDevice(device);
+    return false;
+  }
+  device.dropping = false;
+  resyncDevice(index);
+  std::cout << "EvdevInputDeviceSource: Opened '" << device.path << "'."
+            << std::endl;
+  return true;
+}
+
+void EvdevInputDeviceSource::closeDevice(Device& device) {
+  if (device.fd < 0) return;
+  // Closing also releases a grab and removes the fd from epoll.
+  close(device.fd);
+  device.fd = -1;
+}
+
+bool EvdevInputDeviceSource::readDevice(size_t index) {
+  Device& device = devices_[index];
+  input_event events[kEventBatchSize];
+  while (true) {
+    const ssize_t bytes = read(device.fd, events, sizeof(events));
+    if (bytes < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return true;  // Drained
+      if (errno == EINTR) continue;
+      return false;  // ENODEV: unplugged
+    }
+    if (bytes == 0) return false;
+    const size_t count = static_cast<size_t>(bytes) / sizeof(input_event);
+    eventsRead_.fetch_add(count, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < count; ++i) {
+      const input_event& event = events[i];
+      if (event.type == EV_SYN) {
+        if (event.code == SYN_DROPPED) {
+          // The kernel buffer overflowed; events up to the next SYN_REPORT
+          // are incomplete. Discard them and read the state instead.
+          device.dropping = true;
+        } else if (event.code == SYN_REPORT) {
+          if (device.dropping) {
+            device.dropping = false;
+            resyncDevice(index);
+          } else {
+            commitDevice(index, device.monotonic_timestamps
+                                    ? EventTimeUs(event)
+                                    : MonotonicNowUs());
+          }
+        }
+        continue;
+      }
+      if (device.dropping) continue;
+      if (event.type == EV_ABS && event.code < ABS_CNT) {
+        const int axis = device.axis_by_code[event.code];
+        if (axis >= 0) {
+          axes_[axis].staged_raw = event.value;
+          axes_[axis].staged = true;
+        }
+      } else if (event.type == EV_KEY && event.code < KEY_CNT) {
+        const int button = device.button_by_code[event.code];
+        if (button >= 0) {
+          // value 2 is autorepeat: still pressed.
+          buttons_[button].staged_pressed = event.value != 0;
+          buttons_[button].staged = true;
+        }
+      }
+    }
+    if (static_cast<size_t>(bytes) < sizeof(events)) return true;
+  }
+}
+
+void EvdevInputDeviceSource::commitDevice(size_t index,
+                                          int64_t event_time_us) {
+  bool changed = false;
+  for (Axis& axis : axes_) {
+    if (axis.device != index || !axis.staged) continue;
+    axis.staged = false;
+    axis.raw = axis.staged_raw;
+    axis.value = applyCalibration(axis);
+    changed = true;
+  }
+  for (Button& button : buttons_) {
+    if (button.device != index || !button.staged) continue;
+    button.staged = false;
+    if (button.staged_pressed && !button.pressed &&
+        button.config.action == InputButtonAction::SetGear) {
+      gear_ = button.config.gear;
+    }
+    button.pressed = button.staged_pressed;
+    changed = true;
+  }
+  if (changed && oldestUnsentEventUs_ == 0) {
+    oldestUnsentEventUs_ = event_time_us;
+  }
+}
+
+void EvdevInputDeviceSource::resyncDevice(size_t index) {
+  Device& device = devices_[index];
+  for (Axis& axis : axes_) {
+    if (axis.device != index) continue;
+    axis.staged = false;
+    input_absinfo info{};
+    if (ioctl(device.fd, EVIOCGABS(axis.config.code), &info) == 0) {
+      axis.raw = info.value;
+      axis.value = applyCalibration(axis);
+    }
+  }
+  uint8_t key_bits[KEY_CNT / 8 + 1] = {};
+  const bool have_keys =
+      ioctl(device.fd, EVIOCGKEY(sizeof(key_bits)), key_bits) >= 0;
+  for (Button& button : buttons_) {
+    if (button.device != index) continue;
+    button.staged = false;
+    if (have_keys) {
+      const uint16_t code = button.config.code;
+      // Only tracks the held state; a gear is selected on a press edge.
+      button.pressed = (key_bits[code / 8] >> (code % 8)) & 1;
+    }
+  }
+  if (oldestUnsentEventUs_ == 0) oldestUnsentEventUs_ = MonotonicNowUs();
+}
+
+void EvdevInputDeviceSource::reopenLostDevices() {
+  for (size_t i = 0; i < devices_.size(); ++i) {
+    if (devices_[i].fd >= 0) continue;
+    if (openDevice(i)) --lostDevices_;
+  }
+  if (lostDevices_ == 0) {
+    std::cout << "EvdevInputDeviceSource: All devices back; resuming commands."
+              << std::endl;
+  }
+}
+
+void EvdevInputDeviceSource::submitCommand() {
+  // Several axes may drive one target (e.g. two brake pedals); the largest
+  // magnitude wins.
+  bool has_steering = false, has_acceleration = false, has_braking = false;
+  double steering = 0.0, acceleration = 0.0, braking = 0.0;
+  for (const Axis& axis : axes_) {
+    switch (axis.config.target) {
+      case InputAxisTarget::Steering:
+        if (!has_steering || std::fabs(axis.value) > std::fabs(steering)) {
+          steering = axis.value;
+        }
+        has_steering = true;
+        break;
+      case InputAxisTarget::Acceleration:
+        acceleration = std::max(acceleration, axis.value);
+        has_acceleration = true;
+        break;
+      case InputAxisTarget::Braking:
+        braking = std::max(braking, axis.value);
+        has_braking = true;
+        break;
+    }
+  }
+  bool hand_brake = false;
+  for (const Button& button : buttons_) {
+    if (button.config.action == InputButtonAction::HandBrake &&
+        button.pressed) {
+      hand_brake = true;
+    }
+  }
+
+  // Clear() keeps the message's storage.
+  controlCommand_.Clear();
+  if (has_steering) {
+    controlCommand_.set_steering_angle(steering * config_.max_steering_angle);
+  }
+  if (has_acceleration) controlCommand_.set_acceleration(acceleration);
+  if (has_braking) controlCommand_.set_braking(braking);
+  controlCommand_.set_gear(gear_);
+  controlCommand_.set_hand_brake(hand_brake);
+
+  // Submitted every tick, changed or not: the sink treats a silent source
+  // as inactive.
+  if (!commandSink_->submitControlCommand(CommandSource::InputDevice,
+                                          controlCommand_)) {
+    const uint64_t failures =
+        submitFailures_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (failures <= 10 || failures % 1000 == 0) {
+      std::cerr << "EvdevInputDeviceSource: Control command rejected ("
+                << failures << " failures so far)." << std::endl;
+    }
+    return;
+  }
+  commandsSubmitted_.fetch_add(1, std::memory_order_relaxed);
+  if (oldestUnsentEventUs_ != 0) {
+    recordLatency(MonotonicNowUs() - oldestUnsentEventUs_);
+    oldestUnsentEventUs_ = 0;
+  }
+}
+
+void EvdevInputDeviceSource::recordLatency(int64_t latency_us) {
+  latency_us = std::max<int64_t>(latency_us, 0);
+  // Single writer (the polling thread), so the max needs no CAS loop.
+  latencySamples_.fetch_add(1, std::memory_order_relaxed);
+  latencySumUs_.fetch_add(latency_us, std::memory_order_relaxed);
+  if (latency_us > latencyMaxUs_.load(std::memory_order_relaxed)) {
+    latencyMaxUs_.store(latency_us, std::memory_order_relaxed);
+  }
+  latencyLastUs_.store(latency_us, std::memory_order_relaxed);
+}
+
+void EvdevInputDeviceSource::closePollingFds() {
+  for (Device& device : devices_) closeDevice(device);
+  for (int* fd : {&epollFd_, &timerFd_, &stopFd_}) {
+    if (*fd >= 0) {
+      close(*fd);
+      *fd = -1;
+    }
+  }
+}
+
+// --- Calibration ---
+
+double EvdevInputDeviceSource::applyCalibration(const Axis& axis) const {
+  double t = (static_cast<double>(axis.raw) - axis.raw_min) /
+             (axis.raw_max - axis.raw_min);
+  t = std::clamp(t, 0.0, 1.0);
+  if (axis.config.invert) t = 1.0 - t;
+
+  // Magnitude away from rest: the center for bipolar axes, the low end for
+  // pedals.
+  double sign = 1.0;
+  double magnitude = t;
+  if (IsBipolar(axis.config.target)) {
+    const double centered = 2.0 * t - 1.0;
+    sign = centered < 0.0 ? -1.0 : 1.0;
+    magnitude = std::fabs(centered);
+  }
+  const double deadzone = axis.config.deadzone;
+  if (magnitude <= deadzone) return 0.0;
+  magnitude = (magnitude - deadzone) / (1.0 - deadzone);
+  return sign * applyCurve(axis.config, magnitude);
+}
+
+double EvdevInputDeviceSource::applyCurve(const InputAxisConfig& config,
+                                          double magnitude) {
+  const auto& points = config.curve_points;
+  if (points.empty()) {
+    return config.curve_exponent == 1.0
+               ? magnitude
+               : std::pow(magnitude, config.curve_exponent);
+  }
+  if (magnitude <= points.front().first) return points.front().second;
+  if (magnitude >= points.back().first) return points.back().second;
+  // First point with input > magnitude; a handful of points, linear scan.
+  size_t i = 1;
+  while (points[i].first <= magnitude) ++i;
+  const auto& lo = points[i - 1];
+  const auto& hi = points[i];
+  return lo.second +
+         (hi.second - lo.second) * (magnitude - lo.first) / (hi.first - lo.first);
+}
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
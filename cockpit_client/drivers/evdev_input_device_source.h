@@ -0,0 +1,170 @@
+#ifndef EVDEV_INPUT_DEVICE_SOURCE_H
+#define EVDEV_INPUT_DEVICE_SOURCE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "drivers/force_feedback_controller.h"
+#include "drivers/input_device_source.h"  // Interface
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+// Event-to-send latency of the device input, in microseconds: from the
+// kernel timestamp of the oldest input event not yet submitted to the moment
+// the ControlCommand carrying it was handed to the command sink.
+struct InputLatencyStats {
+  uint64_t events_read = 0;         // evdev events processed
+  uint64_t commands_submitted = 0;  // ControlCommands submitted
+  uint64_t submit_failures = 0;
+  uint64_t samples = 0;  // Commands that carried new input
+  double mean_us = 0.0;
+  int64_t max_us = 0;
+  int64_t last_us = 0;
+};
+
+// IInputDeviceSource reading steering wheels, pedals and shifters through
+// Linux evdev (/dev/input/event*).
+//
+// One polling thread waits in epoll on all device fds, a timerfd for the
+// send rate and an eventfd for stop. Every wakeup drains each readable
+// device completely (batched read()s until EAGAIN) and applies the values
+// on SYN_REPORT, so a frame is never sent half-updated; SYN_DROPPED
+// triggers a resync from the device state (EVIOCGABS/EVIOCGKEY). Axis
+// values go through the configured deadzone and calibration curve. On each
+// timer tick one ControlCommand with the freshest values is submitted to
+// the command sink, so it sees a steady rate regardless of how fast the
+// devices report.
+//
+// If a device disappears, or is missing when polling starts, no commands
+// are submitted until it is back (it is reopened once per second); stale
+// values must not be presented as fresh.
+//
+// The hot path does not allocate: the command message is reused.
+//
+// With force_feedback enabled, vehicle telemetry drives effects on the wheel
+// through a ForceFeedbackController, which runs its own thread so effect
+// updates never delay the polling loop.
+class EvdevInputDeviceSource : public IInputDeviceSource {
+ public:
+  EvdevInputDeviceSource();
+  ~EvdevInputDeviceSource() override;
+
+  // --- Implementation of IInputDeviceSource Interface ---
+  // Validates the config; devices are opened by startPolling().
+  bool init(std::shared_ptr<ICommandSink> command_sink,
+            const InputDeviceConfig& config) override;
+  // Opens every configured device and starts the polling thread. Fails if a
+  // device cannot be opened. With no axes or buttons configured, succeeds
+  // without starting a thread.
+  bool startPolling() override;
+  void stopPolling() override;
+  void processVehicleTelemetry(
+      const autodev::remote::chassis::Chassis& telemetry_data) override;
+
+  // MUST BE THREAD-SAFE.
+  InputLatencyStats getLatencyStats() const;
+
+ private:
+  struct Device {
+    std::string path;
+    int fd = -1;
+    // The kernel stamps events with CLOCK_MONOTONIC (EVIOCSCLOCKID); false
+    // on kernels without it, then read time is used instead.
+    bool monotonic_timestamps = false;
+    bool dropping = false;  // After SYN_DROPPED, until the next SYN_REPORT
+    // Event code -> index into axes_/buttons_, or -1.
+    std::vector<int> axis_by_code;
+    std::vector<int> button_by_code;
+  };
+
+  struct Axis {
+    InputAxisConfig config;
+    size_t device = 0;
+    double raw_min = 0.0;
+    double raw_max = 0.0;
+    int32_t raw = 0;         // Applied value
+    int32_t staged_raw = 0;  // Received since the last SYN_REPORT
+    bool staged = false;
+    double value = 0.0;  // After deadzone and curve
+  };
+
+  struct Button {
+    InputButtonConfig config;
+    size_t device = 0;
+    bool pressed = false;
+    bool staged_pressed = false;
+    bool staged = false;
+  };
+
+  // --- Polling thread ---
+  void pollingThreadMain();
+  // Opens the device, registers it with epoll and reads its current state.
+  bool openDevice(size_t index);
+  void closeDevice(Device& device);
+  // Drains all pending events; returns false if the device is gone.
+  bool readDevice(size_t index);
+  // Applies the staged values of a device (SYN_REPORT).
+  void commitDevice(size_t index, int64_t event_time_us);
+  // Reads the current axis/button state from the kernel.
+  void resyncDevice(size_t index);
+  void reopenLostDevices();
+  void submitCommand();
+  void recordLatency(int64_t latency_us);
+  void closePollingFds();
+  // Force feedback is optional: failures are logged and input continues.
+  void startForceFeedback();
+  void stopForceFeedback();
+
+  double applyCalibration(const Axis& axis) const;
+  static double applyCurve(const InputAxisConfig& config, double magnitude);
+
+  std::shared_ptr<ICommandSink> commandSink_;
+  InputDeviceConfig config_;
+
+  // Built by init(); state is touched by the polling thread only.
+  std::vector<Device> devices_;
+  std::vector<Axis> axes_;
+  std::vector<Button> buttons_;
+  int32_t gear_ = 0;
+  // Kernel time of the oldest applied event not yet sent (0: none).
+  int64_t oldestUnsentEventUs_ = 0;
+  size_t lostDevices_ = 0;
+  autodev::remote::control::ControlCommand controlCommand_;
+
+  int epollFd_ = -1;
+  int timerFd_ = -1;
+  int stopFd_ = -1;  // eventfd
+  std::thread pollingThread_;
+  bool polling_ = false;  // start/stopPolling are called from the app thread
+
+  std::unique_ptr<ForceFeedbackController> forceFeedback_;
+  std::string forceFeedbackDevicePath_;
+  // Set while forceFeedback_ is started; read by processVehicleTelemetry().
+  std::atomic<ForceFeedbackController*> activeForceFeedback_{nullptr};
+
+  // --- Statistics (written by the polling thread) ---
+  std::atomic<uint64_t> eventsRead_{0};
+  std::atomic<uint64_t> commandsSubmitted_{0};
+  std::atomic<uint64_t> submitFailures_{0};
+  std::atomic<uint64_t> latencySamples_{0};
+  std::atomic<int64_t> latencySumUs_{0};
+  std::atomic<int64_t> latencyMaxUs_{0};
+  std::atomic<int64_t> latencyLastUs_{0};
+
+  // Prevent copying
+  EvdevInputDeviceSource(const EvdevInputDeviceSource&) = delete;
+  EvdevInputDeviceSource& operator=(const EvdevInputDeviceSource&) = delete;
+};
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // EVDEV_INPUT_DEVICE_SOURCE_H
@@ -0,0 +1,297 @@
+#include "drivers/force_feedback_controller.h"
+
+#include <fcntl.h>
+#include <linux/input.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+namespace {
+
+constexpr size_t kFfBitsBytes = FF_CNT / 8 + 1;
+
+bool TestBit(const uint8_t* bits, unsigned bit) {
+  return (bits[bit / 8] >> (bit % 8)) & 1;
+}
+
+// -1..1 -> signed 16-bit effect level / coefficient.
+int16_t ToLevel(double value) {
+  return static_cast<int16_t>(std::lround(std::clamp(value, -1.0, 1.0) * 0x7fff));
+}
+
+}  // namespace
+
+ForceFeedbackController::ForceFeedbackController(
+    const ForceFeedbackConfig& config)
+    : config_(config) {}
+
+ForceFeedbackController::~ForceFeedbackController() { stop(); }
+
+bool ForceFeedbackController::start(const std::string& device_path) {
+  if (fd_ >= 0) {
+    std::cerr << "ForceFeedbackController: Already started." << std::endl;
+    return false;
+  }
+  if (!(config_.update_rate_hz > 0.0)) {
+    std::cerr << "ForceFeedbackController: update_rate_hz must be > 0."
+              << std::endl;
+    return false;
+  }
+  // A separate fd from the input source's: effect uploads need write access
+  // and must not share the polled descriptor.
+  fd_ = open(device_path.c_str(), O_RDWR | O_CLOEXEC);
+  if (fd_ < 0) {
+    std::cerr << "ForceFeedbackController: Failed to open '" << device_path
+              << "': " << std::strerror(errno) << std::endl;
+    return false;
+  }
+
+  uint8_t ff_bits[kFfBitsBytes] = {};
+  if (ioctl(fd_, EVIOCGBIT(EV_FF, sizeof(ff_bits)), ff_bits) < 0) {
+    std::cerr << "ForceFeedbackController: '" << device_path
+              << "' does not support force feedback." << std::endl;
+    close(fd_);
+    fd_ = -1;
+    return false;
+  }
+  useConditionEffects_ = TestBit(ff_bits, FF_SPRING);
+  hasDamper_ = useConditionEffects_ && TestBit(ff_bits, FF_DAMPER);
+  if (!useConditionEffects_ && !TestBit(ff_bits, FF_CONSTANT)) {
+    std::cerr << "ForceFeedbackController: '" << device_path
+              << "' supports neither FF_SPRING nor FF_CONSTANT." << std::endl;
+    close(fd_);
+    fd_ = -1;
+    return false;
+  }
+  if (TestBit(ff_bits, FF_GAIN)) {
+    writeFfEvent(FF_GAIN, static_cast<int32_t>(
+                              std::clamp(config_.gain, 0.0, 1.0) * 0xffff));
+  }
+  // The device's own centering would fight (and hide) the computed forces.
+  if (TestBit(ff_bits, FF_AUTOCENTER)) writeFfEvent(FF_AUTOCENTER, 0);
+
+  // Upload the effects at zero strength and start them; later updates only
+  // change their parameters.
+  applied_ = Forces();
+  bool ok;
+  if (useConditionEffects_) {
+    ok = uploadEffect(&springId_, FF_SPRING, applied_) && playEffect(springId_);
+    if (ok && hasDamper_) {
+      ok = uploadEffect(&damperId_, FF_DAMPER, applied_) &&
+           playEffect(damperId_);
+    }
+  } else {
+    ok = uploadEffect(&constantId_, FF_CONSTANT, applied_) &&
+         playEffect(constantId_);
+  }
+  if (!ok) {
+    removeEffects();
+    close(fd_);
+    fd_ = -1;
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = false;
+    dirty_ = false;
+    haveTelemetry_ = false;
+  }
+  hapticThread_ = std::thread(&ForceFeedbackController::hapticThreadMain, this);
+  std::cout << "ForceFeedbackController: Started on '" << device_path << "' ("
+            << (useConditionEffects_
+                    ? (hasDamper_ ? "spring + damper" : "spring")
+                    : "constant force")
+            << ")." << std::endl;
+  return true;
+}
+
+void ForceFeedbackController::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  if (hapticThread_.joinable()) hapticThread_.join();
+  if (fd_ < 0) return;
+  removeEffects();
+  close(fd_);
+  fd_ = -1;
+  std::cout << "ForceFeedbackController: Stopped." << std::endl;
+}
+
+void ForceFeedbackController::updateVehicleState(double speed_mps,
+                                                 double steering_ratio) {
+  // Called from the telemetry (WebRTC) thread. MUST BE THREAD-SAFE.
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.telemetry_updates;
+    if (dirty_) ++stats_.coalesced;
+    speedMps_ = speed_mps;
+    steeringRatio_ = steering_ratio;
+    lastTelemetry_ = Clock::now();
+    haveTelemetry_ = true;
+    dirty_ = true;
+  }
+  cv_.notify_one();
+}
+
+ForceFeedbackStats ForceFeedbackController::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+// --- Haptic thread ---
+
+void ForceFeedbackController::hapticThreadMain() {
+  const auto min_interval =
+      std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(1.0 / config_.update_rate_hz));
+  const auto timeout = std::chrono::milliseconds(config_.telemetry_timeout_ms);
+  Clock::time_point next_update = Clock::now();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    // Wait for new telemetry, or for the current one to go stale.
+    if (haveTelemetry_) {
+      cv_.wait_until(lock, lastTelemetry_ + timeout,
+                     [this] { return stopping_ || dirty_; });
+    } else {
+      cv_.wait(lock, [this] { return stopping_ || dirty_; });
+    }
+    if (stopping_) return;
+    // Rate limit; telemetry arriving meanwhile replaces the pending one.
+    if (Clock::now() < next_update) {
+      cv_.wait_until(lock, next_update, [this] { return stopping_; });
+      if (stopping_) return;
+    }
+
+    const Clock::time_point now = Clock::now();
+    const bool stale = !haveTelemetry_ || now - lastTelemetry_ >= timeout;
+    const double speed_mps = speedMps_;
+    const double steering_ratio = steeringRatio_;
+    dirty_ = false;
+    if (stale) haveTelemetry_ = false;
+    next_update = now + min_interval;
+
+    lock.unlock();
+    applyForces(stale ? Forces() : computeForces(speed_mps, steering_ratio));
+    lock.lock();
+  }
+}
+
+ForceFeedbackController::Forces ForceFeedbackController::computeForces(
+    double speed_mps, double steering_ratio) const {
+  const double speed_factor =
+      config_.full_speed_mps > 0.0
+          ? std::clamp(std::fabs(speed_mps) / config_.full_speed_mps, 0.0, 1.0)
+          : 1.0;
+  Forces forces;
+  forces.spring = config_.centering_at_standstill +
+                  (config_.centering_at_speed -
+                   config_.centering_at_standstill) *
+                      speed_factor;
+  forces.damper = config_.damping_at_speed * speed_factor;
+  // Self-aligning torque: against the steering position, stronger with
+  // speed.
+  forces.constant_level = -std::clamp(steering_ratio, -1.0, 1.0) *
+                          forces.spring *
+                          (config_.invert_constant_force ? -1.0 : 1.0);
+  return forces;
+}
+
+void ForceFeedbackController::applyForces(const Forces& forces) {
+  // Skips changes below min_change, but always reaches exactly zero so
+  // released forces do not linger.
+  auto changed = [this](double target, double current) {
+    return std::fabs(target - current) >= config_.min_change ||
+           (target == 0.0 && current != 0.0);
+  };
+  uint64_t updates = 0;
+  if (useConditionEffects_) {
+    if (changed(forces.spring, applied_.spring) &&
+        uploadEffect(&springId_, FF_SPRING, forces)) {
+      applied_.spring = forces.spring;
+      ++updates;
+    }
+    if (hasDamper_ && changed(forces.damper, applied_.damper) &&
+        uploadEffect(&damperId_, FF_DAMPER, forces)) {
+      applied_.damper = forces.damper;
+      ++updates;
+    }
+  } else if (changed(forces.constant_level, applied_.constant_level) &&
+             uploadEffect(&constantId_, FF_CONSTANT, forces)) {
+    applied_.constant_level = forces.constant_level;
+    ++updates;
+  }
+  if (updates > 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.effect_updates += updates;
+  }
+}
+
+// --- Device access ---
+
+bool ForceFeedbackController::uploadEffect(int16_t* id, uint16_t type,
+                                           const Forces& forces) {
+  ff_effect effect{};
+  effect.type = type;
+  effect.id = *id;
+  effect.direction = 0x4000;  // Along the steering axis
+  effect.replay.length = 0;   // Infinite
+  if (type == FF_CONSTANT) {
+    effect.u.constant.level = ToLevel(forces.constant_level);
+  } else {
+    const double strength = type == FF_SPRING ? forces.spring : forces.damper;
+    ff_condition_effect& axis = effect.u.condition[0];
+    axis.right_saturation = 0xffff;
+    axis.left_saturation = 0xffff;
+    axis.right_coeff = ToLevel(strength);
+    axis.left_coeff = ToLevel(strength);
+  }
+  if (ioctl(fd_, EVIOCSFF, &effect) < 0) {
+    std::cerr << "ForceFeedbackController: Failed to upload effect: "
+              << std::strerror(errno) << std::endl;
+    return false;
+  }
+  *id = effect.id;
+  return true;
+}
+
+bool ForceFeedbackController::playEffect(int16_t id) {
+  return writeFfEvent(static_cast<uint16_t>(id), 1);
+}
+
+void ForceFeedbackController::removeEffects() {
+  for (int16_t* id : {&springId_, &damperId_, &constantId_}) {
+    if (*id < 0) continue;
+    ioctl(fd_, EVIOCRMFF, static_cast<int>(*id));
+    *id = -1;
+  }
+}
+
+bool ForceFeedbackController::writeFfEvent(uint16_t code, int32_t value) {
+  input_event event{};
+  event.type = EV_FF;
+  event.code = code;
+  event.value = value;
+  if (write(fd_, &event, sizeof(event)) != sizeof(event)) {
+    std::cerr << "ForceFeedbackController: Failed to write FF event "
+              << code << ": " << std::strerror(errno) << std::endl;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
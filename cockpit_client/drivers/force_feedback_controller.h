@@ -0,0 +1,104 @@
+#ifndef FORCE_FEEDBACK_CONTROLLER_H
+#define FORCE_FEEDBACK_CONTROLLER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "config/input_device_config.h"  // ForceFeedbackConfig
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+struct ForceFeedbackStats {
+  uint64_t telemetry_updates = 0;  // updateVehicleState() calls
+  uint64_t effect_updates = 0;     // EVIOCSFF calls after the initial upload
+  uint64_t coalesced = 0;  // Telemetry replaced before it was applied
+};
+
+// Plays steering force feedback on an evdev wheel from the vehicle state.
+//
+// The wheel gets a self-centering spring (FF_SPRING) and, if supported, a
+// damper (FF_DAMPER), both stiffening with vehicle speed. Wheels without
+// condition effects get a constant force (FF_CONSTANT) against the
+// vehicle's current steering position instead, approximating the
+// self-aligning torque of the tyres.
+//
+// Effects are updated from a dedicated haptic thread on a separate fd, so
+// the FF ioctls never delay input polling. updateVehicleState() only stores
+// the latest state; the haptic thread applies it at most update_rate_hz
+// times per second, skipping updates below min_change.
+class ForceFeedbackController {
+ public:
+  explicit ForceFeedbackController(const ForceFeedbackConfig& config);
+  ~ForceFeedbackController();
+
+  // Opens the device, uploads and starts the effects and the haptic thread.
+  bool start(const std::string& device_path);
+  // Removes the effects (the wheel goes slack) and joins the thread.
+  void stop();
+
+  // speed_mps: vehicle speed; steering_ratio: vehicle steering position,
+  // -1 (full left) .. 1 (full right).
+  // Non-blocking. MUST BE THREAD-SAFE.
+  void updateVehicleState(double speed_mps, double steering_ratio);
+
+  // MUST BE THREAD-SAFE.
+  ForceFeedbackStats getStats() const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  // Effect strengths, 0..1 (constant_level: -1..1).
+  struct Forces {
+    double spring = 0.0;
+    double damper = 0.0;
+    double constant_level = 0.0;
+  };
+
+  void hapticThreadMain();
+  Forces computeForces(double speed_mps, double steering_ratio) const;
+  // Uploads the effect (*id == -1) or updates it in place; *id receives the
+  // kernel's effect id.
+  bool uploadEffect(int16_t* id, uint16_t type, const Forces& forces);
+  bool playEffect(int16_t id);
+  void applyForces(const Forces& forces);
+  void removeEffects();
+  bool writeFfEvent(uint16_t code, int32_t value);
+
+  const ForceFeedbackConfig config_;
+  int fd_ = -1;
+  bool useConditionEffects_ = false;  // Spring (+damper) vs constant force
+  bool hasDamper_ = false;
+  int16_t springId_ = -1;
+  int16_t damperId_ = -1;
+  int16_t constantId_ = -1;
+  Forces applied_;  // Haptic thread only
+  std::thread hapticThread_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  // --- Guarded by mutex_ ---
+  double speedMps_ = 0.0;
+  double steeringRatio_ = 0.0;
+  Clock::time_point lastTelemetry_;
+  bool haveTelemetry_ = false;
+  bool dirty_ = false;  // Not applied yet
+  bool stopping_ = false;
+  ForceFeedbackStats stats_;
+
+  // Prevent copying
+  ForceFeedbackController(const ForceFeedbackController&) = delete;
+  ForceFeedbackController& operator=(const ForceFeedbackController&) = delete;
+};
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // FORCE_FEEDBACK_CONTROLLER_H
@@ -0,0 +1,84 @@
+#ifndef FRAME_BUFFER_POOL_H
+#define FRAME_BUFFER_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+// A small pool of reusable byte buffers for encoded video frames.
+// Buffers are handed out as shared_ptr whose deleter returns the storage to
+// the pool instead of freeing it, so steady-state streaming performs no heap
+// allocation per frame once each buffer has grown to the largest frame size.
+// The pool state is shared with outstanding buffers, so a buffer that outlives
+// the pool is simply freed. MUST BE THREAD-SAFE: acquire() is called from
+// encoder worker threads, buffers are released from the transport thread.
+class FrameBufferPool {
+ public:
+  using Buffer = std::vector<char>;
+
+  // max_pooled_buffers: Upper bound of idle buffers kept for reuse. Buffers
+  // released while the pool is full are freed.
+  explicit FrameBufferPool(size_t max_pooled_buffers)
+      : state_(std::make_shared<State>()) {
+    state_->max_pooled = max_pooled_buffers;
+  }
+
+  // Returns an empty buffer with at least 'capacity' bytes reserved.
+  std::shared_ptr<Buffer> acquire(size_t capacity) {
+    std::unique_ptr<Buffer> buffer;
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      if (!state_->free_buffers.empty()) {
+        buffer = std::move(state_->free_buffers.back());
+        state_->free_buffers.pop_back();
+      }
+    }
+    if (!buffer) {
+      buffer = std::make_unique<Buffer>();
+    }
+    buffer->clear();
+    buffer->reserve(capacity);
+
+    std::weak_ptr<State> weak_state = state_;
+    return std::shared_ptr<Buffer>(buffer.release(), [weak_state](Buffer* b) {
+      std::unique_ptr<Buffer> owned(b);
+      if (auto state = weak_state.lock()) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->free_buffers.size() < state->max_pooled) {
+          state->free_buffers.push_back(std::move(owned));
+        }
+      }
+    });
+  }
+
+  // Number of idle buffers currently available for reuse.
+  size_t idleCount() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->free_buffers.size();
+  }
+
+ private:
+  struct State {
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Buffer>> free_buffers;
+    size_t max_pooled = 0;
+  };
+
+  std::shared_ptr<State> state_;
+
+  // Prevent copying
+  FrameBufferPool(const FrameBufferPool&) = delete;
+  FrameBufferPool& operator=(const FrameBufferPool&) = delete;
+};
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // FRAME_BUFFER_POOL_H
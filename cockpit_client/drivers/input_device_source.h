@@ -2,19 +2,18 @@
 #define INPUT_DEVICE_SOURCE_H
 
 #include <functional>  // For optional callbacks
-#include <memory>      // For shared_ptr to WebrtcManager
+#include <memory>      // For shared_ptr to ICommandSink
 #include <string>
 #include <vector>
 
-// Include the interface for the WebRTC manager (dependency)
-#include "webrtc/webrtc_manager.h"
+// Where the produced commands go (dependency); also includes the generated
+// protobuf headers for the command types produced by this source
+#include "drivers/command_sink.h"
 
-// Include generated protobuf headers for command types produced by this source
-#include "control/proto/control_command.pb.h"
-#include "control/proto/emergency_command.pb.h"
+// Vehicle state, used for force feedback
+#include "chassis/proto/chassis.pb.h"
 
-// Forward declare configuration struct if defined elsewhere
-// struct InputDeviceConfig;
+#include "config/input_device_config.h"  // InputDeviceConfig
 
 // Use namespace for better organization
 namespace autodev {
@@ -24,33 +23,29 @@ namespace drivers {  // Or sensors, depending on how input devices are
 
 // Interface for a physical input device source (e.g., steering wheel,
 // joystick). This source reads device state, converts it into structured
-// commands (Protobuf), and sends them directly to the vehicle via the
-// WebrtcManager. It acts like a sensor source, but produces commands instead of
-// telemetry.
+// commands (Protobuf), and submits them to the command sink (the
+// CommandArbiter, which decides what is sent to the vehicle). It acts like a
+// sensor source, but produces commands instead of telemetry.
 class IInputDeviceSource {
  public:
   virtual ~IInputDeviceSource() = default;
 
   // Initializes the input device source.
-  // Needs access to the WebrtcManager to send commands to the vehicle.
   // Also needs configuration parameters to specify the device or its settings.
   // The implementation should store the provided shared_ptr and config.
   //
-  // webrtc_manager: Shared pointer to the WebrtcManager instance.
-  // control_channel_label: The DataChannel label for sending control commands.
-  // target_peer_id: The ID of the vehicle peer to send commands to.
+  // command_sink: Receives the produced commands (source InputDevice). While
+  // a device is in use, its state MUST be resubmitted periodically even
+  // without changes, so the sink sees the source as active.
   // config: Configuration specific to the input device (e.g., device node
   // path). Returns true on success, false on failure.
-  virtual bool init(
-      std::shared_ptr<autodev::remote::webrtc::WebrtcManager> webrtc_manager,
-      const std::string& control_channel_label,
-      const std::string& target_peer_id,
-      /* const InputDeviceConfig& config */) = 0;
+  virtual bool init(std::shared_ptr<ICommandSink> command_sink,
+                    const InputDeviceConfig& config) = 0;
 
   // Starts the input device polling and command sending loop.
   // Implementations typically run a background thread or integrate with an
   // event loop to read device state periodically or when events occur, convert
-  // to commands, and send via the WebrtcManager. Returns true on success (e.g.,
+  // to commands, and submit them to the sink. Returns true on success (e.g.,
   // polling thread started). Must be called after init(). If polling is already
   // active, calling this might return false.
   virtual bool startPolling() = 0;
@@ -60,6 +55,13 @@ class IInputDeviceSource {
   // Safe to call even if polling is not active or already stopped.
   virtual void stopPolling() = 0;
 
+  // Feeds the latest vehicle telemetry to the source, e.g. to drive force
+  // feedback on the input device. Sources without such output ignore it.
+  // Called from a WebRTC thread for every telemetry message; MUST BE
+  // THREAD-SAFE and return quickly.
+  virtual void processVehicleTelemetry(
+      const autodev::remote::chassis::Chassis& telemetry_data) = 0;
+
   // Optional: Add an error handler callback from the source (e.g., device
   // disconnect). using OnErrorHandler = std::function<void(const std::string&
   // error_msg)>; virtual void setOnErrorHandler(OnErrorHandler handler) = 0;
@@ -0,0 +1,31 @@
+#ifndef SESSION_CONTROL_H
+#define SESSION_CONTROL_H
+
+#include <string>
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+// Take-over switch of a cockpit connected to several vehicles: at most one
+// vehicle is controlled, the others are previewed.
+class ISessionControl {
+ public:
+  virtual ~ISessionControl() = default;
+
+  // Makes vehicle_id the controlled vehicle; the previously controlled one
+  // (if any) goes back to preview. Returns false if the vehicle is unknown
+  // or not connected. MUST BE THREAD-SAFE.
+  virtual bool takeControl(const std::string& vehicle_id) = 0;
+
+  // Puts the controlled vehicle (if any) back to preview; no vehicle gets
+  // control commands afterwards. MUST BE THREAD-SAFE.
+  virtual void releaseControl() = 0;
+};
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // SESSION_CONTROL_H
@@ -1,65 +1,292 @@
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <string>
 
-#include "include/drivers/telemetry_handler.h"
-#include "include/transport/transport_server.h"  // To send to Web UI
+#include "drivers/telemetry_handler_impl.h"
+#include "transport/json_writer.h"       // Allocation-free JSON output
+#include "transport/transport_server.h"  // To send to Web UI
 
-// Include protobuf header
-// #include "proto/chassis.pb.h"
+namespace autodev {
+namespace remote {
+namespace drivers {
 
-// Include JSON library (to serialize protobuf to JSON for JS)
-// #include <nlohmann/json.hpp>
-// using json = nlohmann::json;
+namespace {
 
-class TelemetryHandler : public ITelemetryHandler {
- public:
-  TelemetryHandler() {
-    std::cout << "TelemetryHandler created (skeleton)" << std::endl;
+void PutLe16(char* dst, uint16_t v) {
+  dst[0] = static_cast<char>(v);
+  dst[1] = static_cast<char>(v >> 8);
+}
+
+void PutLe32(char* dst, uint32_t v) {
+  for (int i = 0; i < 4; ++i) dst[i] = static_cast<char>(v >> (8 * i));
+}
+
+void PutLe64(char* dst, uint64_t v) {
+  for (int i = 0; i < 8; ++i) dst[i] = static_cast<char>(v >> (8 * i));
+}
+
+}  // namespace
+
+TelemetryHandlerImpl::TelemetryHandlerImpl(
+    const TelemetryHandlerConfig& config)
+    : config_(config) {
+  std::cout << "TelemetryHandlerImpl created ("
+            << (config_.format == TelemetryFormat::Json ? "JSON" : "binary")
+            << ", max " << config_.publish_rate_hz << " Hz)" << std::endl;
+}
+
+TelemetryHandlerImpl::~TelemetryHandlerImpl() { stop(); }
+
+// --- Implementation of ITelemetryHandler Interface ---
+
+bool TelemetryHandlerImpl::init(
+    std::shared_ptr<autodev::remote::transport::ITransportServer>
+        transport_server) {
+  if (!transport_server) {
+    std::cerr << "TelemetryHandlerImpl: TransportServer is null." << std::endl;
+    return false;
+  }
+  if (publisherThread_.joinable()) {
+    std::cerr << "TelemetryHandlerImpl: Already initialized." << std::endl;
+    return false;
+  }
+  transportServer_ = transport_server;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = false;
+  }
+  publisherThread_ =
+      std::thread(&TelemetryHandlerImpl::publisherThreadMain, this);
+  std::cout << "TelemetryHandlerImpl: Initialized." << std::endl;
+  return true;
+}
+
+void TelemetryHandlerImpl::addVehicleVideoTrack(
+    const std::string& peer_id,
+    rtc::scoped_refptr<webrtc::VideoTrackInterface> /*track*/) {
+  // Video is delivered to the UI by the WebSocketVideoSink /
+  // EncodedVideoForwarder that CockpitClientApp attaches to the track.
+  std::cout << "TelemetryHandlerImpl: Ignoring video track from " << peer_id
+            << " (handled by the application's video path)." << std::endl;
+}
+
+void TelemetryHandlerImpl::processIncomingTelemetry(
+    const std::string& peer_id,
+    const autodev::remote::chassis::Chassis& telemetry_data) {
+  // Called from a WebRTC thread. MUST BE THREAD-SAFE. Only records the latest
+  // state; the publisher thread serializes and sends it.
+  const int64_t now_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          Clock::now().time_since_epoch())
+          .count();
+  std::lock_guard<std::mutex> lock(mutex_);
+  VehicleState& vehicle = vehicles_[peer_id];
+  vehicle.latest.speed_mps = telemetry_data.speed_mps();
+  vehicle.latest.gear = static_cast<int32_t>(telemetry_data.gear());
+  vehicle.latest.timestamp_us = now_us;
+  ++vehicle.latest.seq;
+  vehicle.dirty = true;
+  if (!workPending_) {
+    workPending_ = true;
+    cv_.notify_one();
+  }
+}
+
+void TelemetryHandlerImpl::addClient(WebSocketConnectionId conn_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (std::find(clients_.begin(), clients_.end(), conn_id) != clients_.end()) {
+    return;
+  }
+  clients_.push_back(conn_id);
+  newClients_.push_back(conn_id);
+  if (!vehicles_.empty() && !workPending_) {
+    // Send the current state right away instead of waiting for an update.
+    workPending_ = true;
+    cv_.notify_one();
+  }
+}
+
+void TelemetryHandlerImpl::removeClient(WebSocketConnectionId conn_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  clients_.erase(std::remove(clients_.begin(), clients_.end(), conn_id),
+                 clients_.end());
+  newClients_.erase(
+      std::remove(newClients_.begin(), newClients_.end(), conn_id),
+      newClients_.end());
+}
+
+void TelemetryHandlerImpl::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  if (publisherThread_.joinable()) {
+    publisherThread_.join();
+    std::cout << "TelemetryHandlerImpl: Publisher stopped." << std::endl;
   }
+}
+
+void TelemetryHandlerImpl::notifyConnectionStatus(const std::string& peer_id,
+                                                  const std::string& status,
+                                                  const std::string& detail) {
+  // Rare and called from several threads, so built in a local buffer and
+  // handed to the transport as a view: the only copy is its queue entry.
+  // Longer details spill into 'overflow' (empty until then).
+  std::string overflow;
+  autodev::remote::transport::StackJsonWriter<512> writer(&overflow);
+  writer.beginObject()
+      .field("type", "status")
+      .field("vehicle_id", peer_id)
+      .field("status", status)
+      .field("detail", detail)
+      .endObject();
+  if (writer.ok()) sendStatusMessage(writer.view());
+}
+
+void TelemetryHandlerImpl::notifyError(const std::string& source,
+                                       const std::string& error_msg) {
+  std::string overflow;
+  autodev::remote::transport::StackJsonWriter<512> writer(&overflow);
+  writer.beginObject()
+      .field("type", "error")
+      .field("source", source)
+      .field("message", error_msg)
+      .endObject();
+  if (writer.ok()) sendStatusMessage(writer.view());
+}
+
+void TelemetryHandlerImpl::sendStatusMessage(std::string_view message) {
+  if (!transportServer_) return;  // Not initialized
+  // Status goes to every UI client, subscribed to telemetry or not.
+  transportServer_->sendToAllWebSocketClients(message);
+}
 
-  bool init(std::shared_ptr<ITransportServer> transport_server) override {
-    if (!transport_server) {
-      std::cerr << "TelemetryHandler: TransportServer is null." << std::endl;
-      return false;
+// --- Publisher thread ---
+
+void TelemetryHandlerImpl::publisherThreadMain() {
+  const auto min_interval =
+      config_.publish_rate_hz > 0.0
+          ? std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(1.0 / config_.publish_rate_hz))
+          : Clock::duration::zero();
+  Clock::time_point next_publish = Clock::now();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this]() { return stopping_ || workPending_; });
+    if (stopping_) break;
+    // Rate cap: updates arriving until the next slot are coalesced into the
+    // per-vehicle latest state.
+    if (cv_.wait_until(lock, next_publish, [this]() { return stopping_; })) {
+      break;
     }
-    transportServer_ = transport_server;
-    std::cout << "TelemetryHandler: Initialized." << std::endl;
-    return true;
+    const Clock::time_point publish_start = Clock::now();
+    workPending_ = false;
+    if (collectPushesLocked() == 0) continue;
+
+    lock.unlock();
+    publishPending();
+    lock.lock();
+    next_publish = publish_start + min_interval;
   }
+}
+
+size_t TelemetryHandlerImpl::collectPushesLocked() {
+  publishClients_.assign(clients_.begin(), clients_.end());
+  publishNewClients_.assign(newClients_.begin(), newClients_.end());
+  newClients_.clear();
 
-  void processIncomingTelemetry(
-      const std::string& peer_id,
-      const autodev::remote::chassis::Chassis& telemetry_data) override {
-    // std::cout << "TelemetryHandler: Processing telemetry from " << peer_id <<
-    // std::endl;
-    // TODO: Serialize telemetry_data (Protobuf) to a format suitable for
-    // WebSocket (e.g., JSON) Example using nlohmann/json: json j;
-    // // TODO: Populate JSON from protobuf fields
-    // // j["speed_mps"] = telemetry_data.speed_mps();
-    // // j["gear"] = telemetry_data.gear();
-    // // ... map all relevant fields
-
-    // std::string json_string = j.dump();
-
-    // Send the JSON string to all connected WebSocket clients (the display)
-    // Need a way to get active WebSocket connection IDs from the server.
-    // Or, the transport server could have a broadcast method.
-    // For simplicity, assuming a single display client connection with ID 1.
-
-    // --- Skeleton implementation ---
-    std::string dummy_json =
-        "{ \"speed_mps\": " + std::to_string(telemetry_data.speed_mps()) +
-        ", \"gear\": " + std::to_string(telemetry_data.gear()) + " }";
-    std::cout << "TelemetryHandler: Sending telemetry (skeleton) to WS conn 1: "
-              << dummy_json << std::endl;
-    transportServer_->sendWebSocketMessage(
-        1, dummy_json);  // Assuming conn_id 1 for the display
+  pendingPushCount_ = 0;
+  const bool has_new_clients = !publishNewClients_.empty();
+  for (auto& entry : vehicles_) {
+    VehicleState& vehicle = entry.second;
+    if (!vehicle.dirty && !has_new_clients) continue;
+    if (pendingPushCount_ == pendingPushes_.size()) {
+      pendingPushes_.emplace_back();
+    }
+    PendingPush& push = pendingPushes_[pendingPushCount_++];
+    push.vehicle_id.assign(entry.first);  // Reuses the string's capacity
+    push.snapshot = vehicle.latest;
+    push.changed = vehicle.dirty;
+    vehicle.dirty = false;
+  }
+  return publishClients_.empty() ? 0 : pendingPushCount_;
+}
+
+void TelemetryHandlerImpl::publishPending() {
+  for (size_t i = 0; i < pendingPushCount_; ++i) {
+    const PendingPush& push = pendingPushes_[i];
+    if (config_.format == TelemetryFormat::Json) {
+      serializeJson(push);
+    } else {
+      serializeBinary(push);
+    }
+    for (WebSocketConnectionId conn_id : publishClients_) {
+      // Unchanged states only go to clients that just subscribed.
+      if (!push.changed &&
+          std::find(publishNewClients_.begin(), publishNewClients_.end(),
+                    conn_id) == publishNewClients_.end()) {
+        continue;
+      }
+      sendSerialized(conn_id);
+    }
   }
+}
+
+void TelemetryHandlerImpl::serializeJson(const PendingPush& push) {
+  // The writer reuses jsonBuffer_'s capacity, so steady-state pushes do not
+  // allocate.
+  autodev::remote::transport::JsonWriter writer(jsonBuffer_);
+  writer.beginObject()
+      .field("type", "telemetry")
+      .field("vehicle_id", push.vehicle_id)
+      .field("seq", push.snapshot.seq)
+      .field("timestamp_us", push.snapshot.timestamp_us)
+      .key("data")
+      .beginObject()
+      .field("speed_mps", push.snapshot.speed_mps)
+      .field("gear", push.snapshot.gear)
+      .endObject()
+      .endObject();
+  writer.finish();
+}
 
- private:
-  std::shared_ptr<ITransportServer> transportServer_;
+void TelemetryHandlerImpl::serializeBinary(const PendingPush& push) {
+  const size_t id_size = std::min<size_t>(push.vehicle_id.size(), 0xffff);
+  binaryBuffer_.resize(kTelemetryBinaryHeaderSize + id_size);
+  char* out = binaryBuffer_.data();
+  std::memcpy(out, kTelemetryBinaryMagic, sizeof(kTelemetryBinaryMagic));
+  PutLe16(out + 4, static_cast<uint16_t>(kTelemetryBinaryHeaderSize));
+  out[6] = static_cast<char>(kTelemetryBinaryVersion);
+  out[7] = 0;
+  PutLe32(out + 8, push.snapshot.seq);
+  PutLe16(out + 12, static_cast<uint16_t>(id_size));
+  PutLe16(out + 14, 0);
+  PutLe64(out + 16, static_cast<uint64_t>(push.snapshot.timestamp_us));
+  uint64_t speed_bits;
+  std::memcpy(&speed_bits, &push.snapshot.speed_mps, sizeof(speed_bits));
+  PutLe64(out + 24, speed_bits);
+  PutLe32(out + 32, static_cast<uint32_t>(push.snapshot.gear));
+  std::memcpy(out + kTelemetryBinaryHeaderSize, push.vehicle_id.data(),
+              id_size);
+}
+
+void TelemetryHandlerImpl::sendSerialized(WebSocketConnectionId conn_id) {
+  // The transport queues the message; a full or closed client only affects
+  // itself.
+  const bool sent = config_.format == TelemetryFormat::Json
+                        ? transportServer_->sendWebSocketMessage(conn_id,
+                                                                 jsonBuffer_)
+                        : transportServer_->sendWebSocketMessage(
+                              conn_id, binaryBuffer_);
+  if (!sent) {
+    std::cerr << "TelemetryHandlerImpl: Failed to send telemetry to WS conn "
+              << conn_id << std::endl;
+  }
+}
 
-  // Prevent copying
-  TelemetryHandler(const TelemetryHandler&) = delete;
-  TelemetryHandler& operator=(const TelemetryHandler&) = delete;
-};
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
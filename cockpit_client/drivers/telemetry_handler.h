@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "transport/transport_server.h"
+#include "webrtc/api/media_stream_interface.h"  // For webrtc::VideoTrackInterface
 
 // Include the generated protobuf header for telemetry data
 // Ensure this path is correct for your build system
@@ -58,15 +59,37 @@ class ITelemetryHandler {
       const std::string& peer_id,
       const autodev::remote::chassis::Chassis& telemetry_data) = 0;
 
+  // Subscribes a UI client (WebSocket connection) to telemetry pushes. The
+  // client receives the latest known state of every vehicle with the next
+  // push. Thread-safe; typically called from the TransportServer thread.
+  virtual void addClient(WebSocketConnectionId conn_id) = 0;
+
+  // Unsubscribes a UI client, e.g. after its WebSocket closed. Thread-safe.
+  virtual void removeClient(WebSocketConnectionId conn_id) = 0;
+
+  // Stops any background publishing. Pending updates are discarded. Safe to
+  // call multiple times. Must be called before the TransportServer stops.
+  virtual void stop() = 0;
+
   // Optional: Add specific methods for processing other types of telemetry,
   // or use a generic wrapper message if handling multiple types.
   // virtual void processIncomingSensorData(const std::string& peer_id, const
   // autodev::remote::sensors::SensorData& data) = 0;
 
-  // Optional: Notify UI about connection status changes
-  // Implementations would use the TransportServer to send a status message to
-  // the UI. virtual void notifyConnectionStatus(const std::string& peer_id,
-  // bool is_connected) = 0;
+  // Notifies every UI client about a change of the link to a vehicle.
+  // Sent as {"type":"status","vehicle_id":...,"status":...,"detail":...}.
+  // status: Short machine-readable state, e.g. "connected", "disconnected",
+  //         "network_up", "network_down", "heartbeat_lost".
+  // detail: Optional human-readable reason (may be empty).
+  // Thread-safe.
+  virtual void notifyConnectionStatus(const std::string& peer_id,
+                                      const std::string& status,
+                                      const std::string& detail) = 0;
+
+  // Notifies every UI client about an error in the cockpit.
+  // Sent as {"type":"error","source":...,"message":...}. Thread-safe.
+  virtual void notifyError(const std::string& source,
+                           const std::string& error_msg) = 0;
 
   // Optional: Add an error handler callback from the TelemetryHandler itself?
   // (Less common) using OnErrorHandler = std::function<void(const std::string&
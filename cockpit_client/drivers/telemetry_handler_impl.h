@@ -0,0 +1,156 @@
+#ifndef TELEMETRY_HANDLER_IMPL_H
+#define TELEMETRY_HANDLER_IMPL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "drivers/telemetry_handler.h"   // Interface
+#include "transport/transport_server.h"  // Dependency
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+// Wire format of the telemetry pushes to the UI.
+enum class TelemetryFormat {
+  // Text message:
+  // {"type":"telemetry","vehicle_id":"...","seq":N,"timestamp_us":T,
+  //  "data":{"speed_mps":S,"gear":G}}
+  Json,
+  // Binary message, see the kTelemetryBinary* layout below.
+  Binary,
+};
+
+// Binary telemetry message (all fields little-endian). The browser
+// (display/src/app.js) parses the same layout, so any change here MUST be
+// mirrored there and the version bumped.
+//   offset  size  field
+//   0       4     magic ('W','T','M','1')
+//   4       2     header_size (offset of vehicle_id)
+//   6       1     version
+//   7       1     reserved (0)
+//   8       4     seq (per vehicle, counts received updates)
+//   12      2     vehicle_id_length (bytes)
+//   14      2     reserved (0)
+//   16      8     timestamp_us (cockpit receive time, steady clock)
+//   24      8     speed_mps (IEEE 754 double)
+//   32      4     gear (int32, chassis proto enum value)
+//   36      n     vehicle_id (UTF-8)
+constexpr uint8_t kTelemetryBinaryMagic[4] = {'W', 'T', 'M', '1'};
+constexpr uint8_t kTelemetryBinaryVersion = 1;
+constexpr size_t kTelemetryBinaryHeaderSize = 36;
+
+struct TelemetryHandlerConfig {
+  // Maximum pushes per second per vehicle. Updates arriving faster are
+  // coalesced: only the latest state is sent. <= 0 disables the cap.
+  double publish_rate_hz = 30.0;
+  TelemetryFormat format = TelemetryFormat::Json;
+};
+
+// ITelemetryHandler that keeps the latest state per vehicle and pushes it to
+// every subscribed UI client from a publisher thread, at most
+// publish_rate_hz times per second. processIncomingTelemetry only copies the
+// displayed fields under a lock, so the WebRTC thread is never blocked on
+// serialization or the transport.
+// Serialization reuses buffers owned by the publisher thread and does not
+// allocate once they have grown to the message size.
+class TelemetryHandlerImpl : public ITelemetryHandler {
+ public:
+  explicit TelemetryHandlerImpl(
+      const TelemetryHandlerConfig& config = TelemetryHandlerConfig());
+  ~TelemetryHandlerImpl() override;
+
+  // --- Implementation of ITelemetryHandler Interface ---
+  // Starts the publisher thread.
+  bool init(std::shared_ptr<autodev::remote::transport::ITransportServer>
+                transport_server) override;
+  void addVehicleVideoTrack(
+      const std::string& peer_id,
+      rtc::scoped_refptr<webrtc::VideoTrackInterface> track) override;
+  void processIncomingTelemetry(
+      const std::string& peer_id,
+      const autodev::remote::chassis::Chassis& telemetry_data) override;
+  void addClient(WebSocketConnectionId conn_id) override;
+  void removeClient(WebSocketConnectionId conn_id) override;
+  void notifyConnectionStatus(const std::string& peer_id,
+                              const std::string& status,
+                              const std::string& detail) override;
+  void notifyError(const std::string& source,
+                   const std::string& error_msg) override;
+  void stop() override;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  // The fields shown by the UI, copied out of the protobuf message.
+  struct TelemetrySnapshot {
+    double speed_mps = 0.0;
+    int32_t gear = 0;
+    int64_t timestamp_us = 0;
+    uint32_t seq = 0;
+  };
+
+  struct VehicleState {
+    TelemetrySnapshot latest;
+    bool dirty = false;  // Updated since the last push
+  };
+
+  // One vehicle's state queued for a push (publisher thread).
+  struct PendingPush {
+    std::string vehicle_id;
+    TelemetrySnapshot snapshot;
+    bool changed = false;  // false: only for newly subscribed clients
+  };
+
+  void publisherThreadMain();
+  // Copies what is due for publishing into pendingPushes_/clients lists;
+  // mutex_ MUST be held. Returns the number of pushes collected.
+  size_t collectPushesLocked();
+  void publishPending();
+  // Serializes one push into jsonBuffer_ or binaryBuffer_.
+  void serializeJson(const PendingPush& push);
+  void serializeBinary(const PendingPush& push);
+  void sendSerialized(WebSocketConnectionId conn_id);
+  void sendStatusMessage(std::string_view message);
+
+  const TelemetryHandlerConfig config_;
+  std::shared_ptr<autodev::remote::transport::ITransportServer>
+      transportServer_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::map<std::string, VehicleState> vehicles_;  // Guarded by mutex_
+  std::vector<WebSocketConnectionId> clients_;    // Guarded by mutex_
+  // Subscribed since the last push; they get every vehicle's state.
+  std::vector<WebSocketConnectionId> newClients_;  // Guarded by mutex_
+  bool workPending_ = false;                       // Guarded by mutex_
+  bool stopping_ = false;                          // Guarded by mutex_
+  std::thread publisherThread_;
+
+  // --- Publisher thread only (reused across pushes) ---
+  std::vector<PendingPush> pendingPushes_;
+  size_t pendingPushCount_ = 0;
+  std::vector<WebSocketConnectionId> publishClients_;
+  std::vector<WebSocketConnectionId> publishNewClients_;
+  std::string jsonBuffer_;
+  std::vector<char> binaryBuffer_;
+
+  // Prevent copying
+  TelemetryHandlerImpl(const TelemetryHandlerImpl&) = delete;
+  TelemetryHandlerImpl& operator=(const TelemetryHandlerImpl&) = delete;
+};
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // TELEMETRY_HANDLER_IMPL_H
@@ -0,0 +1,308 @@
+// Tests EvdevInputDeviceSource against virtual uinput devices: a wheel
+// (steering axis, gear and hand brake buttons) and a pedal set (throttle and
+// an inverted brake). Checks the deadzone, both calibration curves, the
+// raw range override, button actions and that commands leave at the fixed
+// send rate whether the devices are idle or flooding events.
+//
+// Needs write access to /dev/uinput (root, or the uinput group); exits with
+// 77 (skipped) without it. Build, then run, from the repository root, with
+// the generated protobuf sources in $PROTO_GEN:
+//   g++ -std=c++17 -O1 -g -I. -Icockpit_client -I"$PROTO_GEN"
+//       -o /tmp/evdev_input_device_source_test
+//       cockpit_client/drivers/tests/evdev_input_device_source_test.cc
+//       cockpit_client/drivers/evdev_input_device_source.cc
+//       cockpit_client/drivers/force_feedback_controller.cc
+//       "$PROTO_GEN"/control/proto/control_command.pb.cc
+//       "$PROTO_GEN"/control/proto/emergency_command.pb.cc
+//       "$PROTO_GEN"/chassis/proto/chassis.pb.cc -lprotobuf -lpthread
+//   sudo /tmp/evdev_input_device_source_test
+
+#include <linux/input.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "drivers/evdev_input_device_source.h"
+#include "drivers/tests/uinput_device.h"
+#include "testing/check.h"
+
+namespace {
+
+using autodev::remote::control::ControlCommand;
+using autodev::remote::control::EmergencyCommand;
+using autodev::remote::drivers::CommandSource;
+using autodev::remote::drivers::EvdevInputDeviceSource;
+using autodev::remote::drivers::ICommandSink;
+using autodev::remote::drivers::InputLatencyStats;
+using autodev::remote::testing::kSkipExitCode;
+using autodev::remote::testing::UinputDevice;
+using Clock = std::chrono::steady_clock;
+
+constexpr double kSendRateHz = 50.0;
+constexpr double kMaxSteeringAngle = 0.5;
+
+// Records every submitted command with its arrival time.
+class RecordingSink : public ICommandSink {
+ public:
+  struct Sample {
+    Clock::time_point time;
+    ControlCommand command;
+  };
+
+  bool submitControlCommand(CommandSource source,
+                            const ControlCommand& command) override {
+    CHECK(source == CommandSource::InputDevice);
+    std::lock_guard<std::mutex> lock(mutex_);
+    samples_.push_back({Clock::now(), command});
+    cv_.notify_all();
+    return true;
+  }
+
+  bool submitEmergencyCommand(CommandSource,
+                              const EmergencyCommand&) override {
+    return true;
+  }
+
+  // Waits until a command submitted from now on satisfies 'predicate'.
+  bool waitFor(const std::function<bool(const ControlCommand&)>& predicate) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    size_t next = samples_.size();
+    const auto deadline = Clock::now() + std::chrono::seconds(2);
+    while (true) {
+      for (; next < samples_.size(); ++next) {
+        if (predicate(samples_[next].command)) return true;
+      }
+      if (cv_.wait_until(lock, deadline) == std::cv_status::timeout) {
+        return false;
+      }
+    }
+  }
+
+  // Arrival times of the commands submitted during the next 'duration'.
+  std::vector<Clock::time_point> record(Clock::duration duration) {
+    size_t first;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      first = samples_.size();
+    }
+    std::this_thread::sleep_for(duration);
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Clock::time_point> times;
+    for (size_t i = first; i < samples_.size(); ++i) {
+      times.push_back(samples_[i].time);
+    }
+    return times;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<Sample> samples_;
+};
+
+bool Near(double a, double b) { return std::fabs(a - b) < 1e-9; }
+
+// The send rate is steady: the count over one second matches the rate and
+// the median interval is one period (timerfd ticks, so scheduling jitter
+// only moves single samples).
+void CheckFixedRate(const std::vector<Clock::time_point>& times,
+                    const char* phase) {
+  std::vector<double> intervals_ms;
+  for (size_t i = 1; i < times.size(); ++i) {
+    intervals_ms.push_back(
+        std::chrono::duration<double, std::milli>(times[i] - times[i - 1])
+            .count());
+  }
+  CHECK(!intervals_ms.empty());
+  std::nth_element(intervals_ms.begin(),
+                   intervals_ms.begin() + intervals_ms.size() / 2,
+                   intervals_ms.end());
+  const double median_ms = intervals_ms[intervals_ms.size() / 2];
+  std::printf("%s: %zu commands in 1 s, median interval %.2f ms\n", phase,
+              times.size(), median_ms);
+  CHECK(times.size() >= kSendRateHz * 0.8 && times.size() <= kSendRateHz * 1.2);
+  CHECK(std::fabs(median_ms - 1000.0 / kSendRateHz) < 2.0);
+}
+
+}  // namespace
+
+int main() {
+  // --- Virtual devices ---
+  std::string error;
+  UinputDevice::Options wheel_options;
+  wheel_options.name = "test wheel";
+  wheel_options.axes = {{ABS_X, 0, 1000, 500}};
+  wheel_options.keys = {BTN_TRIGGER_HAPPY1, BTN_TRIGGER_HAPPY2};
+  auto wheel = UinputDevice::Create(wheel_options, &error);
+  if (!wheel) {
+    std::printf("SKIPPED: cannot create uinput device (%s)\n", error.c_str());
+    return kSkipExitCode;
+  }
+  UinputDevice::Options pedal_options;
+  pedal_options.name = "test pedals";
+  // The brake reports 0..4095; the config overrides it with 0..1000.
+  pedal_options.axes = {{ABS_Z, 0, 1000, 0}, {ABS_RZ, 0, 4095, 1000}};
+  auto pedals = UinputDevice::Create(pedal_options, &error);
+  CHECK(pedals);
+
+  // --- Source config ---
+  InputDeviceConfig config;
+  config.send_rate_hz = kSendRateHz;
+  config.max_steering_angle = kMaxSteeringAngle;
+
+  InputAxisConfig steering;
+  steering.device_path = wheel->eventPath();
+  steering.code = ABS_X;
+  steering.target = InputAxisTarget::Steering;
+  steering.deadzone = 0.1;  // Range from the device (EVIOCGABS)
+  config.axes.push_back(steering);
+
+  InputAxisConfig throttle;
+  throttle.device_path = pedals->eventPath();
+  throttle.code = ABS_Z;
+  throttle.target = InputAxisTarget::Acceleration;
+  throttle.curve_points = {{0.0, 0.0}, {0.5, 0.2}, {1.0, 1.0}};
+  config.axes.push_back(throttle);
+
+  InputAxisConfig brake;
+  brake.device_path = pedals->eventPath();
+  brake.code = ABS_RZ;
+  brake.target = InputAxisTarget::Braking;
+  brake.raw_min = 0;
+  brake.raw_max = 1000;
+  brake.invert = true;  // Reports raw_max when released
+  brake.deadzone = 0.05;
+  brake.curve_exponent = 2.0;
+  config.axes.push_back(brake);
+
+  InputButtonConfig drive;
+  drive.device_path = wheel->eventPath();
+  drive.code = BTN_TRIGGER_HAPPY1;
+  drive.action = InputButtonAction::SetGear;
+  drive.gear = 1;
+  config.buttons.push_back(drive);
+
+  InputButtonConfig hand_brake;
+  hand_brake.device_path = wheel->eventPath();
+  hand_brake.code = BTN_TRIGGER_HAPPY2;
+  hand_brake.action = InputButtonAction::HandBrake;
+  config.buttons.push_back(hand_brake);
+
+  auto sink = std::make_shared<RecordingSink>();
+  EvdevInputDeviceSource source;
+  CHECK(source.init(sink, config));
+  CHECK(source.startPolling());
+
+  // --- Initial state (read from the devices on open) ---
+  CHECK(sink->waitFor([](const ControlCommand& c) {
+    return Near(c.steering_angle(), 0.0) && Near(c.acceleration(), 0.0) &&
+           Near(c.braking(), 0.0) && c.gear() == 0 && !c.hand_brake();
+  }));
+
+  // --- Steering deadzone: 10% of the half range around center ---
+  // 0.55 right of center: (0.55 - 0.1) / 0.9 = 0.5 of full lock.
+  CHECK(wheel->setAxis(ABS_X, 775));
+  CHECK(sink->waitFor([](const ControlCommand& c) {
+    return Near(c.steering_angle(), 0.5 * kMaxSteeringAngle);
+  }));
+  // 520 / 1000 is 0.04 right of center, inside the deadzone.
+  CHECK(wheel->setAxis(ABS_X, 520));
+  CHECK(sink->waitFor([](const ControlCommand& c) {
+    return Near(c.steering_angle(), 0.0);
+  }));
+  CHECK(wheel->setAxis(ABS_X, 0));
+  CHECK(sink->waitFor([](const ControlCommand& c) {
+    return Near(c.steering_angle(), -kMaxSteeringAngle);
+  }));
+  CHECK(wheel->setAxis(ABS_X, 500));
+
+  // --- Throttle: piecewise-linear curve ---
+  CHECK(pedals->setAxis(ABS_Z, 250));  // 0.25 -> 0.1
+  CHECK(sink->waitFor([](const ControlCommand& c) {
+    return Near(c.acceleration(), 0.1);
+  }));
+  CHECK(pedals->setAxis(ABS_Z, 750));  // 0.75 -> 0.2 + 0.8 * 0.5
+  CHECK(sink->waitFor([](const ControlCommand& c) {
+    return Near(c.acceleration(), 0.6);
+  }));
+  CHECK(pedals->setAxis(ABS_Z, 1000));
+  CHECK(sink->waitFor([](const ControlCommand& c) {
+    return Near(c.acceleration(), 1.0);
+  }));
+  CHECK(pedals->setAxis(ABS_Z, 0));
+
+  // --- Brake: configured range, inverted, deadzone, then squared ---
+  CHECK(pedals->setAxis(ABS_RZ, 475));  // (0.525 - 0.05) / 0.95 = 0.5
+  CHECK(sink->waitFor([](const ControlCommand& c) {
+    return Near(c.braking(), 0.25) && Near(c.acceleration(), 0.0);
+  }));
+  CHECK(pedals->setAxis(ABS_RZ, 970));  // 0.03 pressed, in the deadzone
+  CHECK(sink->waitFor([](const ControlCommand& c) {
+    return Near(c.braking(), 0.0);
+  }));
+  CHECK(pedals->setAxis(ABS_RZ, 475));
+  CHECK(sink->waitFor([](const ControlCommand& c) {
+    return Near(c.braking(), 0.25);
+  }));
+  // Beyond the configured range (the device allows up to 4095): clamped
+  // to fully released.
+  CHECK(pedals->setAxis(ABS_RZ, 3000));
+  CHECK(sink->waitFor([](const ControlCommand& c) {
+    return Near(c.braking(), 0.0);
+  }));
+
+  // --- Buttons ---
+  CHECK(wheel->setKey(BTN_TRIGGER_HAPPY1, true));
+  CHECK(wheel->setKey(BTN_TRIGGER_HAPPY1, false));
+  CHECK(wheel->setKey(BTN_TRIGGER_HAPPY2, true));
+  CHECK(sink->waitFor([](const ControlCommand& c) {
+    return c.gear() == 1 && c.hand_brake();
+  }));
+  CHECK(wheel->setKey(BTN_TRIGGER_HAPPY2, false));
+  CHECK(sink->waitFor([](const ControlCommand& c) {
+    return c.gear() == 1 && !c.hand_brake();  // The gear stays selected
+  }));
+
+  // --- Fixed send rate, idle devices ---
+  CheckFixedRate(sink->record(std::chrono::seconds(1)), "idle");
+
+  // --- Fixed send rate while the wheel reports at ~1 kHz ---
+  std::atomic<bool> flooding{true};
+  std::thread flood([&] {
+    int32_t value = 0;
+    while (flooding.load()) {
+      wheel->setAxis(ABS_X, value);
+      value = (value + 7) % 1001;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+  CheckFixedRate(sink->record(std::chrono::seconds(1)), "flooding");
+  flooding.store(false);
+  flood.join();
+
+  const InputLatencyStats stats = source.getLatencyStats();
+  std::printf("events read %llu, commands %llu, event-to-send mean %.0f us, "
+              "max %lld us\n",
+              static_cast<unsigned long long>(stats.events_read),
+              static_cast<unsigned long long>(stats.commands_submitted),
+              stats.mean_us, static_cast<long long>(stats.max_us));
+  CHECK(stats.events_read > 0);
+  CHECK(stats.samples > 0);
+  CHECK(stats.submit_failures == 0);
+  // Every sample waits at most one send period (plus scheduling).
+  CHECK(stats.mean_us < 2.0 * 1e6 / kSendRateHz);
+
+  source.stopPolling();
+  std::printf("evdev_input_device_source_test: OK\n");
+  return 0;
+}
@@ -0,0 +1,317 @@
+// Tests ForceFeedbackController against virtual FF-capable uinput wheels.
+// The test plays the wheel's driver: it answers the effect uploads and
+// erases the kernel forwards to the uinput fd and records what the
+// controller asked for (effects, playback, gain, autocenter). Checks:
+//   - start(): gain set, autocenter off, effects uploaded and playing;
+//   - spring / damper strength against vehicle speed (condition effects);
+//   - constant force against the steering position (FF_CONSTANT only);
+//   - the update rate limit with telemetry bursts coalesced;
+//   - forces released when telemetry stops, and effects erased by stop().
+//
+// Needs write access to /dev/uinput (root, or the uinput group); exits with
+// 77 (skipped) without it. Build, then run, from the repository root:
+//   g++ -std=c++17 -O1 -g -I. -Icockpit_client
+//       -o /tmp/force_feedback_controller_test
+//       cockpit_client/drivers/tests/force_feedback_controller_test.cc
+//       cockpit_client/drivers/force_feedback_controller.cc -lpthread
+//   sudo /tmp/force_feedback_controller_test
+
+#include <linux/input.h>
+#include <linux/uinput.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "drivers/force_feedback_controller.h"
+#include "drivers/tests/uinput_device.h"
+#include "testing/check.h"
+
+namespace {
+
+using autodev::remote::drivers::ForceFeedbackController;
+using autodev::remote::drivers::ForceFeedbackStats;
+using autodev::remote::testing::kSkipExitCode;
+using autodev::remote::testing::UinputDevice;
+using Clock = std::chrono::steady_clock;
+
+// What the controller has set up on the virtual wheel.
+struct WheelState {
+  std::map<int16_t, ff_effect> effects;  // Uploaded, by id
+  std::map<int16_t, int32_t> playing;    // Last playback value, by id
+  int uploads = 0;
+  int erases = 0;
+  int32_t gain = -1;
+  int32_t autocenter = -1;
+
+  // Uploaded effect of 'type', or nullptr.
+  const ff_effect* find(uint16_t type) const {
+    for (const auto& entry : effects) {
+      if (entry.second.type == type) return &entry.second;
+    }
+    return nullptr;
+  }
+};
+
+// Services the force feedback requests of a uinput device, as a wheel's
+// driver would, on its own thread.
+class WheelEmulator {
+ public:
+  explicit WheelEmulator(UinputDevice* device)
+      : device_(device), thread_(&WheelEmulator::run, this) {}
+
+  ~WheelEmulator() {
+    running_.store(false);
+    thread_.join();
+  }
+
+  // Waits until 'predicate' holds for the wheel state.
+  bool waitFor(const std::function<bool(const WheelState&)>& predicate,
+               std::chrono::milliseconds timeout =
+                   std::chrono::milliseconds(2000)) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, timeout, [&] { return predicate(state_); });
+  }
+
+  WheelState state() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return state_;
+  }
+
+ private:
+  void run() {
+    const int fd = device_->fd();
+    while (running_.load()) {
+      pollfd pfd{fd, POLLIN, 0};
+      if (poll(&pfd, 1, 20) <= 0) continue;
+      input_event event{};
+      while (read(fd, &event, sizeof(event)) ==
+             static_cast<ssize_t>(sizeof(event))) {
+        handle(fd, event);
+      }
+    }
+  }
+
+  void handle(int fd, const input_event& event) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (event.type == EV_UINPUT && event.code == UI_FF_UPLOAD) {
+      uinput_ff_upload upload{};
+      upload.request_id = static_cast<uint32_t>(event.value);
+      CHECK(ioctl(fd, UI_BEGIN_FF_UPLOAD, &upload) == 0);
+      state_.effects[upload.effect.id] = upload.effect;
+      ++state_.uploads;
+      upload.retval = 0;
+      CHECK(ioctl(fd, UI_END_FF_UPLOAD, &upload) == 0);
+    } else if (event.type == EV_UINPUT && event.code == UI_FF_ERASE) {
+      uinput_ff_erase erase{};
+      erase.request_id = static_cast<uint32_t>(event.value);
+      CHECK(ioctl(fd, UI_BEGIN_FF_ERASE, &erase) == 0);
+      state_.effects.erase(static_cast<int16_t>(erase.effect_id));
+      state_.playing.erase(static_cast<int16_t>(erase.effect_id));
+      ++state_.erases;
+      erase.retval = 0;
+      CHECK(ioctl(fd, UI_END_FF_ERASE, &erase) == 0);
+    } else if (event.type == EV_FF) {
+      if (event.code == FF_GAIN) {
+        state_.gain = event.value;
+      } else if (event.code == FF_AUTOCENTER) {
+        state_.autocenter = event.value;
+      } else {
+        state_.playing[static_cast<int16_t>(event.code)] = event.value;
+      }
+    } else {
+      return;
+    }
+    cv_.notify_all();
+  }
+
+  UinputDevice* const device_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  WheelState state_;  // Guarded by mutex_
+  std::atomic<bool> running_{true};
+  std::thread thread_;
+
+  // Prevent copying
+  WheelEmulator(const WheelEmulator&) = delete;
+  WheelEmulator& operator=(const WheelEmulator&) = delete;
+};
+
+// Effect level / coefficient the controller sends for a 0..1 strength.
+int16_t Level(double strength) {
+  return static_cast<int16_t>(std::lround(strength * 0x7fff));
+}
+
+int16_t Coefficient(const WheelState& state, uint16_t type) {
+  const ff_effect* effect = state.find(type);
+  return effect ? effect->u.condition[0].right_coeff : -1;
+}
+
+std::unique_ptr<UinputDevice> CreateWheel(const char* name,
+                                          std::initializer_list<uint16_t> ff,
+                                          std::string* error) {
+  UinputDevice::Options options;
+  options.name = name;
+  options.axes = {{ABS_X, -32768, 32767, 0}};
+  options.ff_effects = ff;
+  options.ff_effects_max = 4;
+  return UinputDevice::Create(options, error);
+}
+
+// A wheel with spring and damper support (most direct-drive and belt
+// wheels).
+void TestConditionEffects(UinputDevice* device) {
+  WheelEmulator wheel(device);
+
+  ForceFeedbackConfig config;
+  config.gain = 0.5;
+  config.update_rate_hz = 20.0;
+  config.telemetry_timeout_ms = 300;
+  ForceFeedbackController controller(config);
+  CHECK(controller.start(device->eventPath()));
+
+  // Effects start at zero strength, playing; gain set, autocenter off.
+  CHECK(wheel.waitFor([](const WheelState& s) {
+    return s.find(FF_SPRING) && s.find(FF_DAMPER) && s.playing.size() == 2;
+  }));
+  WheelState state = wheel.state();
+  CHECK(state.gain == static_cast<int32_t>(0.5 * 0xffff));
+  CHECK(state.autocenter == 0);
+  CHECK(Coefficient(state, FF_SPRING) == 0);
+  CHECK(Coefficient(state, FF_DAMPER) == 0);
+  for (const auto& entry : state.playing) CHECK(entry.second == 1);
+
+  // Standstill: centering_at_standstill, no damping.
+  controller.updateVehicleState(0.0, 0.0);
+  CHECK(wheel.waitFor([&](const WheelState& s) {
+    return Coefficient(s, FF_SPRING) ==
+           Level(config.centering_at_standstill);
+  }));
+  CHECK(Coefficient(wheel.state(), FF_DAMPER) == 0);
+
+  // Half of full_speed_mps: halfway between the spring strengths.
+  controller.updateVehicleState(config.full_speed_mps / 2, 0.3);
+  CHECK(wheel.waitFor([&](const WheelState& s) {
+    return Coefficient(s, FF_SPRING) ==
+               Level((config.centering_at_standstill +
+                      config.centering_at_speed) / 2) &&
+           Coefficient(s, FF_DAMPER) == Level(config.damping_at_speed / 2);
+  }));
+
+  // Above full_speed_mps: saturated.
+  controller.updateVehicleState(config.full_speed_mps * 2, 0.0);
+  CHECK(wheel.waitFor([&](const WheelState& s) {
+    return Coefficient(s, FF_SPRING) == Level(config.centering_at_speed) &&
+           Coefficient(s, FF_DAMPER) == Level(config.damping_at_speed);
+  }));
+
+  // A telemetry burst (200 updates over ~200 ms) is coalesced down to
+  // update_rate_hz: at most 20 Hz * 0.2 s plus the edges, per effect.
+  const ForceFeedbackStats before = controller.getStats();
+  const Clock::time_point burst_start = Clock::now();
+  for (int i = 0; i < 200; ++i) {
+    controller.updateVehicleState((i % 2) ? 0.0 : config.full_speed_mps, 0.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const double burst_s =
+      std::chrono::duration<double>(Clock::now() - burst_start).count();
+  const ForceFeedbackStats after = controller.getStats();
+  const uint64_t effect_updates = after.effect_updates - before.effect_updates;
+  std::printf("burst: 200 updates in %.0f ms -> %llu effect updates, "
+              "%llu coalesced\n",
+              burst_s * 1000.0,
+              static_cast<unsigned long long>(effect_updates),
+              static_cast<unsigned long long>(after.coalesced -
+                                              before.coalesced));
+  CHECK(after.telemetry_updates - before.telemetry_updates == 200);
+  CHECK(effect_updates <= 2 * (burst_s * config.update_rate_hz + 2));
+  CHECK(after.coalesced > before.coalesced);
+
+  // Telemetry stops: the forces are released after telemetry_timeout_ms.
+  const Clock::time_point last_telemetry = Clock::now();
+  controller.updateVehicleState(config.full_speed_mps, 0.0);
+  CHECK(wheel.waitFor([&](const WheelState& s) {
+    return Coefficient(s, FF_SPRING) == Level(config.centering_at_speed);
+  }));
+  CHECK(wheel.waitFor([](const WheelState& s) {
+    return Coefficient(s, FF_SPRING) == 0 && Coefficient(s, FF_DAMPER) == 0;
+  }));
+  const double released_after_ms = std::chrono::duration<double, std::milli>(
+                                       Clock::now() - last_telemetry)
+                                       .count();
+  std::printf("released %.0f ms after the last telemetry\n",
+              released_after_ms);
+  CHECK(released_after_ms >= config.telemetry_timeout_ms);
+
+  // stop() removes both effects.
+  controller.stop();
+  CHECK(wheel.waitFor([](const WheelState& s) {
+    return s.effects.empty() && s.erases == 2;
+  }));
+}
+
+// A wheel with only FF_CONSTANT (e.g. older gear-driven wheels): a constant
+// force against the steering position replaces the spring.
+void TestConstantForce(UinputDevice* device) {
+  WheelEmulator wheel(device);
+
+  ForceFeedbackConfig config;
+  config.update_rate_hz = 100.0;
+  ForceFeedbackController controller(config);
+  CHECK(controller.start(device->eventPath()));
+  CHECK(wheel.waitFor([](const WheelState& s) {
+    return s.find(FF_CONSTANT) && s.playing.size() == 1;
+  }));
+  CHECK(!wheel.state().find(FF_SPRING));
+  CHECK(wheel.state().gain == -1);  // No FF_GAIN support: not written
+
+  auto constant_level = [](const WheelState& s) {
+    const ff_effect* effect = s.find(FF_CONSTANT);
+    return effect ? effect->u.constant.level : INT16_MIN;
+  };
+  // Steered right at full speed: pushes left with the full spring strength.
+  controller.updateVehicleState(config.full_speed_mps, 0.5);
+  CHECK(wheel.waitFor([&](const WheelState& s) {
+    return constant_level(s) == Level(-0.5 * config.centering_at_speed);
+  }));
+  controller.updateVehicleState(0.0, -1.0);
+  CHECK(wheel.waitFor([&](const WheelState& s) {
+    return constant_level(s) == Level(config.centering_at_standstill);
+  }));
+  controller.stop();
+  CHECK(wheel.waitFor([](const WheelState& s) { return s.effects.empty(); }));
+}
+
+}  // namespace
+
+int main() {
+  std::string error;
+  auto condition_wheel = CreateWheel(
+      "test ff wheel",
+      {FF_SPRING, FF_DAMPER, FF_CONSTANT, FF_GAIN, FF_AUTOCENTER}, &error);
+  if (!condition_wheel) {
+    std::printf("SKIPPED: cannot create uinput device (%s)\n", error.c_str());
+    return kSkipExitCode;
+  }
+  TestConditionEffects(condition_wheel.get());
+  condition_wheel.reset();
+
+  auto constant_wheel =
+      CreateWheel("test ff constant wheel", {FF_CONSTANT}, &error);
+  CHECK(constant_wheel);
+  TestConstantForce(constant_wheel.get());
+
+  std::printf("force_feedback_controller_test: OK\n");
+  return 0;
+}
@@ -0,0 +1,188 @@
+#ifndef UINPUT_DEVICE_H
+#define UINPUT_DEVICE_H
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/uinput.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Virtual evdev devices for the input device tests (Linux uinput, kernel
+// 4.5+). Needs write access to /dev/uinput; tests exit with
+// kSkipExitCode when it is unavailable (e.g. in containers), which ctest
+// reports as skipped with SKIP_RETURN_CODE 77.
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace testing {
+
+constexpr int kSkipExitCode = 77;
+
+class UinputDevice {
+ public:
+  struct Axis {
+    uint16_t code = 0;  // ABS_*
+    int32_t minimum = 0;
+    int32_t maximum = 0;
+    int32_t value = 0;  // Initial value
+  };
+
+  struct Options {
+    std::string name;
+    std::vector<Axis> axes;
+    std::vector<uint16_t> keys;        // BTN_* / KEY_*
+    std::vector<uint16_t> ff_effects;  // FF_* types (and FF_GAIN)
+    uint32_t ff_effects_max = 0;       // Effect slots, with ff_effects
+  };
+
+  // Creates the device and waits for its /dev/input/event* node. Returns
+  // nullptr and sets *error on failure.
+  static std::unique_ptr<UinputDevice> Create(const Options& options,
+                                              std::string* error) {
+    std::unique_ptr<UinputDevice> device(new UinputDevice());
+    device->fd_ = open("/dev/uinput", O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (device->fd_ < 0) return Fail("open /dev/uinput", error);
+    const int fd = device->fd_;
+
+    if (!options.axes.empty() && ioctl(fd, UI_SET_EVBIT, EV_ABS) != 0) {
+      return Fail("UI_SET_EVBIT EV_ABS", error);
+    }
+    for (const Axis& axis : options.axes) {
+      uinput_abs_setup setup{};
+      setup.code = axis.code;
+      setup.absinfo.minimum = axis.minimum;
+      setup.absinfo.maximum = axis.maximum;
+      setup.absinfo.value = axis.value;
+      if (ioctl(fd, UI_SET_ABSBIT, axis.code) != 0 ||
+          ioctl(fd, UI_ABS_SETUP, &setup) != 0) {
+        return Fail("UI_ABS_SETUP", error);
+      }
+    }
+    if (!options.keys.empty() && ioctl(fd, UI_SET_EVBIT, EV_KEY) != 0) {
+      return Fail("UI_SET_EVBIT EV_KEY", error);
+    }
+    for (uint16_t key : options.keys) {
+      if (ioctl(fd, UI_SET_KEYBIT, key) != 0) {
+        return Fail("UI_SET_KEYBIT", error);
+      }
+    }
+    if (!options.ff_effects.empty() && ioctl(fd, UI_SET_EVBIT, EV_FF) != 0) {
+      return Fail("UI_SET_EVBIT EV_FF", error);
+    }
+    for (uint16_t effect : options.ff_effects) {
+      if (ioctl(fd, UI_SET_FFBIT, effect) != 0) {
+        return Fail("UI_SET_FFBIT", error);
+      }
+    }
+
+    uinput_setup setup{};
+    setup.id.bustype = BUS_VIRTUAL;
+    setup.id.vendor = 0x1234;
+    setup.id.product = 0x5678;
+    std::strncpy(setup.name, options.name.c_str(), UINPUT_MAX_NAME_SIZE - 1);
+    setup.ff_effects_max = options.ff_effects_max;
+    if (ioctl(fd, UI_DEV_SETUP, &setup) != 0) {
+      return Fail("UI_DEV_SETUP", error);
+    }
+    if (ioctl(fd, UI_DEV_CREATE) != 0) return Fail("UI_DEV_CREATE", error);
+    device->created_ = true;
+
+    if (!device->findEventNode(error)) return nullptr;
+    return device;
+  }
+
+  ~UinputDevice() {
+    if (fd_ < 0) return;
+    if (created_) ioctl(fd_, UI_DEV_DESTROY);
+    close(fd_);
+  }
+
+  // /dev/input/eventN of the device.
+  const std::string& eventPath() const { return eventPath_; }
+
+  // The uinput fd: FF requests and played effects are read from it.
+  int fd() const { return fd_; }
+
+  bool emit(uint16_t type, uint16_t code, int32_t value) {
+    input_event event{};
+    event.type = type;
+    event.code = code;
+    event.value = value;
+    return write(fd_, &event, sizeof(event)) ==
+           static_cast<ssize_t>(sizeof(event));
+  }
+
+  // Sets an axis and ends the frame (SYN_REPORT).
+  bool setAxis(uint16_t code, int32_t value) {
+    return emit(EV_ABS, code, value) && sync();
+  }
+
+  bool setKey(uint16_t code, bool pressed) {
+    return emit(EV_KEY, code, pressed ? 1 : 0) && sync();
+  }
+
+  bool sync() { return emit(EV_SYN, SYN_REPORT, 0); }
+
+ private:
+  UinputDevice() = default;
+
+  static std::unique_ptr<UinputDevice> Fail(const char* what,
+                                            std::string* error) {
+    *error = std::string(what) + ": " + std::strerror(errno);
+    return nullptr;
+  }
+
+  // The event node is named in sysfs under the input device; udev may take
+  // a moment to create (and grant access to) the /dev node.
+  bool findEventNode(std::string* error) {
+    char sysname[64] = {};
+    if (ioctl(fd_, UI_GET_SYSNAME(sizeof(sysname)), sysname) < 0) {
+      *error = std::string("UI_GET_SYSNAME: ") + std::strerror(errno);
+      return false;
+    }
+    const std::string sys_dir =
+        std::string("/sys/devices/virtual/input/") + sysname;
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (std::chrono::steady_clock::now() < deadline) {
+      if (DIR* dir = opendir(sys_dir.c_str())) {
+        while (dirent* entry = readdir(dir)) {
+          if (std::strncmp(entry->d_name, "event", 5) == 0) {
+            eventPath_ = std::string("/dev/input/") + entry->d_name;
+          }
+        }
+        closedir(dir);
+      }
+      if (!eventPath_.empty() && access(eventPath_.c_str(), R_OK) == 0) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    *error = "no readable event node under " + sys_dir;
+    return false;
+  }
+
+  int fd_ = -1;
+  bool created_ = false;
+  std::string eventPath_;
+
+  // Prevent copying
+  UinputDevice(const UinputDevice&) = delete;
+  UinputDevice& operator=(const UinputDevice&) = delete;
+};
+
+}  // namespace testing
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // UINPUT_DEVICE_H
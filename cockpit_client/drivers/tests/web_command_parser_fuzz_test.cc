@@ -0,0 +1,301 @@
+// Fuzz test for WebCommandParser, which parses untrusted browser input in
+// place inside the transport's buffer.
+//
+// Each input is copied into a heap buffer of exactly its size, so under
+// AddressSanitizer any read or write past the message is reported. On top of
+// memory safety, every parse is checked for:
+//   - a consistent result: error() is empty exactly when parse() succeeds,
+//     and an Emergency / TakeControl result carries its required field;
+//   - views (emergency_reason, vehicle_id) lying inside the buffer, since
+//     decoding in place must never produce bytes outside the message;
+//   - determinism: parsing a fresh copy gives the same result.
+//
+// Two ways to run it, from the repository root:
+//
+// Standalone (the seed checks below, then deterministic mutations of the
+// seeds; the optional argument is the number of mutations):
+//   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -I. -Icockpit_client
+//       -o /tmp/web_command_parser_fuzz_test
+//       cockpit_client/drivers/tests/web_command_parser_fuzz_test.cc
+//       cockpit_client/drivers/web_command_parser.cc
+//   /tmp/web_command_parser_fuzz_test 200000
+//
+// Under libFuzzer (coverage-guided, runs until stopped):
+//   clang++ -std=c++17 -O1 -g -fsanitize=fuzzer,address,undefined
+//       -DWEB_COMMAND_PARSER_LIBFUZZER -I. -Icockpit_client
+//       -o /tmp/web_command_parser_fuzzer
+//       cockpit_client/drivers/tests/web_command_parser_fuzz_test.cc
+//       cockpit_client/drivers/web_command_parser.cc
+//   /tmp/web_command_parser_fuzzer
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "drivers/web_command_parser.h"
+#include "testing/check.h"
+
+namespace {
+
+using autodev::remote::drivers::WebCommand;
+using autodev::remote::drivers::WebCommandKind;
+using autodev::remote::drivers::WebCommandParser;
+using autodev::remote::drivers::kWebControlAcceleration;
+using autodev::remote::drivers::kWebControlBraking;
+using autodev::remote::drivers::kWebControlGear;
+using autodev::remote::drivers::kWebControlHandBrake;
+using autodev::remote::drivers::kWebControlSteeringAngle;
+
+// A parse of one copy of the input, with the views turned into strings so it
+// can be compared with the parse of another copy.
+struct Outcome {
+  bool ok = false;
+  std::string error;
+  WebCommand command;
+  std::string emergency_reason;
+  std::string vehicle_id;
+};
+
+bool ViewInside(std::string_view view, const char* data, size_t size) {
+  if (view.empty()) return true;
+  return view.data() >= data && view.data() + view.size() <= data + size;
+}
+
+Outcome ParseCopy(const uint8_t* input, size_t size) {
+  // Exactly 'size' bytes (no terminator, no slack) so overruns are caught.
+  std::unique_ptr<char[]> buffer(new char[size == 0 ? 1 : size]);
+  if (size != 0) std::memcpy(buffer.get(), input, size);
+
+  WebCommandParser parser;
+  Outcome outcome;
+  outcome.ok = parser.parse(buffer.get(), size, &outcome.command);
+  outcome.error = parser.error();
+
+  const WebCommand& command = outcome.command;
+  CHECK(outcome.ok == outcome.error.empty());
+  if (outcome.ok) {
+    CHECK(ViewInside(command.emergency_reason, buffer.get(), size));
+    CHECK(ViewInside(command.vehicle_id, buffer.get(), size));
+    if (command.kind == WebCommandKind::Emergency) {
+      CHECK(command.has_emergency_type);
+    }
+    if (command.kind == WebCommandKind::TakeControl) {
+      CHECK(!command.vehicle_id.empty());
+    }
+  }
+  outcome.emergency_reason = std::string(command.emergency_reason);
+  outcome.vehicle_id = std::string(command.vehicle_id);
+  return outcome;
+}
+
+bool SameNumber(double a, double b) {
+  return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+void CheckInput(const uint8_t* input, size_t size) {
+  const Outcome first = ParseCopy(input, size);
+  const Outcome second = ParseCopy(input, size);
+  CHECK(first.ok == second.ok);
+  CHECK(first.error == second.error);
+  if (!first.ok) return;
+  const WebCommand& a = first.command;
+  const WebCommand& b = second.command;
+  CHECK(a.kind == b.kind);
+  CHECK(a.control_fields == b.control_fields);
+  CHECK(SameNumber(a.acceleration, b.acceleration));
+  CHECK(SameNumber(a.braking, b.braking));
+  CHECK(SameNumber(a.steering_angle, b.steering_angle));
+  CHECK(a.gear == b.gear);
+  CHECK(a.hand_brake == b.hand_brake);
+  CHECK(a.has_emergency_type == b.has_emergency_type);
+  CHECK(a.emergency_type == b.emergency_type);
+  CHECK(first.emergency_reason == second.emergency_reason);
+  CHECK(first.vehicle_id == second.vehicle_id);
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  CheckInput(data, size);
+  return 0;
+}
+
+#if !defined(WEB_COMMAND_PARSER_LIBFUZZER)
+
+namespace {
+
+// Messages as display/src/app.js sends them, plus edge cases of the grammar.
+const char* const kSeeds[] = {
+    "{\"type\":\"control\",\"data\":{\"acceleration\":0.25,\"braking\":0,"
+    "\"steering_angle\":-12.5,\"gear\":1,\"hand_brake\":false}}",
+    "{\"type\":\"emergency\",\"data\":{\"type\":1,"
+    "\"reason\":\"Manual Emergency Stop Button\"}}",
+    "{\"type\":\"take_control\",\"data\":{\"vehicle_id\":\"vehicle-042\"}}",
+    "{\"type\":\"release_control\"}",
+    "{\"type\":\"join\",\"room\":\"r1\",\"extra\":[1,{\"a\":[null,true]}]}",
+    "{\"data\":{\"reason\":\"a\\\"b\\\\c\\u00e9\\ud83d\\ude97\",\"type\":2},"
+    "\"type\":\"emergency\"}",
+    " { \"type\" : \"control\" , \"data\" : { \"gear\" : -1 } } ",
+    "{}",
+};
+
+// Known answers: what the seeds and a few malformed messages must parse to.
+void CheckKnownAnswers() {
+  WebCommandParser parser;
+  WebCommand command;
+  auto parse = [&](const char* text) {
+    static std::string buffer;
+    buffer = text;
+    return parser.parse(buffer.data(), buffer.size(), &command);
+  };
+
+  CHECK(parse(kSeeds[0]));
+  CHECK(command.kind == WebCommandKind::Control);
+  CHECK(command.control_fields ==
+        (kWebControlAcceleration | kWebControlBraking |
+         kWebControlSteeringAngle | kWebControlGear | kWebControlHandBrake));
+  CHECK(command.acceleration == 0.25);
+  CHECK(command.braking == 0.0);
+  CHECK(command.steering_angle == -12.5);
+  CHECK(command.gear == 1);
+  CHECK(!command.hand_brake);
+
+  CHECK(parse(kSeeds[1]));
+  CHECK(command.kind == WebCommandKind::Emergency);
+  CHECK(command.emergency_type == 1);
+  CHECK(command.emergency_reason == "Manual Emergency Stop Button");
+
+  CHECK(parse(kSeeds[2]));
+  CHECK(command.kind == WebCommandKind::TakeControl);
+  CHECK(command.vehicle_id == "vehicle-042");
+
+  CHECK(parse(kSeeds[3]));
+  CHECK(command.kind == WebCommandKind::ReleaseControl);
+
+  CHECK(parse(kSeeds[4]));
+  CHECK(command.kind == WebCommandKind::Other);
+
+  // Escapes are decoded in place, including a surrogate pair.
+  CHECK(parse(kSeeds[5]));
+  CHECK(command.kind == WebCommandKind::Emergency);
+  CHECK(command.emergency_type == 2);
+  CHECK(command.emergency_reason == "a\"b\\c\xc3\xa9\xf0\x9f\x9a\x97");
+
+  CHECK(parse(kSeeds[6]));
+  CHECK(command.control_fields == kWebControlGear);
+  CHECK(command.gear == -1);
+
+  std::string deep = "{\"x\":";
+  for (int i = 0; i < WebCommandParser::kMaxDepth + 1; ++i) deep += '[';
+  for (int i = 0; i < WebCommandParser::kMaxDepth + 1; ++i) deep += ']';
+  deep += '}';
+
+  const char* const kMalformed[] = {
+      "",
+      "[]",
+      "{\"type\":\"control\"} x",
+      "{\"type\":\"control\",\"data\":{\"gear\":1.5}}",
+      "{\"type\":\"control\",\"data\":{\"acceleration\":\"1\"}}",
+      "{\"type\":\"control\",\"data\":{\"hand_brake\":1}}",
+      "{\"type\":\"control\",\"data\":{\"gear\":1e10}}",
+      "{\"type\":\"emergency\",\"data\":{\"reason\":\"x\"}}",
+      "{\"type\":\"emergency\"}",
+      "{\"type\":\"take_control\",\"data\":{}}",
+      "{\"type\":\"x\",\"data\":{\"reason\":\"\\ud83d\"}}",
+      "{\"type\":\"x\",\"data\":{\"reason\":\"\\q\"}}",
+      "{\"type\":\"x\",\"data\":{\"reason\":\"\x01\"}}",
+      "{\"type\":\"control\",\"data\":{\"gear\":1}",
+      "{\"type\":\"control\",\"data\":{\"gear\":-}}",
+      deep.c_str(),
+  };
+  for (const char* input : kMalformed) {
+    if (parse(input)) {
+      std::fprintf(stderr, "accepted malformed message: %s\n", input);
+      std::abort();
+    }
+    CHECK(*parser.error() != '\0');
+  }
+}
+
+// One random edit of 'input': flip, insert, delete, duplicate a span, or
+// splice in part of another seed. Biased towards JSON punctuation so the
+// mutations reach deep into the grammar.
+void Mutate(std::mt19937& rng, std::string* input) {
+  static const char kAlphabet[] = "{}[]\":,\\u0123456789.-+eE tfnrl \x01\xff";
+  auto pick = [&](size_t n) {
+    return n == 0 ? size_t{0}
+                  : std::uniform_int_distribution<size_t>(0, n - 1)(rng);
+  };
+  const size_t size = input->size();
+  switch (pick(5)) {
+    case 0:
+      if (size != 0) {
+        (*input)[pick(size)] = kAlphabet[pick(sizeof(kAlphabet) - 1)];
+      }
+      break;
+    case 1:
+      input->insert(input->begin() + pick(size + 1),
+                    kAlphabet[pick(sizeof(kAlphabet) - 1)]);
+      break;
+    case 2:
+      if (size != 0) input->erase(pick(size), 1 + pick(8));
+      break;
+    case 3:
+      if (size != 0) {
+        const size_t begin = pick(size);
+        const std::string span = input->substr(begin, 1 + pick(16));
+        input->insert(pick(input->size() + 1), span);
+      }
+      break;
+    default: {
+      const std::string other = kSeeds[pick(std::size(kSeeds))];
+      const size_t begin = pick(other.size());
+      input->insert(pick(size + 1), other.substr(begin, 1 + pick(32)));
+      break;
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const uint64_t mutations =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+
+  CheckKnownAnswers();
+
+  std::mt19937 rng(20251017);  // Fixed seed: every run is reproducible
+  std::vector<std::string> corpus(std::begin(kSeeds), std::end(kSeeds));
+  uint64_t parsed_ok = 0;
+  for (uint64_t i = 0; i < mutations; ++i) {
+    std::string input = corpus[i % corpus.size()];
+    const int edits = 1 + static_cast<int>(rng() % 4);
+    for (int e = 0; e < edits; ++e) Mutate(rng, &input);
+    if (input.size() > 4096) input.resize(4096);
+    CheckInput(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+
+    // Keep mutants that still parse as seeds for further mutation.
+    std::string copy = input;
+    WebCommandParser parser;
+    WebCommand command;
+    if (parser.parse(copy.data(), copy.size(), &command)) {
+      ++parsed_ok;
+      if (corpus.size() < 256) corpus.push_back(input);
+    }
+  }
+  std::printf("web_command_parser_fuzz_test: %llu mutations (%llu valid), "
+              "OK\n",
+              static_cast<unsigned long long>(mutations),
+              static_cast<unsigned long long>(parsed_ok));
+  return 0;
+}
+
+#endif  // !WEB_COMMAND_PARSER_LIBFUZZER
@@ -0,0 +1,264 @@
+#include "drivers/vehicle_session_manager.h"
+
+#include <iostream>
+#include <utility>
+
+#include "proto/remote_command.pb.h"  // SessionRequest
+
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+VehicleSessionManager::VehicleSessionManager(
+    std::shared_ptr<autodev::remote::webrtc::WebrtcManager> webrtc_manager,
+    std::shared_ptr<CommandArbiter> command_arbiter,
+    const VehicleSessionConfig& config)
+    : webrtcManager_(std::move(webrtc_manager)),
+      commandArbiter_(std::move(command_arbiter)),
+      config_(config) {
+  for (const std::string& vehicle_id : config_.vehicle_ids) {
+    sessions_[vehicle_id] = SessionState{};
+  }
+  std::cout << "VehicleSessionManager created for " << sessions_.size()
+            << " vehicle(s)." << std::endl;
+}
+
+VehicleSessionManager::~VehicleSessionManager() { stop(); }
+
+void VehicleSessionManager::onSessionChanged(OnSessionChangedHandler handler) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  onSessionChangedHandler_ = std::move(handler);
+}
+
+bool VehicleSessionManager::start() {
+  if (!webrtcManager_ || !commandArbiter_) {
+    std::cerr << "VehicleSessionManager: Dependencies not set." << std::endl;
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+      std::cerr << "VehicleSessionManager: Already running." << std::endl;
+      return false;
+    }
+    running_ = true;
+    retryThread_ = std::thread(&VehicleSessionManager::retryThreadMain, this);
+  }
+
+  // No vehicle gets commands until one is taken over.
+  commandArbiter_->setTargetPeer("");
+  for (const std::string& vehicle_id : config_.vehicle_ids) {
+    if (!webrtcManager_->connectToPeer(vehicle_id)) {
+      std::cerr << "VehicleSessionManager: Failed to connect to vehicle "
+                << vehicle_id << "." << std::endl;
+    }
+  }
+  return true;
+}
+
+void VehicleSessionManager::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) return;
+    running_ = false;
+  }
+  cv_.notify_all();
+  if (retryThread_.joinable()) retryThread_.join();
+}
+
+// --- Connection events (called from WebRTC threads) ---
+
+void VehicleSessionManager::handlePeerConnected(const std::string& peer_id) {
+  std::lock_guard<std::mutex> switch_lock(switchMutex_);
+  bool take_over = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(peer_id);
+    if (it == sessions_.end()) {
+      std::cerr << "VehicleSessionManager: Peer " << peer_id
+                << " is not a configured vehicle; no session." << std::endl;
+      return;
+    }
+    it->second.connected = true;
+    it->second.mode_pending = true;
+    if (!initialTakeOverDone_ && peer_id == config_.initial_vehicle_id &&
+        controlledVehicle_.empty()) {
+      take_over = true;
+    }
+    initialTakeOverDone_ =
+        initialTakeOverDone_ || peer_id == config_.initial_vehicle_id;
+  }
+  if (take_over) {
+    takeControlLocked(peer_id);  // Also sends the pending modes
+  } else {
+    sendPendingModes();
+  }
+}
+
+void VehicleSessionManager::handlePeerDisconnected(const std::string& peer_id) {
+  std::lock_guard<std::mutex> switch_lock(switchMutex_);
+  bool released = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(peer_id);
+    if (it == sessions_.end()) return;
+    it->second.connected = false;
+    it->second.mode_pending = false;
+    if (controlledVehicle_ == peer_id) {
+      controlledVehicle_.clear();
+      released = true;
+    }
+  }
+  if (released) {
+    // Control is not handed back on reconnect; the operator takes over
+    // again.
+    commandArbiter_->setTargetPeer("");
+    std::cerr << "VehicleSessionManager: Controlled vehicle " << peer_id
+              << " disconnected; no vehicle is controlled." << std::endl;
+    notifySessionChanged(peer_id, false);
+  }
+}
+
+// --- Implementation of ISessionControl Interface ---
+
+bool VehicleSessionManager::takeControl(const std::string& vehicle_id) {
+  std::lock_guard<std::mutex> switch_lock(switchMutex_);
+  return takeControlLocked(vehicle_id);
+}
+
+void VehicleSessionManager::releaseControl() {
+  std::lock_guard<std::mutex> switch_lock(switchMutex_);
+  std::string previous;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (controlledVehicle_.empty()) return;
+    previous.swap(controlledVehicle_);
+    sessions_[previous].mode_pending = true;
+  }
+  commandArbiter_->setTargetPeer("");
+  sendPendingModes();
+  std::cout << "VehicleSessionManager: Released control of " << previous
+            << "." << std::endl;
+  notifySessionChanged(previous, false);
+}
+
+std::string VehicleSessionManager::getControlledVehicle() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return controlledVehicle_;
+}
+
+std::vector<VehicleSession> VehicleSessionManager::getSessions() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<VehicleSession> sessions;
+  sessions.reserve(sessions_.size());
+  for (const auto& [vehicle_id, state] : sessions_) {
+    sessions.push_back(VehicleSession{vehicle_id, state.connected,
+                                      vehicle_id == controlledVehicle_});
+  }
+  return sessions;
+}
+
+// --- Internal helpers ---
+
+bool VehicleSessionManager::takeControlLocked(const std::string& vehicle_id) {
+  std::string previous;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sessions_.find(vehicle_id);
+    if (it == sessions_.end() || !it->second.connected) {
+      std::cerr << "VehicleSessionManager: Cannot take control of "
+                << vehicle_id << ": unknown or not connected." << std::endl;
+      return false;
+    }
+    if (controlledVehicle_ == vehicle_id) return true;
+    previous = controlledVehicle_;
+    controlledVehicle_ = vehicle_id;
+    it->second.mode_pending = true;
+    if (!previous.empty()) sessions_[previous].mode_pending = true;
+  }
+
+  // From here on no command reaches the previous vehicle. Its preview
+  // request and the new vehicle's control request go out right after.
+  commandArbiter_->setTargetPeer(vehicle_id);
+  sendPendingModes();
+
+  std::cout << "VehicleSessionManager: Took control of " << vehicle_id;
+  if (!previous.empty()) std::cout << " (" << previous << " to preview)";
+  std::cout << "." << std::endl;
+  if (!previous.empty()) notifySessionChanged(previous, false);
+  notifySessionChanged(vehicle_id, true);
+  return true;
+}
+
+void VehicleSessionManager::sendPendingModes() {
+  std::vector<std::pair<std::string, bool>> pending;  // Vehicle, control
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [vehicle_id, state] : sessions_) {
+      if (state.connected && state.mode_pending) {
+        pending.emplace_back(vehicle_id, vehicle_id == controlledVehicle_);
+      }
+    }
+  }
+  // Modes only change under switchMutex_, which the caller holds, so what
+  // is sent is still current when the flag is cleared.
+  for (const auto& [vehicle_id, control] : pending) {
+    if (!sendMode(vehicle_id, control)) continue;  // Retried later
+    std::lock_guard<std::mutex> lock(mutex_);
+    sessions_[vehicle_id].mode_pending = false;
+  }
+}
+
+bool VehicleSessionManager::sendMode(const std::string& vehicle_id,
+                                     bool control) {
+  autodev::remote::control::SessionRequest request;
+  request.set_mode(control ? autodev::remote::control::SESSION_MODE_CONTROL
+                           : autodev::remote::control::SESSION_MODE_PREVIEW);
+  std::vector<char> buffer(request.ByteSizeLong());
+  if (!request.SerializeToArray(buffer.data(),
+                                static_cast<int>(buffer.size()))) {
+    std::cerr << "VehicleSessionManager: Failed to serialize session request."
+              << std::endl;
+    return false;
+  }
+  return webrtcManager_->sendDataChannelMessage(
+      vehicle_id, config_.session_channel_label, buffer);
+}
+
+void VehicleSessionManager::notifySessionChanged(const std::string& vehicle_id,
+                                                 bool control) {
+  OnSessionChangedHandler handler;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    handler = onSessionChangedHandler_;
+  }
+  if (handler) handler(vehicle_id, control ? "control" : "preview");
+}
+
+// --- Retry thread ---
+
+void VehicleSessionManager::retryThreadMain() {
+  const std::chrono::milliseconds interval(config_.retry_interval_ms);
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_) {
+    cv_.wait_for(lock, interval, [this] { return !running_; });
+    if (!running_) break;
+    bool any_pending = false;
+    for (const auto& [vehicle_id, state] : sessions_) {
+      any_pending = any_pending || (state.connected && state.mode_pending);
+    }
+    if (!any_pending) continue;
+
+    // Lock order: switchMutex_ before mutex_.
+    lock.unlock();
+    {
+      std::lock_guard<std::mutex> switch_lock(switchMutex_);
+      sendPendingModes();
+    }
+    lock.lock();
+  }
+}
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
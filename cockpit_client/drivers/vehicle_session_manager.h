@@ -0,0 +1,127 @@
+#ifndef VEHICLE_SESSION_MANAGER_H
+#define VEHICLE_SESSION_MANAGER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "drivers/command_arbiter.h"  // Dependency
+#include "drivers/session_control.h"  // Interface
+#include "webrtc/webrtc_manager.h"    // Dependency
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+struct VehicleSessionConfig {
+  // Vehicles the cockpit connects to and keeps connected.
+  std::vector<std::string> vehicle_ids;
+  // Taken over the first time it connects (if no vehicle is controlled by
+  // then); empty: the operator takes over explicitly.
+  std::string initial_vehicle_id;
+  std::string session_channel_label = "session";
+  // A mode request that could not be sent (e.g., the DataChannel is not
+  // open yet) is retried at this interval.
+  int retry_interval_ms = 200;
+};
+
+// Snapshot of one vehicle's session.
+struct VehicleSession {
+  std::string vehicle_id;
+  bool connected = false;
+  bool controlled = false;
+};
+
+// Lightweight sessions to several vehicles, one of them controlled.
+//
+// Every vehicle stays connected with video and telemetry. The cockpit asks
+// each one over the session DataChannel for a stream mode (SessionRequest):
+// preview (reduced-rate video) for all but the controlled vehicle, which
+// streams at full rate. Taking over another vehicle only sends two mode
+// requests and retargets the CommandArbiter; the PeerConnections and their
+// channels stay as they are, so there is no renegotiation.
+class VehicleSessionManager : public ISessionControl {
+ public:
+  // Called with the vehicle and its new mode ("control" or "preview").
+  using OnSessionChangedHandler = std::function<void(
+      const std::string& vehicle_id, const std::string& mode)>;
+
+  VehicleSessionManager(
+      std::shared_ptr<autodev::remote::webrtc::WebrtcManager> webrtc_manager,
+      std::shared_ptr<CommandArbiter> command_arbiter,
+      const VehicleSessionConfig& config);
+  ~VehicleSessionManager() override;
+
+  // Set before start().
+  void onSessionChanged(OnSessionChangedHandler handler);
+
+  // Connects to every vehicle (the WebrtcManager must be running) and
+  // starts the retry thread.
+  bool start();
+  void stop();
+
+  // Forwarded by the application from the WebrtcManager. MUST BE
+  // THREAD-SAFE.
+  void handlePeerConnected(const std::string& peer_id);
+  void handlePeerDisconnected(const std::string& peer_id);
+
+  // --- Implementation of ISessionControl Interface ---
+  bool takeControl(const std::string& vehicle_id) override;
+  void releaseControl() override;
+
+  // MUST BE THREAD-SAFE.
+  std::string getControlledVehicle() const;
+  std::vector<VehicleSession> getSessions() const;
+
+ private:
+  struct SessionState {
+    bool connected = false;
+    // The vehicle has not received its current mode yet.
+    bool mode_pending = false;
+  };
+
+  void retryThreadMain();
+  // switchMutex_ MUST be held for the three below.
+  bool takeControlLocked(const std::string& vehicle_id);
+  // Sends the pending mode requests.
+  void sendPendingModes();
+  void notifySessionChanged(const std::string& vehicle_id, bool control);
+  bool sendMode(const std::string& vehicle_id, bool control);
+
+  const std::shared_ptr<autodev::remote::webrtc::WebrtcManager>
+      webrtcManager_;
+  const std::shared_ptr<CommandArbiter> commandArbiter_;
+  const VehicleSessionConfig config_;
+
+  // Serializes mode changes and connection events with the sends of the
+  // mode requests, so a vehicle never receives an outdated mode last. Lock
+  // order: switchMutex_, then mutex_.
+  std::mutex switchMutex_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  // --- Guarded by mutex_ ---
+  std::map<std::string, SessionState> sessions_;  // By vehicle id
+  std::string controlledVehicle_;                 // Empty: none
+  bool initialTakeOverDone_ = false;
+  bool running_ = false;
+  OnSessionChangedHandler onSessionChangedHandler_;
+  std::thread retryThread_;
+
+  // Prevent copying
+  VehicleSessionManager(const VehicleSessionManager&) = delete;
+  VehicleSessionManager& operator=(const VehicleSessionManager&) = delete;
+};
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // VEHICLE_SESSION_MANAGER_H
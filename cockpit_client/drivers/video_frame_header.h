@@ -0,0 +1,106 @@
+#ifndef VIDEO_FRAME_HEADER_H
+#define VIDEO_FRAME_HEADER_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+// Fixed-size binary header prepended to every video frame sent to the browser
+// as a binary WebSocket message. The browser (display/src/video_player.js)
+// parses the same layout, so any change here MUST be mirrored there and the
+// version bumped.
+//
+// Wire layout (all fields little-endian, kVideoFrameHeaderSize bytes):
+//   offset  size  field
+//   0       4     magic ('W','V','F','1')
+//   4       2     header_size (bytes, allows appending fields later)
+//   6       1     version
+//   7       1     payload_type (VideoPayloadType)
+//   8       4     stream_id
+//   12      4     sequence (per stream, wraps around)
+//   16      8     capture_timestamp_us (capture clock of the sender)
+//   24      2     width
+//   26      2     height
+//   28      4     payload_size (bytes following the header)
+//   32      4     flags (VideoFrameFlags, since version 2)
+// Readers MUST skip header_size bytes to reach the payload.
+enum class VideoPayloadType : uint8_t {
+  Unknown = 0,
+  Jpeg = 1,
+  // Encoded access units forwarded without decoding (passthrough mode).
+  H264 = 2,  // Annex B byte stream (start codes), one access unit per message
+  Vp8 = 3,   // One VP8 frame per message
+};
+
+// Bit flags of the 'flags' header field.
+enum VideoFrameFlags : uint32_t {
+  kVideoFrameFlagNone = 0,
+  // The frame can be decoded on its own (always set for JPEG). Delta frames
+  // of H264/VP8 need every frame since the last key frame.
+  kVideoFrameFlagKeyFrame = 1u << 0,
+};
+
+constexpr uint8_t kVideoFrameMagic[4] = {'W', 'V', 'F', '1'};
+constexpr uint8_t kVideoFrameHeaderVersion = 2;
+constexpr size_t kVideoFrameHeaderSize = 36;
+
+struct VideoFrameHeader {
+  uint8_t version = kVideoFrameHeaderVersion;
+  VideoPayloadType payload_type = VideoPayloadType::Unknown;
+  uint32_t stream_id = 0;
+  uint32_t sequence = 0;
+  int64_t capture_timestamp_us = 0;
+  uint16_t width = 0;
+  uint16_t height = 0;
+  uint32_t payload_size = 0;
+  uint32_t flags = kVideoFrameFlagNone;
+};
+
+namespace video_frame_header_internal {
+
+inline void PutLe16(uint8_t* dst, uint16_t v) {
+  dst[0] = static_cast<uint8_t>(v);
+  dst[1] = static_cast<uint8_t>(v >> 8);
+}
+
+inline void PutLe32(uint8_t* dst, uint32_t v) {
+  for (int i = 0; i < 4; ++i) dst[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+inline void PutLe64(uint8_t* dst, uint64_t v) {
+  for (int i = 0; i < 8; ++i) dst[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+}  // namespace video_frame_header_internal
+
+// Writes the header into 'dst', which MUST have room for at least
+// kVideoFrameHeaderSize bytes. Explicit byte stores keep the wire format
+// independent of host endianness and struct padding.
+inline void WriteVideoFrameHeader(const VideoFrameHeader& header, char* dst) {
+  using namespace video_frame_header_internal;
+  uint8_t* out = reinterpret_cast<uint8_t*>(dst);
+  out[0] = kVideoFrameMagic[0];
+  out[1] = kVideoFrameMagic[1];
+  out[2] = kVideoFrameMagic[2];
+  out[3] = kVideoFrameMagic[3];
+  PutLe16(out + 4, static_cast<uint16_t>(kVideoFrameHeaderSize));
+  out[6] = header.version;
+  out[7] = static_cast<uint8_t>(header.payload_type);
+  PutLe32(out + 8, header.stream_id);
+  PutLe32(out + 12, header.sequence);
+  PutLe64(out + 16, static_cast<uint64_t>(header.capture_timestamp_us));
+  PutLe16(out + 24, header.width);
+  PutLe16(out + 26, header.height);
+  PutLe32(out + 28, header.payload_size);
+  PutLe32(out + 32, header.flags);
+}
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // VIDEO_FRAME_HEADER_H
@@ -0,0 +1,119 @@
+#include <iostream>
+#include <string>
+
+#include "drivers/web_command_handler_impl.h"
+
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+WebCommandHandlerImpl::WebCommandHandlerImpl() {
+  std::cout << "WebCommandHandlerImpl created." << std::endl;
+}
+
+WebCommandHandlerImpl::~WebCommandHandlerImpl() = default;
+
+// --- Implementation of IWebCommandHandler Interface ---
+
+bool WebCommandHandlerImpl::init(
+    std::shared_ptr<ICommandSink> command_sink,
+    std::shared_ptr<ISessionControl> session_control) {
+  if (!command_sink) {
+    std::cerr << "WebCommandHandlerImpl: Command sink is null." << std::endl;
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  commandSink_ = command_sink;
+  sessionControl_ = session_control;
+  std::cout << "WebCommandHandlerImpl: Initialized." << std::endl;
+  return true;
+}
+
+void WebCommandHandlerImpl::processRawWebCommand(WebSocketConnectionId conn_id,
+                                                 char* data, size_t size) {
+  // Called from a TransportServer thread. MUST BE THREAD-SAFE.
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!commandSink_) return;  // Not initialized
+
+  // Decoded in the transport's buffer; command_ views into it until this
+  // returns.
+  if (!parser_.parse(data, size, &command_)) {
+    const uint64_t errors = parseErrors_.fetch_add(1) + 1;
+    // Log the first few failures, then every 1000th.
+    if (errors <= 10 || errors % 1000 == 0) {
+      std::cerr << "WebCommandHandlerImpl: Invalid message from WS conn "
+                << conn_id << ": " << parser_.error() << " (" << errors
+                << " invalid messages so far)" << std::endl;
+    }
+    return;
+  }
+
+  switch (command_.kind) {
+    case WebCommandKind::Control:
+      submitControlCommand();
+      break;
+    case WebCommandKind::Emergency:
+      submitEmergencyCommand();
+      break;
+    case WebCommandKind::TakeControl:
+      if (sessionControl_) {
+        sessionControl_->takeControl(std::string(command_.vehicle_id));
+      }
+      break;
+    case WebCommandKind::ReleaseControl:
+      if (sessionControl_) sessionControl_->releaseControl();
+      break;
+    case WebCommandKind::Other:
+      break;  // Not a command (e.g., signaling); handled elsewhere
+  }
+}
+
+// --- Internal helpers (mutex_ held) ---
+
+void WebCommandHandlerImpl::submitControlCommand() {
+  // Clear() keeps the message's storage; only present fields are set so
+  // absent ones keep their proto3 defaults.
+  controlCommand_.Clear();
+  if (command_.control_fields & kWebControlAcceleration) {
+    controlCommand_.set_acceleration(command_.acceleration);
+  }
+  if (command_.control_fields & kWebControlBraking) {
+    controlCommand_.set_braking(command_.braking);
+  }
+  if (command_.control_fields & kWebControlSteeringAngle) {
+    controlCommand_.set_steering_angle(command_.steering_angle);
+  }
+  if (command_.control_fields & kWebControlGear) {
+    controlCommand_.set_gear(command_.gear);
+  }
+  if (command_.control_fields & kWebControlHandBrake) {
+    controlCommand_.set_hand_brake(command_.hand_brake);
+  }
+  commandSink_->submitControlCommand(CommandSource::WebUi, controlCommand_);
+}
+
+void WebCommandHandlerImpl::submitEmergencyCommand() {
+  if (!autodev::remote::control::EmergencyType_IsValid(
+          command_.emergency_type)) {
+    std::cerr << "WebCommandHandlerImpl: Unknown emergency type "
+              << command_.emergency_type << std::endl;
+    return;
+  }
+  emergencyCommand_.Clear();
+  emergencyCommand_.set_type(static_cast<autodev::remote::control::EmergencyType>(
+      command_.emergency_type));
+  // assign() reuses the reason string's capacity.
+  emergencyCommand_.mutable_reason()->assign(command_.emergency_reason.data(),
+                                             command_.emergency_reason.size());
+  std::cout << "WebCommandHandlerImpl: Emergency command (type "
+            << command_.emergency_type << ")." << std::endl;
+  if (!commandSink_->submitEmergencyCommand(CommandSource::WebUi,
+                                            emergencyCommand_)) {
+    std::cerr << "WebCommandHandlerImpl: FAILED to send emergency command!"
+              << std::endl;
+  }
+}
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
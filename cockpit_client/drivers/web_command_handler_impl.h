@@ -0,0 +1,67 @@
+#ifndef WEB_COMMAND_HANDLER_IMPL_H
+#define WEB_COMMAND_HANDLER_IMPL_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "drivers/web_command_handler.h"  // Interface
+#include "drivers/web_command_parser.h"   // In-situ JSON parser
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+// IWebCommandHandler for the JSON messages of the browser UI
+// ({"type":"control"|"emergency","data":{...}}, see display/src/app.js, and
+// the rare take_control/release_control requests).
+//
+// Messages arrive at input-device rates, so the hot path does not allocate:
+// the transport's buffer is parsed in place by WebCommandParser, and the
+// result fills a reused ControlCommand / EmergencyCommand, which is
+// submitted to the command sink. Messages of other types are ignored.
+class WebCommandHandlerImpl : public IWebCommandHandler {
+ public:
+  WebCommandHandlerImpl();
+  ~WebCommandHandlerImpl() override;
+
+  // --- Implementation of IWebCommandHandler Interface ---
+  bool init(std::shared_ptr<ICommandSink> command_sink,
+            std::shared_ptr<ISessionControl> session_control) override;
+  // Serialized by an internal mutex (the transport delivers messages from one
+  // thread, so it is uncontended). MUST BE THREAD-SAFE.
+  void processRawWebCommand(WebSocketConnectionId conn_id, char* data,
+                            size_t size) override;
+
+ private:
+  // Both called with mutex_ held.
+  void submitControlCommand();
+  void submitEmergencyCommand();
+
+  std::shared_ptr<ICommandSink> commandSink_;
+  std::shared_ptr<ISessionControl> sessionControl_;  // May be null
+
+  std::mutex mutex_;
+  // --- Reused per message, guarded by mutex_ ---
+  WebCommandParser parser_;
+  WebCommand command_;
+  autodev::remote::control::ControlCommand controlCommand_;
+  autodev::remote::control::EmergencyCommand emergencyCommand_;
+
+  // Parse failures are counted and logged sparsely; a misbehaving page must
+  // not flood the log at input rates.
+  std::atomic<uint64_t> parseErrors_{0};
+
+  // Prevent copying
+  WebCommandHandlerImpl(const WebCommandHandlerImpl&) = delete;
+  WebCommandHandlerImpl& operator=(const WebCommandHandlerImpl&) = delete;
+};
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // WEB_COMMAND_HANDLER_IMPL_H
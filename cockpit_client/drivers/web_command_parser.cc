@@ -0,0 +1,401 @@
+#include "drivers/web_command_parser.h"
+
+#include <charconv>  // std::from_chars, locale-independent
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+namespace {
+
+bool IsSpace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+// Returns the first byte in [p, end) that ends the plain part of a JSON
+// string: '"', '\\' or a control character (invalid inside strings).
+const char* FindStringSpecial(const char* p, const char* end) {
+#if defined(__SSE2__)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i max_control = _mm_set1_epi8(0x1f);
+  while (end - p >= 16) {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    // Unsigned c <= 0x1f  <=>  max(c, 0x1f) == 0x1f
+    const __m128i special = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                     _mm_cmpeq_epi8(chunk, backslash)),
+        _mm_cmpeq_epi8(_mm_max_epu8(chunk, max_control), max_control));
+    const int mask = _mm_movemask_epi8(special);
+    if (mask != 0) {
+      return p + __builtin_ctz(static_cast<unsigned>(mask));
+    }
+    p += 16;
+  }
+#endif
+  for (; p != end; ++p) {
+    const unsigned char c = static_cast<unsigned char>(*p);
+    if (c == '"' || c == '\\' || c < 0x20) break;
+  }
+  return p;
+}
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// Writes 'cp' as UTF-8 to 'out' and returns the byte count (1..4).
+size_t EncodeUtf8(uint32_t cp, char* out) {
+  if (cp < 0x80) {
+    out[0] = static_cast<char>(cp);
+    return 1;
+  }
+  if (cp < 0x800) {
+    out[0] = static_cast<char>(0xc0 | (cp >> 6));
+    out[1] = static_cast<char>(0x80 | (cp & 0x3f));
+    return 2;
+  }
+  if (cp < 0x10000) {
+    out[0] = static_cast<char>(0xe0 | (cp >> 12));
+    out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+    out[2] = static_cast<char>(0x80 | (cp & 0x3f));
+    return 3;
+  }
+  out[0] = static_cast<char>(0xf0 | (cp >> 18));
+  out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3f));
+  out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+  out[3] = static_cast<char>(0x80 | (cp & 0x3f));
+  return 4;
+}
+
+// Cursor over the message with the grammar pieces the schema needs.
+// Every method returns false (and sets error_) on invalid input.
+class Reader {
+ public:
+  Reader(char* data, size_t size) : p_(data), end_(data + size) {}
+
+  const char* error() const { return error_; }
+
+  bool fail(const char* error) {
+    error_ = error;
+    return false;
+  }
+
+  void skipSpace() {
+    while (p_ != end_ && IsSpace(*p_)) ++p_;
+  }
+
+  bool atEnd() {
+    skipSpace();
+    return p_ == end_;
+  }
+
+  // Consumes 'c' (after whitespace) if it is next.
+  bool consume(char c) {
+    skipSpace();
+    if (p_ != end_ && *p_ == c) {
+      ++p_;
+      return true;
+    }
+    return false;
+  }
+
+  bool expect(char c, const char* error) {
+    return consume(c) ? true : fail(error);
+  }
+
+  char peek() {
+    skipSpace();
+    return p_ != end_ ? *p_ : '\0';
+  }
+
+  // Parses a string and decodes escapes in place. 'out' views the decoded
+  // bytes inside the buffer.
+  bool readString(std::string_view* out) {
+    if (!consume('"')) return fail("expected string");
+    char* const begin = p_;
+    char* w = nullptr;  // Write position once an escape was decoded
+    while (true) {
+      char* special = const_cast<char*>(FindStringSpecial(p_, end_));
+      if (w) {
+        std::memmove(w, p_, static_cast<size_t>(special - p_));
+        w += special - p_;
+      }
+      p_ = special;
+      if (p_ == end_) return fail("unterminated string");
+      if (*p_ == '"') {
+        *out = std::string_view(begin, static_cast<size_t>((w ? w : p_) - begin));
+        ++p_;
+        return true;
+      }
+      if (*p_ != '\\') return fail("control character in string");
+      if (!w) w = p_;
+      if (!decodeEscape(&w)) return false;
+    }
+  }
+
+  bool readNumber(double* out) {
+    skipSpace();
+    if (p_ == end_ || !(*p_ == '-' || (*p_ >= '0' && *p_ <= '9'))) {
+      return fail("expected number");
+    }
+    const auto result = std::from_chars(p_, end_, *out);
+    if (result.ec != std::errc() || !std::isfinite(*out)) {
+      return fail("invalid number");
+    }
+    p_ = const_cast<char*>(result.ptr);
+    return true;
+  }
+
+  bool readInt32(int32_t* out) {
+    double value;
+    if (!readNumber(&value)) return false;
+    if (value != std::floor(value) || value < INT32_MIN || value > INT32_MAX) {
+      return fail("expected integer");
+    }
+    *out = static_cast<int32_t>(value);
+    return true;
+  }
+
+  bool readBool(bool* out) {
+    skipSpace();
+    if (matchLiteral("true")) {
+      *out = true;
+      return true;
+    }
+    if (matchLiteral("false")) {
+      *out = false;
+      return true;
+    }
+    return fail("expected boolean");
+  }
+
+  // Validates and skips any JSON value.
+  bool skipValue(int depth) {
+    if (depth > WebCommandParser::kMaxDepth) return fail("nesting too deep");
+    switch (peek()) {
+      case '"': {
+        std::string_view ignored;
+        return readString(&ignored);
+      }
+      case '{':
+        ++p_;
+        if (consume('}')) return true;
+        do {
+          std::string_view ignored;
+          if (!readString(&ignored)) return false;
+          if (!expect(':', "expected ':'")) return false;
+          if (!skipValue(depth + 1)) return false;
+        } while (consume(','));
+        return expect('}', "expected '}'");
+      case '[':
+        ++p_;
+        if (consume(']')) return true;
+        do {
+          if (!skipValue(depth + 1)) return false;
+        } while (consume(','));
+        return expect(']', "expected ']'");
+      case 't':
+      case 'f': {
+        bool ignored;
+        return readBool(&ignored);
+      }
+      case 'n':
+        return matchLiteral("null") ? true : fail("invalid literal");
+      default: {
+        double ignored;
+        return readNumber(&ignored);
+      }
+    }
+  }
+
+ private:
+  bool matchLiteral(const char* literal) {
+    const size_t len = std::strlen(literal);
+    if (static_cast<size_t>(end_ - p_) < len ||
+        std::memcmp(p_, literal, len) != 0) {
+      return false;
+    }
+    p_ += len;
+    return true;
+  }
+
+  bool readHex4(uint32_t* out) {
+    if (end_ - p_ < 4) return fail("truncated \\u escape");
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+      const int digit = HexValue(p_[i]);
+      if (digit < 0) return fail("invalid \\u escape");
+      value = (value << 4) | static_cast<uint32_t>(digit);
+    }
+    p_ += 4;
+    *out = value;
+    return true;
+  }
+
+  // p_ is at a backslash; writes the decoded bytes at *w. Decoded output is
+  // never longer than the escape, so writing in place is safe.
+  bool decodeEscape(char** w) {
+    ++p_;
+    if (p_ == end_) return fail("truncated escape");
+    const char c = *p_++;
+    char decoded;
+    switch (c) {
+      case '"':
+      case '\\':
+      case '/':
+        decoded = c;
+        break;
+      case 'b':
+        decoded = '\b';
+        break;
+      case 'f':
+        decoded = '\f';
+        break;
+      case 'n':
+        decoded = '\n';
+        break;
+      case 'r':
+        decoded = '\r';
+        break;
+      case 't':
+        decoded = '\t';
+        break;
+      case 'u': {
+        uint32_t cp;
+        if (!readHex4(&cp)) return false;
+        if (cp >= 0xd800 && cp <= 0xdbff) {
+          // High surrogate; JSON encodes non-BMP characters as a pair.
+          uint32_t low;
+          if (end_ - p_ < 2 || p_[0] != '\\' || p_[1] != 'u') {
+            return fail("unpaired surrogate");
+          }
+          p_ += 2;
+          if (!readHex4(&low)) return false;
+          if (low < 0xdc00 || low > 0xdfff) return fail("unpaired surrogate");
+          cp = 0x10000 + ((cp - 0xd800) << 10) + (low - 0xdc00);
+        } else if (cp >= 0xdc00 && cp <= 0xdfff) {
+          return fail("unpaired surrogate");
+        }
+        *w += EncodeUtf8(cp, *w);
+        return true;
+      }
+      default:
+        return fail("invalid escape");
+    }
+    *(*w)++ = decoded;
+    return true;
+  }
+
+  char* p_;
+  char* const end_;
+  const char* error_ = "";
+};
+
+// Parses the "data" object; which members are expected does not depend on
+// "type" (the control, emergency and take_control schemas share no names
+// except "type", which only emergencies use), so "type" may appear before or
+// after "data".
+bool ParseData(Reader& reader, WebCommand* out) {
+  if (!reader.expect('{', "\"data\" must be an object")) return false;
+  if (reader.consume('}')) return true;
+  do {
+    std::string_view key;
+    if (!reader.readString(&key)) return false;
+    if (!reader.expect(':', "expected ':'")) return false;
+    bool ok;
+    if (key == "acceleration") {
+      ok = reader.readNumber(&out->acceleration);
+      out->control_fields |= kWebControlAcceleration;
+    } else if (key == "braking") {
+      ok = reader.readNumber(&out->braking);
+      out->control_fields |= kWebControlBraking;
+    } else if (key == "steering_angle") {
+      ok = reader.readNumber(&out->steering_angle);
+      out->control_fields |= kWebControlSteeringAngle;
+    } else if (key == "gear") {
+      ok = reader.readInt32(&out->gear);
+      out->control_fields |= kWebControlGear;
+    } else if (key == "hand_brake") {
+      ok = reader.readBool(&out->hand_brake);
+      out->control_fields |= kWebControlHandBrake;
+    } else if (key == "type") {
+      ok = reader.readInt32(&out->emergency_type);
+      out->has_emergency_type = true;
+    } else if (key == "reason") {
+      ok = reader.readString(&out->emergency_reason);
+    } else if (key == "vehicle_id") {
+      ok = reader.readString(&out->vehicle_id);
+    } else {
+      ok = reader.skipValue(2);
+    }
+    if (!ok) return false;
+  } while (reader.consume(','));
+  return reader.expect('}', "expected '}'");
+}
+
+}  // namespace
+
+bool WebCommandParser::parse(char* data, size_t size, WebCommand* out) {
+  *out = WebCommand();
+  error_ = "";
+  Reader reader(data, size);
+
+  std::string_view type;
+  bool has_data = false;
+  bool ok = reader.expect('{', "message must be an object");
+  if (ok && !reader.consume('}')) {
+    do {
+      std::string_view key;
+      ok = reader.readString(&key) && reader.expect(':', "expected ':'");
+      if (!ok) break;
+      if (key == "type" && reader.peek() == '"') {
+        ok = reader.readString(&type);
+      } else if (key == "data" && reader.peek() == '{') {
+        ok = ParseData(reader, out);
+        has_data = true;
+      } else {
+        ok = reader.skipValue(1);
+      }
+    } while (ok && reader.consume(','));
+    ok = ok && reader.expect('}', "expected '}'");
+  }
+  if (ok && !reader.atEnd()) ok = reader.fail("trailing characters");
+  if (!ok) {
+    error_ = reader.error();
+    return false;
+  }
+
+  if (type == "control") {
+    out->kind = WebCommandKind::Control;
+  } else if (type == "emergency") {
+    out->kind = WebCommandKind::Emergency;
+    if (!has_data || !out->has_emergency_type) {
+      error_ = "emergency without data.type";
+      return false;
+    }
+  } else if (type == "take_control") {
+    out->kind = WebCommandKind::TakeControl;
+    if (out->vehicle_id.empty()) {
+      error_ = "take_control without data.vehicle_id";
+      return false;
+    }
+  } else if (type == "release_control") {
+    out->kind = WebCommandKind::ReleaseControl;
+  }
+  return true;
+}
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
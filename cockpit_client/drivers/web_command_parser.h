@@ -0,0 +1,86 @@
+#ifndef WEB_COMMAND_PARSER_H
+#define WEB_COMMAND_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+// Kind of a message sent by the browser UI (display/src/app.js).
+enum class WebCommandKind {
+  Other,      // Valid JSON with another (or no) "type"; not a command
+  Control,    // {"type":"control","data":{...}}
+  Emergency,  // {"type":"emergency","data":{...}}
+  TakeControl,     // {"type":"take_control","data":{"vehicle_id":"..."}}
+  ReleaseControl,  // {"type":"release_control"}
+};
+
+// Bits of WebCommand::control_fields telling which control fields were
+// present in the message.
+enum WebControlField : uint32_t {
+  kWebControlAcceleration = 1u << 0,
+  kWebControlBraking = 1u << 1,
+  kWebControlSteeringAngle = 1u << 2,
+  kWebControlGear = 1u << 3,
+  kWebControlHandBrake = 1u << 4,
+};
+
+// Result of parsing one UI message. Reused between messages: parse() resets
+// every field, so keeping one instance per handler avoids any allocation.
+struct WebCommand {
+  WebCommandKind kind = WebCommandKind::Other;
+
+  // "data" of a control message.
+  uint32_t control_fields = 0;  // WebControlField bits
+  double acceleration = 0.0;
+  double braking = 0.0;
+  double steering_angle = 0.0;
+  int32_t gear = 0;
+  bool hand_brake = false;
+
+  // "data" of an emergency message.
+  bool has_emergency_type = false;
+  int32_t emergency_type = 0;
+  // Points into the buffer passed to WebCommandParser::parse (escapes
+  // already decoded); valid while that buffer is.
+  std::string_view emergency_reason;
+
+  // "data" of a take_control message (same lifetime as emergency_reason).
+  std::string_view vehicle_id;
+};
+
+// Schema-specific JSON parser for the command messages of the browser UI.
+//
+// Parsing is in-situ: string escapes are decoded inside the caller's buffer
+// and strings are returned as views into it, so no memory is allocated.
+// Only the fields of the command schema are decoded; any other member (at
+// any depth) is validated and skipped. String scanning uses SSE2 where
+// available (16 bytes per step) with a scalar fallback.
+//
+// Not thread-safe; use one parser per thread.
+class WebCommandParser {
+ public:
+  // Maximum nesting of skipped values; deeper input is rejected.
+  static constexpr int kMaxDepth = 32;
+
+  // Parses the message in [data, data + size), modifying it in place.
+  // Returns false on malformed input or schema violations (e.g. a string
+  // where a number is expected); error() then describes the problem.
+  bool parse(char* data, size_t size, WebCommand* out);
+
+  // Static description of the last parse error, or "" after success.
+  const char* error() const { return error_; }
+
+ private:
+  const char* error_ = "";
+};
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // WEB_COMMAND_PARSER_H
@@ -0,0 +1,263 @@
+#include "drivers/websocket_video_sink.h"
+
+#include <turbojpeg.h>  // libjpeg-turbo TurboJPEG API (SIMD accelerated)
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>  // Logging
+
+#include "webrtc/api/video/i420_buffer.h"  // For webrtc::I420BufferInterface
+
+namespace autodev {
+namespace remote {
+namespace drivers {
+
+namespace {
+
+// Serial-number comparison (RFC 1982 style) so the stale-frame check keeps
+// working when the 32-bit sequence wraps around.
+bool IsNewerSequence(uint32_t candidate, uint32_t reference) {
+  return candidate != reference &&
+         static_cast<uint32_t>(candidate - reference) < 0x80000000u;
+}
+
+void UpdateMax(std::atomic<uint64_t>& target, uint64_t value) {
+  uint64_t current = target.load(std::memory_order_relaxed);
+  while (value > current &&
+         !target.compare_exchange_weak(current, value,
+                                       std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+WebSocketVideoSink::WebSocketVideoSink(
+    std::shared_ptr<autodev::remote::transport::ITransportServer>
+        transport_server,
+    const std::string& stream_name, uint32_t stream_id,
+    const WebSocketVideoSinkConfig& config)
+    : transport_server_(transport_server),
+      stream_name_(stream_name),
+      stream_id_(stream_id),
+      config_(config),
+      buffer_pool_(config.pooled_buffers) {
+  const size_t worker_count = std::max<size_t>(1, config_.encoder_threads);
+  workers_.reserve(worker_count);
+  for (size_t i = 0; i < worker_count; ++i) {
+    workers_.emplace_back(&WebSocketVideoSink::encoderThreadMain, this);
+  }
+  std::cout << "WebSocketVideoSink created for stream: " << stream_name_
+            << " (id " << stream_id_ << ", " << worker_count
+            << " encoder threads, quality " << config_.jpeg_quality << ")"
+            << std::endl;
+}
+
+WebSocketVideoSink::~WebSocketVideoSink() {
+  stop();
+  std::cout << "WebSocketVideoSink destroyed for stream: " << stream_name_
+            << std::endl;
+}
+
+void WebSocketVideoSink::stop() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (stopping_) {
+      return;
+    }
+    stopping_ = true;
+    pending_frames_.clear();
+  }
+  queue_cv_.notify_all();
+  for (auto& worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  workers_.clear();
+}
+
+void WebSocketVideoSink::OnFrame(const webrtc::VideoFrame& frame) {
+  frames_received_.fetch_add(1, std::memory_order_relaxed);
+
+  if (!transport_server_) {
+    // Server might be stopped or destroyed
+    return;
+  }
+
+  PendingFrame pending;
+  pending.buffer = frame.video_frame_buffer();
+  pending.capture_timestamp_us = frame.timestamp_us();
+  pending.sequence = next_sequence_.fetch_add(1, std::memory_order_relaxed);
+
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (stopping_) {
+      return;
+    }
+    const size_t max_pending = std::max<size_t>(1, config_.max_pending_frames);
+    while (pending_frames_.size() >= max_pending) {
+      // Workers are saturated; drop the oldest frame instead of building a
+      // backlog that only adds latency.
+      pending_frames_.pop_front();
+      frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    pending_frames_.push_back(std::move(pending));
+  }
+  queue_cv_.notify_one();
+}
+
+void WebSocketVideoSink::encoderThreadMain() {
+  tjhandle encoder = tjInitCompress();
+  if (!encoder) {
+    std::cerr << "WebSocketVideoSink: tjInitCompress failed for stream "
+              << stream_name_ << ": " << tjGetErrorStr() << std::endl;
+    return;
+  }
+
+  // Reusable JPEG output buffer for this worker, only reallocated when the
+  // resolution grows, so after warm-up no allocation happens per frame.
+  unsigned char* scratch = nullptr;
+  unsigned long scratch_size = 0;
+
+  while (true) {
+    PendingFrame frame;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_cv_.wait(lock,
+                     [this] { return stopping_ || !pending_frames_.empty(); });
+      if (stopping_) {
+        break;
+      }
+      frame = std::move(pending_frames_.front());
+      pending_frames_.pop_front();
+    }
+    encodeAndSend(encoder, frame, &scratch, &scratch_size);
+  }
+
+  if (scratch) {
+    tjFree(scratch);
+  }
+  tjDestroy(encoder);
+}
+
+void WebSocketVideoSink::encodeAndSend(void* encoder,
+                                       const PendingFrame& frame,
+                                       unsigned char** scratch,
+                                       unsigned long* scratch_size) {
+  const auto encode_start = std::chrono::steady_clock::now();
+
+  // No-op for frames already in I420 (the common case for decoded video).
+  rtc::scoped_refptr<webrtc::I420BufferInterface> i420 =
+      frame.buffer->ToI420();
+  if (!i420) {
+    encode_failures_.fetch_add(1, std::memory_order_relaxed);
+    std::cerr << "WebSocketVideoSink: Failed to convert frame to I420 for "
+              << "stream " << stream_name_ << std::endl;
+    return;
+  }
+
+  const int width = i420->width();
+  const int height = i420->height();
+  const unsigned char* planes[3] = {i420->DataY(), i420->DataU(),
+                                    i420->DataV()};
+  const int strides[3] = {i420->StrideY(), i420->StrideU(), i420->StrideV()};
+
+  // Size the worker's scratch buffer for the worst case of this resolution so
+  // libjpeg-turbo never has to reallocate mid-encode (TJFLAG_NOREALLOC).
+  const unsigned long required_size = tjBufSize(width, height, TJSAMP_420);
+  if (*scratch_size < required_size) {
+    if (*scratch) {
+      tjFree(*scratch);
+    }
+    *scratch = tjAlloc(static_cast<int>(required_size));
+    *scratch_size = *scratch ? required_size : 0;
+    if (!*scratch) {
+      encode_failures_.fetch_add(1, std::memory_order_relaxed);
+      std::cerr << "WebSocketVideoSink: Failed to allocate JPEG buffer for "
+                << "stream " << stream_name_ << std::endl;
+      return;
+    }
+  }
+
+  unsigned long jpeg_size = *scratch_size;
+  if (tjCompressFromYUVPlanes(static_cast<tjhandle>(encoder), planes, width,
+                              strides, height, TJSAMP_420, scratch, &jpeg_size,
+                              config_.jpeg_quality,
+                              TJFLAG_FASTDCT | TJFLAG_NOREALLOC) != 0) {
+    encode_failures_.fetch_add(1, std::memory_order_relaxed);
+    std::cerr << "WebSocketVideoSink: JPEG encode failed for stream "
+              << stream_name_ << ": "
+              << tjGetErrorStr2(static_cast<tjhandle>(encoder)) << std::endl;
+    return;
+  }
+
+  const uint64_t encode_time_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - encode_start)
+          .count();
+  frames_encoded_.fetch_add(1, std::memory_order_relaxed);
+  last_encode_time_us_.store(encode_time_us, std::memory_order_relaxed);
+  total_encode_time_us_.fetch_add(encode_time_us, std::memory_order_relaxed);
+  UpdateMax(max_encode_time_us_, encode_time_us);
+
+  // Frame the JPEG into a pooled buffer: fixed binary header + payload.
+  VideoFrameHeader header;
+  header.payload_type = VideoPayloadType::Jpeg;
+  header.stream_id = stream_id_;
+  header.sequence = frame.sequence;
+  header.capture_timestamp_us = frame.capture_timestamp_us;
+  header.width = static_cast<uint16_t>(width);
+  header.height = static_cast<uint16_t>(height);
+  header.payload_size = static_cast<uint32_t>(jpeg_size);
+  header.flags = kVideoFrameFlagKeyFrame;
+
+  auto message = buffer_pool_.acquire(kVideoFrameHeaderSize + jpeg_size);
+  message->resize(kVideoFrameHeaderSize);
+  WriteVideoFrameHeader(header, message->data());
+  message->insert(message->end(), reinterpret_cast<const char*>(*scratch),
+                  reinterpret_cast<const char*>(*scratch) + jpeg_size);
+
+  std::lock_guard<std::mutex> lock(send_mutex_);
+  if (has_sent_frame_ &&
+      !IsNewerSequence(frame.sequence, last_sent_sequence_)) {
+    // Another worker already delivered a newer frame.
+    frames_dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  has_sent_frame_ = true;
+  last_sent_sequence_ = frame.sequence;
+
+  // Broadcast the frame once for all connected WebSocket clients; the
+  // transport shares one wire buffer across clients, keeps only the latest
+  // frame per client and paces each one to its own drain rate.
+  // MUST BE THREAD-SAFE on the transport side.
+  if (!transport_server_->broadcastVideoFrame(
+          message, autodev::remote::transport::VideoFrameType::Independent)) {
+    send_failures_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  bytes_sent_.fetch_add(message->size(), std::memory_order_relaxed);
+  last_frame_bytes_.store(message->size(), std::memory_order_relaxed);
+}
+
+VideoSinkStats WebSocketVideoSink::getStats() const {
+  VideoSinkStats stats;
+  stats.frames_received = frames_received_.load(std::memory_order_relaxed);
+  stats.frames_encoded = frames_encoded_.load(std::memory_order_relaxed);
+  stats.frames_dropped = frames_dropped_.load(std::memory_order_relaxed);
+  stats.encode_failures = encode_failures_.load(std::memory_order_relaxed);
+  stats.send_failures = send_failures_.load(std::memory_order_relaxed);
+  stats.bytes_sent = bytes_sent_.load(std::memory_order_relaxed);
+  stats.last_frame_bytes = last_frame_bytes_.load(std::memory_order_relaxed);
+  stats.last_encode_time_us =
+      last_encode_time_us_.load(std::memory_order_relaxed);
+  stats.max_encode_time_us =
+      max_encode_time_us_.load(std::memory_order_relaxed);
+  stats.total_encode_time_us =
+      total_encode_time_us_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}  // namespace drivers
+}  // namespace remote
+}  // namespace autodev
@@ -1,107 +1,148 @@
-#include <iostream>  // Logging
-#include <memory>    // For shared_ptr
+#ifndef WEBSOCKET_VIDEO_SINK_H
+#define WEBSOCKET_VIDEO_SINK_H
+
+#include <atomic>              // For std::atomic
+#include <condition_variable>  // For worker queue signalling
+#include <cstdint>
+#include <deque>
+#include <memory>  // For shared_ptr
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
-#include "transport/transport_server.h"         // Dependency
+#include "drivers/frame_buffer_pool.h"   // Pooled output buffers
+#include "drivers/video_frame_header.h"  // Binary frame header layout
+#include "transport/transport_server.h"  // Dependency
 #include "webrtc/api/media_stream_interface.h"  // For webrtc::VideoSinkInterface
-#include "webrtc/api/video/i420_buffer.h"       // If handling I420 format
-#include "webrtc/api/video/video_frame.h"       // For webrtc::VideoFrame
-#include "webrtc/rtc_base/platform_thread.h"    // Potentially needed
-#include "webrtc/rtc_base/thread.h"  // Potentially needed for thread checks/marshalling
-// Include a library for image encoding, e.g., libjpeg-turbo
-// #include <turbojpeg.h> // Example
+#include "webrtc/api/video/video_frame.h"         // For webrtc::VideoFrame
+#include "webrtc/api/video/video_frame_buffer.h"  // For webrtc::VideoFrameBuffer
 
+// Use namespace for better organization
+namespace autodev {
 namespace remote {
 namespace drivers {
 
-// A WebRTC VideoSink implementation that encodes frames (e.g., to JPEG)
-// and sends them over WebSocket via the TransportServer.
+// Configuration for the JPEG encoding pipeline of a WebSocketVideoSink.
+struct WebSocketVideoSinkConfig {
+  int jpeg_quality = 75;  // 1..100, passed to libjpeg-turbo
+  // Number of encoder worker threads. Each worker owns its own libjpeg-turbo
+  // handle, so frames are encoded in parallel without locking.
+  size_t encoder_threads = 2;
+  // Frames waiting for a free worker. When full the OLDEST pending frame is
+  // dropped: for remote driving a fresh frame is worth more than a complete
+  // sequence.
+  size_t max_pending_frames = 2;
+  // Idle output buffers kept for reuse.
+  size_t pooled_buffers = 8;
+};
+
+// Snapshot of the sink's counters. All times are in microseconds.
+struct VideoSinkStats {
+  uint64_t frames_received = 0;  // Frames delivered by WebRTC to OnFrame
+  uint64_t frames_encoded = 0;   // Frames successfully JPEG-encoded
+  uint64_t frames_dropped = 0;   // Dropped because workers were busy or stale
+  uint64_t encode_failures = 0;
+  uint64_t send_failures = 0;
+  uint64_t bytes_sent = 0;  // Total bytes handed to the transport (with header)
+  uint64_t last_frame_bytes = 0;
+  uint64_t last_encode_time_us = 0;
+  uint64_t max_encode_time_us = 0;
+  uint64_t total_encode_time_us = 0;  // Divide by frames_encoded for the mean
+};
+
+// A WebRTC VideoSink implementation that encodes frames to JPEG with
+// libjpeg-turbo (SIMD accelerated) on a small worker pool and sends them as
+// binary WebSocket messages via the TransportServer.
+// Each message is a VideoFrameHeader (see video_frame_header.h) followed by
+// the JPEG bytes, written once into a pooled, refcounted buffer that the
+// transport shares across all connected viewers.
 class WebSocketVideoSink
     : public webrtc::VideoSinkInterface<webrtc::VideoFrame> {
  public:
-  // Needs access to the TransportServer to send data, and potentially config
-  // The TransportServer must outlive this sink. Using raw pointer here assumes
-  // the App manages lifetime correctly, or use shared_ptr if appropriate.
+  // The TransportServer is shared, so it stays valid while the sink is active.
+  // stream_name: Human-readable identifier used for logging (e.g.,
+  // "camera_front"). stream_id: Numeric identifier written into every frame
+  // header so the UI can tell streams apart.
+  // Encoder workers are started here and stopped in the destructor.
   WebSocketVideoSink(
       std::shared_ptr<autodev::remote::transport::ITransportServer>
           transport_server,
-      const std::string& stream_id  // Identifier for this video stream
-      /* , potentially config for encoding */)
-      : transport_server_(transport_server),
-        stream_id_(stream_id)
-  // , tj_handle_(nullptr) // If using libjpeg-turbo
-  {
-    // TODO: Initialize encoder here, e.g., tjInitCompress(&tj_handle_)
-    std::cout << "WebSocketVideoSink created for stream: " << stream_id_
-              << std::endl;
-  }
-
-  ~WebSocketVideoSink() override {
-    // TODO: Destroy encoder here, e.g., tjDestroy(tj_handle_)
-    std::cout << "WebSocketVideoSink destroyed for stream: " << stream_id_
-              << std::endl;
-  }
+      const std::string& stream_name, uint32_t stream_id,
+      const WebSocketVideoSinkConfig& config = WebSocketVideoSinkConfig());
+
+  ~WebSocketVideoSink() override;
 
   // This method is called by WebRTC when a new frame is available.
   // It will be called on a WebRTC internal thread. MUST BE THREAD-SAFE.
-  void OnFrame(const webrtc::VideoFrame& frame) override {
-    // std::cout << "Sink received frame: " << frame.width() << "x" <<
-    // frame.height() << std::endl;
-
-    if (!transport_server_) {
-      // Server might be stopped or destroyed
-      return;
-    }
-
-    // TODO: Implement frame conversion and encoding
-    // Example (conceptual) using JPEG encoding:
-    // - Get pixel data from frame (e.g., frame.video_frame_buffer()->ToI420()
-    // then access planes)
-    // - Encode I420/other format to JPEG bytes using a library (libjpeg-turbo,
-    // OpenCV, etc.)
-    // - Store JPEG bytes in a std::vector<char>
-
-    std::vector<char> jpeg_data;  // Placeholder for encoded JPEG data
-    // Dummy data for skeleton:
-    std::string dummy_jpeg_string = "DUMMY_JPEG_DATA_" + stream_id_ + "_" +
-                                    std::to_string(frame.timestamp_us());
-    jpeg_data.assign(dummy_jpeg_string.begin(), dummy_jpeg_string.end());
-
-    // Optional: Add a header/wrapper to the message to identify the stream or
-    // frame type This helps the UI differentiate video data from other
-    // WebSocket messages. Example: A simple header could be
-    // "VIDEO:<stream_id>:<frame_data>"
-    std::vector<char> message_with_header;
-    std::string header_str = "VIDEO:" + stream_id_ + ":";
-    message_with_header.insert(message_with_header.end(), header_str.begin(),
-                               header_str.end());
-    message_with_header.insert(message_with_header.end(), jpeg_data.begin(),
-                               jpeg_data.end());
-
-    // Send the encoded frame data to all connected WebSocket clients via the
-    // TransportServer. TransportServer::sendToAllWebSocketClients MUST BE
-    // THREAD-SAFE.
-    bool success = transport_server_->sendToAllWebSocketClients(
-        message_with_header);  // Use sendToAll for broadcast
-
-    if (!success) {
-      // std::cerr << "Sink failed to send video frame for stream: " <<
-      // stream_id_ << std::endl; Handle send failure (e.g., clients
-      // disconnected)
-    }
-  }
+  // Only queues a reference to the frame buffer; conversion and encoding
+  // happen on the worker threads so the WebRTC thread is never blocked.
+  void OnFrame(const webrtc::VideoFrame& frame) override;
+
+  // Stops the encoder workers. Frames still pending are discarded. Safe to
+  // call multiple times; called by the destructor.
+  void stop();
+
+  // Returns a snapshot of the encode/send counters. Thread-safe.
+  VideoSinkStats getStats() const;
 
  private:
-  // Shared pointer to the TransportServer. Ensures server is valid while sink
-  // is active.
+  struct PendingFrame {
+    rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer;
+    int64_t capture_timestamp_us = 0;
+    uint32_t sequence = 0;
+  };
+
+  // Worker thread entry point. Owns one encoder handle for its lifetime.
+  void encoderThreadMain();
+
+  // Encodes 'frame' with 'encoder' (a tjhandle) into a pooled buffer and
+  // sends it. scratch/scratch_size is the worker's reusable JPEG output
+  // buffer, grown when the frame resolution increases.
+  void encodeAndSend(void* encoder, const PendingFrame& frame,
+                     unsigned char** scratch, unsigned long* scratch_size);
+
   std::shared_ptr<autodev::remote::transport::ITransportServer>
       transport_server_;
-  std::string stream_id_;  // Identifier for this video stream (e.g.,
-                           // "camera_front", "camera_rear")
+  const std::string stream_name_;
+  const uint32_t stream_id_;
+  const WebSocketVideoSinkConfig config_;
+
+  FrameBufferPool buffer_pool_;
 
-  // TODO: Encoder handle, e.g., tjhandle tj_handle_;
+  // --- Worker pool ---
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  std::deque<PendingFrame> pending_frames_;  // Guarded by queue_mutex_
+  bool stopping_ = false;                    // Guarded by queue_mutex_
+  std::vector<std::thread> workers_;
+  std::atomic<uint32_t> next_sequence_{0};
+
+  // Workers may finish out of order; frames older than the last one sent are
+  // dropped so the UI never steps backwards.
+  std::mutex send_mutex_;
+  bool has_sent_frame_ = false;     // Guarded by send_mutex_
+  uint32_t last_sent_sequence_ = 0;  // Guarded by send_mutex_
+
+  // --- Stats ---
+  std::atomic<uint64_t> frames_received_{0};
+  std::atomic<uint64_t> frames_encoded_{0};
+  std::atomic<uint64_t> frames_dropped_{0};
+  std::atomic<uint64_t> encode_failures_{0};
+  std::atomic<uint64_t> send_failures_{0};
+  std::atomic<uint64_t> bytes_sent_{0};
+  std::atomic<uint64_t> last_frame_bytes_{0};
+  std::atomic<uint64_t> last_encode_time_us_{0};
+  std::atomic<uint64_t> max_encode_time_us_{0};
+  std::atomic<uint64_t> total_encode_time_us_{0};
+
+  // Prevent copying
+  WebSocketVideoSink(const WebSocketVideoSink&) = delete;
+  WebSocketVideoSink& operator=(const WebSocketVideoSink&) = delete;
 };
 
 }  // namespace drivers
 }  // namespace remote
+}  // namespace autodev
+
+#endif  // WEBSOCKET_VIDEO_SINK_H
@@ -0,0 +1,113 @@
+// JsonWriter against std::string concatenation, for the two kinds of
+// cockpit -> browser JSON: the telemetry push (built per vehicle at up to
+// telemetry_publish_rate_hz) and the status message.
+//
+// Build, then run, from the repository root:
+//   g++ -std=c++17 -O2 -I. -Icockpit_client -o /tmp/json_writer_benchmark
+//       cockpit_client/transport/benchmarks/json_writer_benchmark.cc
+//   /tmp/json_writer_benchmark
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "testing/allocation_counter.h"
+#include "testing/benchmark.h"
+#include "transport/json_writer.h"
+
+namespace {
+
+using autodev::remote::testing::Allocations;
+using autodev::remote::testing::DoNotOptimize;
+using autodev::remote::testing::NanosPerOp;
+using autodev::remote::transport::JsonWriter;
+using autodev::remote::transport::StackJsonWriter;
+
+constexpr uint64_t kIterations = 2000000;
+
+struct Telemetry {
+  std::string vehicle_id = "vehicle-042";
+  uint32_t seq = 123456;
+  int64_t timestamp_us = 1760000000123456;
+  double speed_mps = 13.377;
+  int gear = 3;
+};
+
+// The concatenation style the handlers used before JsonWriter.
+std::string ConcatTelemetry(const Telemetry& t) {
+  return "{\"type\":\"telemetry\",\"vehicle_id\":\"" + t.vehicle_id +
+         "\",\"seq\":" + std::to_string(t.seq) +
+         ",\"timestamp_us\":" + std::to_string(t.timestamp_us) +
+         ",\"data\":{\"speed_mps\":" + std::to_string(t.speed_mps) +
+         ",\"gear\":" + std::to_string(t.gear) + "}}";
+}
+
+void WriteTelemetry(JsonWriter& writer, const Telemetry& t) {
+  writer.beginObject()
+      .field("type", "telemetry")
+      .field("vehicle_id", t.vehicle_id)
+      .field("seq", t.seq)
+      .field("timestamp_us", t.timestamp_us)
+      .key("data")
+      .beginObject()
+      .field("speed_mps", t.speed_mps)
+      .field("gear", t.gear)
+      .endObject()
+      .endObject();
+}
+
+std::string ConcatStatus(const std::string& vehicle_id,
+                         const std::string& status,
+                         const std::string& detail) {
+  return "{\"type\":\"status\",\"vehicle_id\":\"" + vehicle_id +
+         "\",\"status\":\"" + status + "\",\"detail\":\"" + detail + "\"}";
+}
+
+// Runs one case and prints its time and heap allocations per message.
+template <typename Op>
+void Run(const char* name, Op&& op) {
+  const uint64_t allocations_before = Allocations();
+  const double ns = NanosPerOp(kIterations, op);
+  const double allocations =
+      static_cast<double>(Allocations() - allocations_before) /
+      static_cast<double>(kIterations + kIterations / 10);
+  std::printf("%-40s %8.1f ns/msg %6.2f allocs/msg\n", name, ns,
+              allocations);
+}
+
+}  // namespace
+
+int main() {
+  const Telemetry telemetry;
+  const std::string vehicle_id = "vehicle-042";
+  const std::string status = "disconnected";
+  const std::string detail = "ICE connection failed";
+
+  Run("telemetry: string concatenation", [&] {
+    std::string message = ConcatTelemetry(telemetry);
+    DoNotOptimize(message);
+  });
+  std::string arena;
+  Run("telemetry: JsonWriter (reused arena)", [&] {
+    JsonWriter writer(arena);
+    WriteTelemetry(writer, telemetry);
+    DoNotOptimize(writer.finish());
+  });
+
+  Run("status: string concatenation", [&] {
+    std::string message = ConcatStatus(vehicle_id, status, detail);
+    DoNotOptimize(message);
+  });
+  Run("status: StackJsonWriter<512>", [&] {
+    std::string overflow;
+    StackJsonWriter<512> writer(&overflow);
+    writer.beginObject()
+        .field("type", "status")
+        .field("vehicle_id", vehicle_id)
+        .field("status", status)
+        .field("detail", detail)
+        .endObject();
+    DoNotOptimize(writer.view());
+  });
+  return 0;
+}
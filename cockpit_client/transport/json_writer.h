@@ -0,0 +1,269 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <algorithm>
+#include <charconv>  // std::to_chars, locale-independent and allocation-free
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace transport {
+
+// Minimal streaming JSON writer for cockpit -> browser messages.
+//
+// Output goes into one of two kinds of storage:
+//  - an arena: a caller-owned std::string that is reused across messages.
+//    Its capacity survives, so once it has grown to the largest message no
+//    further allocation happens;
+//  - a fixed buffer (see StackJsonWriter), optionally spilling into an arena
+//    when a message outgrows it.
+// Numbers are formatted with std::to_chars (shortest round-trip form for
+// doubles), strings are escaped per RFC 8259. Commas are inserted
+// automatically; nesting is limited to kMaxDepth levels.
+//
+// Usage:
+//   JsonWriter w(buffer_);
+//   w.beginObject().field("type", "telemetry").field("seq", seq).endObject();
+//   transport->sendToAllWebSocketClients(w.finish());
+//
+// Not thread-safe; use one writer (and arena) per thread.
+class JsonWriter {
+ public:
+  static constexpr int kMaxDepth = 32;
+
+  // Writes into 'arena'; its previous content is discarded.
+  explicit JsonWriter(std::string& arena) : arena_(&arena) {
+    // Use all existing capacity; only a fresh arena allocates here.
+    arena.resize(std::max(arena.capacity(), kMinArenaSize));
+    begin_ = pos_ = &arena[0];
+    end_ = begin_ + arena.size();
+  }
+
+  // Writes into [buffer, buffer + capacity). If the message does not fit it
+  // continues in 'overflow' when given, otherwise ok() turns false.
+  JsonWriter(char* buffer, size_t capacity, std::string* overflow = nullptr)
+      : begin_(buffer), pos_(buffer), end_(buffer + capacity),
+        arena_(overflow), in_arena_(false) {}
+
+  JsonWriter& beginObject() { return open('{'); }
+  JsonWriter& endObject() { return close('}'); }
+  JsonWriter& beginArray() { return open('['); }
+  JsonWriter& endArray() { return close(']'); }
+
+  // Object member name; MUST be followed by exactly one value.
+  JsonWriter& key(std::string_view name) {
+    separate();
+    writeString(name);
+    put(':');
+    afterKey_ = true;
+    return *this;
+  }
+
+  JsonWriter& value(std::string_view s) {
+    separate();
+    writeString(s);
+    return *this;
+  }
+  JsonWriter& value(const char* s) { return value(std::string_view(s)); }
+  JsonWriter& value(const std::string& s) { return value(std::string_view(s)); }
+  JsonWriter& value(bool b) {
+    separate();
+    b ? write("true", 4) : write("false", 5);
+    return *this;
+  }
+  JsonWriter& value(int v) { return writeNumber(v); }
+  JsonWriter& value(unsigned v) { return writeNumber(v); }
+  JsonWriter& value(long v) { return writeNumber(v); }
+  JsonWriter& value(unsigned long v) { return writeNumber(v); }
+  JsonWriter& value(long long v) { return writeNumber(v); }
+  JsonWriter& value(unsigned long long v) { return writeNumber(v); }
+  // Non-finite values have no JSON representation and are written as null.
+  JsonWriter& value(double v) {
+    if (!std::isfinite(v)) return null();
+    return writeNumber(v);
+  }
+  JsonWriter& value(float v) { return value(static_cast<double>(v)); }
+  JsonWriter& null() {
+    separate();
+    write("null", 4);
+    return *this;
+  }
+
+  // key(name).value(v)
+  template <typename T>
+  JsonWriter& field(std::string_view name, const T& v) {
+    return key(name).value(v);
+  }
+
+  // False if a fixed buffer without overflow ran out of space or the nesting
+  // limit was exceeded; the output is then truncated and must not be sent.
+  bool ok() const { return ok_; }
+
+  // The JSON written so far. Valid until the writer or its storage changes.
+  std::string_view view() const {
+    return std::string_view(begin_, static_cast<size_t>(pos_ - begin_));
+  }
+
+  // Trims the arena to the written size and returns it (arena mode, or after
+  // a fixed buffer spilled into 'overflow'). Otherwise copies view() into
+  // 'fallback' and returns that.
+  const std::string& finish(std::string* fallback = nullptr) {
+    if (in_arena_) {
+      arena_->resize(static_cast<size_t>(pos_ - begin_));
+      return *arena_;
+    }
+    static const std::string kEmpty;
+    if (!fallback) return kEmpty;
+    fallback->assign(begin_, static_cast<size_t>(pos_ - begin_));
+    return *fallback;
+  }
+
+ private:
+  static constexpr size_t kMinArenaSize = 256;
+
+  JsonWriter& open(char c) {
+    separate();
+    put(c);
+    if (depth_ + 1 >= kMaxDepth) {
+      ok_ = false;
+      return *this;
+    }
+    ++depth_;
+    hasElement_[depth_] = false;
+    return *this;
+  }
+
+  JsonWriter& close(char c) {
+    put(c);
+    if (depth_ > 0) --depth_;
+    return *this;
+  }
+
+  // Emits the comma between elements of the current container.
+  void separate() {
+    if (afterKey_) {
+      afterKey_ = false;
+      return;
+    }
+    if (hasElement_[depth_]) put(',');
+    hasElement_[depth_] = true;
+  }
+
+  template <typename T>
+  JsonWriter& writeNumber(T v) {
+    separate();
+    char buf[32];  // Enough for any int64/uint64/double from to_chars
+    const auto result = std::to_chars(buf, buf + sizeof(buf), v);
+    write(buf, static_cast<size_t>(result.ptr - buf));
+    return *this;
+  }
+
+  // Copies runs of plain characters in one go; only '"', '\\' and control
+  // characters are escaped. UTF-8 passes through unchanged.
+  void writeString(std::string_view s) {
+    put('"');
+    const char* run = s.data();
+    const char* const end = s.data() + s.size();
+    for (const char* p = run; p != end; ++p) {
+      const unsigned char c = static_cast<unsigned char>(*p);
+      if (c >= 0x20 && c != '"' && c != '\\') continue;
+      write(run, static_cast<size_t>(p - run));
+      run = p + 1;
+      switch (c) {
+        case '"':
+          write("\\\"", 2);
+          break;
+        case '\\':
+          write("\\\\", 2);
+          break;
+        case '\n':
+          write("\\n", 2);
+          break;
+        case '\r':
+          write("\\r", 2);
+          break;
+        case '\t':
+          write("\\t", 2);
+          break;
+        default: {
+          static const char kHex[] = "0123456789abcdef";
+          const char escaped[6] = {'\\', 'u', '0', '0', kHex[c >> 4],
+                                   kHex[c & 0xf]};
+          write(escaped, sizeof(escaped));
+        }
+      }
+    }
+    write(run, static_cast<size_t>(end - run));
+    put('"');
+  }
+
+  void put(char c) {
+    if (pos_ == end_ && !grow(1)) return;
+    *pos_++ = c;
+  }
+
+  void write(const char* data, size_t size) {
+    if (size == 0) return;
+    if (static_cast<size_t>(end_ - pos_) < size && !grow(size)) return;
+    std::memcpy(pos_, data, size);
+    pos_ += size;
+  }
+
+  // Makes room for 'needed' more bytes by (re)sizing the arena.
+  bool grow(size_t needed) {
+    if (!arena_) {
+      ok_ = false;
+      return false;
+    }
+    const size_t used = static_cast<size_t>(pos_ - begin_);
+    const size_t capacity = static_cast<size_t>(end_ - begin_);
+    const size_t new_size = std::max(capacity * 2, used + needed);
+    if (in_arena_) {
+      arena_->resize(new_size);
+    } else {
+      // Spill the fixed buffer into the arena.
+      arena_->resize(std::max(new_size, arena_->capacity()));
+      std::memcpy(&(*arena_)[0], begin_, used);
+      in_arena_ = true;
+    }
+    begin_ = &(*arena_)[0];
+    pos_ = begin_ + used;
+    end_ = begin_ + arena_->size();
+    return true;
+  }
+
+  char* begin_ = nullptr;
+  char* pos_ = nullptr;
+  char* end_ = nullptr;
+  std::string* arena_ = nullptr;
+  bool in_arena_ = true;
+  bool ok_ = true;
+  bool afterKey_ = false;
+  int depth_ = 0;
+  bool hasElement_[kMaxDepth] = {};
+};
+
+// JsonWriter backed by an N-byte buffer inside the object, typically on the
+// stack. Short, infrequent messages (status, errors) are built without
+// touching the heap; pass 'overflow' to allow larger messages.
+template <size_t N>
+class StackJsonWriter : public JsonWriter {
+ public:
+  explicit StackJsonWriter(std::string* overflow = nullptr)
+      : JsonWriter(storage_, N, overflow) {}
+
+ private:
+  char storage_[N];  // Only its address is used by the base constructor
+};
+
+}  // namespace transport
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // JSON_WRITER_H
@@ -1,10 +1,12 @@
 #ifndef TRANSPORT_SERVER_H
 #define TRANSPORT_SERVER_H
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // Define a type for a WebSocket connection identifier.
@@ -17,6 +19,31 @@ namespace autodev {
 namespace remote {
 namespace transport {
 
+// Per-client delivery statistics reported by ITransportServer::getClientStats.
+struct WebSocketClientStats {
+  WebSocketConnectionId conn_id = 0;
+  // Bytes accepted for this client but not yet written to its socket
+  // (application queues plus the server library's write buffer).
+  size_t buffered_bytes = 0;
+  uint64_t reliable_messages_sent = 0;
+  uint64_t video_frames_sent = 0;
+  // Frames replaced by a newer frame before this client was ready for them.
+  uint64_t video_frames_skipped = 0;
+  // Current adaptive video frame rate limit for this client.
+  double video_fps_limit = 0.0;
+};
+
+// How a broadcast video frame depends on the frames before it.
+enum class VideoFrameType {
+  // Decodable on its own and safe to skip (e.g., JPEG).
+  Independent,
+  // Codec key frame (H.264 IDR / VP8 key frame); starts a decodable sequence.
+  KeyFrame,
+  // Needs every frame since the last key frame. If a client misses one, it
+  // gets nothing more until the next key frame.
+  DeltaFrame,
+};
+
 // Interface for a local server serving web content and providing WebSocket
 // communication. This server is typically used by the CockpitClientApp to host
 // the remote driving UI.
@@ -40,14 +67,14 @@ class ITransportServer {
       std::function<void(WebSocketConnectionId conn_id)>;
 
   // Handler for messages received over WebSocket.
-  // Use vector<char> for binary support, which is common for Protobuf or other
-  // formats. conn_id: The identifier of the connection the message arrived on.
-  // message: The received raw data.
-  // Implementations MUST be thread-safe. The message vector's memory
-  // is typically owned by the server implementation; copy data if needed after
-  // handler returns.
+  // conn_id: The identifier of the connection the message arrived on.
+  // data, size: The received payload (text or binary), handed over in place
+  // without a copy. The handler may modify it (e.g., in-situ parsing); it
+  // is owned by the server implementation and only valid during the call, so
+  // copy what is needed after the handler returns.
+  // Implementations MUST be thread-safe.
   using OnWebSocketMessageReceivedHandler = std::function<void(
-      WebSocketConnectionId conn_id, const std::vector<char>& message)>;
+      WebSocketConnectionId conn_id, char* data, size_t size)>;
 
   // Handler for critical server errors (e.g., bind failure, listen error).
   // error_msg: Description of the error.
@@ -55,6 +82,12 @@ class ITransportServer {
   using OnServerErrorHandler =
       std::function<void(const std::string& error_msg)>;
 
+  // Handler invoked when a client needs a key frame to (re)start decoding an
+  // encoded video stream, e.g. after it connected or had to skip a frame.
+  // Implementations MUST be thread-safe and cheap (typically they just set a
+  // flag for the video source).
+  using OnVideoKeyFrameRequestedHandler = std::function<void()>;
+
   // --- Server Lifecycle Methods ---
 
   // Initializes the server with network configuration and static file path.
@@ -99,8 +132,29 @@ class ITransportServer {
   // completed. This method should ideally be non-blocking.
   virtual bool sendToAllWebSocketClients(const std::vector<char>& data) = 0;
 
-  // Overload to send string data to ALL currently connected WebSocket clients.
-  virtual bool sendToAllWebSocketClients(const std::string& data) = 0;
+  // Overload to send text to ALL currently connected WebSocket clients. Takes
+  // a view, so messages built in a caller's buffer (e.g., StackJsonWriter)
+  // are queued without an intermediate std::string.
+  virtual bool sendToAllWebSocketClients(std::string_view data) = 0;
+
+  // Broadcasts a binary video frame to ALL currently connected WebSocket
+  // clients. The frame is framed for the wire once and the same buffer is
+  // shared by every client's send queue, so each additional viewer only costs
+  // its socket write. The caller may reuse or release 'frame' once this
+  // returns.
+  // Unlike sendToAllWebSocketClients, delivery is latest-frame-only: each
+  // client holds at most one pending frame, and a newer frame replaces it.
+  // Independent frames are also paced per client according to how fast that
+  // client drains its socket, so a slow browser only lowers its own frame rate
+  // and never delays telemetry or other clients. For encoded streams
+  // ('type' KeyFrame/DeltaFrame) a client that falls behind skips to the next
+  // key frame, and a key frame is requested via onVideoKeyFrameRequested.
+  // Returns true if the frame was offered to at least one client.
+  virtual bool broadcastVideoFrame(
+      std::shared_ptr<const std::vector<char>> frame, VideoFrameType type) = 0;
+
+  // Returns delivery statistics for every connected client. Thread-safe.
+  virtual std::vector<WebSocketClientStats> getClientStats() const = 0;
 
   // --- Handler Registration Methods ---
   // These methods allow the application to register callbacks for server
@@ -121,6 +175,10 @@ class ITransportServer {
   // Register handler for critical server errors.
   virtual void onServerError(OnServerErrorHandler handler) = 0;
 
+  // Register handler for key frame requests of encoded video streams.
+  virtual void onVideoKeyFrameRequested(
+      OnVideoKeyFrameRequestedHandler handler) = 0;
+
   // Optional: Add a method to get the list of currently connected client IDs?
   // virtual std::vector<WebSocketConnectionId> getConnectedClients() const = 0;
 };
@@ -0,0 +1,655 @@
+#include "transport/websocket_transport_server.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <utility>
+
+// Use websocketpp's lib::bind which works with both Boost.Bind and std::bind
+using websocketpp::lib::bind;
+using websocketpp::lib::placeholders::_1;
+using websocketpp::lib::placeholders::_2;
+
+namespace autodev {
+namespace remote {
+namespace transport {
+
+namespace {
+
+// Minimal content-type table for the files shipped in display/public.
+std::string ContentTypeForPath(const std::string& path) {
+  static const std::pair<const char*, const char*> kTypes[] = {
+      {".html", "text/html; charset=utf-8"},
+      {".js", "application/javascript"},
+      {".css", "text/css"},
+      {".json", "application/json"},
+      {".png", "image/png"},
+      {".jpg", "image/jpeg"},
+      {".svg", "image/svg+xml"},
+      {".ico", "image/x-icon"},
+  };
+  for (const auto& entry : kTypes) {
+    const std::string ext = entry.first;
+    if (path.size() >= ext.size() &&
+        path.compare(path.size() - ext.size(), ext.size(), ext) == 0) {
+      return entry.second;
+    }
+  }
+  return "application/octet-stream";
+}
+
+}  // namespace
+
+WebSocketTransportServer::WebSocketTransportServer(
+    const WebSocketTransportServerConfig& config)
+    : config_(config) {
+  std::cout << "WebSocketTransportServer created." << std::endl;
+}
+
+WebSocketTransportServer::~WebSocketTransportServer() {
+  std::cout << "WebSocketTransportServer destroying." << std::endl;
+  stop();
+  std::cout << "WebSocketTransportServer destroyed." << std::endl;
+}
+
+// --- Lifecycle ---
+
+bool WebSocketTransportServer::init(const std::string& address, uint16_t port,
+                                    const std::string& static_files_path) {
+  if (isInitialized_) {
+    std::cerr << "WebSocketTransportServer: Already initialized." << std::endl;
+    return false;
+  }
+  if (port == 0) {
+    std::cerr << "WebSocketTransportServer: Invalid port 0." << std::endl;
+    return false;
+  }
+  address_ = address;
+  port_ = port;
+  staticFilesPath_ = static_files_path;
+
+  try {
+    wsServer_.set_access_channels(websocketpp::log::alevel::none);
+    wsServer_.set_error_channels(websocketpp::log::elevel::warn |
+                                 websocketpp::log::elevel::rerror |
+                                 websocketpp::log::elevel::fatal);
+    wsServer_.init_asio();
+    wsServer_.set_reuse_addr(true);
+  } catch (const websocketpp::exception& e) {
+    std::cerr << "WebSocketTransportServer: Failed to initialize Asio: "
+              << e.what() << std::endl;
+    return false;
+  }
+
+  wsServer_.set_open_handler(
+      bind(&WebSocketTransportServer::handleOpen, this, _1));
+  wsServer_.set_close_handler(
+      bind(&WebSocketTransportServer::handleClose, this, _1));
+  wsServer_.set_message_handler(
+      bind(&WebSocketTransportServer::handleMessage, this, _1, _2));
+  wsServer_.set_http_handler(
+      bind(&WebSocketTransportServer::handleHttp, this, _1));
+
+  isInitialized_ = true;
+  std::cout << "WebSocketTransportServer: Initialized for " << address_ << ":"
+            << port_ << ", serving " << staticFilesPath_ << std::endl;
+  return true;
+}
+
+bool WebSocketTransportServer::start() {
+  if (!isInitialized_) {
+    std::cerr << "WebSocketTransportServer: start() called before init()."
+              << std::endl;
+    return false;
+  }
+  if (isRunning_) {
+    std::cout << "WebSocketTransportServer: Already running." << std::endl;
+    return true;
+  }
+
+  websocketpp::lib::error_code ec;
+  wsServer_.listen(address_, std::to_string(port_), ec);
+  if (ec) {
+    reportError("Failed to listen on " + address_ + ":" +
+                std::to_string(port_) + ": " + ec.message());
+    return false;
+  }
+  wsServer_.start_accept(ec);
+  if (ec) {
+    reportError("Failed to start accepting connections: " + ec.message());
+    return false;
+  }
+
+  pumpTimer_ = std::make_unique<websocketpp::lib::asio::steady_timer>(
+      wsServer_.get_io_service());
+  isRunning_ = true;
+  schedulePump();
+
+  asioThread_ = std::thread([this]() {
+    std::cout << "WebSocketTransportServer: Asio thread started." << std::endl;
+    try {
+      wsServer_.run();
+    } catch (const std::exception& e) {
+      reportError(std::string("Asio thread terminated: ") + e.what());
+    }
+    std::cout << "WebSocketTransportServer: Asio thread finished running."
+              << std::endl;
+  });
+
+  std::cout << "WebSocketTransportServer: Listening on " << address_ << ":"
+            << port_ << std::endl;
+  return true;
+}
+
+void WebSocketTransportServer::stop() {
+  if (!isRunning_.exchange(false)) {
+    return;
+  }
+  std::cout << "WebSocketTransportServer: Stopping..." << std::endl;
+
+  // Shut down on the Asio thread: stop accepting, close every client and
+  // cancel the pump. run() returns once the close handshakes complete (or
+  // time out).
+  websocketpp::lib::asio::post(wsServer_.get_io_service(), [this]() {
+    websocketpp::lib::error_code ec;
+    if (pumpTimer_) {
+      pumpTimer_->cancel();
+    }
+    wsServer_.stop_listening(ec);
+
+    std::vector<connection_hdl> handles;
+    {
+      std::lock_guard<std::mutex> lock(clientsMutex_);
+      for (const auto& entry : clients_) {
+        handles.push_back(entry.second.hdl);
+      }
+    }
+    for (const auto& hdl : handles) {
+      wsServer_.close(hdl, websocketpp::close::status::going_away,
+                      "Server shutting down", ec);
+    }
+  });
+
+  if (asioThread_.joinable()) {
+    asioThread_.join();
+  }
+  pumpTimer_.reset();
+
+  std::lock_guard<std::mutex> lock(clientsMutex_);
+  clients_.clear();
+  connectionIds_.clear();
+  std::cout << "WebSocketTransportServer: Stopped." << std::endl;
+}
+
+// --- Data Sending Methods ---
+
+bool WebSocketTransportServer::sendWebSocketMessage(
+    WebSocketConnectionId conn_id, const std::vector<char>& data) {
+  return enqueueReliable(conn_id, data.data(), data.size(),
+                         websocketpp::frame::opcode::binary);
+}
+
+bool WebSocketTransportServer::sendWebSocketMessage(
+    WebSocketConnectionId conn_id, const std::string& data) {
+  return enqueueReliable(conn_id, data.data(), data.size(),
+                         websocketpp::frame::opcode::text);
+}
+
+bool WebSocketTransportServer::sendToAllWebSocketClients(
+    const std::vector<char>& data) {
+  return enqueueReliableToAll(data.data(), data.size(),
+                              websocketpp::frame::opcode::binary);
+}
+
+bool WebSocketTransportServer::sendToAllWebSocketClients(
+    std::string_view data) {
+  return enqueueReliableToAll(data.data(), data.size(),
+                              websocketpp::frame::opcode::text);
+}
+
+bool WebSocketTransportServer::broadcastVideoFrame(
+    std::shared_ptr<const std::vector<char>> frame, VideoFrameType type) {
+  if (!isRunning_ || !frame) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    if (clients_.empty()) {
+      return false;
+    }
+  }
+  // Framed once, outside the lock; every client below shares this message.
+  message_ptr message = makeSharedVideoMessage(*frame);
+
+  bool need_key_frame = false;
+  bool offered = false;
+  {
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    for (auto& entry : clients_) {
+      ClientState& client = entry.second;
+      if (type == VideoFrameType::DeltaFrame) {
+        if (client.awaitingKeyFrame) {
+          ++client.videoFramesSkipped;
+          continue;
+        }
+        if (client.pendingVideoFrame) {
+          // The client has not taken the previous delta frame yet. Replacing
+          // it would corrupt the client's decoder, so drop both and restart
+          // this client from the next key frame.
+          client.videoFramesSkipped += 2;
+          client.pendingVideoFrame.reset();
+          client.awaitingKeyFrame = true;
+          need_key_frame = true;
+          continue;
+        }
+      } else {
+        if (client.pendingVideoFrame) {
+          // The client was not ready for the previous frame; only the newest
+          // one is worth delivering.
+          ++client.videoFramesSkipped;
+        }
+        client.awaitingKeyFrame = false;
+      }
+      client.pendingVideoFrame = message;
+      client.pendingVideoPaced = type == VideoFrameType::Independent;
+      scheduleFlushLocked(entry.first, client);
+      offered = true;
+    }
+  }
+  if (need_key_frame) {
+    requestVideoKeyFrame();
+  }
+  return offered;
+}
+
+std::vector<WebSocketClientStats> WebSocketTransportServer::getClientStats()
+    const {
+  std::vector<WebSocketClientStats> stats;
+  std::lock_guard<std::mutex> lock(clientsMutex_);
+  stats.reserve(clients_.size());
+  for (const auto& entry : clients_) {
+    const ClientState& client = entry.second;
+    WebSocketClientStats s;
+    s.conn_id = entry.first;
+    s.buffered_bytes = client.socketBufferedBytes + client.reliableQueueBytes +
+                       (client.pendingVideoFrame
+                            ? client.pendingVideoFrame->get_payload().size()
+                            : 0);
+    s.reliable_messages_sent = client.reliableMessagesSent;
+    s.video_frames_sent = client.videoFramesSent;
+    s.video_frames_skipped = client.videoFramesSkipped;
+    s.video_fps_limit = client.videoFpsLimit;
+    stats.push_back(s);
+  }
+  return stats;
+}
+
+// --- Handler Registration ---
+
+void WebSocketTransportServer::onWebSocketConnected(
+    OnWebSocketConnectedHandler handler) {
+  std::lock_guard<std::mutex> lock(handlersMutex_);
+  onConnectedHandler_ = std::move(handler);
+}
+
+void WebSocketTransportServer::onWebSocketDisconnected(
+    OnWebSocketDisconnectedHandler handler) {
+  std::lock_guard<std::mutex> lock(handlersMutex_);
+  onDisconnectedHandler_ = std::move(handler);
+}
+
+void WebSocketTransportServer::onWebSocketMessageReceived(
+    OnWebSocketMessageReceivedHandler handler) {
+  std::lock_guard<std::mutex> lock(handlersMutex_);
+  onMessageReceivedHandler_ = std::move(handler);
+}
+
+void WebSocketTransportServer::onServerError(OnServerErrorHandler handler) {
+  std::lock_guard<std::mutex> lock(handlersMutex_);
+  onServerErrorHandler_ = std::move(handler);
+}
+
+void WebSocketTransportServer::onVideoKeyFrameRequested(
+    OnVideoKeyFrameRequestedHandler handler) {
+  std::lock_guard<std::mutex> lock(handlersMutex_);
+  onVideoKeyFrameRequestedHandler_ = std::move(handler);
+}
+
+// --- websocketpp handlers (Asio thread) ---
+
+void WebSocketTransportServer::handleOpen(connection_hdl hdl) {
+  WebSocketConnectionId conn_id;
+  {
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    conn_id = nextConnectionId_++;
+    ClientState& client = clients_[conn_id];
+    client.hdl = hdl;
+    client.videoFpsLimit = config_.max_video_fps;
+    client.lastAdaptation = Clock::now();
+    connectionIds_[hdl] = conn_id;
+  }
+  std::cout << "WebSocketTransportServer: Client " << conn_id << " connected."
+            << std::endl;
+
+  OnWebSocketConnectedHandler handler;
+  {
+    std::lock_guard<std::mutex> lock(handlersMutex_);
+    handler = onConnectedHandler_;
+  }
+  if (handler) {
+    handler(conn_id);
+  }
+  // A new viewer of an encoded stream can only start decoding at a key frame.
+  requestVideoKeyFrame();
+}
+
+void WebSocketTransportServer::handleClose(connection_hdl hdl) {
+  WebSocketConnectionId conn_id;
+  {
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    auto it = connectionIds_.find(hdl);
+    if (it == connectionIds_.end()) {
+      return;
+    }
+    conn_id = it->second;
+    connectionIds_.erase(it);
+    clients_.erase(conn_id);
+  }
+  std::cout << "WebSocketTransportServer: Client " << conn_id
+            << " disconnected." << std::endl;
+
+  OnWebSocketDisconnectedHandler handler;
+  {
+    std::lock_guard<std::mutex> lock(handlersMutex_);
+    handler = onDisconnectedHandler_;
+  }
+  if (handler) {
+    handler(conn_id);
+  }
+}
+
+void WebSocketTransportServer::handleMessage(connection_hdl hdl,
+                                             message_ptr msg) {
+  WebSocketConnectionId conn_id;
+  {
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    auto it = connectionIds_.find(hdl);
+    if (it == connectionIds_.end()) {
+      return;
+    }
+    conn_id = it->second;
+  }
+
+  OnWebSocketMessageReceivedHandler handler;
+  {
+    std::lock_guard<std::mutex> lock(handlersMutex_);
+    handler = onMessageReceivedHandler_;
+  }
+  if (handler) {
+    // Lent to the handler: the message is released once it returns.
+    std::string& payload = msg->get_raw_payload();
+    handler(conn_id, payload.data(), payload.size());
+  }
+}
+
+void WebSocketTransportServer::handleHttp(connection_hdl hdl) {
+  server::connection_ptr con = wsServer_.get_con_from_hdl(hdl);
+
+  std::string resource = con->get_resource();
+  const size_t query_pos = resource.find('?');
+  if (query_pos != std::string::npos) {
+    resource.erase(query_pos);
+  }
+  if (resource.empty() || resource == "/") {
+    resource = "/index.html";
+  }
+  // Never serve anything outside the static directory.
+  if (resource.find("..") != std::string::npos) {
+    con->set_status(websocketpp::http::status_code::forbidden);
+    return;
+  }
+
+  std::ifstream file(staticFilesPath_ + resource, std::ios::binary);
+  if (!file) {
+    con->set_status(websocketpp::http::status_code::not_found);
+    con->set_body("Not found");
+    return;
+  }
+  std::ostringstream body;
+  body << file.rdbuf();
+
+  con->append_header("Content-Type", ContentTypeForPath(resource));
+  con->append_header("Cache-Control", "no-cache");
+  con->set_body(body.str());
+  con->set_status(websocketpp::http::status_code::ok);
+}
+
+// --- Send path ---
+
+bool WebSocketTransportServer::enqueueReliable(
+    WebSocketConnectionId conn_id, const char* data, size_t size,
+    websocketpp::frame::opcode::value opcode) {
+  if (!isRunning_) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(clientsMutex_);
+  auto it = clients_.find(conn_id);
+  if (it == clients_.end()) {
+    return false;
+  }
+  ClientState& client = it->second;
+  client.reliableQueue.push_back({std::string(data, size), opcode});
+  client.reliableQueueBytes += size;
+  scheduleFlushLocked(conn_id, client);
+  return true;
+}
+
+bool WebSocketTransportServer::enqueueReliableToAll(
+    const char* data, size_t size, websocketpp::frame::opcode::value opcode) {
+  if (!isRunning_) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(clientsMutex_);
+  for (auto& entry : clients_) {
+    ClientState& client = entry.second;
+    client.reliableQueue.push_back({std::string(data, size), opcode});
+    client.reliableQueueBytes += size;
+    scheduleFlushLocked(entry.first, client);
+  }
+  return !clients_.empty();
+}
+
+WebSocketTransportServer::message_ptr
+WebSocketTransportServer::makeSharedVideoMessage(
+    const std::vector<char>& frame) {
+  message_ptr message = websocketpp::lib::make_shared<message_type>(
+      message_type::con_msg_man_ptr(),
+      websocketpp::frame::opcode::binary, frame.size());
+  message->set_payload(frame.data(), frame.size());
+
+  websocketpp::frame::basic_header basic(websocketpp::frame::opcode::binary,
+                                         frame.size(), /*fin=*/true,
+                                         /*mask=*/false);
+  websocketpp::frame::extended_header extended(frame.size());
+  message->set_header(websocketpp::frame::prepare_header(basic, extended));
+  message->set_prepared(true);
+  return message;
+}
+
+void WebSocketTransportServer::scheduleFlushLocked(
+    WebSocketConnectionId conn_id, ClientState& client) {
+  if (client.flushScheduled) {
+    return;
+  }
+  client.flushScheduled = true;
+  websocketpp::lib::asio::post(wsServer_.get_io_service(),
+                               [this, conn_id]() { flushClient(conn_id); });
+}
+
+void WebSocketTransportServer::flushClient(WebSocketConnectionId conn_id) {
+  connection_hdl too_slow;
+  {
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    auto it = clients_.find(conn_id);
+    if (it == clients_.end()) {
+      return;
+    }
+    it->second.flushScheduled = false;
+    if (flushClientLocked(it->second, Clock::now())) {
+      return;
+    }
+    too_slow = it->second.hdl;
+  }
+  std::cerr << "WebSocketTransportServer: Client " << conn_id
+            << " is not draining its socket, disconnecting." << std::endl;
+  websocketpp::lib::error_code ec;
+  wsServer_.close(too_slow, websocketpp::close::status::try_again_later,
+                  "Client too slow", ec);
+}
+
+bool WebSocketTransportServer::flushClientLocked(ClientState& client,
+                                                 Clock::time_point now) {
+  websocketpp::lib::error_code ec;
+  server::connection_ptr con = wsServer_.get_con_from_hdl(client.hdl, ec);
+  if (ec || !con || con->get_state() != websocketpp::session::state::open) {
+    // The close handler will remove the client.
+    return true;
+  }
+
+  // Reliable messages first, so telemetry never waits behind video.
+  while (!client.reliableQueue.empty()) {
+    const OutgoingMessage& message = client.reliableQueue.front();
+    ec = con->send(message.payload.data(), message.payload.size(),
+                   message.opcode);
+    if (ec) {
+      std::cerr << "WebSocketTransportServer: Failed to send message: "
+                << ec.message() << std::endl;
+      break;
+    }
+    client.reliableQueueBytes -= message.payload.size();
+    client.reliableQueue.pop_front();
+    ++client.reliableMessagesSent;
+  }
+
+  const size_t buffered = con->get_buffered_amount();
+  client.socketBufferedBytes = buffered;
+  if (buffered > config_.max_buffered_bytes) {
+    return false;
+  }
+  const bool behind = buffered > config_.video_buffered_bytes_threshold;
+  if (behind) {
+    client.fellBehindSinceAdaptation = true;
+  }
+  adaptVideoRateLocked(client, now);
+
+  if (!client.pendingVideoFrame || behind) {
+    return true;
+  }
+  const auto min_interval = std::chrono::duration<double>(
+      1.0 / std::max(client.videoFpsLimit, config_.min_video_fps));
+  if (client.pendingVideoPaced && now - client.lastVideoSent < min_interval) {
+    // Paced out; the pump retries on its next tick.
+    return true;
+  }
+
+  // The message is already prepared, so websocketpp queues the shared buffer
+  // directly instead of copying it for this connection.
+  ec = con->send(client.pendingVideoFrame);
+  client.pendingVideoFrame.reset();
+  if (ec) {
+    std::cerr << "WebSocketTransportServer: Failed to send video frame: "
+              << ec.message() << std::endl;
+    return true;
+  }
+  client.lastVideoSent = now;
+  ++client.videoFramesSent;
+  client.socketBufferedBytes = con->get_buffered_amount();
+  return true;
+}
+
+void WebSocketTransportServer::adaptVideoRateLocked(ClientState& client,
+                                                    Clock::time_point now) {
+  if (now - client.lastAdaptation <
+      std::chrono::milliseconds(config_.adaptation_interval_ms)) {
+    return;
+  }
+  if (client.fellBehindSinceAdaptation) {
+    client.videoFpsLimit =
+        std::max(config_.min_video_fps,
+                 client.videoFpsLimit * config_.fps_decrease_factor);
+  } else {
+    client.videoFpsLimit =
+        std::min(config_.max_video_fps,
+                 client.videoFpsLimit + config_.fps_increase_step);
+  }
+  client.fellBehindSinceAdaptation = false;
+  client.lastAdaptation = now;
+}
+
+// --- Pump ---
+
+void WebSocketTransportServer::schedulePump() {
+  if (!isRunning_ || !pumpTimer_) {
+    return;
+  }
+  pumpTimer_->expires_after(
+      std::chrono::milliseconds(config_.pump_interval_ms));
+  pumpTimer_->async_wait(
+      [this](const websocketpp::lib::asio::error_code& ec) {
+        if (ec) {
+          return;  // Cancelled during stop()
+        }
+        onPump();
+        schedulePump();
+      });
+}
+
+void WebSocketTransportServer::onPump() {
+  std::vector<connection_hdl> too_slow;
+  {
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    const Clock::time_point now = Clock::now();
+    for (auto& entry : clients_) {
+      if (!flushClientLocked(entry.second, now)) {
+        too_slow.push_back(entry.second.hdl);
+      }
+    }
+  }
+  for (const auto& hdl : too_slow) {
+    std::cerr << "WebSocketTransportServer: Disconnecting client that is not "
+                 "draining its socket."
+              << std::endl;
+    websocketpp::lib::error_code ec;
+    wsServer_.close(hdl, websocketpp::close::status::try_again_later,
+                    "Client too slow", ec);
+  }
+}
+
+void WebSocketTransportServer::requestVideoKeyFrame() {
+  OnVideoKeyFrameRequestedHandler handler;
+  {
+    std::lock_guard<std::mutex> lock(handlersMutex_);
+    handler = onVideoKeyFrameRequestedHandler_;
+  }
+  if (handler) {
+    handler();
+  }
+}
+
+void WebSocketTransportServer::reportError(const std::string& error_msg) {
+  std::cerr << "WebSocketTransportServer Error: " << error_msg << std::endl;
+  OnServerErrorHandler handler;
+  {
+    std::lock_guard<std::mutex> lock(handlersMutex_);
+    handler = onServerErrorHandler_;
+  }
+  if (handler) {
+    handler(error_msg);
+  }
+}
+
+}  // namespace transport
+}  // namespace remote
+}  // namespace autodev
@@ -0,0 +1,204 @@
+#ifndef WEBSOCKET_TRANSPORT_SERVER_H
+#define WEBSOCKET_TRANSPORT_SERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "transport/transport_server.h"  // Include the interface
+
+// --- Include websocketpp ---
+// The server only listens on the local interface for the cockpit UI, so the
+// plain (non-TLS) Asio config is used.
+#include <websocketpp/config/asio_no_tls.hpp>
+#include <websocketpp/server.hpp>
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace transport {
+
+// Tuning for per-client flow control. Defaults suit a local browser on the
+// same machine or LAN showing ~30 fps JPEG video.
+struct WebSocketTransportServerConfig {
+  // Interval of the pump that paces video and adapts per-client frame rates.
+  int pump_interval_ms = 5;
+  // How often each client's frame rate limit is re-evaluated.
+  int adaptation_interval_ms = 200;
+
+  // Video frame rate bounds per client. Each client starts at max_video_fps.
+  double max_video_fps = 30.0;
+  double min_video_fps = 2.0;
+  // AIMD: while the client keeps up the limit grows by fps_increase_step per
+  // adaptation interval; when it falls behind the limit is multiplied by
+  // fps_decrease_factor.
+  double fps_increase_step = 2.0;
+  double fps_decrease_factor = 0.5;
+
+  // A client is "behind" when more than this many bytes are still waiting in
+  // its socket write buffer. No new video frame is written while above it.
+  size_t video_buffered_bytes_threshold = 512 * 1024;
+  // A client whose write buffer exceeds this (i.e. it no longer drains even
+  // reliable messages) is disconnected so it cannot grow memory unbounded.
+  size_t max_buffered_bytes = 16 * 1024 * 1024;
+};
+
+// WebSocket + static HTTP server for the cockpit UI, built on websocketpp.
+// Every client has its own send state:
+//  - a reliable FIFO for telemetry, signaling and status messages, always
+//    written ahead of video;
+//  - a latest-only video slot, where a newer frame replaces one the client
+//    has not been ready for yet;
+//  - an adaptive video frame rate limit driven by the client's buffered bytes.
+// All socket writes happen on the server's Asio thread; the public send
+// methods only update queues and schedule a flush. MUST BE THREAD-SAFE.
+class WebSocketTransportServer : public ITransportServer {
+ public:
+  explicit WebSocketTransportServer(
+      const WebSocketTransportServerConfig& config =
+          WebSocketTransportServerConfig());
+  ~WebSocketTransportServer() override;
+
+  // --- Implementation of ITransportServer Interface ---
+  bool init(const std::string& address, uint16_t port,
+            const std::string& static_files_path) override;
+  bool start() override;
+  void stop() override;
+
+  bool sendWebSocketMessage(WebSocketConnectionId conn_id,
+                            const std::vector<char>& data) override;
+  bool sendWebSocketMessage(WebSocketConnectionId conn_id,
+                            const std::string& data) override;
+  bool sendToAllWebSocketClients(const std::vector<char>& data) override;
+  bool sendToAllWebSocketClients(std::string_view data) override;
+  bool broadcastVideoFrame(std::shared_ptr<const std::vector<char>> frame,
+                           VideoFrameType type) override;
+  std::vector<WebSocketClientStats> getClientStats() const override;
+
+  void onWebSocketConnected(OnWebSocketConnectedHandler handler) override;
+  void onWebSocketDisconnected(OnWebSocketDisconnectedHandler handler) override;
+  void onWebSocketMessageReceived(
+      OnWebSocketMessageReceivedHandler handler) override;
+  void onServerError(OnServerErrorHandler handler) override;
+  void onVideoKeyFrameRequested(
+      OnVideoKeyFrameRequestedHandler handler) override;
+
+ private:
+  using server = websocketpp::server<websocketpp::config::asio>;
+  using connection_hdl = websocketpp::connection_hdl;
+  using message_type = websocketpp::config::asio::message_type;
+  using message_ptr = server::message_ptr;
+  using Clock = std::chrono::steady_clock;
+
+  struct OutgoingMessage {
+    std::string payload;
+    websocketpp::frame::opcode::value opcode;
+  };
+
+  // Per-connection send state. Guarded by clientsMutex_.
+  struct ClientState {
+    connection_hdl hdl;
+    std::deque<OutgoingMessage> reliableQueue;
+    size_t reliableQueueBytes = 0;
+    // Wire-ready frame shared with every other client (see
+    // makeSharedVideoMessage); null when nothing is pending.
+    message_ptr pendingVideoFrame;
+    // Independent frames are paced to videoFpsLimit; encoded key/delta frames
+    // keep the sender's cadence.
+    bool pendingVideoPaced = false;
+    // Set after this client missed a delta frame (or just connected); delta
+    // frames are skipped until the next key frame.
+    bool awaitingKeyFrame = true;
+    bool flushScheduled = false;
+
+    // Adaptive pacing
+    double videoFpsLimit = 0.0;
+    Clock::time_point lastVideoSent;
+    Clock::time_point lastAdaptation;
+    bool fellBehindSinceAdaptation = false;
+
+    // Stats
+    size_t socketBufferedBytes = 0;  // Last sampled library write buffer
+    uint64_t reliableMessagesSent = 0;
+    uint64_t videoFramesSent = 0;
+    uint64_t videoFramesSkipped = 0;
+  };
+
+  // --- websocketpp handlers (called in the Asio thread) ---
+  void handleOpen(connection_hdl hdl);
+  void handleClose(connection_hdl hdl);
+  void handleMessage(connection_hdl hdl, message_ptr msg);
+  void handleHttp(connection_hdl hdl);
+
+  // --- Send path ---
+  // Builds a binary message whose WebSocket frame header is already written,
+  // so websocketpp sends it as-is on every connection instead of re-framing a
+  // copy per connection. Valid because server frames are never masked and no
+  // per-message extension (e.g. permessage-deflate) is enabled.
+  static message_ptr makeSharedVideoMessage(const std::vector<char>& frame);
+  bool enqueueReliable(WebSocketConnectionId conn_id, const char* data,
+                       size_t size, websocketpp::frame::opcode::value opcode);
+  bool enqueueReliableToAll(const char* data, size_t size,
+                            websocketpp::frame::opcode::value opcode);
+  // Posts a flush of 'conn_id' to the Asio thread unless one is pending.
+  void scheduleFlushLocked(WebSocketConnectionId conn_id, ClientState& client);
+  // Writes whatever the client is allowed to receive now (Asio thread).
+  void flushClient(WebSocketConnectionId conn_id);
+  // Flush + rate adaptation for a single client; clientsMutex_ MUST be held.
+  // Returns false if the client must be disconnected for falling too far
+  // behind.
+  bool flushClientLocked(ClientState& client, Clock::time_point now);
+  void adaptVideoRateLocked(ClientState& client, Clock::time_point now);
+
+  // Periodic pump (Asio thread).
+  void schedulePump();
+  void onPump();
+
+  void reportError(const std::string& error_msg);
+  void requestVideoKeyFrame();
+
+  const WebSocketTransportServerConfig config_;
+
+  server wsServer_;
+  std::unique_ptr<websocketpp::lib::asio::steady_timer> pumpTimer_;
+  std::thread asioThread_;
+  std::atomic<bool> isInitialized_{false};
+  std::atomic<bool> isRunning_{false};
+
+  std::string address_;
+  uint16_t port_ = 0;
+  std::string staticFilesPath_;
+
+  // Connection bookkeeping
+  mutable std::mutex clientsMutex_;
+  std::map<WebSocketConnectionId, ClientState> clients_;  // Guarded
+  std::map<connection_hdl, WebSocketConnectionId,
+           std::owner_less<connection_hdl>>
+      connectionIds_;  // Guarded by clientsMutex_
+  WebSocketConnectionId nextConnectionId_ = 1;  // Guarded by clientsMutex_
+
+  // Application handlers
+  mutable std::mutex handlersMutex_;
+  OnWebSocketConnectedHandler onConnectedHandler_;
+  OnWebSocketDisconnectedHandler onDisconnectedHandler_;
+  OnWebSocketMessageReceivedHandler onMessageReceivedHandler_;
+  OnServerErrorHandler onServerErrorHandler_;
+  OnVideoKeyFrameRequestedHandler onVideoKeyFrameRequestedHandler_;
+
+  // Prevent copying
+  WebSocketTransportServer(const WebSocketTransportServer&) = delete;
+  WebSocketTransportServer& operator=(const WebSocketTransportServer&) = delete;
+};
+
+}  // namespace transport
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // WEBSOCKET_TRANSPORT_SERVER_H
@@ -0,0 +1,183 @@
+// Handoff latency through VehicleShmBridge between two threads, each with
+// its own mapping of the object as the two processes would have.
+//
+// The client side pushes a command into the SPSC ring; the autonomy side
+// spins on popCommand() and answers with a chassis state (seqlock slot)
+// carrying the command's timestamp, which the client spins on. Reported:
+// - ring handoff: push on the client to pop on the autonomy side;
+// - seqlock handoff: publishChassis to the client seeing the new version;
+// - round trip: both, measured on the client.
+// Timestamps are steady_clock, shared by the threads. Single-threaded op
+// costs are printed first for reference.
+//
+// The handoff is only meaningful with the threads on two cores: pass the
+// CPUs to pin them to (e.g., two cores of one socket). With a single CPU
+// both threads yield while spinning and the figures are context switches.
+//
+// Build, then run, from the repository root:
+//   g++ -std=c++17 -O2 -I. -o /tmp/vehicle_shm_bridge_benchmark
+//       ipc/benchmarks/vehicle_shm_bridge_benchmark.cc
+//       ipc/vehicle_shm_bridge.cc ipc/shared_memory.cc -lpthread -lrt
+//   /tmp/vehicle_shm_bridge_benchmark [client_cpu autonomy_cpu]
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ipc/shared_memory.h"
+#include "ipc/vehicle_shm_bridge.h"
+#include "testing/benchmark.h"
+
+namespace {
+
+using autodev::remote::ipc::SharedMemoryRegion;
+using autodev::remote::ipc::ShmChassisState;
+using autodev::remote::ipc::ShmCommand;
+using autodev::remote::ipc::VehicleShmBridge;
+using autodev::remote::testing::DoNotOptimize;
+using autodev::remote::testing::NanosPerOp;
+using autodev::remote::testing::PrintResult;
+
+constexpr int kRoundTrips = 200000;
+
+int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void Pin(int cpu) {
+  if (cpu < 0) return;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+    std::fprintf(stderr, "Failed to pin to CPU %d\n", cpu);
+    std::exit(1);
+  }
+}
+
+// Busy-wait step: spin on two cores, let the other thread run on one.
+void Relax(bool yield) {
+  if (yield) std::this_thread::yield();
+}
+
+double Percentile(std::vector<int64_t> values, double p) {
+  if (values.empty()) return 0.0;
+  const size_t index = std::min(
+      values.size() - 1, static_cast<size_t>(p * values.size()));
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return static_cast<double>(values[index]);
+}
+
+void PrintLatency(const char* name, const std::vector<int64_t>& ns) {
+  std::printf("%-36s p50 %8.0f  p99 %8.0f  p99.9 %8.0f ns\n", name,
+              Percentile(ns, 0.5), Percentile(ns, 0.99),
+              Percentile(ns, 0.999));
+}
+
+void BenchmarkSingleThread(VehicleShmBridge* client,
+                           VehicleShmBridge* autonomy) {
+  ShmCommand command;
+  ShmCommand popped;
+  PrintResult("ring push+pop (one thread)",
+              NanosPerOp(10000000, [&] {
+                client->pushCommand(command);
+                autonomy->popCommand(&popped);
+                DoNotOptimize(popped);
+              }));
+  ShmChassisState state;
+  ShmChassisState loaded;
+  PrintResult("seqlock publish+load (one thread)",
+              NanosPerOp(10000000, [&] {
+                ++state.timestamp_ns;
+                autonomy->publishChassis(state);
+                client->latestChassis(&loaded);
+                DoNotOptimize(loaded);
+              }));
+}
+
+void BenchmarkHandoff(VehicleShmBridge* client, VehicleShmBridge* autonomy,
+                      int client_cpu, int autonomy_cpu, bool yield) {
+  std::vector<int64_t> ring_ns(kRoundTrips);
+  std::vector<int64_t> seqlock_ns(kRoundTrips);
+  std::vector<int64_t> round_trip_ns(kRoundTrips);
+  std::atomic<bool> ready{false};
+
+  // Autonomy side: pop each command, answer with a chassis state.
+  std::thread autonomy_thread([&] {
+    Pin(autonomy_cpu);
+    ready.store(true);
+    ShmCommand command;
+    for (int i = 0; i < kRoundTrips; ++i) {
+      while (!autonomy->popCommand(&command)) Relax(yield);
+      const int64_t popped_ns = NowNs();
+      ring_ns[i] = popped_ns - command.control.timestamp_ns;
+      ShmChassisState state;
+      state.timestamp_ns = NowNs();
+      state.gear = command.control.gear;  // Round trip id
+      autonomy->publishChassis(state);
+    }
+  });
+
+  Pin(client_cpu);
+  while (!ready.load()) Relax(true);
+  ShmCommand command;
+  ShmChassisState state;
+  for (int i = 0; i < kRoundTrips; ++i) {
+    const uint64_t version = client->chassisVersion();
+    command.control.gear = i;
+    command.control.timestamp_ns = NowNs();
+    if (!client->pushCommand(command)) {
+      std::fprintf(stderr, "Command ring full\n");
+      std::exit(1);
+    }
+    while (client->chassisVersion() == version) Relax(yield);
+    const int64_t seen_ns = NowNs();
+    if (!client->latestChassis(&state) || state.gear != i) {
+      std::fprintf(stderr, "Unexpected chassis state\n");
+      std::exit(1);
+    }
+    seqlock_ns[i] = seen_ns - state.timestamp_ns;
+    round_trip_ns[i] = seen_ns - command.control.timestamp_ns;
+  }
+  autonomy_thread.join();
+
+  PrintLatency("ring handoff (two threads)", ring_ns);
+  PrintLatency("seqlock handoff (two threads)", seqlock_ns);
+  PrintLatency("round trip (two threads)", round_trip_ns);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int client_cpu = argc > 2 ? std::atoi(argv[1]) : -1;
+  const int autonomy_cpu = argc > 2 ? std::atoi(argv[2]) : -1;
+  const bool single_cpu = std::thread::hardware_concurrency() < 2 ||
+                          (client_cpu >= 0 && client_cpu == autonomy_cpu);
+  if (single_cpu) {
+    std::printf("single CPU: spinning threads yield, the handoff figures "
+                "are context switches\n");
+  }
+
+  const std::string name =
+      "/autodev_shm_bridge_benchmark_" + std::to_string(getpid());
+  VehicleShmBridge autonomy;
+  VehicleShmBridge client;
+  if (!autonomy.open(name) || !client.open(name)) return 1;
+  SharedMemoryRegion::unlink(name);  // The mappings stay valid
+
+  BenchmarkSingleThread(&client, &autonomy);
+  BenchmarkHandoff(&client, &autonomy, client_cpu, autonomy_cpu, single_cpu);
+  return 0;
+}
@@ -0,0 +1,71 @@
+#include "ipc/mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace autodev {
+namespace remote {
+namespace ipc {
+
+MappedFile::~MappedFile() { close(); }
+
+bool MappedFile::open(const std::string& path) {
+  close();
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    std::cerr << "MappedFile: Failed to open " << path << ": "
+              << std::strerror(errno) << std::endl;
+    return false;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    std::cerr << "MappedFile: " << path << " is not a regular file."
+              << std::endl;
+    ::close(fd);
+    return false;
+  }
+  const size_t size = static_cast<size_t>(st.st_size);
+  if (size > 0) {
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      std::cerr << "MappedFile: mmap of " << path
+                << " failed: " << std::strerror(errno) << std::endl;
+      ::close(fd);
+      return false;
+    }
+    ::madvise(data, size, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(data);
+  }
+  ::close(fd);  // The mapping keeps the file
+  size_ = size;
+  open_ = true;
+  return true;
+}
+
+void MappedFile::close() {
+  if (data_) ::munmap(const_cast<char*>(data_), size_);
+  data_ = nullptr;
+  size_ = 0;
+  open_ = false;
+}
+
+void MappedFile::release(size_t offset, size_t size) const {
+  if (!data_ || offset >= size_) return;
+  // madvise works on whole pages: only those entirely inside the range.
+  const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  const size_t begin = (offset + page - 1) / page * page;
+  const size_t end = offset + size < size_ ? (offset + size) / page * page
+                                           : size_;
+  if (end <= begin) return;
+  ::madvise(const_cast<char*>(data_) + begin, end - begin, MADV_DONTNEED);
+}
+
+}  // namespace ipc
+}  // namespace remote
+}  // namespace autodev
@@ -0,0 +1,48 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace ipc {
+
+// A regular file mapped read-only into this process (mmap), so large files
+// are read through the page cache without copying them into memory.
+class MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile();  // Unmaps
+
+  // Maps the whole file, hinting sequential access (readahead). An empty
+  // file maps to data() == nullptr, size() == 0. Returns false on error
+  // (logged).
+  bool open(const std::string& path);
+  void close();
+
+  bool isOpen() const { return open_; }
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+  // Unmaps the pages of [offset, offset + size) from this process once they
+  // were read (they are mapped again if read again), so a long sequential
+  // read does not add up in the process's resident memory.
+  void release(size_t offset, size_t size) const;
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  bool open_ = false;
+
+  // Prevent copying
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+};
+
+}  // namespace ipc
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // MAPPED_FILE_H
@@ -0,0 +1,90 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace ipc {
+
+// Latest-value slot for one writer and any number of readers, which may
+// live in other processes (the slot can be placed in shared memory).
+//
+// The writer never waits. A reader copies the value and retries if a write
+// overlapped (odd or changed sequence). The value is copied word by word
+// with relaxed atomics, so a torn copy is never used and there is no data
+// race.
+template <typename T>
+class SeqlockSlot {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "SeqlockSlot values are copied bytewise");
+  static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                "Shared memory needs address-free (lock-free) atomics");
+
+ public:
+  SeqlockSlot() = default;
+
+  // Single writer only. A sequence left odd by a writer that died in the
+  // middle of a store is rounded up, so a restarted writer makes it even.
+  void store(const T& value) {
+    uint64_t words[kWords] = {};
+    std::memcpy(words, &value, sizeof(T));
+    uint64_t seq = seq_.load(std::memory_order_relaxed);
+    if (seq & 1) ++seq;
+    seq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kWords; ++i) {
+      words_[i].store(words[i], std::memory_order_relaxed);
+    }
+    seq_.store(seq + 2, std::memory_order_release);
+  }
+
+  // Copies the latest value to *value and its version (number of stores so
+  // far) to *version. Returns false if nothing was stored yet, or if no
+  // consistent copy was obtained within max_attempts (e.g., the writer died
+  // in the middle of a store).
+  bool load(T* value, uint64_t* version = nullptr,
+            int max_attempts = 1000) const {
+    uint64_t words[kWords];
+    for (int attempt = 0; attempt < max_attempts; ++attempt) {
+      const uint64_t before = seq_.load(std::memory_order_acquire);
+      if (before & 1) continue;  // Write in progress
+      for (size_t i = 0; i < kWords; ++i) {
+        words[i] = words_[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (seq_.load(std::memory_order_relaxed) != before) continue;
+      if (before == 0) return false;
+      std::memcpy(value, words, sizeof(T));
+      if (version) *version = before / 2;
+      return true;
+    }
+    return false;
+  }
+
+  // Number of stores so far; cheap check for a new value.
+  uint64_t version() const {
+    return seq_.load(std::memory_order_acquire) / 2;
+  }
+
+ private:
+  static constexpr size_t kWords = (sizeof(T) + 7) / 8;
+
+  std::atomic<uint64_t> seq_{0};  // Odd while a store is in progress
+  std::atomic<uint64_t> words_[kWords] = {};
+
+  // Prevent copying
+  SeqlockSlot(const SeqlockSlot&) = delete;
+  SeqlockSlot& operator=(const SeqlockSlot&) = delete;
+};
+
+}  // namespace ipc
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // SEQLOCK_H
@@ -0,0 +1,89 @@
+#include "ipc/shared_memory.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace autodev {
+namespace remote {
+namespace ipc {
+
+SharedMemoryRegion::~SharedMemoryRegion() { close(); }
+
+bool SharedMemoryRegion::open(const std::string& name, size_t size,
+                              bool* created) {
+  close();
+  *created = false;
+  int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0660);
+  if (fd >= 0) {
+    *created = true;
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+      std::cerr << "SharedMemoryRegion: ftruncate of " << name
+                << " failed: " << std::strerror(errno) << std::endl;
+      ::close(fd);
+      ::shm_unlink(name.c_str());
+      return false;
+    }
+  } else if (errno == EEXIST) {
+    fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+      std::cerr << "SharedMemoryRegion: Failed to open " << name << ": "
+                << std::strerror(errno) << std::endl;
+      return false;
+    }
+    // The creator may not have sized it yet.
+    struct stat st;
+    for (int i = 0; i < 100 && ::fstat(fd, &st) == 0 && st.st_size == 0; ++i) {
+      ::usleep(1000);
+    }
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < size) {
+      std::cerr << "SharedMemoryRegion: " << name << " is smaller than "
+                << size << " bytes (created by another version?)."
+                << std::endl;
+      ::close(fd);
+      return false;
+    }
+  } else {
+    std::cerr << "SharedMemoryRegion: Failed to create " << name << ": "
+              << std::strerror(errno) << std::endl;
+    return false;
+  }
+
+  void* data =
+      ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);  // The mapping keeps the object
+  if (data == MAP_FAILED) {
+    std::cerr << "SharedMemoryRegion: mmap of " << name
+              << " failed: " << std::strerror(errno) << std::endl;
+    if (*created) ::shm_unlink(name.c_str());
+    return false;
+  }
+  data_ = data;
+  size_ = size;
+  return true;
+}
+
+void SharedMemoryRegion::close() {
+  if (!data_) return;
+  ::munmap(data_, size_);
+  data_ = nullptr;
+  size_ = 0;
+}
+
+bool SharedMemoryRegion::unlink(const std::string& name) {
+  if (::shm_unlink(name.c_str()) != 0 && errno != ENOENT) {
+    std::cerr << "SharedMemoryRegion: Failed to unlink " << name << ": "
+              << std::strerror(errno) << std::endl;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace ipc
+}  // namespace remote
+}  // namespace autodev
@@ -0,0 +1,45 @@
+#ifndef SHARED_MEMORY_H
+#define SHARED_MEMORY_H
+
+#include <cstddef>
+#include <string>
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace ipc {
+
+// A POSIX shared memory object (shm_open) mapped into this process.
+class SharedMemoryRegion {
+ public:
+  SharedMemoryRegion() = default;
+  ~SharedMemoryRegion();  // Unmaps; the object itself stays (see unlink())
+
+  // Opens the object 'name' (e.g., "/autodev_vehicle"), creating it with
+  // 'size' zero-filled bytes if it does not exist, and maps it read-write.
+  // *created tells whether this call created it (and must initialize it).
+  // Returns false on error (logged), or if an existing object is smaller
+  // than 'size'.
+  bool open(const std::string& name, size_t size, bool* created);
+  void close();
+
+  // Removes the name; mappings stay valid until closed.
+  static bool unlink(const std::string& name);
+
+  void* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  void* data_ = nullptr;
+  size_t size_ = 0;
+
+  // Prevent copying
+  SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+  SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+};
+
+}  // namespace ipc
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // SHARED_MEMORY_H
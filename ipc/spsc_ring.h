@@ -0,0 +1,87 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace ipc {
+
+// Bounded FIFO between one producer and one consumer, lock-free and
+// wait-free for both. Fixed-size and self-contained, so it can be placed in
+// shared memory with the producer and consumer in different processes.
+//
+// The indices grow without wrapping (64 bits); a slot is index % Capacity.
+// Producer and consumer each keep a cached copy of the other side's index,
+// so the shared cache lines are only touched when the cache says full or
+// empty.
+template <typename T, size_t Capacity>
+class SpscRing {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "SpscRing elements are copied bytewise");
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+  static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                "Shared memory needs address-free (lock-free) atomics");
+
+ public:
+  SpscRing() = default;
+
+  // Producer only. Returns false if the ring is full.
+  bool tryPush(const T& value) {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - producerHeadCache_ >= Capacity) {
+      producerHeadCache_ = head_.load(std::memory_order_acquire);
+      if (tail - producerHeadCache_ >= Capacity) return false;
+    }
+    slots_[tail & (Capacity - 1)] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only. Returns false if the ring is empty.
+  bool tryPop(T* value) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head == consumerTailCache_) {
+      consumerTailCache_ = tail_.load(std::memory_order_acquire);
+      if (head == consumerTailCache_) return false;
+    }
+    *value = slots_[head & (Capacity - 1)];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Approximate when called concurrently with push/pop.
+  size_t size() const {
+    return static_cast<size_t>(tail_.load(std::memory_order_acquire) -
+                               head_.load(std::memory_order_acquire));
+  }
+
+  static constexpr size_t capacity() { return Capacity; }
+
+ private:
+  static constexpr size_t kCacheLine = 64;
+
+  // Consumer side
+  alignas(kCacheLine) std::atomic<uint64_t> head_{0};  // Next to pop
+  uint64_t consumerTailCache_ = 0;
+  // Producer side
+  alignas(kCacheLine) std::atomic<uint64_t> tail_{0};  // Next to push
+  uint64_t producerHeadCache_ = 0;
+
+  alignas(kCacheLine) T slots_[Capacity] = {};
+
+  // Prevent copying
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+};
+
+}  // namespace ipc
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // SPSC_RING_H
@@ -0,0 +1,105 @@
+#include "ipc/vehicle_shm_bridge.h"
+
+#include <chrono>
+#include <iostream>
+#include <new>
+#include <thread>
+
+namespace autodev {
+namespace remote {
+namespace ipc {
+
+bool VehicleShmBridge::open(const std::string& name, int init_timeout_ms) {
+  close();
+  bool created = false;
+  if (!region_.open(name, sizeof(VehicleShmLayout), &created)) return false;
+
+  if (created) {
+    // The object is zero-filled; construct the layout, then publish it.
+    layout_ = new (region_.data()) VehicleShmLayout();
+    layout_->layout_size = sizeof(VehicleShmLayout);
+    layout_->magic.store(VehicleShmLayout::kMagic, std::memory_order_release);
+    std::cout << "VehicleShmBridge: Created " << name << " ("
+              << sizeof(VehicleShmLayout) << " bytes)." << std::endl;
+    return true;
+  }
+
+  VehicleShmLayout* layout = static_cast<VehicleShmLayout*>(region_.data());
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(init_timeout_ms);
+  while (layout->magic.load(std::memory_order_acquire) == 0 &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  if (layout->magic.load(std::memory_order_acquire) !=
+          VehicleShmLayout::kMagic ||
+      layout->layout_size != sizeof(VehicleShmLayout)) {
+    std::cerr << "VehicleShmBridge: " << name
+              << " is not initialized or has another layout version."
+              << std::endl;
+    region_.close();
+    return false;
+  }
+  layout_ = layout;
+  std::cout << "VehicleShmBridge: Attached to " << name << "." << std::endl;
+  return true;
+}
+
+void VehicleShmBridge::close() {
+  layout_ = nullptr;
+  region_.close();
+}
+
+// --- Autonomy stack side ---
+
+void VehicleShmBridge::publishChassis(const ShmChassisState& state) {
+  layout_->chassis.store(state);
+}
+
+bool VehicleShmBridge::popCommand(ShmCommand* command) {
+  return layout_->commands.tryPop(command);
+}
+
+bool VehicleShmBridge::latestControl(ShmControlCommand* command,
+                                     uint64_t* version) const {
+  return layout_->control.load(command, version);
+}
+
+bool VehicleShmBridge::latestLimits(ShmControlLimits* limits,
+                                    uint64_t* version) const {
+  return layout_->limits.load(limits, version);
+}
+
+size_t VehicleShmBridge::discardCommands() {
+  size_t discarded = 0;
+  ShmCommand command;
+  while (layout_->commands.tryPop(&command)) ++discarded;
+  return discarded;
+}
+
+// --- Remote-driving client side ---
+
+bool VehicleShmBridge::latestChassis(ShmChassisState* state,
+                                     uint64_t* version) const {
+  return layout_->chassis.load(state, version);
+}
+
+uint64_t VehicleShmBridge::chassisVersion() const {
+  return layout_->chassis.version();
+}
+
+bool VehicleShmBridge::pushCommand(const ShmCommand& command) {
+  return layout_->commands.tryPush(command);
+}
+
+void VehicleShmBridge::publishControl(const ShmControlCommand& command) {
+  layout_->control.store(command);
+}
+
+void VehicleShmBridge::publishLimits(const ShmControlLimits& limits) {
+  layout_->limits.store(limits);
+}
+
+}  // namespace ipc
+}  // namespace remote
+}  // namespace autodev
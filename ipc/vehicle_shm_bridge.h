@@ -0,0 +1,133 @@
+#ifndef VEHICLE_SHM_BRIDGE_H
+#define VEHICLE_SHM_BRIDGE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "ipc/seqlock.h"
+#include "ipc/shared_memory.h"
+#include "ipc/spsc_ring.h"
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace ipc {
+
+// Plain-data mirrors of the protobuf messages with a fixed layout, as they
+// are exchanged through shared memory. Timestamps are steady_clock
+// (CLOCK_MONOTONIC) nanoseconds, comparable across processes of the host.
+
+struct ShmChassisState {
+  int64_t timestamp_ns = 0;
+  double speed_mps = 0.0;
+  double throttle_percentage = 0.0;
+  double brake_percentage = 0.0;
+  double steering_percentage = 0.0;
+  int32_t gear = 0;
+};
+
+struct ShmControlCommand {
+  int64_t timestamp_ns = 0;
+  double acceleration = 0.0;
+  double braking = 0.0;
+  double steering_angle = 0.0;
+  int32_t gear = 0;
+};
+
+// Limits the autonomy stack applies to the commands (ControllerConfig).
+struct ShmControlLimits {
+  double max_speed_mps = 0.0;
+  double max_steering_angle_rad = 0.0;
+};
+
+enum class ShmCommandType : uint32_t {
+  Control = 1,
+  Emergency = 2,
+};
+
+struct ShmCommand {
+  ShmCommandType type = ShmCommandType::Control;
+  int32_t emergency_type = 0;  // autodev.remote.control.EmergencyType
+  ShmControlCommand control;   // Type Control; timestamp_ns for both
+  char reason[64] = {};        // Type Emergency; NUL-terminated, truncated
+};
+
+// Everything in the shared memory object. Fields are only written by the
+// side named in the comment.
+struct VehicleShmLayout {
+  static constexpr uint64_t kMagic = 0x6164766d73686d31;  // "advmshm1"
+  static constexpr uint32_t kCommandCapacity = 256;
+
+  // Set last (release) by the process that created the object.
+  std::atomic<uint64_t> magic{0};
+  uint64_t layout_size = 0;
+
+  // Autonomy stack -> remote-driving client
+  SeqlockSlot<ShmChassisState> chassis;
+  // Remote-driving client -> autonomy stack: the latest control command,
+  // every control and emergency command in order, and the limits.
+  SeqlockSlot<ShmControlCommand> control;
+  SpscRing<ShmCommand, kCommandCapacity> commands;
+  SeqlockSlot<ShmControlLimits> limits;
+};
+
+// Chassis state and control commands between the remote-driving client and
+// an autonomy stack on the same vehicle computer, through POSIX shared
+// memory: no syscalls, copies of a few cache lines and no serialization.
+//
+// Whichever process opens the bridge first creates and initializes the
+// object; it outlives both (indices included), so either side may restart.
+// Each method is for one side only, and each ring and slot has exactly one
+// writer process: the methods of one side must not be called concurrently
+// from several threads (serialize them, see ShmController).
+//
+// Commands left in the ring by a previous run are delivered to a restarted
+// consumer; it should call discardCommands() on start and check command
+// timestamps against its control timeout.
+class VehicleShmBridge {
+ public:
+  static constexpr const char* kDefaultName = "/autodev_remote_vehicle";
+
+  VehicleShmBridge() = default;
+
+  // Creates or attaches to the object. Waits up to init_timeout_ms for the
+  // creator to initialize it. Returns false on error (logged), including a
+  // layout of another version.
+  bool open(const std::string& name = kDefaultName, int init_timeout_ms = 1000);
+  void close();
+  bool isOpen() const { return layout_ != nullptr; }
+
+  // --- Autonomy stack side ---
+  void publishChassis(const ShmChassisState& state);
+  bool popCommand(ShmCommand* command);
+  bool latestControl(ShmControlCommand* command,
+                     uint64_t* version = nullptr) const;
+  bool latestLimits(ShmControlLimits* limits,
+                    uint64_t* version = nullptr) const;
+  // Drops the queued commands (e.g., on start); returns how many.
+  size_t discardCommands();
+
+  // --- Remote-driving client side ---
+  bool latestChassis(ShmChassisState* state,
+                     uint64_t* version = nullptr) const;
+  uint64_t chassisVersion() const;
+  // Returns false if the ring is full (the consumer is not keeping up).
+  bool pushCommand(const ShmCommand& command);
+  void publishControl(const ShmControlCommand& command);
+  void publishLimits(const ShmControlLimits& limits);
+
+ private:
+  SharedMemoryRegion region_;
+  VehicleShmLayout* layout_ = nullptr;  // In region_; null when closed
+
+  // Prevent copying
+  VehicleShmBridge(const VehicleShmBridge&) = delete;
+  VehicleShmBridge& operator=(const VehicleShmBridge&) = delete;
+};
+
+}  // namespace ipc
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // VEHICLE_SHM_BRIDGE_H
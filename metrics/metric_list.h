@@ -0,0 +1,113 @@
+#ifndef METRIC_LIST_H
+#define METRIC_LIST_H
+
+// The process's compile-time metrics, defined once here (X-macros) and
+// expanded by metrics/static_metrics.h into the CounterId/HistogramId enums
+// and the tables used for export. Adding a metric means adding a line here;
+// there is no runtime registration.
+//
+// Names follow the Prometheus conventions (base units, *_total counters).
+
+// X(name, help)
+#define AUTODEV_REMOTE_COUNTER_LIST(X)                                        \
+  /* WebrtcManagerImpl */                                                     \
+  X(webrtc_dc_messages_sent_total,                                            \
+    "DataChannel messages accepted by a PeerConnection for sending.")         \
+  X(webrtc_dc_sent_bytes_total, "Payload bytes of the sent DataChannel messages.") \
+  X(webrtc_dc_send_failures_total,                                            \
+    "DataChannel sends refused (peer unknown, channel not open, ...).")       \
+  X(webrtc_dc_send_backpressure_total,                                        \
+    "DataChannel messages not sent by trySend (send buffer over threshold).") \
+  X(webrtc_dc_messages_queued_total,                                          \
+    "DataChannel messages held back by the send scheduler.")                  \
+  X(webrtc_dc_messages_dropped_total,                                         \
+    "Queued DataChannel messages dropped (queue full, peer gone).")           \
+  X(webrtc_dc_messages_received_total, "DataChannel messages received.")      \
+  X(webrtc_dc_received_bytes_total,                                           \
+    "Payload bytes of the received DataChannel messages.")                    \
+  X(webrtc_dc_parse_failures_total,                                           \
+    "Received DataChannel messages not parsed as their channel's type.")      \
+  X(webrtc_peer_connections_created_total, "PeerConnections created.")        \
+  X(webrtc_peer_connections_destroyed_total, "PeerConnections destroyed.")    \
+  /* DataChannelMessageBatcher */                                             \
+  X(webrtc_dc_batches_sent_total,                                             \
+    "DataChannel messages sent that carry a batch of messages.")              \
+  X(webrtc_dc_batched_messages_total, "Messages sent inside batches.")        \
+  X(webrtc_dc_batch_messages_saved_total,                                     \
+    "DataChannel messages (SCTP DATA chunks) saved by batching.")             \
+  X(webrtc_dc_batch_bytes_saved_total,                                        \
+    "Estimated SCTP bytes saved by batching (chunk overhead minus framing).") \
+  X(webrtc_dc_batches_received_total, "Received batches unpacked.")           \
+  X(webrtc_dc_batch_parse_failures_total, "Received batches malformed.")      \
+  /* ChunkedTransferSender, ChunkedTransferReceiver */                        \
+  X(file_transfer_bytes_sent_total,                                           \
+    "File bytes sent in transfer chunks (resends included).")                 \
+  X(file_transfer_bytes_received_total,                                       \
+    "File bytes received, verified and written.")                             \
+  X(file_transfer_checksum_failures_total,                                    \
+    "Transfer chunks or whole files received with a wrong CRC.")              \
+  X(file_transfers_completed_total, "File transfers ended and verified.")     \
+  X(file_transfers_failed_total,                                              \
+    "File transfers ended otherwise (refused, timed out, peer gone, ...).")   \
+  /* SignalingClientImpl */                                                   \
+  X(signaling_messages_sent_total, "Signaling messages sent.")                \
+  X(signaling_messages_received_total, "Signaling messages received.")        \
+  X(signaling_send_failures_total,                                            \
+    "Signaling messages not sent (connection not open or send error).")       \
+  X(signaling_parse_failures_total, "Received signaling messages not parsed.") \
+  X(signaling_connection_failures_total, "Failed signaling handshakes.")      \
+  /* Camera source */                                                         \
+  X(camera_frames_captured_total, "Frames delivered by the camera source.")   \
+  /* Chassis source */                                                        \
+  X(chassis_updates_total, "Chassis states delivered by the chassis source.") \
+  /* ShmController */                                                         \
+  X(ipc_commands_dropped_total,                                               \
+    "Commands not queued in shared memory because the ring was full.")        \
+  /* VehicleClientApp */                                                      \
+  X(vehicle_control_rejected_total,                                           \
+    "Control messages dropped because the peer is not the controller.")       \
+  X(vehicle_degradation_escalations_total,                                    \
+    "Degradation level increases due to the controller's connection health.") \
+  X(vehicle_degradation_recoveries_total,                                     \
+    "Degradation level decreases after the connection health recovered.")     \
+  X(vehicle_pull_overs_total, "Pull overs issued by the degradation policy.")
+
+// X(name, help, scale): values are recorded as unsigned integers in the
+// metric's recording unit; scale converts them to the exported base unit
+// (e.g., 1e-6 for durations recorded in microseconds).
+#define AUTODEV_REMOTE_HISTOGRAM_LIST(X)                                      \
+  /* WebrtcManagerImpl */                                                     \
+  X(webrtc_dc_send_duration_seconds,                                          \
+    "Time spent in sendDataChannelMessage, including lock waits.", 1e-6)      \
+  X(webrtc_dc_message_size_bytes, "Size of the sent DataChannel messages.", 1.0) \
+  X(webrtc_dc_queue_delay_seconds,                                            \
+    "Time DataChannel messages waited in the send scheduler.", 1e-6)          \
+  /* DataChannelMessageBatcher */                                             \
+  X(webrtc_dc_batch_messages,                                                 \
+    "Messages per DataChannel message sent by the batcher.", 1.0)             \
+  /* SignalingClientImpl */                                                   \
+  X(signaling_message_size_bytes, "Size of the serialized signaling messages.", \
+    1.0)                                                                      \
+  X(signaling_dispatch_duration_seconds,                                      \
+    "Time to parse and dispatch a received signaling message.", 1e-6)         \
+  /* Camera source */                                                         \
+  X(camera_frame_interval_seconds, "Time between consecutive frames.", 1e-6)  \
+  X(camera_frame_handler_duration_seconds,                                    \
+    "Time the frame handler took per frame.", 1e-6)                           \
+  /* Chassis source */                                                        \
+  X(chassis_update_interval_seconds,                                          \
+    "Time between consecutive chassis states.", 1e-6)                         \
+  X(chassis_handler_duration_seconds,                                         \
+    "Time the chassis state handler took per state.", 1e-6)                   \
+  X(chassis_shm_handoff_latency_seconds,                                      \
+    "Time from publishing a chassis state in shared memory to reading it.",   \
+    1e-9)                                                                     \
+  /* VehicleClientApp */                                                      \
+  X(vehicle_control_interval_seconds,                                         \
+    "Time between consecutive control messages, no file transfer active.",    \
+    1e-6)                                                                     \
+  X(vehicle_control_interval_during_transfer_seconds,                         \
+    "Time between consecutive control messages while receiving a file.",      \
+    1e-6)
+
+#endif  // METRIC_LIST_H
@@ -0,0 +1,162 @@
+#include "metrics/metrics_registry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+#include "metrics/static_metrics.h"
+
+namespace autodev {
+namespace remote {
+namespace metrics {
+
+namespace {
+
+Labels SortedLabels(const Labels& labels) {
+  Labels sorted = labels;
+  std::sort(sorted.begin(), sorted.end());
+  return sorted;
+}
+
+// Label values escape backslash, double quote and newline; HELP text only
+// backslash and newline.
+void AppendEscaped(std::string* out, const std::string& value,
+                   bool escape_quotes) {
+  for (char c : value) {
+    if (c == '\\') {
+      out->append("\\\\");
+    } else if (c == '\n') {
+      out->append("\\n");
+    } else if (c == '"' && escape_quotes) {
+      out->append("\\\"");
+    } else {
+      out->push_back(c);
+    }
+  }
+}
+
+void AppendSeriesName(std::string* out, const std::string& name,
+                      const Labels& labels) {
+  out->append(name);
+  if (labels.empty()) return;
+  out->push_back('{');
+  for (size_t i = 0; i < labels.size(); ++i) {
+    if (i > 0) out->push_back(',');
+    out->append(labels[i].first);
+    out->append("=\"");
+    AppendEscaped(out, labels[i].second, true);
+    out->push_back('"');
+  }
+  out->push_back('}');
+}
+
+void AppendValue(std::string* out, double value) {
+  if (std::isnan(value)) {
+    out->append("NaN");
+  } else if (std::isinf(value)) {
+    out->append(value > 0 ? "+Inf" : "-Inf");
+  } else {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+    out->append(buffer);
+  }
+}
+
+template <typename Series>
+size_t EraseLabeled(std::map<Labels, std::shared_ptr<Series>>* series,
+                    const std::pair<std::string, std::string>& label) {
+  size_t removed = 0;
+  for (auto it = series->begin(); it != series->end();) {
+    if (std::find(it->first.begin(), it->first.end(), label) !=
+        it->first.end()) {
+      it = series->erase(it);
+      ++removed;
+    } else {
+      ++it;
+    }
+  }
+  return removed;
+}
+
+}  // namespace
+
+std::shared_ptr<Counter> MetricsRegistry::counter(const std::string& name,
+                                                  const std::string& help,
+                                                  const Labels& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Family* family = familyLocked(name, help, Type::Counter);
+  if (!family) return std::make_shared<Counter>();
+  std::shared_ptr<Counter>& series = family->counters[SortedLabels(labels)];
+  if (!series) series = std::make_shared<Counter>();
+  return series;
+}
+
+std::shared_ptr<Gauge> MetricsRegistry::gauge(const std::string& name,
+                                              const std::string& help,
+                                              const Labels& labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Family* family = familyLocked(name, help, Type::Gauge);
+  if (!family) return std::make_shared<Gauge>();
+  std::shared_ptr<Gauge>& series = family->gauges[SortedLabels(labels)];
+  if (!series) series = std::make_shared<Gauge>();
+  return series;
+}
+
+void MetricsRegistry::removeSeries(const std::string& label_name,
+                                   const std::string& label_value) {
+  const auto label = std::make_pair(label_name, label_value);
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [name, family] : families_) {
+    EraseLabeled(&family.counters, label);
+    EraseLabeled(&family.gauges, label);
+  }
+}
+
+std::string MetricsRegistry::renderPrometheus() const {
+  std::string out;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [name, family] : families_) {
+      out.append("# HELP ");
+      out.append(name);
+      out.push_back(' ');
+      AppendEscaped(&out, family.help, false);
+      out.append("\n# TYPE ");
+      out.append(name);
+      out.append(family.type == Type::Counter ? " counter\n" : " gauge\n");
+      for (const auto& [labels, series] : family.counters) {
+        AppendSeriesName(&out, name, labels);
+        out.push_back(' ');
+        out.append(std::to_string(series->value()));
+        out.push_back('\n');
+      }
+      for (const auto& [labels, series] : family.gauges) {
+        AppendSeriesName(&out, name, labels);
+        out.push_back(' ');
+        AppendValue(&out, series->value());
+        out.push_back('\n');
+      }
+    }
+  }
+  AppendStaticMetrics(&out);
+  return out;
+}
+
+MetricsRegistry::Family* MetricsRegistry::familyLocked(const std::string& name,
+                                                       const std::string& help,
+                                                       Type type) {
+  auto it = families_.find(name);
+  if (it == families_.end()) {
+    it = families_.emplace(name, Family{type, help, {}, {}}).first;
+  } else if (it->second.type != type) {
+    std::cerr << "MetricsRegistry: Metric '" << name
+              << "' is already registered with another type." << std::endl;
+    return nullptr;
+  }
+  return &it->second;
+}
+
+}  // namespace metrics
+}  // namespace remote
+}  // namespace autodev
@@ -0,0 +1,115 @@
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace metrics {
+
+// Label set of one series, e.g. {{"peer_id", "vehicle-1"}}. Kept sorted by
+// name by the registry.
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+// Monotonic counter. Updates are lock-free.
+class Counter {
+ public:
+  void increment(uint64_t n = 1) {
+    value_.fetch_add(n, std::memory_order_relaxed);
+  }
+  // For totals maintained elsewhere (e.g., libwebrtc stats): publishes the
+  // current total as is.
+  void set(uint64_t total) { value_.store(total, std::memory_order_relaxed); }
+  uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<uint64_t> value_{0};
+};
+
+// Current value that may go up and down. Updates are lock-free.
+class Gauge {
+ public:
+  void set(double value) { value_.store(value, std::memory_order_relaxed); }
+  void add(double delta) {
+    double current = value_.load(std::memory_order_relaxed);
+    while (!value_.compare_exchange_weak(current, current + delta,
+                                         std::memory_order_relaxed)) {
+    }
+  }
+  double value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<double> value_{0.0};
+};
+
+// Process-wide set of named metrics, rendered in the Prometheus text
+// exposition format.
+//
+// Looking up a series (counter()/gauge()) takes a mutex and may allocate, so
+// producers look their series up once and keep the returned pointer; the
+// updates themselves are single atomic operations. Series are shared_ptrs:
+// removing one (e.g., when a peer disconnects) never invalidates a pointer
+// a producer still holds, its updates just stop being exported.
+class MetricsRegistry {
+ public:
+  MetricsRegistry() = default;
+
+  // Returns the series of the metric 'name' with these labels, creating it
+  // (and the metric) on first use. 'help' is used when the metric is
+  // created. If 'name' is already registered with another type, an error is
+  // logged and an unregistered series is returned.
+  // MUST BE THREAD-SAFE.
+  std::shared_ptr<Counter> counter(const std::string& name,
+                                   const std::string& help,
+                                   const Labels& labels = {});
+  std::shared_ptr<Gauge> gauge(const std::string& name,
+                               const std::string& help,
+                               const Labels& labels = {});
+
+  // Removes every series carrying the label label_name=label_value.
+  // Metrics left without series are still listed (HELP/TYPE only).
+  // MUST BE THREAD-SAFE.
+  void removeSeries(const std::string& label_name,
+                    const std::string& label_value);
+
+  // Renders all metrics in the Prometheus text format (version 0.0.4): the
+  // series registered here, then the compile-time metrics of
+  // metrics/metric_list.h (see static_metrics.h). MUST BE THREAD-SAFE.
+  std::string renderPrometheus() const;
+
+ private:
+  enum class Type { Counter, Gauge };
+
+  struct Family {
+    Type type;
+    std::string help;
+    std::map<Labels, std::shared_ptr<Counter>> counters;
+    std::map<Labels, std::shared_ptr<Gauge>> gauges;
+  };
+
+  // Returns the family, creating it if needed; nullptr on a type clash.
+  // mutex_ MUST be held.
+  Family* familyLocked(const std::string& name, const std::string& help,
+                       Type type);
+
+  mutable std::mutex mutex_;
+  std::map<std::string, Family> families_;  // Guarded by mutex_; by name
+
+  // Prevent copying
+  MetricsRegistry(const MetricsRegistry&) = delete;
+  MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+};
+
+}  // namespace metrics
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // METRICS_REGISTRY_H
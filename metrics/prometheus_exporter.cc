@@ -0,0 +1,193 @@
+#include "metrics/prometheus_exporter.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+namespace autodev {
+namespace remote {
+namespace metrics {
+
+namespace {
+
+// A scrape request fits easily; anything longer is not one.
+constexpr size_t kMaxRequestBytes = 4096;
+// Per-connection socket timeout, so a stuck client cannot block the server.
+constexpr int kIoTimeoutMs = 1000;
+
+bool SendAll(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    const ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+    if (sent < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    data += sent;
+    size -= static_cast<size_t>(sent);
+  }
+  return true;
+}
+
+void SendResponse(int fd, const char* status, const std::string& body) {
+  std::string response = "HTTP/1.1 ";
+  response.append(status);
+  response.append(
+      "\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8"
+      "\r\nContent-Length: ");
+  response.append(std::to_string(body.size()));
+  response.append("\r\nConnection: close\r\n\r\n");
+  response.append(body);
+  SendAll(fd, response.data(), response.size());
+}
+
+}  // namespace
+
+PrometheusExporter::PrometheusExporter(
+    std::shared_ptr<MetricsRegistry> registry, const std::string& address,
+    uint16_t port)
+    : registry_(std::move(registry)), address_(address), port_(port) {}
+
+PrometheusExporter::~PrometheusExporter() { stop(); }
+
+bool PrometheusExporter::start() {
+  if (listenFd_ >= 0) {
+    std::cerr << "PrometheusExporter: Already started." << std::endl;
+    return false;
+  }
+  if (!registry_) {
+    std::cerr << "PrometheusExporter: No metrics registry." << std::endl;
+    return false;
+  }
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port_);
+  if (inet_pton(AF_INET, address_.c_str(), &addr.sin_addr) != 1) {
+    std::cerr << "PrometheusExporter: Invalid address '" << address_ << "'."
+              << std::endl;
+    return false;
+  }
+
+  listenFd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (listenFd_ < 0) {
+    std::cerr << "PrometheusExporter: socket() failed: "
+              << std::strerror(errno) << std::endl;
+    return false;
+  }
+  const int reuse = 1;
+  setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  if (bind(listenFd_, reinterpret_cast<const sockaddr*>(&addr),
+           sizeof(addr)) < 0 ||
+      listen(listenFd_, 8) < 0) {
+    std::cerr << "PrometheusExporter: Failed to listen on " << address_ << ":"
+              << port_ << ": " << std::strerror(errno) << std::endl;
+    close(listenFd_);
+    listenFd_ = -1;
+    return false;
+  }
+
+  stopEventFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (stopEventFd_ < 0) {
+    std::cerr << "PrometheusExporter: eventfd() failed: "
+              << std::strerror(errno) << std::endl;
+    close(listenFd_);
+    listenFd_ = -1;
+    return false;
+  }
+
+  serverThread_ = std::thread(&PrometheusExporter::serverThreadMain, this);
+  std::cout << "PrometheusExporter: Serving http://" << address_ << ":"
+            << port_ << "/metrics" << std::endl;
+  return true;
+}
+
+void PrometheusExporter::stop() {
+  if (stopEventFd_ >= 0) {
+    const uint64_t one = 1;
+    if (write(stopEventFd_, &one, sizeof(one)) < 0) {
+      std::cerr << "PrometheusExporter: Failed to signal stop: "
+                << std::strerror(errno) << std::endl;
+    }
+  }
+  if (serverThread_.joinable()) serverThread_.join();
+  if (listenFd_ >= 0) {
+    close(listenFd_);
+    listenFd_ = -1;
+    std::cout << "PrometheusExporter: Stopped." << std::endl;
+  }
+  if (stopEventFd_ >= 0) {
+    close(stopEventFd_);
+    stopEventFd_ = -1;
+  }
+}
+
+// --- Server thread ---
+
+void PrometheusExporter::serverThreadMain() {
+  pollfd fds[2] = {{listenFd_, POLLIN, 0}, {stopEventFd_, POLLIN, 0}};
+  while (true) {
+    if (poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) continue;
+      std::cerr << "PrometheusExporter: poll() failed: "
+                << std::strerror(errno) << std::endl;
+      return;
+    }
+    if (fds[1].revents != 0) return;  // stop()
+    if ((fds[0].revents & POLLIN) == 0) continue;
+
+    const int fd = accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0) continue;  // Client gone already, or out of fds
+    handleConnection(fd);
+    close(fd);
+  }
+}
+
+void PrometheusExporter::handleConnection(int fd) {
+  timeval timeout{};
+  timeout.tv_sec = kIoTimeoutMs / 1000;
+  timeout.tv_usec = (kIoTimeoutMs % 1000) * 1000;
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+  // Read up to the end of the request headers; only the request line is
+  // looked at.
+  std::string request;
+  char buffer[1024];
+  while (request.find("\r\n\r\n") == std::string::npos) {
+    if (request.size() >= kMaxRequestBytes) {
+      SendResponse(fd, "431 Request Header Fields Too Large", "");
+      return;
+    }
+    const ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return;  // Closed, or timed out
+    request.append(buffer, static_cast<size_t>(n));
+  }
+
+  const std::string request_line = request.substr(0, request.find("\r\n"));
+  if (request_line.rfind("GET ", 0) != 0) {
+    SendResponse(fd, "405 Method Not Allowed", "Only GET is supported.\n");
+    return;
+  }
+  const size_t path_end = request_line.find(' ', 4);
+  const std::string path = request_line.substr(
+      4, path_end == std::string::npos ? std::string::npos : path_end - 4);
+  if (path != "/metrics" && path.rfind("/metrics?", 0) != 0) {
+    SendResponse(fd, "404 Not Found", "Metrics are served at /metrics.\n");
+    return;
+  }
+  SendResponse(fd, "200 OK", registry_->renderPrometheus());
+}
+
+}  // namespace metrics
+}  // namespace remote
+}  // namespace autodev
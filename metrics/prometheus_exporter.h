@@ -0,0 +1,55 @@
+#ifndef PROMETHEUS_EXPORTER_H
+#define PROMETHEUS_EXPORTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "metrics/metrics_registry.h"
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace metrics {
+
+// Minimal HTTP endpoint serving MetricsRegistry::renderPrometheus() on
+// GET /metrics for a local Prometheus scraper (or curl).
+//
+// One thread accepts and answers connections one at a time; every response
+// closes its connection. This is deliberately not a general HTTP server: it
+// is meant to be bound to a loopback address and scraped every few seconds.
+class PrometheusExporter {
+ public:
+  PrometheusExporter(std::shared_ptr<MetricsRegistry> registry,
+                     const std::string& address, uint16_t port);
+  ~PrometheusExporter();
+
+  // Binds address:port and starts the server thread.
+  bool start();
+  // Stops the server thread and closes the socket. Safe to call repeatedly.
+  void stop();
+
+ private:
+  void serverThreadMain();
+  void handleConnection(int fd);
+
+  const std::shared_ptr<MetricsRegistry> registry_;
+  const std::string address_;
+  const uint16_t port_;
+
+  int listenFd_ = -1;
+  int stopEventFd_ = -1;  // Wakes the server thread on stop()
+  std::thread serverThread_;
+
+  // Prevent copying
+  PrometheusExporter(const PrometheusExporter&) = delete;
+  PrometheusExporter& operator=(const PrometheusExporter&) = delete;
+};
+
+}  // namespace metrics
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // PROMETHEUS_EXPORTER_H
@@ -0,0 +1,226 @@
+#include "metrics/static_metrics.h"
+
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace autodev {
+namespace remote {
+namespace metrics {
+
+namespace {
+
+struct CounterInfo {
+  const char* name;
+  const char* help;
+};
+constexpr CounterInfo kCounters[] = {
+#define AUTODEV_REMOTE_COUNTER_INFO(name, help) {#name, help},
+    AUTODEV_REMOTE_COUNTER_LIST(AUTODEV_REMOTE_COUNTER_INFO)
+#undef AUTODEV_REMOTE_COUNTER_INFO
+};
+
+struct HistogramInfo {
+  const char* name;
+  const char* help;
+  double scale;
+};
+constexpr HistogramInfo kHistograms[] = {
+#define AUTODEV_REMOTE_HISTOGRAM_INFO(name, help, scale) {#name, help, scale},
+    AUTODEV_REMOTE_HISTOGRAM_LIST(AUTODEV_REMOTE_HISTOGRAM_INFO)
+#undef AUTODEV_REMOTE_HISTOGRAM_INFO
+};
+
+constexpr double kQuantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+struct ShardList {
+  std::mutex mutex;
+  std::vector<internal::ThreadShard*> live;  // Guarded by mutex
+  // Totals of exited threads; only written under mutex.
+  internal::ThreadShard retired;
+  // Target of threads that record after their shard was retired (from
+  // other thread_local destructors). Shared, so concurrent updates may be
+  // lost; they are rare and only happen at thread exit.
+  internal::ThreadShard orphan;
+};
+
+// Never destroyed: threads may still exit (and retire their shards) while
+// static destructors run.
+ShardList& Shards() {
+  static ShardList* shards = new ShardList;
+  return *shards;
+}
+
+void Accumulate(internal::ThreadShard* into, const internal::ThreadShard& from) {
+  for (size_t i = 0; i < kCounterCount; ++i) {
+    internal::AddRelaxed(into->counters[i],
+                         from.counters[i].load(std::memory_order_relaxed));
+  }
+  for (size_t h = 0; h < kHistogramCount; ++h) {
+    for (size_t b = 0; b < kHistogramBuckets; ++b) {
+      internal::AddRelaxed(
+          into->histograms[h].buckets[b],
+          from.histograms[h].buckets[b].load(std::memory_order_relaxed));
+    }
+    internal::AddRelaxed(
+        into->histograms[h].sum,
+        from.histograms[h].sum.load(std::memory_order_relaxed));
+  }
+}
+
+// Retires the thread's shard when the thread exits.
+struct ShardOwner {
+  internal::ThreadShard* shard = nullptr;
+  ~ShardOwner() {
+    if (!shard) return;
+    ShardList& shards = Shards();
+    {
+      std::lock_guard<std::mutex> lock(shards.mutex);
+      Accumulate(&shards.retired, *shard);
+      for (auto it = shards.live.begin(); it != shards.live.end(); ++it) {
+        if (*it == shard) {
+          shards.live.erase(it);
+          break;
+        }
+      }
+    }
+    internal::tls_shard = &shards.orphan;
+    delete shard;
+  }
+};
+thread_local ShardOwner tls_owner;
+
+// Calls fn(shard) for every shard holding values. Shards().mutex MUST be
+// held.
+template <typename Fn>
+void ForEachShardLocked(ShardList& shards, Fn fn) {
+  fn(shards.retired);
+  fn(shards.orphan);
+  for (const internal::ThreadShard* shard : shards.live) fn(*shard);
+}
+
+void AppendValue(std::string* out, double value) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+  out->append(buffer);
+}
+
+void AppendHelpAndType(std::string* out, const char* name, const char* help,
+                       const char* type) {
+  out->append("# HELP ");
+  out->append(name);
+  out->push_back(' ');
+  out->append(help);
+  out->append("\n# TYPE ");
+  out->append(name);
+  out->push_back(' ');
+  out->append(type);
+  out->push_back('\n');
+}
+
+}  // namespace
+
+namespace internal {
+
+ThreadShard* RegisterThreadShard() {
+  auto* shard = new ThreadShard();
+  ShardList& shards = Shards();
+  {
+    std::lock_guard<std::mutex> lock(shards.mutex);
+    shards.live.push_back(shard);
+  }
+  tls_owner.shard = shard;
+  tls_shard = shard;
+  return shard;
+}
+
+}  // namespace internal
+
+uint64_t CounterValue(CounterId id) {
+  const size_t index = static_cast<size_t>(id);
+  uint64_t total = 0;
+  ShardList& shards = Shards();
+  std::lock_guard<std::mutex> lock(shards.mutex);
+  ForEachShardLocked(shards, [&](const internal::ThreadShard& shard) {
+    total += shard.counters[index].load(std::memory_order_relaxed);
+  });
+  return total;
+}
+
+void AppendStaticMetrics(std::string* out) {
+  std::array<uint64_t, kCounterCount> counters{};
+  // Merged histogram buckets; large, so not on the stack.
+  std::vector<std::array<uint64_t, kHistogramBuckets>> buckets(kHistogramCount);
+  std::array<uint64_t, kHistogramCount> sums{};
+  {
+    ShardList& shards = Shards();
+    std::lock_guard<std::mutex> lock(shards.mutex);
+    ForEachShardLocked(shards, [&](const internal::ThreadShard& shard) {
+      for (size_t i = 0; i < kCounterCount; ++i) {
+        counters[i] += shard.counters[i].load(std::memory_order_relaxed);
+      }
+      for (size_t h = 0; h < kHistogramCount; ++h) {
+        for (size_t b = 0; b < kHistogramBuckets; ++b) {
+          buckets[h][b] +=
+              shard.histograms[h].buckets[b].load(std::memory_order_relaxed);
+        }
+        sums[h] += shard.histograms[h].sum.load(std::memory_order_relaxed);
+      }
+    });
+  }
+
+  for (size_t i = 0; i < kCounterCount; ++i) {
+    AppendHelpAndType(out, kCounters[i].name, kCounters[i].help, "counter");
+    out->append(kCounters[i].name);
+    out->push_back(' ');
+    out->append(std::to_string(counters[i]));
+    out->push_back('\n');
+  }
+
+  for (size_t h = 0; h < kHistogramCount; ++h) {
+    const HistogramInfo& info = kHistograms[h];
+    uint64_t count = 0;
+    for (uint64_t n : buckets[h]) count += n;
+
+    AppendHelpAndType(out, info.name, info.help, "summary");
+    for (double q : kQuantiles) {
+      out->append(info.name);
+      out->append("{quantile=\"");
+      AppendValue(out, q);
+      out->append("\"} ");
+      if (count == 0) {
+        out->append("NaN\n");
+        continue;
+      }
+      // The bucket holding the value of rank ceil(q * count), reported as
+      // its midpoint.
+      const uint64_t rank = std::max<uint64_t>(
+          1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(count))));
+      uint64_t seen = 0;
+      size_t b = 0;
+      for (; b + 1 < kHistogramBuckets; ++b) {
+        seen += buckets[h][b];
+        if (seen >= rank) break;
+      }
+      const uint64_t lower = HistogramBucketLowerBound(b);
+      const uint64_t upper = HistogramBucketUpperBound(b);
+      AppendValue(out, (static_cast<double>(lower) +
+                        static_cast<double>(upper - lower) / 2.0) *
+                           info.scale);
+      out->push_back('\n');
+    }
+    out->append(info.name);
+    out->append("_sum ");
+    AppendValue(out, static_cast<double>(sums[h]) * info.scale);
+    out->push_back('\n');
+    out->append(info.name);
+    out->append("_count ");
+    out->append(std::to_string(count));
+    out->push_back('\n');
+  }
+}
+
+}  // namespace metrics
+}  // namespace remote
+}  // namespace autodev
@@ -0,0 +1,173 @@
+#ifndef STATIC_METRICS_H
+#define STATIC_METRICS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "metrics/metric_list.h"
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace metrics {
+
+// Hot-path instrumentation for the metrics in metrics/metric_list.h.
+//
+// Every thread writes to its own shard, so an update is a couple of relaxed
+// loads/stores on a cache line no other thread writes: no lock, no locked
+// read-modify-write, no sharing. A scrape (AppendStaticMetrics) sums the
+// shards of all live threads plus the totals of exited ones; the only
+// mutex is taken when a thread records its first value, when it exits, and
+// by the scrape.
+//
+// Histograms are HDR-style log-linear: exact below 16, above that each
+// power of two is split into 8 linear sub-buckets (at most 12.5% bucket
+// width relative to the value). They are exported as Prometheus summaries
+// with estimated quantiles.
+
+enum class CounterId : uint32_t {
+#define AUTODEV_REMOTE_COUNTER_ID(name, help) name,
+  AUTODEV_REMOTE_COUNTER_LIST(AUTODEV_REMOTE_COUNTER_ID)
+#undef AUTODEV_REMOTE_COUNTER_ID
+};
+
+enum class HistogramId : uint32_t {
+#define AUTODEV_REMOTE_HISTOGRAM_ID(name, help, scale) name,
+  AUTODEV_REMOTE_HISTOGRAM_LIST(AUTODEV_REMOTE_HISTOGRAM_ID)
+#undef AUTODEV_REMOTE_HISTOGRAM_ID
+};
+
+#define AUTODEV_REMOTE_COUNT_ONE(...) +1
+constexpr size_t kCounterCount =
+    0 AUTODEV_REMOTE_COUNTER_LIST(AUTODEV_REMOTE_COUNT_ONE);
+constexpr size_t kHistogramCount =
+    0 AUTODEV_REMOTE_HISTOGRAM_LIST(AUTODEV_REMOTE_COUNT_ONE);
+#undef AUTODEV_REMOTE_COUNT_ONE
+
+// --- Histogram bucketing ---
+
+constexpr unsigned kHistogramSubBucketBits = 3;
+constexpr uint64_t kHistogramSubBuckets = uint64_t{1}
+                                          << kHistogramSubBucketBits;
+// Values below 2 * kHistogramSubBuckets get one bucket each; above, every
+// power of two from 2 * kHistogramSubBuckets up to 2^63 gets
+// kHistogramSubBuckets.
+constexpr size_t kHistogramBuckets =
+    (65 - kHistogramSubBucketBits) * kHistogramSubBuckets;
+
+constexpr size_t HistogramBucketIndex(uint64_t value) {
+  if (value < 2 * kHistogramSubBuckets) return static_cast<size_t>(value);
+  const unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(value));
+  const unsigned shift = msb - kHistogramSubBucketBits;
+  return static_cast<size_t>((shift + 1) * kHistogramSubBuckets +
+                             ((value >> shift) - kHistogramSubBuckets));
+}
+
+// Smallest and largest value of a bucket.
+constexpr uint64_t HistogramBucketLowerBound(size_t index) {
+  if (index < 2 * kHistogramSubBuckets) return index;
+  const unsigned shift =
+      static_cast<unsigned>(index / kHistogramSubBuckets) - 1;
+  return (kHistogramSubBuckets + index % kHistogramSubBuckets) << shift;
+}
+constexpr uint64_t HistogramBucketUpperBound(size_t index) {
+  return index + 1 < kHistogramBuckets
+             ? HistogramBucketLowerBound(index + 1) - 1
+             : UINT64_MAX;
+}
+
+static_assert(HistogramBucketIndex(UINT64_MAX) == kHistogramBuckets - 1,
+              "Histogram buckets must cover all uint64_t values");
+
+namespace internal {
+
+// One thread's values. Written only by its thread, read by scrapes.
+struct alignas(64) ThreadShard {
+  std::array<std::atomic<uint64_t>, kCounterCount> counters{};
+  struct Histogram {
+    std::array<std::atomic<uint64_t>, kHistogramBuckets> buckets{};
+    std::atomic<uint64_t> sum{0};
+  };
+  std::array<Histogram, kHistogramCount> histograms{};
+};
+
+// The calling thread's shard; nullptr until it records its first value.
+// Constant-initialized, so access is a plain TLS load.
+inline thread_local ThreadShard* tls_shard = nullptr;
+
+// Creates and registers the calling thread's shard (slow path).
+ThreadShard* RegisterThreadShard();
+
+inline ThreadShard& LocalShard() {
+  ThreadShard* shard = tls_shard;
+  return shard ? *shard : *RegisterThreadShard();
+}
+
+// Single writer per shard: a relaxed load/store pair instead of a locked
+// fetch_add.
+inline void AddRelaxed(std::atomic<uint64_t>& value, uint64_t n) {
+  value.store(value.load(std::memory_order_relaxed) + n,
+              std::memory_order_relaxed);
+}
+
+}  // namespace internal
+
+// Adds n to a counter. Lock-free; callable from any thread.
+inline void Increment(CounterId id, uint64_t n = 1) {
+  internal::AddRelaxed(
+      internal::LocalShard().counters[static_cast<size_t>(id)], n);
+}
+
+// Records one value (in the histogram's recording unit). Lock-free.
+inline void Record(HistogramId id, uint64_t value) {
+  internal::ThreadShard::Histogram& histogram =
+      internal::LocalShard().histograms[static_cast<size_t>(id)];
+  internal::AddRelaxed(histogram.buckets[HistogramBucketIndex(value)], 1);
+  internal::AddRelaxed(histogram.sum, value);
+}
+
+// Records the microseconds since 'start'.
+inline void RecordMicrosSince(HistogramId id,
+                              std::chrono::steady_clock::time_point start) {
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  Record(id, static_cast<uint64_t>(std::max<int64_t>(
+                 std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+                     .count(),
+                 0)));
+}
+
+// Records the lifetime of the object, in microseconds, on destruction.
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(HistogramId id)
+      : id_(id), start_(std::chrono::steady_clock::now()) {}
+  ~ScopedTimer() { RecordMicrosSince(id_, start_); }
+
+ private:
+  const HistogramId id_;
+  const std::chrono::steady_clock::time_point start_;
+
+  // Prevent copying
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+// --- Scrape side ---
+
+// Current total of a counter over all threads.
+uint64_t CounterValue(CounterId id);
+
+// Appends all metrics of metric_list.h in the Prometheus text format.
+// Called by MetricsRegistry::renderPrometheus(). MUST BE THREAD-SAFE.
+void AppendStaticMetrics(std::string* out);
+
+}  // namespace metrics
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // STATIC_METRICS_H
@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "include/webrtc/signaling_message.h"
+#include "metrics/static_metrics.h"
 
 // --- Include websocketpp ---
 // Ensure you have websocketpp and its Asio transport dependency (Boost.Asio or
@@ -232,6 +233,8 @@ class SignalingClientImpl : public SignalingClient {
       std::cerr << "SignalingClientImpl Error: Cannot send signal (connection "
                    "not open): "
                 << ec.message() << std::endl;
+      autodev::remote::metrics::Increment(
+          autodev::remote::metrics::CounterId::signaling_send_failures_total);
       if (onErrorHandler_) {
         onErrorHandler_(
             "Cannot send signal, connection not open or handle invalid.");
@@ -244,6 +247,9 @@ class SignalingClientImpl : public SignalingClient {
 
     // Serialize the SignalMessage to a JSON string
     std::string message_string = SerializeSignalMessage(message);
+    autodev::remote::metrics::Record(
+        autodev::remote::metrics::HistogramId::signaling_message_size_bytes,
+        message_string.size());
     // std::cout << "SignalingClientImpl: Sending: " << message_string <<
     // std::endl; // Avoid logging large SDPs always
 
@@ -253,9 +259,14 @@ class SignalingClientImpl : public SignalingClient {
     if (ec) {
       std::cerr << "SignalingClientImpl Error: Failed to send message: "
                 << ec.message() << std::endl;
+      autodev::remote::metrics::Increment(
+          autodev::remote::metrics::CounterId::signaling_send_failures_total);
       if (onErrorHandler_) {
         onErrorHandler_("Failed to send message: " + ec.message());
       }
+    } else {
+      autodev::remote::metrics::Increment(
+          autodev::remote::metrics::CounterId::signaling_messages_sent_total);
     }
     // Note: This send method is generally thread-safe in websocketpp as it
     // marshals the operation to the Asio thread.
@@ -313,6 +324,11 @@ class SignalingClientImpl : public SignalingClient {
     // std::cout << "SignalingClientImpl: Message received (payload size: " <<
     // msg->get_payload().size() << ")." << std::endl; // Avoid logging large
     // SDPs always
+    autodev::remote::metrics::ScopedTimer dispatch_timer(
+        autodev::remote::metrics::HistogramId::
+            signaling_dispatch_duration_seconds);
+    autodev::remote::metrics::Increment(
+        autodev::remote::metrics::CounterId::signaling_messages_received_total);
 
     // Deserialize the received message string (JSON) into a SignalMessage
     // struct
@@ -330,6 +346,8 @@ class SignalingClientImpl : public SignalingClient {
       std::cerr << "SignalingClientImpl Error: Failed to deserialize received "
                    "message payload."
                 << std::endl;
+      autodev::remote::metrics::Increment(
+          autodev::remote::metrics::CounterId::signaling_parse_failures_total);
       if (onErrorHandler_) {
         // TODO: As with onOpen, marshal this callback if it needs to run on a
         // different thread.
@@ -381,6 +399,8 @@ class SignalingClientImpl : public SignalingClient {
     }
 
     std::cerr << "SignalingClientImpl Error: " << error_msg << std::endl;
+    autodev::remote::metrics::Increment(
+        autodev::remote::metrics::CounterId::signaling_connection_failures_total);
 
     // Report the error
     if (onErrorHandler_) {
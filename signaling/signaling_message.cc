@@ -1,6 +1,6 @@
 // signaling_client/src/signaling_message.cc
 
-#include "include/webrtc/signaling_message.h"  // Assuming include path
+#include "signaling/signaling_message.h"
 
 #include <iostream>
 #include <map>  // For the maps
@@ -37,9 +37,70 @@ const std::map<std::string, SignalMessage::Type> stringToTypeMap = {
     {"offer", SignalMessage::Type::OFFER},
     {"answer", SignalMessage::Type::ANSWER},
     {"candidate", SignalMessage::Type::CANDIDATE}};
+
+// Returns the end of the JSON string starting at data[pos] (the opening
+// quote): the index of its closing quote, or npos.
+size_t SkipJsonString(const std::string& data, size_t pos) {
+  for (size_t i = pos + 1; i < data.size(); ++i) {
+    if (data[i] == '\\') {
+      ++i;
+    } else if (data[i] == '"') {
+      return i;
+    }
+  }
+  return std::string::npos;
+}
+
+// Value of the string member `key` of the top-level object; members of
+// nested objects and text inside strings are skipped, so a sender cannot
+// shadow a field the server sets (e.g., "role") by nesting its own copy.
+// Escape sequences in the value are kept as is.
+std::optional<std::string> FindTopLevelString(const std::string& data,
+                                              const std::string& key) {
+  int depth = 0;
+  bool expect_key = false;
+  for (size_t i = 0; i < data.size(); ++i) {
+    const char c = data[i];
+    if (c == '{' || c == '[') {
+      ++depth;
+      expect_key = (c == '{' && depth == 1);
+    } else if (c == '}' || c == ']') {
+      --depth;
+    } else if (c == ',') {
+      expect_key = (depth == 1);
+    } else if (c == '"') {
+      const size_t end = SkipJsonString(data, i);
+      if (end == std::string::npos) return std::nullopt;
+      if (expect_key && data.compare(i + 1, end - i - 1, key) == 0) {
+        size_t value = data.find_first_not_of(" \t\r\n", end + 1);
+        if (value == std::string::npos || data[value] != ':') {
+          return std::nullopt;
+        }
+        value = data.find_first_not_of(" \t\r\n", value + 1);
+        if (value == std::string::npos || data[value] != '"') {
+          return std::nullopt;
+        }
+        const size_t value_end = SkipJsonString(data, value);
+        if (value_end == std::string::npos) return std::nullopt;
+        return data.substr(value + 1, value_end - value - 1);
+      }
+      expect_key = false;
+      i = end;
+    }
+  }
+  return std::nullopt;
+}
 }  // anonymous namespace
 
-// Implementation of the static member function
+// Implementation of the static member functions
+std::string SignalMessage::TypeToString(Type type) {
+  auto it = typeToStringMap.find(type);
+  if (it != typeToStringMap.end()) {
+    return it->second;
+  }
+  return "unknown";
+}
+
 SignalMessage::Type SignalMessage::StringToType(const std::string& typeStr) {
   auto it = stringToTypeMap.find(typeStr);
   if (it != stringToTypeMap.end()) {
@@ -136,34 +197,16 @@ std::optional<SignalMessage> DeserializeSignalMessage(const std::string& data) {
   // --- Simple Skeleton Parser (Highly Fragile) ---
   SignalMessage msg;
   try {
-    // This is a very basic parser assuming field order and simple values. NOT
-    // ROBUST.
-    size_t type_pos = data.find("\"type\":\"");
-    if (type_pos != std::string::npos) {
-      size_t start = type_pos + 8;
-      size_t end = data.find("\"", start);
-      if (end != std::string::npos) {
-        msg.type = SignalMessage::StringToType(data.substr(start, end - start));
-      }
-    }
-
-    size_t from_pos = data.find("\"from\":\"");
-    if (from_pos != std::string::npos) {
-      size_t start = from_pos + 8;
-      size_t end = data.find("\"", start);
-      if (end != std::string::npos) {
-        msg.from = data.substr(start, end - start);
-      }
-    }
-
-    size_t to_pos = data.find("\"to\":\"");
-    if (to_pos != std::string::npos) {
-      size_t start = to_pos + 6;
-      size_t end = data.find("\"", start);
-      if (end != std::string::npos) {
-        msg.to = data.substr(start, end - start);
-      }
+    // Only members of the top-level object are read. NOT a full parser:
+    // sdp, candidate, etc. are not extracted yet.
+    if (auto type = FindTopLevelString(data, "type")) {
+      msg.type = SignalMessage::StringToType(*type);
     }
+    if (auto from = FindTopLevelString(data, "from")) msg.from = *from;
+    if (auto to = FindTopLevelString(data, "to")) msg.to = *to;
+    // Set by the signaling server, which overwrites any top-level "role" of
+    // the sender; a "role" nested elsewhere in the message is ignored.
+    msg.role = FindTopLevelString(data, "role");
 
     // Add similar simple logic for sdp, candidate, etc. - this gets complex
     // fast.
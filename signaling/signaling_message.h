@@ -27,6 +27,9 @@ struct SignalMessage {
   std::optional<std::string> sdpMid;     // For CANDIDATE
   std::optional<int> sdpMlineIndex;      // For CANDIDATE
   std::optional<std::string> reason;     // For LEAVE messages, errors, etc.
+  // Role claim of the sender's token. Set by the signaling server, which
+  // verified the token, on the messages it forwards; never sent by clients.
+  std::optional<std::string> role;
   // Add more optional fields as needed for other message types
 
   // Constructor for convenience (example for sending simple messages)
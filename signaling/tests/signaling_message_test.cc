@@ -0,0 +1,124 @@
+// Test of the top-level member scan of DeserializeSignalMessage, which
+// decides the role claim, and so who may drive the vehicle. Only a "role"
+// member of the top-level object counts (the one the signaling server sets
+// after verifying the token); a sender must not be able to shadow it with a
+// "role" nested in an object or array, spelled inside a string value, or
+// hidden behind escaped quotes. A missing or non-string role is no claim.
+//
+// Build, then run, from the repository root:
+//   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -I.
+//       -o /tmp/signaling_message_test
+//       signaling/tests/signaling_message_test.cc
+//       signaling/signaling_message.cc
+//   /tmp/signaling_message_test
+
+#include <cstdio>
+#include <optional>
+#include <string>
+
+#include "signaling/signaling_message.h"
+#include "testing/check.h"
+
+namespace {
+
+// The role claim of a message, which must parse.
+std::optional<std::string> RoleOf(const std::string& json) {
+  const std::optional<SignalMessage> message = DeserializeSignalMessage(json);
+  CHECK(message.has_value());
+  return message->role;
+}
+
+bool HasRole(const std::string& json, const std::string& role) {
+  const std::optional<std::string> found = RoleOf(json);
+  return found && *found == role;
+}
+
+void TestTopLevelMembers() {
+  const std::optional<SignalMessage> message = DeserializeSignalMessage(
+      R"({"type":"offer","from":"cockpit-1","to":"vehicle-1",)"
+      R"("role":"driver"})");
+  CHECK(message.has_value());
+  CHECK(message->type == SignalMessage::Type::OFFER);
+  CHECK(message->from == "cockpit-1");
+  CHECK(message->to == "vehicle-1");
+  CHECK(message->role && *message->role == "driver");
+
+  CHECK(HasRole(" { \"role\" :\t\"driver\" \n} ", "driver"));
+  // After nested members, arrays and strings holding brackets.
+  CHECK(HasRole(R"({"sdp":"v=0 {[","candidate":{"a":[1,{"b":2}]},)"
+                R"("list":["x"],"role":"observer"})",
+                "observer"));
+}
+
+void TestNestedRoleIgnored() {
+  CHECK(!RoleOf(R"({"type":"offer","candidate":{"role":"driver"}})"));
+  CHECK(!RoleOf(R"({"a":{"b":{"role":"driver"}}})"));
+  // The top-level one wins over a nested copy before or after it.
+  CHECK(HasRole(R"({"x":{"role":"driver"},"role":"observer"})", "observer"));
+  CHECK(HasRole(R"({"role":"observer","x":{"role":"driver"}})", "observer"));
+}
+
+void TestRoleInsideStringIgnored() {
+  CHECK(!RoleOf(R"({"sdp":"role"})"));
+  // "role" as a value followed by a string: neither is a member named role.
+  CHECK(!RoleOf(R"({"reason":"role","sdp":"driver"})"));
+  CHECK(!RoleOf(R"({"sdp":"{\"role\":\"driver\"}"})"));
+  CHECK(!RoleOf(R"({"sdp":"\",\"role\":\"driver"})"));
+}
+
+void TestEscapedQuotes() {
+  // Escaped quotes (and an escaped backslash before a real quote) do not
+  // end the string early, so its content never becomes a member.
+  CHECK(HasRole(R"({"sdp":"a\"b\\","role":"observer"})", "observer"));
+  CHECK(HasRole(R"({"sdp":"x\",\"role\":\"driver\"","role":"observer"})",
+                "observer"));
+  CHECK(!RoleOf(R"({"sdp":"\\\",\"role\":\"driver\""})"));
+  // Escapes in the value are kept as is, never unescaped into a match.
+  CHECK(HasRole(R"({"role":"dri\"ver"})", R"(dri\"ver)"));
+}
+
+void TestRoleInsideArrayIgnored() {
+  CHECK(!RoleOf(R"({"list":["role","driver"]})"));
+  CHECK(!RoleOf(R"({"list":[{"role":"driver"}]})"));
+  CHECK(!RoleOf(R"({"list":[["x"],{"a":1,"role":"driver"}]})"));
+  CHECK(!RoleOf(R"([{"role":"driver"}])"));
+  CHECK(!RoleOf(R"(["role","driver"])"));
+  CHECK(HasRole(R"({"list":[{"role":"driver"}],"role":"observer"})",
+                "observer"));
+}
+
+void TestMissingOrNonStringRole() {
+  CHECK(!RoleOf(R"({"type":"offer","from":"cockpit-1"})"));
+  CHECK(!RoleOf(""));
+  CHECK(!RoleOf(R"({"role":1})"));
+  CHECK(!RoleOf(R"({"role":null})"));
+  CHECK(!RoleOf(R"({"role":true})"));
+  CHECK(!RoleOf(R"({"role":["driver"]})"));
+  CHECK(!RoleOf(R"({"role":{"name":"driver"}})"));
+  CHECK(!RoleOf(R"({"role"})"));
+  CHECK(!RoleOf(R"({"role":)"));
+  // Unterminated strings end the scan without a claim.
+  CHECK(!RoleOf(R"({"role":"driver)"));
+  CHECK(!RoleOf(R"({"sdp":"abc,"role":"driver"})"));
+}
+
+void TestTypeNames() {
+  CHECK(SignalMessage::TypeToString(SignalMessage::Type::CANDIDATE) ==
+        "candidate");
+  CHECK(SignalMessage::StringToType("answer") == SignalMessage::Type::ANSWER);
+  CHECK(SignalMessage::StringToType("role") == SignalMessage::Type::UNKNOWN);
+}
+
+}  // namespace
+
+int main() {
+  TestTopLevelMembers();
+  TestNestedRoleIgnored();
+  TestRoleInsideStringIgnored();
+  TestEscapedQuotes();
+  TestRoleInsideArrayIgnored();
+  TestMissingOrNonStringRole();
+  TestTypeNames();
+  std::printf("signaling_message_test: OK\n");
+  return 0;
+}
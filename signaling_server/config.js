@@ -12,7 +12,10 @@ module.exports = {
     },
     auth: {
         jwtSecret: process.env.JWT_SECRET || 'your_default_jwt_secret', // Use strong secret from env var!
-        tokenExpiration: '1h' // Example token expiration
+        tokenExpiration: '1h', // Example token expiration
+        // Role of tokens without a 'role' claim (e.g., 'driver' or 'observer').
+        // Observer by default: control needs an explicit 'driver' claim.
+        defaultRole: process.env.DEFAULT_ROLE || 'observer'
     },
     // Add other configurations, like CORS headers if necessary
 };
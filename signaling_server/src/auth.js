@@ -3,9 +3,9 @@ const jwt = require('jsonwebtoken');
 const config = require('../config'); // Load configuration
 
 /**
- * Verifies a JWT token and extracts the client ID.
+ * Verifies a JWT token and extracts the client ID and role.
  * @param {string} token - The JWT token string.
- * @returns {Promise<string|null>} - Resolves with the client ID if valid, or null if invalid.
+ * @returns {Promise<{clientId: string, role: string}|null>} - Resolves with the claims if valid, or null if invalid.
  */
 async function verifyToken(token) {
     if (!token) {
@@ -13,10 +13,11 @@ async function verifyToken(token) {
     }
     try {
         const decoded = jwt.verify(token, config.auth.jwtSecret);
-        // Assumes the JWT payload includes a 'clientId' field
+        // Assumes the JWT payload includes a 'clientId' field; 'role' is optional
         if (decoded && decoded.clientId) {
-            console.log(`Auth: Token verified for client ${decoded.clientId}`);
-            return decoded.clientId;
+            const role = typeof decoded.role === 'string' ? decoded.role : config.auth.defaultRole;
+            console.log(`Auth: Token verified for client ${decoded.clientId} (role ${role})`);
+            return { clientId: decoded.clientId, role: role };
         }
         return null; // Token valid but no clientId in payload
     } catch (err) {
@@ -45,14 +45,15 @@ wss.on('connection', async (ws, request) => {
     const parameters = url.parse(request.url, true).query;
     const token = parameters.token;
 
-    const clientId = await auth.verifyToken(token);
+    const claims = await auth.verifyToken(token);
 
-    if (!clientId) {
+    if (!claims) {
         console.warn('Server: WebSocket connection rejected: Invalid or missing token.');
         ws.send(JSON.stringify({ type: 'error', message: 'Authentication failed' }));
         ws.terminate(); // Close connection immediately
         return;
     }
+    const clientId = claims.clientId;
 
     // Assign a simple ID to the WebSocket object for easier logging/tracking (optional)
     ws.id = clientId; // Use authenticated client ID as connection ID
@@ -60,7 +61,7 @@ wss.on('connection', async (ws, request) => {
     console.log(`Server: WebSocket connection authenticated for client: ${clientId}`);
 
     // Add client to session manager
-    sessionManager.addClient(ws, clientId);
+    sessionManager.addClient(ws, clientId, claims.role);
 
     // --- Message Handling ---
     ws.on('message', (message) => {
@@ -2,7 +2,7 @@
 
 // Map to store connected clients by their WebSocket connection object
 // Using WebSocket object as key (or a unique connection ID managed by server.js)
-const connectedClients = new Map(); // Map<WebSocket, ClientInfo { id: string, targetId: string | null }>
+const connectedClients = new Map(); // Map<WebSocket, ClientInfo { id: string, role: string, targetId: string | null }>
 
 // Map to manage active sessions (e.g., VehicleId -> CockpitWebSocket)
 // This structure assumes a simple routing logic. More complex routing (1:N, N:M)
@@ -13,13 +13,14 @@ const sessions = new Map(); // Map<string, WebSocket> // e.g., 'vehicle_XYZ' ->
  * Adds a newly connected and authenticated client.
  * @param {WebSocket} ws - The client's WebSocket connection.
  * @param {string} clientId - The authenticated client ID.
+ * @param {string} role - The role claim of the client's token.
  */
-function addClient(ws, clientId) {
+function addClient(ws, clientId, role) {
     if (connectedClients.has(ws)) {
         console.warn(`SessionManager: Client ${clientId} already added.`);
         return;
     }
-    connectedClients.set(ws, { id: clientId, targetId: null });
+    connectedClients.set(ws, { id: clientId, role: role, targetId: null });
     console.log(`SessionManager: Client ${clientId} connected. Total clients: ${connectedClients.size}`);
 
     // If this is a vehicle, register it in sessions immediately (assuming vehicles are targets)
@@ -99,7 +100,9 @@ function routeMessage(senderWs, message) {
         return; // Should not happen if logic is correct
     }
 
-    // Validate 'from' field matches authenticated sender ID
+    // Validate 'from' field matches authenticated sender ID. Every message
+    // forwarded below also carries senderInfo.id as 'from', never the
+    // sender's own value.
     if (message.from !== senderInfo.id) {
         console.warn(`SessionManager: Received message from ${senderInfo.id} claiming to be from ${message.from}. Ignoring.`);
         // Optional: Send error back to sender
@@ -141,6 +144,7 @@ function routeMessage(senderWs, message) {
                     type: 'join_request', // Custom type for routing JOIN
                     from: senderInfo.id,
                     to: targetVehicleId,
+                    role: senderInfo.role, // Verified role claim of the initiator
                     data: { clientId: senderInfo.id } // Send initiator's ID
                 });
 
@@ -199,9 +203,15 @@ function routeMessage(senderWs, message) {
                 // Ensure sender is allowed to send to this recipient if implementing stricter access control
                 // For 1:1, you might check if sender's targetId is recipientId, and recipient's targetId is senderId.
 
-                console.log(`SessionManager: Routing '${message.type}' from ${message.from} to ${recipientId}.`);
-                // Forward the message directly to the recipient
-                sendMessage(recipientWs, message);
+                console.log(`SessionManager: Routing '${message.type}' from ${senderInfo.id} to ${recipientId}.`);
+                // Forward the message with the sender's authenticated ID and
+                // verified role claim; values set by the sender itself are
+                // overwritten.
+                sendMessage(recipientWs, {
+                    ...message,
+                    from: senderInfo.id,
+                    role: senderInfo.role
+                });
 
             } else {
                 console.warn(`SessionManager: Recipient ${recipientId} not found or offline for message from ${senderInfo.id}.`);
@@ -0,0 +1,54 @@
+#ifndef TESTING_ALLOCATION_COUNTER_H
+#define TESTING_ALLOCATION_COUNTER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// Counts heap allocations by replacing the global operator new, so tests and
+// benchmarks can check that a path does not allocate. Replacing operator new
+// is per program: include this from exactly one translation unit (the
+// test's or benchmark's main file).
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace testing {
+
+inline std::atomic<uint64_t>& AllocationCount() {
+  static std::atomic<uint64_t> count{0};
+  return count;
+}
+
+// Allocations made by this process so far (all threads).
+inline uint64_t Allocations() {
+  return AllocationCount().load(std::memory_order_relaxed);
+}
+
+}  // namespace testing
+}  // namespace remote
+}  // namespace autodev
+
+// GCC (-Wmismatched-new-delete) pairs the inlined free() below with the
+// operator new call it cannot see through and warns; the pair matches.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+  autodev::remote::testing::AllocationCount().fetch_add(
+      1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif  // TESTING_ALLOCATION_COUNTER_H
@@ -0,0 +1,44 @@
+#ifndef TESTING_BENCHMARK_H
+#define TESTING_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// Minimal helpers for the standalone benchmarks next to the modules
+// (*/benchmarks/*_benchmark.cc). Each benchmark is a single translation unit
+// with its own main(), built with -O2 against the sources it measures (see
+// the command at the top of each file) and printing one line per case.
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace testing {
+
+// Keeps the compiler from dropping a computation whose result is unused.
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Calls op() 'iterations' times (after a warm-up tenth) and returns the
+// mean wall time per call in nanoseconds.
+template <typename Op>
+double NanosPerOp(uint64_t iterations, Op&& op) {
+  for (uint64_t i = 0; i < iterations / 10; ++i) op();
+  const auto start = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < iterations; ++i) op();
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         static_cast<double>(iterations);
+}
+
+inline void PrintResult(const char* name, double ns_per_op) {
+  std::printf("%-48s %10.1f ns/op\n", name, ns_per_op);
+}
+
+}  // namespace testing
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // TESTING_BENCHMARK_H
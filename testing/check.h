@@ -0,0 +1,20 @@
+#ifndef TESTING_CHECK_H
+#define TESTING_CHECK_H
+
+#include <cstdio>
+#include <cstdlib>
+
+// Assertion for the standalone tests next to the modules
+// (*/tests/*_test.cc). Unlike assert() it stays active under -DNDEBUG, and
+// it reports the failed expression with its location before aborting, so a
+// failing test exits non-zero with a pointer to the broken expectation.
+#define CHECK(condition)                                              \
+  do {                                                                \
+    if (!(condition)) {                                               \
+      std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__,     \
+                   __LINE__, #condition);                             \
+      std::abort();                                                   \
+    }                                                                 \
+  } while (0)
+
+#endif  // TESTING_CHECK_H
@@ -1,10 +1,15 @@
 #ifndef VEHICLE_CONFIG_H
 #define VEHICLE_CONFIG_H
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
 
+#include "control/connection_health.h"
+#include "control/controller_config.h"
+#include "control/degradation_policy.h"
+
 struct WebRtcServerConfig {
   std::string uri;  // Signaling server URI
   std::string jwt;  // Optional JWT
@@ -17,6 +22,22 @@ struct SensorConfig {
   uint32_t camera_fps;
   // Add config for chassis source if needed (e.g., CAN bus interface)
   std::string can_interface;  // e.g., "can0"
+
+  // Follow the send bandwidth estimate with camera format and encoder
+  // bitrate (camera_width/height/fps is the best quality). The reserve is
+  // kept free for the control and telemetry DataChannels.
+  bool video_bandwidth_adaptation = true;
+  uint32_t video_reserved_data_bps = 500000;
+
+  // Video limits for an observer peer: one that asked for preview mode (a
+  // multi-vehicle cockpit supervising this vehicle) or joined while another
+  // peer controls the vehicle.
+  uint32_t video_preview_max_bitrate_bps = 300000;
+  uint32_t video_preview_max_framerate = 5;
+  double video_preview_scale_down_by = 4.0;
+  // Shared by all observers; each gets at most its equal part, so more
+  // observers do not take more of the uplink from the controller.
+  uint32_t video_observers_max_bitrate_bps = 1000000;
 };
 
 // Structure to hold all configuration parameters for the vehicle client
@@ -28,6 +49,58 @@ struct VehicleConfig {
   // DataChannel labels (should match remote driver client)
   std::string control_channel_label = "control";
   std::string telemetry_channel_label = "telemetry";
+  std::string session_channel_label = "session";
+
+  // Files sent by a cockpit (map tiles, calibration, ...) arrive in chunks
+  // on a low priority channel and are stored in received_files_dir, which
+  // must exist; empty disables receiving files. Interrupted transfers resume
+  // when the file is sent again.
+  std::string file_channel_label = "file";
+  std::string received_files_dir;
+  uint64_t received_file_max_bytes = 4ULL << 30;
+
+  // Pack telemetry updates into batches (one DataChannel message each) that
+  // leave at the latest telemetry_batch_max_latency_ms after their first
+  // update. Cockpits unpack them; older cockpits need it disabled.
+  bool telemetry_batching = false;
+  int telemetry_batch_max_latency_ms = 5;
+  size_t telemetry_batch_max_bytes = 1152;
+
+  // Telemetry is skipped for a peer while its telemetry channel holds more
+  // than this many unsent bytes (trySend), instead of queueing stale updates
+  // behind a slow link; the next update goes out once it drains. 0 queues
+  // them in the send scheduler instead.
+  uint64_t telemetry_max_buffered_bytes = 32 * 1024;
+
+  // Telemetry rate per observer peer; the controlling peer gets every
+  // update. 0 disables telemetry for observers.
+  double observer_telemetry_rate_hz = 10.0;
+
+  // Role claim (of the peer's signaling token, forwarded by the signaling
+  // server) that allows a peer to control the vehicle. Peers without a
+  // claim are observers unless require_role_claim is cleared (signaling
+  // servers that do not forward role claims).
+  std::string control_role_claim = "driver";
+  bool require_role_claim = true;
+
+  // Health scoring of the peers' connections and, from the controller's
+  // score, proactive degradation: reduced video, then a speed cap, then a
+  // pull over. Evaluated once per second.
+  bool degradation_policy = true;
+  autodev::remote::vehicle::ConnectionHealthConfig connection_health;
+  autodev::remote::vehicle::DegradationPolicyConfig degradation;
+
+  // Limits the controller enforces (the vehicle's own speed and steering
+  // limits). While SpeedLimited, max_speed_mps is capped further by
+  // degradation.limited_max_speed_mps; recovering restores this.
+  autodev::remote::control::ControllerConfig controller;
+
+  // Exchange chassis state and commands with an autonomy stack on this
+  // computer through shared memory (e.g., "/autodev_remote_vehicle"),
+  // instead of the CAN bus chassis source and the Apollo controller. Empty
+  // disables it. A poll interval of 0 spins a core for the lowest latency.
+  std::string shm_bridge_name;
+  int shm_chassis_poll_interval_us = 200;
 
   // WebRTC ICE server configuration (STUN/TURN)
   struct IceServer {
@@ -37,6 +110,11 @@ struct VehicleConfig {
   };
   std::vector<IceServer> ice_servers;
 
+  // Prometheus text endpoint (http://<address>:<port>/metrics) for the
+  // WebRTC connection statistics; port 0 disables it.
+  std::string metrics_address = "127.0.0.1";
+  uint16_t metrics_port = 9464;
+
   // Add other configurations as needed (e.g., logging levels, heartbeat
   // intervals)
   int heartbeat_interval_ms = 5000;  // milliseconds
@@ -0,0 +1,35 @@
+#include "control/command_limits.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace autodev {
+namespace remote {
+namespace control {
+
+void LimitControlValues(const ControllerConfig& config,
+                        double current_speed_mps, ControlValues* values) {
+  values->steering_angle =
+      std::clamp(values->steering_angle, -config.max_steering_angle_rad,
+                 config.max_steering_angle_rad);
+
+  // Speed is a magnitude here; the gear decides the direction.
+  const double speed = std::fabs(current_speed_mps);
+  const double headroom = config.max_speed_mps - speed;
+  if (headroom <= 0.0) {
+    values->acceleration = 0.0;
+  } else if (headroom < config.speed_limit_taper_mps) {
+    values->acceleration *= headroom / config.speed_limit_taper_mps;
+  }
+
+  if (headroom < 0.0) {
+    const double braking =
+        std::min(config.max_overspeed_braking,
+                 -headroom * config.overspeed_braking_per_mps);
+    values->braking = std::max(values->braking, braking);
+  }
+}
+
+}  // namespace control
+}  // namespace remote
+}  // namespace autodev
@@ -0,0 +1,49 @@
+#ifndef COMMAND_LIMITS_H
+#define COMMAND_LIMITS_H
+
+#include "control/controller_config.h"
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace control {
+
+// The actuator values of a ControlCommand that the limits act on.
+struct ControlValues {
+  double acceleration = 0.0;
+  double braking = 0.0;
+  double steering_angle = 0.0;
+};
+
+// Applies the limits of config to the values before they reach the
+// actuators, given the measured speed:
+// - steering_angle is clamped to +/- max_steering_angle_rad;
+// - acceleration fades out linearly over the last speed_limit_taper_mps
+//   below max_speed_mps and is cut at it;
+// - above max_speed_mps braking is at least overspeed_braking_per_mps per
+//   m/s of excess, capped at max_overspeed_braking, so a lowered limit
+//   (e.g., DegradationLevel::SpeedLimited) slows a faster vehicle down.
+// The operator's own braking is never reduced.
+void LimitControlValues(const ControllerConfig& config,
+                        double current_speed_mps, ControlValues* values);
+
+// LimitControlValues on a ControlCommand (or any message with the same
+// accessors), in place.
+template <typename Command>
+void LimitControlCommand(const ControllerConfig& config,
+                         double current_speed_mps, Command* command) {
+  ControlValues values;
+  values.acceleration = command->acceleration();
+  values.braking = command->braking();
+  values.steering_angle = command->steering_angle();
+  LimitControlValues(config, current_speed_mps, &values);
+  command->set_acceleration(values.acceleration);
+  command->set_braking(values.braking);
+  command->set_steering_angle(values.steering_angle);
+}
+
+}  // namespace control
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // COMMAND_LIMITS_H
@@ -0,0 +1,65 @@
+#include "control/connection_health.h"
+
+#include <algorithm>
+
+namespace autodev {
+namespace remote {
+namespace vehicle {
+
+namespace {
+
+double ScoreInput(double value, const HealthRange& range) {
+  if (value <= range.good) return 1.0;
+  if (value >= range.bad) return 0.0;
+  return (range.bad - value) / (range.bad - range.good);
+}
+
+}  // namespace
+
+ConnectionHealth ScoreConnectionHealth(const ConnectionHealthSample& sample,
+                                       const ConnectionHealthConfig& config) {
+  ConnectionHealth health;
+  health.rtt = ScoreInput(sample.rtt_ms, config.rtt_ms);
+  health.jitter = ScoreInput(sample.jitter_ms, config.jitter_ms);
+  health.loss = ScoreInput(sample.loss_fraction, config.loss_fraction);
+  health.video_freezes =
+      ScoreInput(static_cast<double>(sample.video_freezes),
+                 config.video_freezes);
+  health.command_age =
+      std::max(ScoreInput(sample.command_age_ms, config.command_age_ms),
+               config.command_age_min_score);
+  health.score = std::min({health.rtt, health.jitter, health.loss,
+                           health.video_freezes, health.command_age});
+  return health;
+}
+
+ConnectionHealthTracker::ConnectionHealthTracker(
+    std::chrono::milliseconds freeze_window)
+    : freezeWindow_(freeze_window) {}
+
+void ConnectionHealthTracker::addStats(
+    const autodev::remote::webrtc::PeerConnectionStats& stats,
+    std::chrono::steady_clock::time_point now) {
+  network_.rtt_ms = stats.rtt_ms;
+  network_.jitter_ms = stats.remote_jitter_ms;
+  network_.loss_fraction = stats.remote_fraction_lost;
+  if (lastFramesEncoded_ > 0 && stats.frames_encoded <= lastFramesEncoded_) {
+    freezes_.push_back(now);
+  }
+  lastFramesEncoded_ = stats.frames_encoded;
+}
+
+ConnectionHealthSample ConnectionHealthTracker::sample(
+    std::chrono::steady_clock::time_point now, double command_age_ms) {
+  while (!freezes_.empty() && now - freezes_.front() > freezeWindow_) {
+    freezes_.pop_front();
+  }
+  ConnectionHealthSample sample = network_;
+  sample.video_freezes = static_cast<uint32_t>(freezes_.size());
+  sample.command_age_ms = command_age_ms;
+  return sample;
+}
+
+}  // namespace vehicle
+}  // namespace remote
+}  // namespace autodev
@@ -0,0 +1,89 @@
+#ifndef CONNECTION_HEALTH_H
+#define CONNECTION_HEALTH_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+
+#include "webrtc/peer_connection_stats.h"
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace vehicle {
+
+// What the health of a peer's connection is computed from.
+struct ConnectionHealthSample {
+  double rtt_ms = 0.0;
+  double jitter_ms = 0.0;       // Reported by the peer for the sent media
+  double loss_fraction = 0.0;   // 0..1, reported by the peer
+  uint32_t video_freezes = 0;   // Within the tracker's freeze window
+  double command_age_ms = 0.0;  // Since the last accepted control command
+};
+
+// Score of one input: 1 up to 'good', 0 from 'bad' on, linear in between.
+struct HealthRange {
+  double good = 0.0;
+  double bad = 0.0;
+};
+
+struct ConnectionHealthConfig {
+  HealthRange rtt_ms{100.0, 400.0};
+  HealthRange jitter_ms{20.0, 100.0};
+  HealthRange loss_fraction{0.01, 0.10};
+  HealthRange video_freezes{0.0, 3.0};
+  HealthRange command_age_ms{200.0, 1000.0};
+  // Command age only counts while the vehicle moves faster than this: an
+  // idle controller (the web UI only sends on input) of a standing vehicle
+  // is healthy.
+  double command_age_min_speed_mps = 0.5;
+  // Lowest score the command age gives on its own. A silent controller on a
+  // good link gets the vehicle speed limited, never pulled over (see
+  // DegradationPolicyConfig::pull_over_below); that takes a bad link.
+  double command_age_min_score = 0.3;
+  // Stats polls without a newly encoded frame count as freezes this long.
+  std::chrono::milliseconds freeze_window{10000};
+};
+
+// Scores in 0 (unusable) .. 1 (healthy).
+struct ConnectionHealth {
+  double score = 1.0;  // The worst of the inputs: any one can make driving
+                       // unsafe, good figures elsewhere do not make up for it
+  double rtt = 1.0;
+  double jitter = 1.0;
+  double loss = 1.0;
+  double video_freezes = 1.0;
+  double command_age = 1.0;
+};
+
+ConnectionHealth ScoreConnectionHealth(const ConnectionHealthSample& sample,
+                                       const ConnectionHealthConfig& config);
+
+// Turns the periodic stats reports of one peer into health samples.
+//
+// Not thread-safe; the owner serializes calls.
+class ConnectionHealthTracker {
+ public:
+  explicit ConnectionHealthTracker(std::chrono::milliseconds freeze_window);
+
+  // Takes the network figures of a report; a report without newly encoded
+  // frames (after video was flowing) is a freeze.
+  void addStats(const autodev::remote::webrtc::PeerConnectionStats& stats,
+                std::chrono::steady_clock::time_point now);
+
+  // The latest network figures with the freezes of the window up to now.
+  ConnectionHealthSample sample(std::chrono::steady_clock::time_point now,
+                                double command_age_ms);
+
+ private:
+  const std::chrono::milliseconds freezeWindow_;
+  ConnectionHealthSample network_;
+  uint64_t lastFramesEncoded_ = 0;
+  std::deque<std::chrono::steady_clock::time_point> freezes_;
+};
+
+}  // namespace vehicle
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // CONNECTION_HEALTH_H
@@ -18,6 +18,9 @@
 #include "include/control/controller.h"
 
 #include <iostream>
+#include <mutex>
+
+#include "control/command_limits.h"
 
 // Include generated protobuf headers
 // #include "control/proto/control_command.pb.h"
@@ -26,23 +29,38 @@
 // Need Protobuf library for deserialization
 // #include <google/protobuf/message.h>
 
+namespace autodev {
+namespace remote {
+namespace control {
+
 class ApolloController : public IController {
  public:
   ApolloController() {
     std::cout << "ApolloController created (skeleton)" << std::endl;
   }
 
+  bool init(const ControllerConfig& config) override {
+    return updateConfig(config);
+  }
+
+  // MUST BE THREAD-SAFE: ACQUIRE mutex_
   void processControlCommand(
       const autodev::remote::control::ControlCommand& command) override {
+    autodev::remote::control::ControlCommand limited = command;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      LimitControlCommand(config_, actuatorState_.current_speed_mps,
+                          &limited);
+    }
     std::cout << "ApolloController: Processing ControlCommand (skeleton):"
               << std::endl;
     // TODO: Implement logic to apply command to vehicle actuators
     // This would involve interfacing with low-level vehicle control systems
     // (e.g., CAN bus commands)
-    std::cout << "  Acceleration: " << command.acceleration() << std::endl;
-    std::cout << "  Braking: " << command.braking() << std::endl;
-    std::cout << "  Steering: " << command.steering_angle() << std::endl;
-    std::cout << "  Gear: " << command.gear() << std::endl;
+    std::cout << "  Acceleration: " << limited.acceleration() << std::endl;
+    std::cout << "  Braking: " << limited.braking() << std::endl;
+    std::cout << "  Steering: " << limited.steering_angle() << std::endl;
+    std::cout << "  Gear: " << limited.gear() << std::endl;
   }
 
   void processEmergencyCommand(
@@ -63,4 +81,43 @@ class ApolloController : public IController {
     //     // Execute safe pull-over sequence
     // }
   }
+
+  // MUST BE THREAD-SAFE: ACQUIRE mutex_
+  bool updateConfig(const ControllerConfig& config) override {
+    if (config.max_speed_mps < 0.0 || config.max_steering_angle_rad < 0.0 ||
+        config.speed_limit_taper_mps <= 0.0) {
+      std::cerr << "ApolloController: Rejected config with invalid limits."
+                << std::endl;
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    std::cout << "ApolloController: Config updated: max speed "
+              << config.max_speed_mps << " m/s" << std::endl;
+    return true;
+  }
+
+  // MUST BE THREAD-SAFE: ACQUIRE mutex_
+  void updateActuatorState(const ActuatorState& state) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    actuatorState_ = state;
+  }
+
+  ActuatorState getActuatorState() const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return actuatorState_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  ControllerConfig config_;      // Guarded by mutex_
+  ActuatorState actuatorState_;  // Guarded by mutex_; from the chassis
+
+  // Prevent copying
+  ApolloController(const ApolloController&) = delete;
+  ApolloController& operator=(const ApolloController&) = delete;
 };
+
+}  // namespace control
+}  // namespace remote
+}  // namespace autodev
@@ -3,12 +3,10 @@
 
 #include <string>
 
+#include "control/controller_config.h"
 #include "control/proto/control_command.pb.h"
 #include "control/proto/emergency_command.pb.h"
 
-// Forward declare configuration struct if defined elsewhere
-// struct ControllerConfig;
-
 // Placeholder for ActuatorState struct/message
 // In a real system, this would be a specific struct or Protobuf message
 namespace autodev {
@@ -23,16 +21,6 @@ struct ActuatorState {
   // ... other relevant states
 };
 
-// Placeholder for ControllerConfig struct/message
-// In a real system, this would be a specific struct or Protobuf message
-struct ControllerConfig {
-  // Define controller configuration parameters here (e.g., PID gains, vehicle
-  // parameters)
-  double max_speed_mps = 10.0;
-  double max_steering_angle_rad = 0.5;  // Example
-                                        // ... other relevant config
-};
-
 }  // namespace control
 }  // namespace remote
 }  // namespace autodev
@@ -70,6 +58,17 @@ class IController {
   virtual void processEmergencyCommand(
       const autodev::remote::control::EmergencyCommand& command) = 0;
 
+  // Applies a changed configuration while running (e.g., a lower
+  // max_speed_mps while the connection to the cockpit is degraded); the
+  // commands processed afterwards respect it. Returns false if the
+  // configuration is rejected. Implementations must be thread-safe.
+  virtual bool updateConfig(const ControllerConfig& config) = 0;
+
+  // Feeds the measured actuator state (e.g., the speed from the chassis
+  // source) to controllers that enforce the limits themselves. The default
+  // ignores it. Implementations must be thread-safe.
+  virtual void updateActuatorState(const ActuatorState& /*state*/) {}
+
   // Optional: Method to get the current state of actuators if needed for
   // feedback/telemetry. This should be thread-safe if the controller updates
   // its state asynchronously.
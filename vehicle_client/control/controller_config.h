@@ -0,0 +1,32 @@
+#ifndef CONTROLLER_CONFIG_H
+#define CONTROLLER_CONFIG_H
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace control {
+
+// Configuration of an IController (control/controller.h). Kept apart from
+// the interface so code that only needs the limits does not depend on the
+// generated Protobuf messages.
+struct ControllerConfig {
+  // Define controller configuration parameters here (e.g., PID gains, vehicle
+  // parameters)
+  double max_speed_mps = 10.0;
+  double max_steering_angle_rad = 0.5;  // Example
+  // Enforcement of max_speed_mps by controllers that apply the commands
+  // themselves (see LimitControlCommand): acceleration fades out over the
+  // last speed_limit_taper_mps below the limit, and above it braking is
+  // held at overspeed_braking_per_mps per m/s of excess, at most
+  // max_overspeed_braking (pedal range 0..1).
+  double speed_limit_taper_mps = 1.0;
+  double overspeed_braking_per_mps = 0.1;
+  double max_overspeed_braking = 0.3;
+  // ... other relevant config
+};
+
+}  // namespace control
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // CONTROLLER_CONFIG_H
@@ -0,0 +1,94 @@
+#include "control/degradation_policy.h"
+
+namespace autodev {
+namespace remote {
+namespace vehicle {
+
+const char* DegradationLevelName(DegradationLevel level) {
+  switch (level) {
+    case DegradationLevel::Normal:
+      return "normal";
+    case DegradationLevel::ReducedVideo:
+      return "reduced-video";
+    case DegradationLevel::SpeedLimited:
+      return "speed-limited";
+    case DegradationLevel::PullOver:
+      return "pull-over";
+  }
+  return "unknown";
+}
+
+DegradationPolicy::DegradationPolicy(const DegradationPolicyConfig& config)
+    : config_(config) {}
+
+bool DegradationPolicy::update(double score,
+                               std::chrono::steady_clock::time_point now,
+                               DegradationLevel* level) {
+  const std::chrono::steady_clock::time_point unset;
+  for (size_t i = 1; i < kLevels; ++i) {
+    if (score < threshold(static_cast<DegradationLevel>(i))) {
+      if (belowSince_[i] == unset) belowSince_[i] = now;
+    } else {
+      belowSince_[i] = unset;
+    }
+  }
+  if (level_ == DegradationLevel::PullOver) return false;  // Latched
+
+  // Escalate to the worst level whose hold time has passed.
+  const size_t current = static_cast<size_t>(level_);
+  for (size_t i = kLevels - 1; i > current; --i) {
+    const DegradationLevel candidate = static_cast<DegradationLevel>(i);
+    if (belowSince_[i] != unset && now - belowSince_[i] >= hold(candidate)) {
+      level_ = candidate;
+      recoverSince_ = unset;
+      *level = level_;
+      return true;
+    }
+  }
+
+  // Recover one level at a time.
+  if (level_ == DegradationLevel::Normal) return false;
+  if (score < threshold(level_) + config_.recover_margin) {
+    recoverSince_ = unset;
+    return false;
+  }
+  if (recoverSince_ == unset) {
+    recoverSince_ = now;
+    return false;
+  }
+  if (now - recoverSince_ < config_.recover_hold) return false;
+  level_ = static_cast<DegradationLevel>(current - 1);
+  recoverSince_ = now;  // The next level needs its own hold
+  *level = level_;
+  return true;
+}
+
+void DegradationPolicy::reset() {
+  level_ = DegradationLevel::Normal;
+  belowSince_.fill(std::chrono::steady_clock::time_point());
+  recoverSince_ = std::chrono::steady_clock::time_point();
+}
+
+double DegradationPolicy::threshold(DegradationLevel level) const {
+  switch (level) {
+    case DegradationLevel::ReducedVideo:
+      return config_.reduce_video_below;
+    case DegradationLevel::SpeedLimited:
+      return config_.limit_speed_below;
+    case DegradationLevel::PullOver:
+      return config_.pull_over_below;
+    case DegradationLevel::Normal:
+      break;
+  }
+  return 0.0;  // Normal is never entered by a low score
+}
+
+std::chrono::milliseconds DegradationPolicy::hold(
+    DegradationLevel level) const {
+  return level == DegradationLevel::PullOver ? config_.pull_over_hold
+                                             : config_.escalate_hold;
+}
+
+}  // namespace vehicle
+}  // namespace remote
+}  // namespace autodev
@@ -0,0 +1,85 @@
+#ifndef DEGRADATION_POLICY_H
+#define DEGRADATION_POLICY_H
+
+#include <array>
+#include <chrono>
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace vehicle {
+
+// How far the vehicle has backed off because of a poor connection to its
+// controller. Each level includes the ones before it.
+enum class DegradationLevel {
+  Normal,
+  ReducedVideo,  // Lower video budget, leaving room for control
+  SpeedLimited,  // ControllerConfig::max_speed_mps capped
+  PullOver,      // EmergencyCommand::PULL_OVER issued; latched
+};
+
+const char* DegradationLevelName(DegradationLevel level);
+
+struct DegradationPolicyConfig {
+  // Health score (see ScoreConnectionHealth) below which each level is
+  // entered, once the score stayed below it for the hold time.
+  double reduce_video_below = 0.7;
+  double limit_speed_below = 0.5;
+  double pull_over_below = 0.2;
+  std::chrono::milliseconds escalate_hold{1000};
+  std::chrono::milliseconds pull_over_hold{3000};
+
+  // One level is left once the score stayed at least recover_margin above
+  // its threshold for recover_hold. PullOver is only left by reset().
+  double recover_margin = 0.1;
+  std::chrono::milliseconds recover_hold{5000};
+
+  // Actions of the levels
+  double reduced_video_budget_scale = 0.5;  // Of the bandwidth estimate
+  double limited_max_speed_mps = 3.0;
+};
+
+// Decides the degradation level from a series of health scores.
+//
+// Going down is quick (a level after its hold time, skipping levels when
+// the score already warrants a worse one), coming back is slow and one
+// level at a time, so a flapping link does not toggle speed limits.
+//
+// Deterministic: no clock, no threads; the caller passes the time. A
+// recorded series of (score, time) replays to the same decisions. Not
+// thread-safe; the owner serializes calls.
+class DegradationPolicy {
+ public:
+  explicit DegradationPolicy(const DegradationPolicyConfig& config);
+
+  // Returns true and sets *level when the level changes.
+  bool update(double score, std::chrono::steady_clock::time_point now,
+              DegradationLevel* level);
+
+  DegradationLevel current() const { return level_; }
+
+  // Back to Normal (e.g., after a pull over, when a different peer takes
+  // control or the connection stayed healthy for recover_hold).
+  void reset();
+
+ private:
+  static constexpr size_t kLevels = 4;
+
+  double threshold(DegradationLevel level) const;
+  std::chrono::milliseconds hold(DegradationLevel level) const;
+
+  const DegradationPolicyConfig config_;
+  DegradationLevel level_ = DegradationLevel::Normal;
+  // Per level, start of the period the score has been below its threshold;
+  // unset (epoch) when it is not.
+  std::array<std::chrono::steady_clock::time_point, kLevels> belowSince_{};
+  // Start of the period the current level could have been left; unset
+  // (epoch) when it could not.
+  std::chrono::steady_clock::time_point recoverSince_;
+};
+
+}  // namespace vehicle
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // DEGRADATION_POLICY_H
@@ -0,0 +1,153 @@
+#include "control/peer_role_manager.h"
+
+#include <iostream>
+
+namespace autodev {
+namespace remote {
+namespace vehicle {
+
+PeerRoleManager::PeerRoleManager(const PeerRoleConfig& config)
+    : config_(config),
+      observerTelemetryInterval_(
+          config.observer_telemetry_rate_hz > 0.0
+              ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(
+                        1.0 / config.observer_telemetry_rate_hz))
+              : std::chrono::steady_clock::duration::max()) {}
+
+PeerRole PeerRoleManager::addPeer(const std::string& peer_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  peers_.emplace(peer_id, PeerState{});
+  if (controller_.empty() && mayControlLocked(peer_id)) controller_ = peer_id;
+  publishLocked();
+  const PeerRole role =
+      controller_ == peer_id ? PeerRole::Controller : PeerRole::Observer;
+  std::cout << "PeerRoleManager: Peer " << peer_id << " joined as "
+            << PeerRoleName(role) << " (" << peers_.size() << " peer(s))."
+            << std::endl;
+  return role;
+}
+
+bool PeerRoleManager::removePeer(const std::string& peer_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  peers_.erase(peer_id);
+  const bool was_controller = controller_ == peer_id;
+  if (was_controller) controller_.clear();
+  publishLocked();
+  if (!was_controller) return false;
+  std::cout << "PeerRoleManager: Controller " << peer_id
+            << " left; the vehicle has no controller." << std::endl;
+  return true;
+}
+
+bool PeerRoleManager::requestControl(const std::string& peer_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (peers_.find(peer_id) == peers_.end()) return false;
+  if (controller_ == peer_id) return true;
+  if (!mayControlLocked(peer_id)) {
+    std::cerr << "PeerRoleManager: Control request of " << peer_id
+              << " rejected; its role claim does not allow control."
+              << std::endl;
+    return false;
+  }
+  if (!controller_.empty()) {
+    std::cerr << "PeerRoleManager: Control request of " << peer_id
+              << " rejected; " << controller_ << " is the controller."
+              << std::endl;
+    return false;
+  }
+  controller_ = peer_id;
+  publishLocked();
+  std::cout << "PeerRoleManager: Peer " << peer_id << " is the controller."
+            << std::endl;
+  return true;
+}
+
+bool PeerRoleManager::releaseControl(const std::string& peer_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (controller_ != peer_id) return false;
+  controller_.clear();
+  publishLocked();
+  std::cout << "PeerRoleManager: Peer " << peer_id
+            << " released control; the vehicle has no controller."
+            << std::endl;
+  return true;
+}
+
+bool PeerRoleManager::setRoleClaim(const std::string& peer_id,
+                                   const std::string& role) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = roleClaims_.find(peer_id);
+  if (it != roleClaims_.end() && it->second == role) return false;
+  roleClaims_[peer_id] = role;
+  std::cout << "PeerRoleManager: Peer " << peer_id << " claims role '"
+            << role << "'." << std::endl;
+  if (controller_ != peer_id || mayControlLocked(peer_id)) return false;
+  controller_.clear();
+  publishLocked();
+  std::cerr << "PeerRoleManager: Controller " << peer_id
+            << " lost the control role; the vehicle has no controller."
+            << std::endl;
+  return true;
+}
+
+bool PeerRoleManager::isController(const std::string& peer_id) const {
+  return roleTable_.lookup(peer_id) == PeerRole::Controller;
+}
+
+PeerRole PeerRoleManager::getRole(const std::string& peer_id) const {
+  return roleTable_.lookup(peer_id);
+}
+
+std::string PeerRoleManager::getController() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return controller_;
+}
+
+size_t PeerRoleManager::getObserverCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return peers_.size() - (controller_.empty() ? 0 : 1);
+}
+
+std::vector<std::string> PeerRoleManager::getPeers() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::string> peers;
+  peers.reserve(peers_.size());
+  for (const auto& [peer_id, state] : peers_) peers.push_back(peer_id);
+  return peers;
+}
+
+void PeerRoleManager::selectTelemetryRecipients(
+    std::chrono::steady_clock::time_point now, std::vector<std::string>* out) {
+  out->clear();
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [peer_id, state] : peers_) {
+    if (peer_id != controller_ &&
+        now - state.last_telemetry < observerTelemetryInterval_) {
+      continue;
+    }
+    state.last_telemetry = now;
+    out->push_back(peer_id);
+  }
+}
+
+// --- Internal helpers ---
+
+bool PeerRoleManager::mayControlLocked(const std::string& peer_id) const {
+  auto it = roleClaims_.find(peer_id);
+  if (it == roleClaims_.end()) return !config_.require_role_claim;
+  return it->second == config_.control_role_claim;
+}
+
+void PeerRoleManager::publishLocked() {
+  PeerRoleTable::Roles roles;
+  for (const auto& [peer_id, state] : peers_) {
+    roles[peer_id] =
+        peer_id == controller_ ? PeerRole::Controller : PeerRole::Observer;
+  }
+  roleTable_.publish(roles);
+}
+
+}  // namespace vehicle
+}  // namespace remote
+}  // namespace autodev
@@ -0,0 +1,108 @@
+#ifndef PEER_ROLE_MANAGER_H
+#define PEER_ROLE_MANAGER_H
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "control/peer_role_table.h"
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace vehicle {
+
+struct PeerRoleConfig {
+  // Telemetry rate per observer; the controller gets every update.
+  double observer_telemetry_rate_hz = 10.0;
+  // Role claim that allows a peer to control the vehicle.
+  std::string control_role_claim = "driver";
+  // Peers without a role claim (older signaling servers) are observers
+  // when set; otherwise they may control.
+  bool require_role_claim = true;
+};
+
+// Roles of the peers connected to the vehicle: at most one controller, any
+// number of observers (e.g., safety observers watching the operator).
+//
+// The first peer to connect becomes the controller while there is none, so
+// a single cockpit works as before. Cockpits ask for their role with a
+// SessionRequest: control is granted only while no other peer has it;
+// preview turns a controller into an observer. The controller's
+// disconnection leaves the vehicle without a controller until a peer asks
+// for control.
+//
+// Only peers whose signaling token claims the control role become
+// controller. The signaling server verifies each peer's JWT and forwards its
+// role claim with the peer's signaling messages; a changed claim applies
+// immediately (a controller losing the role becomes an observer).
+//
+// All methods are THREAD-SAFE. The role queries are lock-free (see
+// PeerRoleTable), so the control path can check every message.
+class PeerRoleManager {
+ public:
+  explicit PeerRoleManager(const PeerRoleConfig& config = PeerRoleConfig());
+
+  // Registers a connected peer; returns its role.
+  PeerRole addPeer(const std::string& peer_id);
+  // Returns true if the peer was the controller.
+  bool removePeer(const std::string& peer_id);
+
+  // Returns false (the peer stays observer) if another peer controls the
+  // vehicle or the peer is unknown.
+  bool requestControl(const std::string& peer_id);
+  // Makes the peer an observer; returns true if it was the controller.
+  bool releaseControl(const std::string& peer_id);
+
+  // Records the role claim the signaling server forwarded for the peer
+  // (connected or not yet). Returns true if the peer lost control.
+  bool setRoleClaim(const std::string& peer_id, const std::string& role);
+
+  // Lock-free.
+  bool isController(const std::string& peer_id) const;
+  PeerRole getRole(const std::string& peer_id) const;  // Observer if unknown
+
+  std::string getController() const;                    // Empty: none
+  size_t getObserverCount() const;
+  std::vector<std::string> getPeers() const;
+
+  // Fills out with the peers that get the current telemetry update: the
+  // controller, and each observer whose telemetry interval has passed.
+  void selectTelemetryRecipients(std::chrono::steady_clock::time_point now,
+                                 std::vector<std::string>* out);
+
+ private:
+  struct PeerState {
+    std::chrono::steady_clock::time_point last_telemetry;
+  };
+
+  // mutex_ MUST be held for the two below.
+  bool mayControlLocked(const std::string& peer_id) const;
+  // Publishes peers_ and controller_ to roleTable_.
+  void publishLocked();
+
+  const PeerRoleConfig config_;
+  const std::chrono::steady_clock::duration observerTelemetryInterval_;
+
+  mutable std::mutex mutex_;
+  std::map<std::string, PeerState> peers_;  // Guarded by mutex_
+  std::string controller_;                  // Guarded by mutex_; empty: none
+  // Latest role claim by peer; kept across reconnections. Guarded by mutex_.
+  std::map<std::string, std::string> roleClaims_;
+
+  // Written under mutex_, read without it.
+  PeerRoleTable roleTable_;
+
+  // Prevent copying
+  PeerRoleManager(const PeerRoleManager&) = delete;
+  PeerRoleManager& operator=(const PeerRoleManager&) = delete;
+};
+
+}  // namespace vehicle
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // PEER_ROLE_MANAGER_H
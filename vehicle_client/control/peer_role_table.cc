@@ -0,0 +1,35 @@
+#include "control/peer_role_table.h"
+
+#include <thread>
+
+namespace autodev {
+namespace remote {
+namespace vehicle {
+
+PeerRole PeerRoleTable::lookup(const std::string& peer_id) const {
+  int index;
+  for (;;) {
+    index = active_.load();
+    readers_[index].fetch_add(1);
+    if (active_.load() == index) break;
+    // The writer switched meanwhile and may be rewriting this copy.
+    readers_[index].fetch_sub(1);
+  }
+  const Roles& roles = tables_[index];
+  auto it = roles.find(peer_id);
+  const PeerRole role = it == roles.end() ? PeerRole::Observer : it->second;
+  readers_[index].fetch_sub(1);
+  return role;
+}
+
+void PeerRoleTable::publish(const Roles& roles) {
+  const int next = 1 - active_.load();
+  // Readers still on this copy registered before the last switch.
+  while (readers_[next].load() != 0) std::this_thread::yield();
+  tables_[next] = roles;
+  active_.store(next);
+}
+
+}  // namespace vehicle
+}  // namespace remote
+}  // namespace autodev
@@ -0,0 +1,60 @@
+#ifndef PEER_ROLE_TABLE_H
+#define PEER_ROLE_TABLE_H
+
+#include <atomic>
+#include <string>
+#include <unordered_map>
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace vehicle {
+
+// What a connected peer (cockpit) may do with the vehicle.
+enum class PeerRole {
+  Observer,    // Reduced-rate video and telemetry; control is rejected
+  Controller,  // Full-rate streams; its control commands are executed
+};
+
+inline const char* PeerRoleName(PeerRole role) {
+  return role == PeerRole::Controller ? "controller" : "observer";
+}
+
+// Peer roles readable without locks. The control path looks the sender up
+// on every message; roles only change on connections, session requests and
+// role claims.
+//
+// The table is kept twice (left-right): readers register on the active
+// copy, a writer rebuilds the inactive copy once its last reader is gone
+// and then switches. Readers never wait for a writer (they only retry if a
+// switch happens between two loads); a writer waits for the readers of the
+// copy it rewrites, each a single hash lookup.
+class PeerRoleTable {
+ public:
+  using Roles = std::unordered_map<std::string, PeerRole>;
+
+  PeerRoleTable() = default;
+
+  // Observer if the peer is unknown. THREAD-SAFE, lock-free; no allocation.
+  PeerRole lookup(const std::string& peer_id) const;
+
+  // Replaces the roles. Calls MUST be serialized by the caller.
+  void publish(const Roles& roles);
+
+ private:
+  Roles tables_[2];
+  std::atomic<int> active_{0};
+  // Readers per copy. Sequentially consistent with active_: a reader that
+  // saw a copy as active after registering is seen by the writer.
+  mutable std::atomic<int> readers_[2] = {{0}, {0}};
+
+  // Prevent copying
+  PeerRoleTable(const PeerRoleTable&) = delete;
+  PeerRoleTable& operator=(const PeerRoleTable&) = delete;
+};
+
+}  // namespace vehicle
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // PEER_ROLE_TABLE_H
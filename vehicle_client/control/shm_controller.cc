@@ -0,0 +1,126 @@
+#include "control/shm_controller.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "metrics/static_metrics.h"
+
+namespace autodev {
+namespace remote {
+namespace control {
+
+namespace {
+
+int64_t SteadyNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+ipc::ShmControlLimits ToLimits(const ControllerConfig& config) {
+  ipc::ShmControlLimits limits;
+  limits.max_speed_mps = config.max_speed_mps;
+  limits.max_steering_angle_rad = config.max_steering_angle_rad;
+  return limits;
+}
+
+}  // namespace
+
+ShmController::ShmController(const std::string& shm_name)
+    : shmName_(shm_name) {}
+
+bool ShmController::init(const ControllerConfig& config) {
+  std::lock_guard<std::mutex> lock(producerMutex_);
+  if (!bridge_.open(shmName_)) {
+    std::cerr << "ShmController: Failed to open " << shmName_ << "."
+              << std::endl;
+    return false;
+  }
+  config_ = config;
+  bridge_.publishLimits(ToLimits(config_));
+  std::cout << "ShmController: Initialized (" << shmName_ << ")."
+            << std::endl;
+  return true;
+}
+
+void ShmController::processControlCommand(
+    const autodev::remote::control::ControlCommand& command) {
+  ipc::ShmCommand shm_command;
+  shm_command.type = ipc::ShmCommandType::Control;
+  shm_command.control.timestamp_ns = SteadyNowNs();
+  shm_command.control.acceleration = command.acceleration();
+  shm_command.control.braking = command.braking();
+  shm_command.control.steering_angle = command.steering_angle();
+  shm_command.control.gear = command.gear();
+
+  std::lock_guard<std::mutex> lock(producerMutex_);
+  if (!bridge_.isOpen()) {
+    std::cerr << "ShmController: Not initialized, ControlCommand dropped."
+              << std::endl;
+    return;
+  }
+  // The slot always holds the latest command, even if the ring is full.
+  bridge_.publishControl(shm_command.control);
+  if (!bridge_.pushCommand(shm_command)) {
+    autodev::remote::metrics::Increment(
+        autodev::remote::metrics::CounterId::ipc_commands_dropped_total);
+  }
+}
+
+void ShmController::processEmergencyCommand(
+    const autodev::remote::control::EmergencyCommand& command) {
+  ipc::ShmCommand shm_command;
+  shm_command.type = ipc::ShmCommandType::Emergency;
+  shm_command.control.timestamp_ns = SteadyNowNs();
+  shm_command.emergency_type = static_cast<int32_t>(command.type());
+  std::strncpy(shm_command.reason, command.reason().c_str(),
+               sizeof(shm_command.reason) - 1);
+
+  std::lock_guard<std::mutex> lock(producerMutex_);
+  if (!bridge_.isOpen()) {
+    std::cerr << "ShmController: Not initialized, EmergencyCommand dropped!"
+              << std::endl;
+    return;
+  }
+  // Must not be lost: give the autonomy stack a moment to drain a full ring.
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::microseconds(kEmergencyPushTimeoutUs);
+  while (!bridge_.pushCommand(shm_command)) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      autodev::remote::metrics::Increment(
+          autodev::remote::metrics::CounterId::ipc_commands_dropped_total);
+      std::cerr << "ShmController: Command ring full, EmergencyCommand "
+                   "dropped! Is the autonomy stack running?"
+                << std::endl;
+      return;
+    }
+    std::this_thread::yield();
+  }
+}
+
+bool ShmController::updateConfig(const ControllerConfig& config) {
+  if (config.max_speed_mps < 0.0 || config.max_steering_angle_rad < 0.0) {
+    std::cerr << "ShmController: Rejected config with negative limits."
+              << std::endl;
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(producerMutex_);
+  config_ = config;
+  if (bridge_.isOpen()) bridge_.publishLimits(ToLimits(config_));
+  return true;
+}
+
+ActuatorState ShmController::getActuatorState() const {
+  ActuatorState actuator_state;
+  ipc::ShmChassisState chassis;
+  if (bridge_.isOpen() && bridge_.latestChassis(&chassis)) {
+    actuator_state.current_speed_mps = chassis.speed_mps;
+  }
+  return actuator_state;
+}
+
+}  // namespace control
+}  // namespace remote
+}  // namespace autodev
@@ -0,0 +1,59 @@
+#ifndef SHM_CONTROLLER_H
+#define SHM_CONTROLLER_H
+
+#include <mutex>
+#include <string>
+
+#include "control/controller.h"
+#include "ipc/vehicle_shm_bridge.h"
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace control {
+
+// Hands the commands to an autonomy stack on the same computer through the
+// shared memory bridge (ipc::VehicleShmBridge), which applies them to the
+// actuators. Control commands update the latest-command slot and are queued
+// with the emergency commands, in order; the limits of the ControllerConfig
+// are published in the limits slot.
+class ShmController : public IController {
+ public:
+  explicit ShmController(
+      const std::string& shm_name = ipc::VehicleShmBridge::kDefaultName);
+  ~ShmController() override = default;
+
+  // Opens the bridge and publishes the limits.
+  bool init(const ControllerConfig& config) override;
+  // MUST BE THREAD-SAFE: ACQUIRE producerMutex_
+  void processControlCommand(
+      const autodev::remote::control::ControlCommand& command) override;
+  // MUST BE THREAD-SAFE: ACQUIRE producerMutex_
+  void processEmergencyCommand(
+      const autodev::remote::control::EmergencyCommand& command) override;
+  // MUST BE THREAD-SAFE: ACQUIRE producerMutex_
+  bool updateConfig(const ControllerConfig& config) override;
+  // From the chassis state published by the autonomy stack.
+  ActuatorState getActuatorState() const override;
+
+ private:
+  // How long an emergency command waits for room in a full ring.
+  static constexpr int kEmergencyPushTimeoutUs = 1000;
+
+  const std::string shmName_;
+  // The bridge's slots and ring take one writer at a time, and commands
+  // arrive on several threads (DataChannel, degradation policy).
+  std::mutex producerMutex_;
+  ipc::VehicleShmBridge bridge_;  // Guarded by producerMutex_ for writes
+  ControllerConfig config_;       // Guarded by producerMutex_
+
+  // Prevent copying
+  ShmController(const ShmController&) = delete;
+  ShmController& operator=(const ShmController&) = delete;
+};
+
+}  // namespace control
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // SHM_CONTROLLER_H
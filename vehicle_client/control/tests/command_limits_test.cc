@@ -0,0 +1,105 @@
+// Test of LimitControlCommand: steering clamp, acceleration fading out
+// below max_speed_mps and cut at it, and overspeed braking, e.g., after
+// DegradationLevel::SpeedLimited lowered the limit under the current speed.
+// Runs on a stand-in with the ControlCommand accessors, so neither the
+// generated Protobuf messages nor libprotobuf are needed.
+//
+// Build, then run, from the repository root:
+//   g++ -std=c++17 -O1 -g -I. -Ivehicle_client
+//       -o /tmp/command_limits_test
+//       vehicle_client/control/tests/command_limits_test.cc
+//       vehicle_client/control/command_limits.cc
+//   /tmp/command_limits_test
+
+#include <cmath>
+#include <cstdio>
+
+#include "control/command_limits.h"
+#include "testing/check.h"
+
+namespace {
+
+using autodev::remote::control::ControllerConfig;
+using autodev::remote::control::LimitControlCommand;
+
+// The accessors of ControlCommand that LimitControlCommand uses.
+class ControlCommand {
+ public:
+  double acceleration() const { return acceleration_; }
+  double braking() const { return braking_; }
+  double steering_angle() const { return steering_angle_; }
+  void set_acceleration(double value) { acceleration_ = value; }
+  void set_braking(double value) { braking_ = value; }
+  void set_steering_angle(double value) { steering_angle_ = value; }
+
+ private:
+  double acceleration_ = 0.0;
+  double braking_ = 0.0;
+  double steering_angle_ = 0.0;
+};
+
+bool Near(double a, double b) { return std::fabs(a - b) < 1e-9; }
+
+ControlCommand Limited(const ControllerConfig& config, double speed_mps,
+                       double acceleration, double braking,
+                       double steering_angle) {
+  ControlCommand command;
+  command.set_acceleration(acceleration);
+  command.set_braking(braking);
+  command.set_steering_angle(steering_angle);
+  LimitControlCommand(config, speed_mps, &command);
+  return command;
+}
+
+void TestBelowLimit() {
+  const ControllerConfig config;  // 10 m/s, 0.5 rad, 1 m/s taper
+  ControlCommand command = Limited(config, 5.0, 0.8, 0.0, 0.2);
+  CHECK(Near(command.acceleration(), 0.8));
+  CHECK(Near(command.braking(), 0.0));
+  CHECK(Near(command.steering_angle(), 0.2));
+
+  CHECK(Near(Limited(config, 5.0, 0.8, 0.0, 0.7).steering_angle(), 0.5));
+  CHECK(Near(Limited(config, 5.0, 0.8, 0.0, -0.9).steering_angle(), -0.5));
+}
+
+void TestTaper() {
+  const ControllerConfig config;
+  CHECK(Near(Limited(config, 9.0, 0.8, 0.0, 0.0).acceleration(), 0.8));
+  CHECK(Near(Limited(config, 9.5, 0.8, 0.0, 0.0).acceleration(), 0.4));
+  ControlCommand command = Limited(config, 10.0, 0.8, 0.0, 0.0);
+  CHECK(Near(command.acceleration(), 0.0));
+  CHECK(Near(command.braking(), 0.0));  // At the limit: coast, no braking
+}
+
+void TestOverspeed() {
+  const ControllerConfig config;
+  ControlCommand command = Limited(config, 12.0, 0.8, 0.0, 0.0);
+  CHECK(Near(command.acceleration(), 0.0));
+  CHECK(Near(command.braking(), 0.2));
+  // Capped at max_overspeed_braking; the operator may brake harder.
+  CHECK(Near(Limited(config, 20.0, 0.0, 0.0, 0.0).braking(), 0.3));
+  CHECK(Near(Limited(config, 20.0, 0.0, 0.6, 0.0).braking(), 0.6));
+  // Reversing: the speed is a magnitude.
+  CHECK(Near(Limited(config, -12.0, 0.8, 0.0, 0.0).braking(), 0.2));
+}
+
+void TestLoweredLimit() {
+  // The config VehicleClientApp applies at DegradationLevel::SpeedLimited.
+  ControllerConfig config;
+  config.max_speed_mps = 3.0;
+  ControlCommand command = Limited(config, 8.0, 1.0, 0.0, 0.0);
+  CHECK(Near(command.acceleration(), 0.0));
+  CHECK(Near(command.braking(), 0.3));
+  CHECK(Near(Limited(config, 1.0, 1.0, 0.0, 0.0).acceleration(), 1.0));
+}
+
+}  // namespace
+
+int main() {
+  TestBelowLimit();
+  TestTaper();
+  TestOverspeed();
+  TestLoweredLimit();
+  std::printf("command_limits_test: OK\n");
+  return 0;
+}
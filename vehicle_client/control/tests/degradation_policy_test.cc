@@ -0,0 +1,112 @@
+// Replay test of DegradationPolicy::update: a recorded series of (time,
+// score) samples, one per evaluation as VehicleClientApp makes them, with
+// the level expected after each. Covers escalation after escalate_hold,
+// skipping levels on a collapse, slow recovery one level per recover_hold,
+// a short dip that resets the recovery, the PullOver latch and reset().
+//
+// Build, then run, from the repository root:
+//   g++ -std=c++17 -O1 -g -I. -Ivehicle_client
+//       -o /tmp/degradation_policy_test
+//       vehicle_client/control/tests/degradation_policy_test.cc
+//       vehicle_client/control/degradation_policy.cc
+//   /tmp/degradation_policy_test
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "control/degradation_policy.h"
+#include "testing/check.h"
+
+namespace {
+
+using autodev::remote::vehicle::DegradationLevel;
+using autodev::remote::vehicle::DegradationLevelName;
+using autodev::remote::vehicle::DegradationPolicy;
+using autodev::remote::vehicle::DegradationPolicyConfig;
+using Clock = std::chrono::steady_clock;
+
+// One recorded sample and the decision expected for it.
+struct Sample {
+  double at_s;  // Time since the start of the recording
+  double score;
+  bool changed;  // update() return value
+  DegradationLevel level;  // Expected current() after the sample
+};
+
+constexpr DegradationLevel kNormal = DegradationLevel::Normal;
+constexpr DegradationLevel kReducedVideo = DegradationLevel::ReducedVideo;
+constexpr DegradationLevel kSpeedLimited = DegradationLevel::SpeedLimited;
+constexpr DegradationLevel kPullOver = DegradationLevel::PullOver;
+
+void Replay(DegradationPolicy* policy, const std::vector<Sample>& samples,
+            Clock::time_point start) {
+  for (size_t i = 0; i < samples.size(); ++i) {
+    const Sample& sample = samples[i];
+    const Clock::time_point now =
+        start + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(sample.at_s));
+    DegradationLevel level = policy->current();
+    const bool changed = policy->update(sample.score, now, &level);
+    std::printf("sample %2zu: t=%5.1fs score %.2f -> %s %s\n", i,
+                sample.at_s, sample.score,
+                changed ? "changed  " : "unchanged",
+                DegradationLevelName(policy->current()));
+    CHECK(changed == sample.changed);
+    CHECK(policy->current() == sample.level);
+    if (changed) CHECK(level == policy->current());
+  }
+}
+
+void TestRecordedSeries() {
+  // The defaults: video below 0.7, speed below 0.5, pull over below 0.2;
+  // 1 s to escalate (3 s to pull over), 5 s at +0.1 to recover a level.
+  DegradationPolicy policy{DegradationPolicyConfig()};
+  // Away from the epoch, which the policy uses as "unset".
+  const Clock::time_point start = Clock::time_point() + std::chrono::hours(1);
+
+  Replay(&policy, {
+      {0.0, 0.90, false, kNormal},
+      // Below the video threshold: a level only after escalate_hold.
+      {1.0, 0.65, false, kNormal},
+      {2.0, 0.65, true, kReducedVideo},
+      {3.0, 0.45, false, kReducedVideo},
+      {4.0, 0.45, true, kSpeedLimited},
+      // Back above 0.5 + 0.1: one level up after recover_hold.
+      {5.0, 0.75, false, kSpeedLimited},
+      {9.0, 0.75, false, kSpeedLimited},
+      {10.0, 0.75, true, kReducedVideo},
+      // A dip below 0.7 + 0.1 restarts the hold of the next level.
+      {11.0, 0.55, false, kReducedVideo},
+      {12.0, 0.85, false, kReducedVideo},
+      {16.0, 0.85, false, kReducedVideo},
+      {17.0, 0.85, true, kNormal},
+      // A single bad sample, shorter than escalate_hold, changes nothing.
+      {18.0, 0.40, false, kNormal},
+      {19.0, 0.90, false, kNormal},
+      // Collapse: straight to SpeedLimited, then PullOver after its hold.
+      {20.0, 0.10, false, kNormal},
+      {21.0, 0.10, true, kSpeedLimited},
+      {22.0, 0.10, false, kSpeedLimited},
+      {23.0, 0.10, true, kPullOver},
+      // Latched, however good the link gets.
+      {24.0, 0.95, false, kPullOver},
+      {40.0, 0.95, false, kPullOver},
+  }, start);
+
+  policy.reset();
+  CHECK(policy.current() == kNormal);
+  Replay(&policy, {
+      {41.0, 0.95, false, kNormal},
+      {42.0, 0.60, false, kNormal},
+      {43.0, 0.60, true, kReducedVideo},
+  }, start);
+}
+
+}  // namespace
+
+int main() {
+  TestRecordedSeries();
+  std::printf("degradation_policy_test: OK\n");
+  return 0;
+}
@@ -0,0 +1,155 @@
+// The seqlock path of ChassisStateCache under contention: one writer
+// storing continuously (far above a real chassis rate, the worst case for
+// the readers) and 1, 2 and 4 readers loading continuously, against the same
+// latest-value slot built on a std::mutex. Both hold ipc::ShmChassisState,
+// the plain data the cache keeps; the cache's Chassis conversion on either
+// side is the same for both and left out, so the benchmark needs neither the
+// generated Protobuf messages nor libprotobuf. The seqlock reader retries
+// and yields like ChassisStateCache::load. Per case: ns per load and per
+// store (wall time over operations, all threads together) and the number of
+// torn snapshots. The writer keeps every field a function of one counter,
+// so a snapshot mixing two stores is detected.
+//
+// Build, then run, from the repository root:
+//   g++ -std=c++17 -O2 -I. -o /tmp/chassis_state_cache_benchmark
+//       vehicle_client/sensors/benchmarks/chassis_state_cache_benchmark.cc
+//       -lpthread
+//   /tmp/chassis_state_cache_benchmark
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ipc/seqlock.h"
+#include "ipc/vehicle_shm_bridge.h"
+#include "testing/benchmark.h"
+
+namespace {
+
+using autodev::remote::ipc::SeqlockSlot;
+using autodev::remote::ipc::ShmChassisState;
+using autodev::remote::testing::DoNotOptimize;
+
+constexpr auto kRunTime = std::chrono::milliseconds(1000);
+
+// The slot of ChassisStateCache, loaded as ChassisStateCache::load does.
+class SeqlockChassisCache {
+ public:
+  void publish(const ShmChassisState& state) { slot_.store(state); }
+
+  bool load(ShmChassisState* state) const {
+    while (!slot_.load(state, nullptr, 64)) {
+      if (slot_.version() == 0) return false;
+      std::this_thread::yield();
+    }
+    return true;
+  }
+
+ private:
+  SeqlockSlot<ShmChassisState> slot_;
+};
+
+// The lock-based alternative: the latest state behind a mutex.
+class MutexChassisCache {
+ public:
+  void publish(const ShmChassisState& state) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    state_ = state;
+  }
+
+  bool load(ShmChassisState* state) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    *state = state_;
+    return true;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  ShmChassisState state_;  // Guarded by mutex_
+};
+
+ShmChassisState StateFor(uint64_t counter) {
+  ShmChassisState state;
+  const double value = static_cast<double>(counter);
+  state.timestamp_ns = static_cast<int64_t>(counter);
+  state.speed_mps = value;
+  state.throttle_percentage = value + 1.0;
+  state.brake_percentage = value + 2.0;
+  state.steering_percentage = value + 3.0;
+  state.gear = static_cast<int32_t>(counter % 4);
+  return state;
+}
+
+bool Consistent(const ShmChassisState& state) {
+  const double value = state.speed_mps;
+  return state.timestamp_ns == static_cast<int64_t>(value) &&
+         state.throttle_percentage == value + 1.0 &&
+         state.brake_percentage == value + 2.0 &&
+         state.steering_percentage == value + 3.0 &&
+         state.gear == static_cast<int32_t>(static_cast<uint64_t>(value) % 4);
+}
+
+template <typename Cache>
+void RunCase(const char* name, int readers) {
+  Cache cache;
+  cache.publish(StateFor(0));
+  std::atomic<bool> running{true};
+  std::atomic<uint64_t> loads{0};
+  std::atomic<uint64_t> torn{0};
+  uint64_t publishes = 0;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < readers; ++i) {
+    threads.emplace_back([&] {
+      ShmChassisState state;
+      uint64_t local_loads = 0;
+      uint64_t local_torn = 0;
+      while (running.load(std::memory_order_relaxed)) {
+        cache.load(&state);
+        if (!Consistent(state)) ++local_torn;
+        DoNotOptimize(state);
+        ++local_loads;
+      }
+      loads.fetch_add(local_loads);
+      torn.fetch_add(local_torn);
+    });
+  }
+  std::thread writer([&] {
+    while (running.load(std::memory_order_relaxed)) {
+      cache.publish(StateFor(++publishes));
+    }
+  });
+
+  const auto start = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(kRunTime);
+  running.store(false);
+  writer.join();
+  for (std::thread& thread : threads) thread.join();
+  const double elapsed_ns = std::chrono::duration<double, std::nano>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+
+  std::printf("%-24s %d reader(s): %8.1f ns/load %8.1f ns/store "
+              "torn %llu of %llu\n",
+              name, readers, elapsed_ns / static_cast<double>(loads.load()),
+              elapsed_ns / static_cast<double>(publishes),
+              static_cast<unsigned long long>(torn.load()),
+              static_cast<unsigned long long>(loads.load()));
+}
+
+}  // namespace
+
+int main() {
+  std::printf("%u CPU(s), %lld ms per case\n",
+              std::thread::hardware_concurrency(),
+              static_cast<long long>(kRunTime.count()));
+  for (int readers : {1, 2, 4}) {
+    RunCase<SeqlockChassisCache>("seqlock", readers);
+    RunCase<MutexChassisCache>("mutex", readers);
+  }
+  return 0;
+}
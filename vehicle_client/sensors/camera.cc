@@ -1,8 +1,11 @@
 #include <atomic>
+#include <chrono>
 #include <iostream>
+#include <mutex>
 #include <thread>
 
 #include "include/sensors/camera_source.h"
+#include "metrics/static_metrics.h"
 
 // Include V4L2 headers or other camera API headers
 // #include <linux/videodev2.h>
@@ -31,9 +34,12 @@ class V4L2CameraSource : public ICameraSource {
     std::cout << "V4L2CameraSource: Initializing device " << device_path << " ("
               << width << "x" << height << "@" << fps << "fps)" << std::endl;
     devicePath_ = device_path;
-    width_ = width;
-    height_ = height;
-    fps_ = fps;
+    {
+      std::lock_guard<std::mutex> lock(formatMutex_);
+      width_ = width;
+      height_ = height;
+      fps_ = fps;
+    }
 
     // TODO: Implement V4L2 device opening, format negotiation, buffer setup
     // int fd = open(device_path.c_str(), O_RDWR | O_NONBLOCK, 0);
@@ -77,15 +83,46 @@ class V4L2CameraSource : public ICameraSource {
     // TODO: Clean up V4L2 resources (close device, unmap buffers)
   }
 
-  uint32_t getWidth() const override { return width_; }
-  uint32_t getHeight() const override { return height_; }
-  uint32_t getFps() const override { return fps_; }
+  bool setCaptureFormat(uint32_t width, uint32_t height,
+                        uint32_t fps) override {
+    if (width == 0 || height == 0 || fps == 0) {
+      std::cerr << "V4L2CameraSource: Invalid capture format " << width << "x"
+                << height << "@" << fps << "fps." << std::endl;
+      return false;
+    }
+    // Only recorded here; the capture loop picks it up before its next
+    // frame. The skeleton has no device to renegotiate, so it just resizes
+    // the simulated frame and its interval.
+    std::lock_guard<std::mutex> lock(formatMutex_);
+    width_ = width;
+    height_ = height;
+    fps_ = fps;
+    std::cout << "V4L2CameraSource: Capture format set to " << width << "x"
+              << height << "@" << fps << "fps." << std::endl;
+    return true;
+  }
+
+  uint32_t getWidth() const override {
+    std::lock_guard<std::mutex> lock(formatMutex_);
+    return width_;
+  }
+  uint32_t getHeight() const override {
+    std::lock_guard<std::mutex> lock(formatMutex_);
+    return height_;
+  }
+  uint32_t getFps() const override {
+    std::lock_guard<std::mutex> lock(formatMutex_);
+    return fps_;
+  }
 
  private:
   std::string devicePath_;
-  uint32_t width_ = 0;
-  uint32_t height_ = 0;
-  uint32_t fps_ = 0;
+  // Capture format; written by init()/setCaptureFormat(), read by the
+  // capture loop once per frame.
+  mutable std::mutex formatMutex_;
+  uint32_t width_ = 0;   // Guarded by formatMutex_
+  uint32_t height_ = 0;  // Guarded by formatMutex_
+  uint32_t fps_ = 0;     // Guarded by formatMutex_
   std::atomic<bool> isCapturing_ = false;
   std::thread captureThread_;
   OnFrameCapturedHandler onFrameCapturedHandler_;
@@ -99,11 +136,28 @@ class V4L2CameraSource : public ICameraSource {
               << std::endl;
     // TODO: Implement frame capturing loop using V4L2
     // For skeleton, just simulate capturing frames
-    size_t dummy_frame_size = width_ * height_ * 3 / 2;  // Example for I420
-    std::vector<uint8_t> dummy_frame_data(dummy_frame_size, 0);  // Dummy data
-    std::chrono::milliseconds frame_interval(1000 / fps_);
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t fps = 0;
+    size_t dummy_frame_size = 0;
+    std::vector<uint8_t> dummy_frame_data;  // Dummy data
+    std::chrono::milliseconds frame_interval(0);
+    std::chrono::steady_clock::time_point last_frame;
 
     while (isCapturing_) {
+      // Pick up a format change (setCaptureFormat) between frames.
+      {
+        std::lock_guard<std::mutex> lock(formatMutex_);
+        if (width_ != width || height_ != height || fps_ != fps) {
+          width = width_;
+          height = height_;
+          fps = fps_;
+          dummy_frame_size = width * height * 3 / 2;  // Example for I420
+          dummy_frame_data.assign(dummy_frame_size, 0);
+          frame_interval = std::chrono::milliseconds(1000 / fps);
+        }
+      }
+
       // TODO: Dequeue buffer, process frame, enqueue buffer
       // ioctl(deviceFd_, VIDIOC_DQBUF, &buf);
       // Process data in mapped buffer buffers_[buf.index].start;
@@ -118,11 +172,26 @@ class V4L2CameraSource : public ICameraSource {
       //     .set_rotation(webrtc::kVideoRotation_0)
       //     .build();
 
+      const auto frame_time = std::chrono::steady_clock::now();
+      if (last_frame.time_since_epoch().count() != 0) {
+        autodev::remote::metrics::RecordMicrosSince(
+            autodev::remote::metrics::HistogramId::
+                camera_frame_interval_seconds,
+            last_frame);
+      }
+      last_frame = frame_time;
+      autodev::remote::metrics::Increment(
+          autodev::remote::metrics::CounterId::camera_frames_captured_total);
+
       // Call the handler with frame data
       if (onFrameCapturedHandler_) {
         // Pass raw data for skeleton
         onFrameCapturedHandler_(dummy_frame_data.data(), dummy_frame_size,
-                                width_, height_);
+                                width, height);
+        autodev::remote::metrics::RecordMicrosSince(
+            autodev::remote::metrics::HistogramId::
+                camera_frame_handler_duration_seconds,
+            frame_time);
       }
 
       // TODO: Enqueue buffer
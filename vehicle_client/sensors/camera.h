@@ -71,6 +71,13 @@ class ICameraSource {
   // This must be called AFTER init() and BEFORE startCapture().
   virtual void setOnFrameCapturedHandler(OnFrameCapturedHandler handler) = 0;
 
+  // Changes the capture format while capturing (e.g., to follow the
+  // available bandwidth). Takes effect from the next frame; frames already
+  // delivered keep their size. Returns false if the device cannot deliver
+  // the format. MUST BE THREAD-SAFE.
+  virtual bool setCaptureFormat(uint32_t width, uint32_t height,
+                                uint32_t fps) = 0;
+
   // Gets camera parameters (Optional, might be available after init)
   virtual uint32_t getWidth() const = 0;
   virtual uint32_t getHeight() const = 0;
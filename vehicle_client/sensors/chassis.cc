@@ -4,6 +4,8 @@
 #include <thread>
 
 #include "include/sensors/chassis_source.h"
+#include "metrics/static_metrics.h"
+#include "sensors/chassis_state_cache.h"
 
 // Include CAN bus headers (e.g., SocketCAN)
 // #include <linux/can.h>
@@ -72,10 +74,16 @@ class CanBusChassisSource : public IChassisSource {
     // TODO: Clean up SocketCAN resources (close socket)
   }
 
+  autodev::remote::chassis::Chassis getCurrentState() const override {
+    return stateCache_.get();
+  }
+
  private:
   std::atomic<bool> isUpdating_ = false;
   std::thread updateThread_;
   OnChassisStateUpdatedHandler onChassisStateUpdatedHandler_;
+  // Written by the update thread only; read by getCurrentState()
+  autodev::remote::sensors::ChassisStateCache stateCache_;
   // TODO: SocketCAN file descriptor, interface name
   // int s_ = -1;
   // std::string device_;
@@ -100,6 +108,7 @@ class CanBusChassisSource : public IChassisSource {
 
     double speed = 0.0;
     int gear = 0;
+    std::chrono::steady_clock::time_point last_update;
 
     while (isUpdating_) {
       // Simulate data change
@@ -110,9 +119,25 @@ class CanBusChassisSource : public IChassisSource {
       dummy_state.set_speed_mps(speed);
       dummy_state.set_gear(gear);
 
+      const auto update_time = std::chrono::steady_clock::now();
+      if (last_update.time_since_epoch().count() != 0) {
+        autodev::remote::metrics::RecordMicrosSince(
+            autodev::remote::metrics::HistogramId::
+                chassis_update_interval_seconds,
+            last_update);
+      }
+      last_update = update_time;
+      autodev::remote::metrics::Increment(
+          autodev::remote::metrics::CounterId::chassis_updates_total);
+      stateCache_.publish(dummy_state);
+
       // Call the handler with the updated state
       if (onChassisStateUpdatedHandler_) {
         onChassisStateUpdatedHandler_(dummy_state);
+        autodev::remote::metrics::RecordMicrosSince(
+            autodev::remote::metrics::HistogramId::
+                chassis_handler_duration_seconds,
+            update_time);
       }
 
       // Simulate update interval
@@ -0,0 +1,70 @@
+#include "sensors/chassis_state_cache.h"
+
+#include <chrono>
+#include <thread>
+
+namespace autodev {
+namespace remote {
+namespace sensors {
+
+namespace {
+
+// Copy attempts before a reader yields: a publish is a few stores, so only
+// a preempted writer makes a reader fail that many times.
+constexpr int kLoadAttemptsBeforeYield = 64;
+
+}  // namespace
+
+void ChassisStateCache::publish(
+    const autodev::remote::chassis::Chassis& state) {
+  ipc::ShmChassisState snapshot = ToSnapshot(state);
+  snapshot.timestamp_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count();
+  slot_.store(snapshot);
+}
+
+bool ChassisStateCache::load(autodev::remote::chassis::Chassis* state,
+                             int64_t* timestamp_ns) const {
+  ipc::ShmChassisState snapshot;
+  while (!slot_.load(&snapshot, nullptr, kLoadAttemptsBeforeYield)) {
+    if (slot_.version() == 0) return false;
+    std::this_thread::yield();
+  }
+  *state = FromSnapshot(snapshot);
+  if (timestamp_ns) *timestamp_ns = snapshot.timestamp_ns;
+  return true;
+}
+
+autodev::remote::chassis::Chassis ChassisStateCache::get() const {
+  autodev::remote::chassis::Chassis state;
+  load(&state);
+  return state;
+}
+
+ipc::ShmChassisState ChassisStateCache::ToSnapshot(
+    const autodev::remote::chassis::Chassis& state) {
+  ipc::ShmChassisState snapshot;
+  snapshot.speed_mps = state.speed_mps();
+  snapshot.throttle_percentage = state.throttle_percentage();
+  snapshot.brake_percentage = state.brake_percentage();
+  snapshot.steering_percentage = state.steering_percentage();
+  snapshot.gear = static_cast<int32_t>(state.gear());
+  return snapshot;
+}
+
+autodev::remote::chassis::Chassis ChassisStateCache::FromSnapshot(
+    const ipc::ShmChassisState& snapshot) {
+  autodev::remote::chassis::Chassis state;
+  state.set_speed_mps(snapshot.speed_mps);
+  state.set_gear(snapshot.gear);
+  state.set_throttle_percentage(snapshot.throttle_percentage);
+  state.set_brake_percentage(snapshot.brake_percentage);
+  state.set_steering_percentage(snapshot.steering_percentage);
+  return state;
+}
+
+}  // namespace sensors
+}  // namespace remote
+}  // namespace autodev
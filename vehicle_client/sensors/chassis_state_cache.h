@@ -0,0 +1,59 @@
+#ifndef CHASSIS_STATE_CACHE_H
+#define CHASSIS_STATE_CACHE_H
+
+#include <cstdint>
+
+#include "ipc/seqlock.h"
+#include "ipc/vehicle_shm_bridge.h"
+#include "proto/chassis.pb.h"
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace sensors {
+
+// Latest chassis state of a chassis source, for getCurrentState().
+//
+// The update thread publishes without locking and never waits for readers;
+// any number of readers (telemetry, watchdogs, health monitoring) get a
+// consistent snapshot without locking. The state is kept as plain data
+// (ipc::ShmChassisState, the layout also used in shared memory) in a
+// seqlock, since a protobuf message cannot be copied atomically.
+class ChassisStateCache {
+ public:
+  ChassisStateCache() = default;
+
+  // Single writer only (the source's update thread). Stamps the state with
+  // the steady clock.
+  void publish(const autodev::remote::chassis::Chassis& state);
+
+  // MUST BE THREAD-SAFE: Copies the latest state to *state and, if given,
+  // its publish time (steady clock nanoseconds) to *timestamp_ns. Retries
+  // while a publish overlaps. Returns false if nothing was published yet.
+  bool load(autodev::remote::chassis::Chassis* state,
+            int64_t* timestamp_ns = nullptr) const;
+
+  // MUST BE THREAD-SAFE: The latest state, or a default message.
+  autodev::remote::chassis::Chassis get() const;
+
+  // Number of publishes so far; a cheap check for a new state.
+  uint64_t version() const { return slot_.version(); }
+
+  static ipc::ShmChassisState ToSnapshot(
+      const autodev::remote::chassis::Chassis& state);
+  static autodev::remote::chassis::Chassis FromSnapshot(
+      const ipc::ShmChassisState& snapshot);
+
+ private:
+  ipc::SeqlockSlot<ipc::ShmChassisState> slot_;
+
+  // Prevent copying
+  ChassisStateCache(const ChassisStateCache&) = delete;
+  ChassisStateCache& operator=(const ChassisStateCache&) = delete;
+};
+
+}  // namespace sensors
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // CHASSIS_STATE_CACHE_H
@@ -0,0 +1,123 @@
+#include "sensors/shm_chassis_source.h"
+
+#include <iostream>
+
+#include "metrics/static_metrics.h"
+#include "sensors/chassis_state_cache.h"
+
+namespace autodev {
+namespace remote {
+namespace sensors {
+
+ShmChassisSource::ShmChassisSource(const std::string& shm_name,
+                                   std::chrono::microseconds poll_interval)
+    : shmName_(shm_name), pollInterval_(poll_interval) {}
+
+ShmChassisSource::~ShmChassisSource() { stopUpdates(); }
+
+bool ShmChassisSource::init(const std::string& /*can_interface*/) {
+  if (isUpdating_) {
+    std::cerr << "ShmChassisSource: Cannot init while updating." << std::endl;
+    return false;
+  }
+  if (!bridge_.open(shmName_)) {
+    std::cerr << "ShmChassisSource: Failed to open " << shmName_ << "."
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool ShmChassisSource::startUpdates(OnChassisStateUpdatedHandler handler) {
+  if (!handler) {
+    std::cerr << "ShmChassisSource: Cannot start updates, no handler set."
+              << std::endl;
+    return false;
+  }
+  if (!bridge_.isOpen()) {
+    std::cerr << "ShmChassisSource: Cannot start updates, not initialized."
+              << std::endl;
+    return false;
+  }
+  if (isUpdating_) {
+    std::cout << "ShmChassisSource: Updates already started." << std::endl;
+    return true;
+  }
+  onChassisStateUpdatedHandler_ = std::move(handler);
+  isUpdating_ = true;
+  updateThread_ = std::thread(&ShmChassisSource::updateLoop, this);
+  return true;
+}
+
+void ShmChassisSource::stopUpdates() {
+  if (!isUpdating_) return;
+  isUpdating_ = false;
+  if (updateThread_.joinable()) {
+    updateThread_.join();
+  }
+}
+
+autodev::remote::chassis::Chassis ShmChassisSource::getCurrentState() const {
+  ipc::ShmChassisState state;
+  if (!bridge_.isOpen() || !bridge_.latestChassis(&state)) {
+    return autodev::remote::chassis::Chassis();
+  }
+  return ChassisStateCache::FromSnapshot(state);
+}
+
+void ShmChassisSource::updateLoop() {
+  std::cout << "ShmChassisSource: Update loop started (" << shmName_ << ")."
+            << std::endl;
+  uint64_t delivered_version = 0;
+  std::chrono::steady_clock::time_point last_update;
+
+  while (isUpdating_) {
+    // One load of the sequence counter when nothing changed.
+    if (bridge_.chassisVersion() == delivered_version) {
+      if (pollInterval_.count() > 0) {
+        std::this_thread::sleep_for(pollInterval_);
+      } else {
+        std::this_thread::yield();
+      }
+      continue;
+    }
+
+    ipc::ShmChassisState state;
+    uint64_t version = 0;
+    if (!bridge_.latestChassis(&state, &version)) continue;
+    delivered_version = version;
+
+    const auto update_time = std::chrono::steady_clock::now();
+    const int64_t handoff_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            update_time.time_since_epoch())
+            .count() -
+        state.timestamp_ns;
+    if (state.timestamp_ns > 0 && handoff_ns >= 0) {
+      autodev::remote::metrics::Record(
+          autodev::remote::metrics::HistogramId::
+              chassis_shm_handoff_latency_seconds,
+          static_cast<uint64_t>(handoff_ns));
+    }
+    if (last_update.time_since_epoch().count() != 0) {
+      autodev::remote::metrics::RecordMicrosSince(
+          autodev::remote::metrics::HistogramId::
+              chassis_update_interval_seconds,
+          last_update);
+    }
+    last_update = update_time;
+    autodev::remote::metrics::Increment(
+        autodev::remote::metrics::CounterId::chassis_updates_total);
+
+    onChassisStateUpdatedHandler_(ChassisStateCache::FromSnapshot(state));
+    autodev::remote::metrics::RecordMicrosSince(
+        autodev::remote::metrics::HistogramId::
+            chassis_handler_duration_seconds,
+        update_time);
+  }
+  std::cout << "ShmChassisSource: Update loop stopped." << std::endl;
+}
+
+}  // namespace sensors
+}  // namespace remote
+}  // namespace autodev
@@ -0,0 +1,58 @@
+#ifndef SHM_CHASSIS_SOURCE_H
+#define SHM_CHASSIS_SOURCE_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "ipc/vehicle_shm_bridge.h"
+#include "sensors/chassis.h"
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace sensors {
+
+// Chassis state published by an autonomy stack on the same computer through
+// the shared memory bridge (ipc::VehicleShmBridge), instead of read from the
+// CAN bus. The update thread polls the bridge's chassis slot and delivers
+// every new state once.
+class ShmChassisSource : public IChassisSource {
+ public:
+  // poll_interval: pause between checks of the slot. Zero spins (yielding),
+  // for the lowest latency at the cost of one busy core.
+  explicit ShmChassisSource(
+      const std::string& shm_name = ipc::VehicleShmBridge::kDefaultName,
+      std::chrono::microseconds poll_interval =
+          std::chrono::microseconds(200));
+  ~ShmChassisSource() override;
+
+  // Opens the bridge; the argument (the CAN interface) is not used.
+  bool init(const std::string& can_interface) override;
+  bool startUpdates(OnChassisStateUpdatedHandler handler) override;
+  void stopUpdates() override;
+  // MUST BE THREAD-SAFE: reads the slot without locking.
+  autodev::remote::chassis::Chassis getCurrentState() const override;
+
+ private:
+  void updateLoop();
+
+  const std::string shmName_;
+  const std::chrono::microseconds pollInterval_;
+  ipc::VehicleShmBridge bridge_;  // Opened by init(), read only
+
+  std::atomic<bool> isUpdating_{false};
+  std::thread updateThread_;
+  OnChassisStateUpdatedHandler onChassisStateUpdatedHandler_;
+
+  // Prevent copying
+  ShmChassisSource(const ShmChassisSource&) = delete;
+  ShmChassisSource& operator=(const ShmChassisSource&) = delete;
+};
+
+}  // namespace sensors
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // SHM_CHASSIS_SOURCE_H
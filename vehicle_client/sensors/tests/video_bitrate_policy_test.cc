@@ -0,0 +1,147 @@
+// Deterministic test of VideoBitratePolicy::update: a scripted sequence of
+// (estimate, time) inputs on a three-rung ladder, checking each decision:
+// the encoder target following the budget within a rung, immediate (and
+// multi-rung) step-down, the floor on a collapsed estimate, and step-up
+// one rung at a time only after upgrade_hold of sustained margin.
+//
+// Build, then run, from the repository root:
+//   g++ -std=c++17 -O1 -g -I. -Ivehicle_client
+//       -o /tmp/video_bitrate_policy_test
+//       vehicle_client/sensors/tests/video_bitrate_policy_test.cc
+//       vehicle_client/sensors/video_bitrate_policy.cc
+//   /tmp/video_bitrate_policy_test
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "sensors/video_bitrate_policy.h"
+#include "testing/check.h"
+
+namespace {
+
+using autodev::remote::sensors::VideoBitratePolicy;
+using autodev::remote::sensors::VideoBitratePolicyConfig;
+using autodev::remote::sensors::VideoRung;
+using autodev::remote::sensors::VideoTarget;
+using Clock = std::chrono::steady_clock;
+
+const VideoRung kLow = {320, 180, 15, 200000};
+const VideoRung kMid = {640, 360, 30, 1000000};
+const VideoRung kHigh = {1280, 720, 30, 3000000};
+
+// One scripted input and the decision expected for it.
+struct Step {
+  double at_s;          // Time since the start of the script
+  double available_bps;
+  bool changed;  // update() return value
+  // Expected current() after the step.
+  const VideoRung* rung;
+  uint32_t encoder_bitrate_bps;
+};
+
+// Budget = (estimate - 500 kbps reserve) * 0.5; so the estimate for a
+// budget B is 2 * B + 500000.
+constexpr double Estimate(double budget_bps) {
+  return 2.0 * budget_bps + 500000.0;
+}
+
+void RunScript(VideoBitratePolicy* policy, const std::vector<Step>& script) {
+  // Away from the epoch, which the policy uses as "unset".
+  const Clock::time_point start = Clock::time_point() + std::chrono::hours(1);
+  for (size_t i = 0; i < script.size(); ++i) {
+    const Step& step = script[i];
+    const Clock::time_point now =
+        start + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(step.at_s));
+    VideoTarget target;
+    const bool changed = policy->update(step.available_bps, now, &target);
+    const VideoTarget& current = policy->current();
+    std::printf("step %2zu: t=%5.1fs estimate %8.0f -> %s %ux%u@%u "
+                "%u bps\n",
+                i, step.at_s, step.available_bps,
+                changed ? "changed  " : "unchanged", current.rung.width,
+                current.rung.height, current.rung.fps,
+                current.encoder_bitrate_bps);
+    CHECK(changed == step.changed);
+    CHECK(current.rung.bitrate_bps == step.rung->bitrate_bps);
+    CHECK(current.rung.width == step.rung->width);
+    CHECK(current.encoder_bitrate_bps == step.encoder_bitrate_bps);
+    if (changed) {
+      CHECK(target.rung.bitrate_bps == current.rung.bitrate_bps);
+      CHECK(target.encoder_bitrate_bps == current.encoder_bitrate_bps);
+    }
+  }
+}
+
+void TestStepDownAndUp() {
+  VideoBitratePolicyConfig config;
+  config.ladder = {kHigh, kLow, kMid};  // Sorted by the policy
+  config.reserved_data_bps = 500000;
+  config.video_share = 0.5;
+  config.downgrade_threshold = 0.75;
+  config.upgrade_margin = 1.2;
+  config.upgrade_hold = std::chrono::seconds(5);
+  config.min_target_change = 0.1;
+  VideoBitratePolicy policy(config);
+
+  // The configured (top) format until the first estimate.
+  CHECK(policy.current().rung.bitrate_bps == kHigh.bitrate_bps);
+  CHECK(policy.current().encoder_bitrate_bps == kHigh.bitrate_bps);
+
+  RunScript(&policy, {
+      // Budget matches the top rung: nothing to do.
+      {0.0, Estimate(3000000), false, &kHigh, 3000000},
+      // Within the rung (>= 0.75 of it) only the encoder target follows.
+      {1.0, Estimate(2500000), true, &kHigh, 2500000},
+      // A change under min_target_change (6%) is not applied.
+      {2.0, Estimate(2350000), false, &kHigh, 2500000},
+      // Below 0.75 of the rung: down at once, to the best rung kept.
+      {3.0, Estimate(1000000), true, &kMid, 1000000},
+      // Collapse: two rungs down in one update; the target is held at the
+      // floor (0.75 of the lowest rung).
+      {4.0, Estimate(50000), true, &kLow, 150000},
+      // Recovering, but short of the next rung's margin (1.2 * 1 Mbps).
+      {10.0, Estimate(500000), true, &kLow, 200000},
+      // Enough for every rung: the hold starts...
+      {11.0, Estimate(4000000), false, &kLow, 200000},
+      {15.9, Estimate(4000000), false, &kLow, 200000},
+      // ...and after upgrade_hold the policy goes up one rung only.
+      {16.0, Estimate(4000000), true, &kMid, 1000000},
+      // The next rung needs its own hold, from the step up.
+      {17.0, Estimate(4000000), false, &kMid, 1000000},
+      // A dip below the margin (but within the rung) restarts the hold.
+      {19.0, Estimate(1500000), false, &kMid, 1000000},
+      {20.0, Estimate(4000000), false, &kMid, 1000000},
+      {24.9, Estimate(4000000), false, &kMid, 1000000},
+      {25.0, Estimate(4000000), true, &kHigh, 3000000},
+      // At the top the target stays capped at the rung's bitrate.
+      {26.0, Estimate(9000000), false, &kHigh, 3000000},
+  });
+}
+
+void TestDefaultLadder() {
+  const std::vector<VideoRung> ladder =
+      VideoBitratePolicy::DefaultLadder(1280, 720, 30);
+  CHECK(ladder.size() == 5);
+  for (size_t i = 1; i < ladder.size(); ++i) {
+    CHECK(ladder[i].bitrate_bps > ladder[i - 1].bitrate_bps);
+  }
+  for (const VideoRung& rung : ladder) {
+    CHECK(rung.width % 2 == 0 && rung.height % 2 == 0);
+  }
+  CHECK(ladder.back().width == 1280 && ladder.back().height == 720 &&
+        ladder.back().fps == 30);
+  CHECK(ladder.front().width == 320 && ladder.front().fps == 15);
+}
+
+}  // namespace
+
+int main() {
+  TestStepDownAndUp();
+  TestDefaultLadder();
+  std::printf("video_bitrate_policy_test: OK\n");
+  return 0;
+}
@@ -0,0 +1,125 @@
+#include "sensors/video_bitrate_policy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+namespace autodev {
+namespace remote {
+namespace sensors {
+
+namespace {
+
+constexpr double kBitsPerPixel = 0.1;
+constexpr uint32_t kMinRungBitrateBps = 100000;
+
+// Scales a dimension by num/den, rounded down to an even value (4:2:0).
+uint32_t ScaleEven(uint32_t value, uint32_t num, uint32_t den) {
+  return std::max<uint32_t>(2, (value * num / den) & ~1u);
+}
+
+VideoRung MakeRung(uint32_t width, uint32_t height, uint32_t fps) {
+  VideoRung rung;
+  rung.width = width;
+  rung.height = height;
+  rung.fps = std::max<uint32_t>(1, fps);
+  rung.bitrate_bps = std::max<uint32_t>(
+      kMinRungBitrateBps,
+      static_cast<uint32_t>(static_cast<double>(width) * height * rung.fps *
+                            kBitsPerPixel));
+  return rung;
+}
+
+}  // namespace
+
+VideoBitratePolicy::VideoBitratePolicy(VideoBitratePolicyConfig config)
+    : config_(std::move(config)) {
+  std::sort(config_.ladder.begin(), config_.ladder.end(),
+            [](const VideoRung& a, const VideoRung& b) {
+              return a.bitrate_bps < b.bitrate_bps;
+            });
+  if (config_.ladder.empty()) {
+    std::cerr << "VideoBitratePolicy: Empty ladder; video targets will not "
+                 "change."
+              << std::endl;
+    return;
+  }
+  // Until the first estimate arrives the camera runs its configured format.
+  rungIndex_ = config_.ladder.size() - 1;
+  current_.rung = config_.ladder[rungIndex_];
+  current_.encoder_bitrate_bps = current_.rung.bitrate_bps;
+}
+
+std::vector<VideoRung> VideoBitratePolicy::DefaultLadder(uint32_t width,
+                                                         uint32_t height,
+                                                         uint32_t fps) {
+  const uint32_t half_fps = std::max<uint32_t>(1, fps / 2);
+  return {
+      MakeRung(ScaleEven(width, 1, 4), ScaleEven(height, 1, 4), half_fps),
+      MakeRung(ScaleEven(width, 1, 2), ScaleEven(height, 1, 2), half_fps),
+      MakeRung(ScaleEven(width, 1, 2), ScaleEven(height, 1, 2), fps),
+      MakeRung(ScaleEven(width, 3, 4), ScaleEven(height, 3, 4), fps),
+      MakeRung(width, height, fps),
+  };
+}
+
+double VideoBitratePolicy::videoBudget(double available_bps) const {
+  return std::max(0.0, available_bps - config_.reserved_data_bps) *
+         config_.video_share;
+}
+
+bool VideoBitratePolicy::update(double available_bps,
+                                std::chrono::steady_clock::time_point now,
+                                VideoTarget* target) {
+  if (config_.ladder.empty()) return false;
+  const double budget = videoBudget(available_bps);
+
+  // Down: right away, to the best rung the budget keeps.
+  size_t index = rungIndex_;
+  while (index > 0 && budget < config_.ladder[index].bitrate_bps *
+                                   config_.downgrade_threshold) {
+    --index;
+  }
+
+  // Up: one rung, once the budget covered it (with margin) for long enough.
+  if (index == rungIndex_ && index + 1 < config_.ladder.size() &&
+      budget >=
+          config_.ladder[index + 1].bitrate_bps * config_.upgrade_margin) {
+    if (upgradeSince_.time_since_epoch().count() == 0) {
+      upgradeSince_ = now;
+    } else if (now - upgradeSince_ >= config_.upgrade_hold) {
+      ++index;
+      upgradeSince_ = {};
+    }
+  } else {
+    upgradeSince_ = {};
+  }
+
+  VideoTarget next;
+  next.rung = config_.ladder[index];
+  // The lowest rung keeps a floor so the stream stays decodable on a
+  // collapsed estimate.
+  const double floor_bps =
+      config_.ladder[0].bitrate_bps * config_.downgrade_threshold;
+  next.encoder_bitrate_bps = static_cast<uint32_t>(std::clamp<double>(
+      budget, floor_bps, static_cast<double>(next.rung.bitrate_bps)));
+
+  const bool rung_changed = index != rungIndex_;
+  const double target_change =
+      std::fabs(static_cast<double>(next.encoder_bitrate_bps) -
+                current_.encoder_bitrate_bps) /
+      std::max<double>(1.0, current_.encoder_bitrate_bps);
+  if (!rung_changed && target_change < config_.min_target_change) {
+    return false;
+  }
+
+  rungIndex_ = index;
+  current_ = next;
+  if (target) *target = current_;
+  return true;
+}
+
+}  // namespace sensors
+}  // namespace remote
+}  // namespace autodev
@@ -0,0 +1,101 @@
+#ifndef VIDEO_BITRATE_POLICY_H
+#define VIDEO_BITRATE_POLICY_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace sensors {
+
+// One capture/encode operating point of the camera stream.
+struct VideoRung {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t fps = 0;
+  // Encoder bitrate this rung needs to look right (and the encoder target
+  // cap while it is in use).
+  uint32_t bitrate_bps = 0;
+};
+
+struct VideoBitratePolicyConfig {
+  // Operating points, ordered from lowest to highest bitrate. The lowest one
+  // is used whatever the budget.
+  std::vector<VideoRung> ladder;
+
+  // Bandwidth kept free for the control and telemetry DataChannels; video
+  // only gets what is left of the estimate.
+  uint32_t reserved_data_bps = 500000;
+  // Share of the remaining estimate the encoder may target, leaving room
+  // for estimate noise, RTP overhead and retransmissions.
+  double video_share = 0.85;
+
+  // A rung is kept while the budget is at least downgrade_threshold times
+  // its bitrate (the encoder target then follows the budget); below, the
+  // step down is immediate. Stepping up requires a budget upgrade_margin
+  // times the next rung's bitrate, held for upgrade_hold.
+  double downgrade_threshold = 0.75;
+  double upgrade_margin = 1.15;
+  std::chrono::milliseconds upgrade_hold{5000};
+
+  // Encoder target changes smaller than this (relative) are not applied.
+  double min_target_change = 0.1;
+};
+
+// What the camera should capture and the encoder target.
+struct VideoTarget {
+  VideoRung rung;
+  uint32_t encoder_bitrate_bps = 0;
+};
+
+// Maps the send bandwidth estimate to a camera format and encoder target,
+// keeping config.reserved_data_bps free for the DataChannels.
+//
+// Within a rung the encoder target follows the budget (capped at the rung's
+// bitrate), which absorbs most estimate changes without touching the
+// camera. When the budget falls well below the rung, quality drops right
+// away (video must not starve control); it only rises one rung at a time
+// after the higher budget held for upgrade_hold, so a noisy estimate does
+// not make the camera flap between formats.
+//
+// Not thread-safe; the owner serializes calls.
+class VideoBitratePolicy {
+ public:
+  explicit VideoBitratePolicy(VideoBitratePolicyConfig config);
+
+  // Ladder for a camera whose native format is width x height @ fps:
+  // quarter, half and three-quarter resolution and the full format, the
+  // lower rungs also at reduced frame rates. Bitrates assume about 0.1
+  // bits per pixel (H.264/VP8 realtime).
+  static std::vector<VideoRung> DefaultLadder(uint32_t width, uint32_t height,
+                                              uint32_t fps);
+
+  // Feeds a new estimate (bits per second). Returns true and sets *target
+  // when the camera format or encoder target should change.
+  bool update(double available_bps, std::chrono::steady_clock::time_point now,
+              VideoTarget* target);
+
+  // Target currently in effect (the top rung until the first update).
+  const VideoTarget& current() const { return current_; }
+
+  // Video budget (bps) for an estimate: what is left after the reserve,
+  // times video_share.
+  double videoBudget(double available_bps) const;
+
+ private:
+  VideoBitratePolicyConfig config_;
+  size_t rungIndex_ = 0;
+  VideoTarget current_;
+
+  // Start of the period the budget has covered the next rung up; unset
+  // (epoch) when it does not.
+  std::chrono::steady_clock::time_point upgradeSince_;
+};
+
+}  // namespace sensors
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // VIDEO_BITRATE_POLICY_H
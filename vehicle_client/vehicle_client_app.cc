@@ -3,8 +3,10 @@
 // Include concrete implementations (moved to main or factory in ideal scenario)
 #include "config/json_config_loader.h"  // Example concrete loader
 #include "control/apollo_controller.h"  // Example concrete controller
+#include "control/shm_controller.h"
 #include "network_manager/connection_monitor_impl.h"  // Example concrete monitor
 #include "sensors/canbus_chassis_source.h"  // Example concrete chassis
+#include "sensors/shm_chassis_source.h"
 #include "sensors/v4l2_camera_source.h"     // Example concrete camera
 #include "webrtc/webrtc_manager_impl.h"     // Example concrete webrtc manager
 
@@ -13,11 +15,15 @@
 // #include "proto/control/emergency_command.pb.h"
 // #include "proto/chassis/chassis_state.pb.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <functional>
 #include <iostream>
 #include <thread>
 
+#include "metrics/static_metrics.h"
+
 // Dummy Protobuf messages for compilation
 namespace autodev {
 namespace remote {
@@ -26,9 +32,20 @@ namespace control {
 struct ControlCommand {
   void set_acceleration(double) {}
 };
+enum EmergencyType { EMERGENCY_TYPE_UNKNOWN = 0, EMERGENCY_STOP, PULL_OVER };
 struct EmergencyCommand {
-  void set_type(int) {}
-  enum Type { EMERGENCY_STOP };
+  void set_type(EmergencyType) {}
+  void set_reason(const std::string&) {}
+};
+enum SessionMode {
+  SESSION_MODE_UNKNOWN = 0,
+  SESSION_MODE_PREVIEW = 1,
+  SESSION_MODE_CONTROL = 2
+};
+class SessionRequest {
+ public:
+  bool ParseFromArray(const void*, int) { return true; }
+  SessionMode mode() const { return SESSION_MODE_UNKNOWN; }
 };
 }  // namespace control
 namespace chassis {
@@ -124,6 +141,22 @@ int VehicleClientApp::run() {
   state_ = AppState::Running;
   std::cout << "VehicleClientApp: Running main loop..." << std::endl;
 
+  // Metrics endpoint (optional: the vehicle works without it)
+  if (config_.metrics_port != 0) {
+    metricsExporter_ =
+        std::make_unique<autodev::remote::metrics::PrometheusExporter>(
+            metricsRegistry_, config_.metrics_address, config_.metrics_port);
+    if (!metricsExporter_->start()) {
+      std::cerr << "VehicleClientApp: Failed to start metrics endpoint; "
+                   "continuing without it."
+                << std::endl;
+      metricsExporter_.reset();
+    }
+  }
+
+  if (telemetryBatcher_) telemetryBatcher_->start();
+  if (fileReceiver_) fileReceiver_->start();
+
   // TODO: Integrate with the actual event loop managed by libraries (e.g.,
   // libwebrtc's signaling thread, boost::asio::io_context). The run() method
   // should typically delegate to the event loop's run method or join its
@@ -141,6 +174,7 @@ int VehicleClientApp::run() {
     // called. This placeholder will just print and wait.
     std::this_thread::sleep_for(std::chrono::seconds(1));
     // std::cout << "App running..." << std::endl; // Avoid spamming output
+    evaluateConnectionHealth();
   }
 
   std::cout << "VehicleClientApp: Main loop finished." << std::endl;
@@ -178,11 +212,27 @@ void VehicleClientApp::stop() {
     std::cout << "VehicleClientApp: Camera Source stopped." << std::endl;
   }
 
+  // Sends the last telemetry batch while the peers are still there
+  if (telemetryBatcher_) {
+    telemetryBatcher_->stop();
+    std::cout << "VehicleClientApp: Telemetry batcher stopped." << std::endl;
+  }
+
+  // Partial files are kept; the cockpit resumes them
+  if (fileReceiver_) {
+    fileReceiver_->stop();
+    std::cout << "VehicleClientApp: File receiver stopped." << std::endl;
+  }
+
   // Stop WebRTC gracefully
   if (webrtcManager_) {
     webrtcManager_->stop();
     std::cout << "VehicleClientApp: WebRTC Manager stopped." << std::endl;
   }
+  if (metricsExporter_) {
+    metricsExporter_->stop();
+    std::cout << "VehicleClientApp: Metrics endpoint stopped." << std::endl;
+  }
 
   // The controller doesn't typically have a 'stop' method in this context,
   // it just stops processing commands when the app stops.
@@ -208,6 +258,12 @@ bool VehicleClientApp::setupWebrtcManager() {
     return false;
   }
 
+  PeerRoleConfig role_config;
+  role_config.observer_telemetry_rate_hz = config_.observer_telemetry_rate_hz;
+  role_config.control_role_claim = config_.control_role_claim;
+  role_config.require_role_claim = config_.require_role_claim;
+  peerRoles_ = std::make_unique<PeerRoleManager>(role_config);
+
   // Use lambdas for cleaner binding
   webrtcManager_->onPeerConnected(
       [this](const std::string& peer_id) { handlePeerConnected(peer_id); });
@@ -215,16 +271,113 @@ bool VehicleClientApp::setupWebrtcManager() {
       [this](const std::string& peer_id, const std::string& reason) {
         handlePeerDisconnected(peer_id, reason);
       });
-  webrtcManager_->onControlMessageReceived(
-      [this](const std::string& peer_id, const std::vector<char>& message) {
-        handleControlMessageReceived(peer_id, message);
+
+  // Each DataChannel is declared once; received messages are routed by the
+  // channel id the manager resolved at channel open. Control stays raw: the
+  // controller gate runs before parsing.
+  using autodev::remote::webrtc::ChannelPriority;
+  using autodev::remote::webrtc::ChannelReliability;
+  using autodev::remote::webrtc::DataChannelMessage;
+  using autodev::remote::webrtc::DataChannelMessageView;
+  auto channels =
+      std::make_shared<autodev::remote::webrtc::DataChannelRegistry>();
+  auto control_channel = channels->declare<DataChannelMessage>(
+      {config_.control_channel_label, ChannelPriority::High,
+       ChannelReliability::Reliable()});
+  auto telemetry_channel = channels->declare<DataChannelMessage>(
+      {config_.telemetry_channel_label, ChannelPriority::Medium,
+       ChannelReliability::Reliable()});
+  // Session requests of multi-vehicle cockpits (preview/control mode)
+  auto session_channel =
+      channels->declare<autodev::remote::control::SessionRequest>(
+          {config_.session_channel_label, ChannelPriority::High,
+           ChannelReliability::Reliable()});
+  channelDispatcher_.on(control_channel, [this](const std::string& peer_id,
+                                                DataChannelMessageView m) {
+    handleControlMessageReceived(peer_id, m);
+  });
+  channelDispatcher_.on(telemetry_channel, [this](const std::string& peer_id,
+                                                  DataChannelMessageView m) {
+    handleTelemetryMessageReceived(peer_id, m);
+  });
+  channelDispatcher_.on<autodev::remote::control::SessionRequest>(
+      session_channel,
+      [this](const std::string& peer_id,
+             const autodev::remote::control::SessionRequest& request) {
+        handleSessionRequest(peer_id, request);
       });
-  webrtcManager_->onTelemetryMessageReceived(
-      [this](const std::string& peer_id, const std::vector<char>& message) {
-        handleTelemetryMessageReceived(peer_id, message);
+  // Files: Low priority, so chunks never delay control or telemetry; the
+  // receiver writes them on its own thread.
+  if (!config_.received_files_dir.empty()) {
+    auto file_channel = channels->declare<DataChannelMessage>(
+        {config_.file_channel_label, ChannelPriority::Low,
+         ChannelReliability::Reliable()});
+    autodev::remote::webrtc::ChunkedTransferReceiver::Config file_config;
+    file_config.directory = config_.received_files_dir;
+    file_config.max_file_bytes = config_.received_file_max_bytes;
+    fileReceiver_ =
+        std::make_unique<autodev::remote::webrtc::ChunkedTransferReceiver>(
+            file_config, [this](const std::string& peer_id,
+                                const DataChannelMessage& frame) {
+              return webrtcManager_->sendDataChannelMessage(
+                  peer_id, config_.file_channel_label, frame);
+            });
+    // Frames are queued for the writer thread, so they are copied.
+    channelDispatcher_.on(file_channel, [this](const std::string& peer_id,
+                                               DataChannelMessageView m) {
+      fileReceiver_->handleFrame(peer_id, m.copy());
+    });
+  }
+  if (!webrtcManager_->setDataChannels(std::move(channels))) {
+    return false;
+  }
+  webrtcManager_->onChannelMessage(
+      [this](const std::string& peer_id,
+             autodev::remote::webrtc::ChannelId channel,
+             DataChannelMessageView message) {
+        channelDispatcher_.dispatch(peer_id, channel, message);
       });
+
   webrtcManager_->onError(
       [this](const std::string& error_msg) { handleWebrtcError(error_msg); });
+  // Role claims come with the peer's signaling messages, before it connects
+  webrtcManager_->onPeerRoleClaim(
+      [this](const std::string& peer_id, const std::string& role) {
+        if (peerRoles_->setRoleClaim(peer_id, role)) {
+          applyAllVideoParameters();  // The controller lost its role
+        }
+      });
+  if (config_.degradation_policy) {
+    webrtcManager_->onPeerStats(
+        [this](const std::string& peer_id,
+               const autodev::remote::webrtc::PeerConnectionStats& stats) {
+          handlePeerStats(peer_id, stats);
+        });
+  }
+  if (config_.sensors.video_bandwidth_adaptation) {
+    webrtcManager_->onBandwidthEstimate(
+        [this](const std::string& peer_id, double available_bps) {
+          handleBandwidthEstimate(peer_id, available_bps);
+        });
+  }
+
+  if (config_.telemetry_batching) {
+    autodev::remote::webrtc::DataChannelMessageBatcher::Config batch_config;
+    batch_config.max_latency =
+        std::chrono::milliseconds(config_.telemetry_batch_max_latency_ms);
+    batch_config.max_batch_bytes = config_.telemetry_batch_max_bytes;
+    telemetryBatcher_ =
+        std::make_unique<autodev::remote::webrtc::DataChannelMessageBatcher>(
+            batch_config, [this](const std::string& label,
+                                 const std::vector<char>& message) {
+              sendTelemetry(label, message);
+            });
+  }
+
+  // The manager publishes the connection statistics of every peer here
+  metricsRegistry_ =
+      std::make_shared<autodev::remote::metrics::MetricsRegistry>();
+  webrtcManager_->setMetricsRegistry(metricsRegistry_);
 
   // TODO: Initialize the webrtcManager using the config
   // webrtcManager_->init(config_.webrtc); // Assuming WebrtcManager has an init
@@ -239,9 +392,22 @@ bool VehicleClientApp::setupController() {
     std::cerr << "VehicleClientApp: Controller not injected!" << std::endl;
     return false;
   }
-  // TODO: Initialize the controller if it requires config
-  // controller_->init(config_.control); // Assuming Controller has an init
-  // method
+  // The vehicle's limits; a degraded connection only lowers them.
+  if (!controller_->init(config_.controller)) {
+    std::cerr << "VehicleClientApp: Failed to initialize controller."
+              << std::endl;
+    return false;
+  }
+
+  if (config_.degradation_policy) {
+    std::lock_guard<std::mutex> lock(healthMutex_);
+    degradationPolicy_ =
+        std::make_unique<DegradationPolicy>(config_.degradation);
+    degradationLevelGauge_ = metricsRegistry_->gauge(
+        "vehicle_degradation_level",
+        "Degradation level (0 normal, 1 reduced video, 2 speed limited, "
+        "3 pull over).");
+  }
   std::cout << "VehicleClientApp: Controller setup complete." << std::endl;
   return true;
 }
@@ -262,6 +428,19 @@ bool VehicleClientApp::setupSensors() {
     return false;
   }
 
+  if (config_.sensors.video_bandwidth_adaptation) {
+    autodev::remote::sensors::VideoBitratePolicyConfig policy_config;
+    policy_config.ladder =
+        autodev::remote::sensors::VideoBitratePolicy::DefaultLadder(
+            config_.sensors.camera_width, config_.sensors.camera_height,
+            config_.sensors.camera_fps);
+    policy_config.reserved_data_bps = config_.sensors.video_reserved_data_bps;
+    std::lock_guard<std::mutex> lock(videoAdaptationMutex_);
+    videoPolicy_ =
+        std::make_unique<autodev::remote::sensors::VideoBitratePolicy>(
+            std::move(policy_config));
+  }
+
   // TODO: Pass chassis config to init
   if (!chassisSource_->init(/* config_.sensors.can_interface */)) {
     std::cerr << "VehicleClientApp: Failed to initialize chassis source."
@@ -290,6 +469,10 @@ bool VehicleClientApp::setupSensors() {
 
 void VehicleClientApp::handlePeerConnected(const std::string& peer_id) {
   std::cout << "App: Peer " << peer_id << " connected via WebRTC." << std::endl;
+  // A peer joining while another one controls the vehicle is an observer;
+  // the observers' bitrate share shrinks with every new one.
+  peerRoles_->addPeer(peer_id);
+  applyAllVideoParameters();
   // TODO: Start sending data/video for this peer
   // Sensors should start capturing/updating now that a peer is available.
   // Actual sending will happen in sensor data handlers or by piping sensor
@@ -311,6 +494,22 @@ void VehicleClientApp::handlePeerDisconnected(const std::string& peer_id,
             << std::endl;
   // TODO: Stop sending data/video specific to this peer if not handled
   // automatically. Clean up any peer-specific resources.
+  {
+    // The camera no longer needs to fit this peer's link; the next estimate
+    // of the remaining peers may raise quality again.
+    std::lock_guard<std::mutex> lock(videoAdaptationMutex_);
+    peerBandwidth_.erase(peer_id);
+  }
+  {
+    std::lock_guard<std::mutex> lock(healthMutex_);
+    peerHealth_.erase(peer_id);
+  }
+  // Without the controller no control message is executed until a peer
+  // asks for control.
+  peerRoles_->removePeer(peer_id);
+  applyAllVideoParameters();
+  // Its partial files stay, to be resumed when it reconnects.
+  if (fileReceiver_) fileReceiver_->removePeer(peer_id);
 
   // Policy Decision: Should sensors stop if ALL peers disconnect?
   // Current skeleton keeps them running. A production app might stop sensors
@@ -318,9 +517,34 @@ void VehicleClientApp::handlePeerDisconnected(const std::string& peer_id,
 }
 
 void VehicleClientApp::handleControlMessageReceived(
-    const std::string& peer_id, const std::vector<char>& message) {
+    const std::string& peer_id,
+    autodev::remote::webrtc::DataChannelMessageView message) {
   // std::cout << "App: Received control message from " << peer_id << ", size="
   // << message.size() << std::endl;
+  // Observers do not drive; their messages are dropped before parsing. The
+  // lookup takes no lock (PeerRoleTable).
+  if (!peerRoles_->isController(peer_id)) {
+    autodev::remote::metrics::Increment(
+        autodev::remote::metrics::CounterId::vehicle_control_rejected_total);
+    return;
+  }
+  const int64_t now_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count();
+  const int64_t previous_ns =
+      lastControlMessageNs_.exchange(now_ns, std::memory_order_relaxed);
+  if (previous_ns != 0) {
+    // The cockpit sends at a fixed rate: jitter here is the link's (and
+    // what a file transfer adds to it, compared side by side).
+    using autodev::remote::metrics::HistogramId;
+    const bool transfer_active = fileReceiver_ && fileReceiver_->active();
+    autodev::remote::metrics::Record(
+        transfer_active
+            ? HistogramId::vehicle_control_interval_during_transfer_seconds
+            : HistogramId::vehicle_control_interval_seconds,
+        static_cast<uint64_t>(now_ns - previous_ns) / 1000);
+  }
   if (!controller_) {
     std::cerr
         << "App: Received control message but controller is not available!"
@@ -362,7 +586,8 @@ void VehicleClientApp::handleControlMessageReceived(
 }
 
 void VehicleClientApp::handleTelemetryMessageReceived(
-    const std::string& peer_id, const std::vector<char>& message) {
+    const std::string& peer_id,
+    autodev::remote::webrtc::DataChannelMessageView message) {
   // std::cout << "App: Received telemetry message from " << peer_id << ",
   // size=" << message.size() << std::endl; This might be loopback or commands
   // on the telemetry channel
@@ -386,6 +611,123 @@ void VehicleClientApp::handleWebrtcError(const std::string& error_msg) {
   // }
 }
 
+// Called on the WebRTC signaling thread, once per stats poll and peer.
+void VehicleClientApp::handleBandwidthEstimate(
+    const std::string& peer_id, double available_outgoing_bitrate_bps) {
+  std::lock_guard<std::mutex> lock(videoAdaptationMutex_);
+  if (!videoPolicy_) return;
+
+  const bool new_peer = peerBandwidth_.find(peer_id) == peerBandwidth_.end();
+  peerBandwidth_[peer_id] = available_outgoing_bitrate_bps;
+  // The camera follows the controller's link; observers have their own
+  // caps and never lower the driver's quality. Without a controller (or
+  // its first estimate) the lowest estimate of all peers is used.
+  double policy_bps = available_outgoing_bitrate_bps;
+  auto controller_it = peerBandwidth_.find(peerRoles_->getController());
+  if (controller_it != peerBandwidth_.end()) {
+    policy_bps = controller_it->second;
+  } else {
+    for (const auto& [id, bps] : peerBandwidth_) {
+      policy_bps = std::min(policy_bps, bps);
+    }
+  }
+  // A degraded connection gets less video to leave room for control.
+  policy_bps *= videoBudgetScale_;
+
+  const autodev::remote::sensors::VideoRung previous =
+      videoPolicy_->current().rung;
+  autodev::remote::sensors::VideoTarget target;
+  const bool changed = videoPolicy_->update(
+      policy_bps, std::chrono::steady_clock::now(), &target);
+  if (!changed && !new_peer) return;
+
+  if (changed && (target.rung.width != previous.width ||
+                  target.rung.height != previous.height ||
+                  target.rung.fps != previous.fps)) {
+    std::cout << "App: Bandwidth " << static_cast<uint64_t>(policy_bps)
+              << " bps, switching video to " << target.rung.width << "x"
+              << target.rung.height << "@" << target.rung.fps << "fps, "
+              << target.encoder_bitrate_bps << " bps." << std::endl;
+    if (cameraSource_ &&
+        !cameraSource_->setCaptureFormat(target.rung.width, target.rung.height,
+                                         target.rung.fps)) {
+      std::cerr << "App: Camera rejected the capture format." << std::endl;
+    }
+  }
+
+  // The camera already captures at the rung's format; the encoder only gets
+  // the bitrate and frame rate caps. A new peer gets the current target.
+  if (changed) {
+    for (const auto& [id, bps] : peerBandwidth_) {
+      applyVideoParametersLocked(id);
+    }
+  } else {
+    applyVideoParametersLocked(peer_id);
+  }
+}
+
+void VehicleClientApp::handleSessionRequest(
+    const std::string& peer_id,
+    const autodev::remote::control::SessionRequest& request) {
+  // Called from a WebRTC thread. MUST BE THREAD-SAFE.
+  switch (request.mode()) {
+    case autodev::remote::control::SESSION_MODE_PREVIEW:
+      peerRoles_->releaseControl(peer_id);
+      break;
+    case autodev::remote::control::SESSION_MODE_CONTROL:
+      // Rejected (logged) while another peer is the controller.
+      peerRoles_->requestControl(peer_id);
+      break;
+    default:
+      std::cerr << "App: Unknown session mode " << request.mode() << " from "
+                << peer_id << std::endl;
+      return;
+  }
+  std::cout << "App: Peer " << peer_id << " is "
+            << PeerRoleName(peerRoles_->getRole(peer_id)) << "." << std::endl;
+
+  // Only the senders change; the PeerConnections are not renegotiated.
+  applyAllVideoParameters();
+}
+
+void VehicleClientApp::applyAllVideoParameters() {
+  std::lock_guard<std::mutex> lock(videoAdaptationMutex_);
+  for (const std::string& peer_id : peerRoles_->getPeers()) {
+    applyVideoParametersLocked(peer_id);
+  }
+}
+
+void VehicleClientApp::applyVideoParametersLocked(const std::string& peer_id) {
+  autodev::remote::webrtc::VideoSendParameters params;  // No limits
+  if (videoPolicy_) {
+    const autodev::remote::sensors::VideoTarget target =
+        videoPolicy_->current();
+    params.max_bitrate_bps = target.encoder_bitrate_bps;
+    params.max_framerate = target.rung.fps;
+  }
+  if (!peerRoles_->isController(peer_id)) {
+    // Observers share one budget and each gets the encode of the shared
+    // camera scaled down.
+    const SensorConfig& sensors = config_.sensors;
+    const uint32_t observers = static_cast<uint32_t>(
+        std::max<size_t>(1, peerRoles_->getObserverCount()));
+    const uint32_t observer_bps =
+        std::min(sensors.video_preview_max_bitrate_bps,
+                 sensors.video_observers_max_bitrate_bps / observers);
+    params.max_bitrate_bps =
+        params.max_bitrate_bps == 0
+            ? observer_bps
+            : std::min(params.max_bitrate_bps, observer_bps);
+    params.max_framerate =
+        params.max_framerate == 0
+            ? sensors.video_preview_max_framerate
+            : std::min(params.max_framerate,
+                       sensors.video_preview_max_framerate);
+    params.scale_resolution_down_by = sensors.video_preview_scale_down_by;
+  }
+  webrtcManager_->setVideoSendParameters(peer_id, params);
+}
+
 // --- Handlers for Sensor Events ---
 
 void VehicleClientApp::handleCameraFrameCaptured(
@@ -407,26 +749,197 @@ void VehicleClientApp::handleChassisStateUpdated(
     const autodev::remote::chassis::Chassis& state) {
   // std::cout << "App: Chassis state updated (placeholder): Speed=" <<
   // state.speed_mps() << std::endl;
-  // TODO: Serialize the Protobuf message
+  // The measured speed, against which the controller enforces its speed
+  // limit (e.g., while DegradationLevel::SpeedLimited).
+  if (controller_) {
+    autodev::remote::control::ActuatorState actuator_state;
+    actuator_state.current_speed_mps = state.speed_mps();
+    controller_->updateActuatorState(actuator_state);
+  }
   std::vector<char> serialized_data(state.ByteSizeLong());
-  // if (!state.SerializeToArray(serialized_data.data(),
-  // serialized_data.size())) {
-  //     std::cerr << "App: Failed to serialize Chassis state." << std::endl;
-  //     // TODO: Handle serialization error
-  //     return;
-  // }
+  if (!state.SerializeToArray(serialized_data.data(),
+                              serialized_data.size())) {
+    std::cerr << "App: Failed to serialize Chassis state." << std::endl;
+    return;
+  }
 
-  // Send serialized data via the telemetry DataChannel to all connected peers
-  if (webrtcManager_) {
-    // Use a defined constant for the data channel label
-    const std::string telemetry_channel_label = "telemetry";
-    // webrtcManager_->sendDataChannelMessageToAllPeers(telemetry_channel_label,
-    // serialized_data); // Needs implementation
+  // Send serialized data via the telemetry DataChannel to the connected
+  // peers, in batches when enabled (the batcher sends from its own thread).
+  if (telemetryBatcher_) {
+    telemetryBatcher_->add(config_.telemetry_channel_label, serialized_data);
+  } else if (webrtcManager_) {
+    sendTelemetry(config_.telemetry_channel_label, serialized_data);
   }
   // Placeholder print for state
   // std::cout << "App: Chassis state updated (placeholder)." << std::endl;
 }
 
+// --- Connection health and degradation ---
+
+// Called on the WebRTC signaling thread, once per stats poll and peer.
+void VehicleClientApp::handlePeerStats(
+    const std::string& peer_id,
+    const autodev::remote::webrtc::PeerConnectionStats& stats) {
+  std::lock_guard<std::mutex> lock(healthMutex_);
+  auto it = peerHealth_.find(peer_id);
+  if (it == peerHealth_.end()) {
+    it = peerHealth_
+             .try_emplace(peer_id, config_.connection_health.freeze_window)
+             .first;
+    // Removed with the peer's other series when its connection goes.
+    it->second.score = metricsRegistry_->gauge(
+        "vehicle_connection_health_score",
+        "Connection health of the peer (0 unusable .. 1 healthy).",
+        {{"peer_id", peer_id}});
+  }
+  it->second.tracker.addStats(stats, std::chrono::steady_clock::now());
+}
+
+// Called by the run loop.
+void VehicleClientApp::evaluateConnectionHealth() {
+  const auto now = std::chrono::steady_clock::now();
+  const std::string controller = peerRoles_->getController();
+  // The browser only sends on input, so silence while standing is not a
+  // symptom of the link.
+  const bool moving =
+      controller_ &&
+      std::abs(controller_->getActuatorState().current_speed_mps) >
+          config_.connection_health.command_age_min_speed_mps;
+  std::lock_guard<std::mutex> lock(healthMutex_);
+
+  if (controller != evaluatedController_) {
+    evaluatedController_ = controller;
+    controllerSince_ = now;
+  }
+  if (!controller.empty() && controller != degradationController_) {
+    // A different peer took control and starts without degradation. The
+    // same controller coming back (a reconnect) keeps the level, so a
+    // flapping link does not clear a latched pull over.
+    degradationController_ = controller;
+    if (degradationPolicy_ &&
+        degradationPolicy_->current() != DegradationLevel::Normal) {
+      const DegradationLevel previous = degradationPolicy_->current();
+      degradationPolicy_->reset();
+      pullOverHealthySince_ = {};
+      applyDegradationLevelLocked(previous, DegradationLevel::Normal);
+    }
+  }
+
+  // Only the controller has a command age, and only while the vehicle
+  // moves; observers do not drive.
+  double command_age_ms = 0.0;
+  if (moving) {
+    const std::chrono::steady_clock::time_point last_command(
+        std::chrono::nanoseconds(
+            lastControlMessageNs_.load(std::memory_order_relaxed)));
+    command_age_ms = std::chrono::duration<double, std::milli>(
+                         now - std::max(last_command, controllerSince_))
+                         .count();
+  }
+
+  double controller_score = -1.0;  // No stats yet
+  for (auto& [peer_id, health] : peerHealth_) {
+    const bool is_controller = peer_id == controller;
+    const ConnectionHealth scored = ScoreConnectionHealth(
+        health.tracker.sample(now, is_controller ? command_age_ms : 0.0),
+        config_.connection_health);
+    if (health.score) health.score->set(scored.score);
+    if (is_controller) controller_score = scored.score;
+  }
+
+  if (!degradationPolicy_ || controller_score < 0.0) return;
+  const DegradationLevel previous = degradationPolicy_->current();
+  if (previous == DegradationLevel::PullOver) {
+    // Latched: left once the controller's connection stayed healthy for
+    // recover_hold.
+    const DegradationPolicyConfig& policy = config_.degradation;
+    if (controller_score < policy.reduce_video_below + policy.recover_margin) {
+      pullOverHealthySince_ = {};
+      return;
+    }
+    if (pullOverHealthySince_ == std::chrono::steady_clock::time_point()) {
+      pullOverHealthySince_ = now;
+    }
+    if (now - pullOverHealthySince_ < policy.recover_hold) return;
+    std::cerr << "App: Connection to controller " << controller
+              << " healthy again; leaving the pull over." << std::endl;
+    degradationPolicy_->reset();
+    pullOverHealthySince_ = {};
+    applyDegradationLevelLocked(previous, DegradationLevel::Normal);
+    return;
+  }
+  DegradationLevel level;
+  if (degradationPolicy_->update(controller_score, now, &level)) {
+    std::cerr << "App: Connection health of controller " << controller
+              << " is " << controller_score << "; degradation "
+              << DegradationLevelName(previous) << " -> "
+              << DegradationLevelName(level) << "." << std::endl;
+    applyDegradationLevelLocked(previous, level);
+  }
+}
+
+void VehicleClientApp::applyDegradationLevelLocked(DegradationLevel previous,
+                                                   DegradationLevel level) {
+  const DegradationPolicyConfig& policy = config_.degradation;
+  autodev::remote::metrics::Increment(
+      level > previous ? autodev::remote::metrics::CounterId::
+                             vehicle_degradation_escalations_total
+                       : autodev::remote::metrics::CounterId::
+                             vehicle_degradation_recoveries_total);
+  if (degradationLevelGauge_) {
+    degradationLevelGauge_->set(static_cast<double>(level));
+  }
+
+  // Video: applied with the next bandwidth estimate.
+  {
+    std::lock_guard<std::mutex> lock(videoAdaptationMutex_);
+    videoBudgetScale_ = level >= DegradationLevel::ReducedVideo
+                            ? policy.reduced_video_budget_scale
+                            : 1.0;
+  }
+
+  // Speed cap
+  const bool was_limited = previous >= DegradationLevel::SpeedLimited;
+  const bool limited = level >= DegradationLevel::SpeedLimited;
+  if (controller_ && limited != was_limited) {
+    autodev::remote::control::ControllerConfig controller_config =
+        config_.controller;
+    if (limited) {
+      controller_config.max_speed_mps = std::min(
+          controller_config.max_speed_mps, policy.limited_max_speed_mps);
+    }
+    if (!controller_->updateConfig(controller_config)) {
+      std::cerr << "App: Controller rejected the speed limit." << std::endl;
+    }
+  }
+
+  if (controller_ && level == DegradationLevel::PullOver) {
+    autodev::remote::control::EmergencyCommand emergency_command;
+    emergency_command.set_type(autodev::remote::control::PULL_OVER);
+    emergency_command.set_reason("Connection to the controller degraded");
+    controller_->processEmergencyCommand(emergency_command);
+    autodev::remote::metrics::Increment(
+        autodev::remote::metrics::CounterId::vehicle_pull_overs_total);
+  }
+}
+
+// Called from the chassis thread, or the batcher thread when batching.
+void VehicleClientApp::sendTelemetry(const std::string& label,
+                                     const std::vector<char>& message) {
+  std::vector<std::string> recipients;
+  peerRoles_->selectTelemetryRecipients(std::chrono::steady_clock::now(),
+                                        &recipients);
+  for (const std::string& peer_id : recipients) {
+    if (config_.telemetry_max_buffered_bytes > 0) {
+      // Latest-value data: a skipped update is superseded by the next one.
+      webrtcManager_->trySendDataChannelMessage(
+          peer_id, label, message, config_.telemetry_max_buffered_bytes);
+    } else {
+      webrtcManager_->sendDataChannelMessage(peer_id, label, message);
+    }
+  }
+}
+
 // --- Handlers for ConnectionMonitor Events ---
 
 void VehicleClientApp::handleNetworkUp(const std::string& peer_id) {
@@ -496,12 +1009,27 @@ int main(int argc, char* argv[]) {
   // V4L2, Apollo, etc.) Using concrete classes directly for this example.
   auto webrtc_manager =
       std::make_unique<autodev::remote::webrtc::WebrtcManagerImpl>();
-  auto controller =
-      std::make_unique<autodev::remote::control::ApolloController>();
+  std::unique_ptr<autodev::remote::control::IController> controller;
+  std::unique_ptr<autodev::remote::sensors::IChassisSource> chassis_source;
+  if (!app_config.shm_bridge_name.empty()) {
+    // Co-located autonomy stack: chassis and commands via shared memory
+    // Opens the bridge in VehicleClientApp::init, with the configured
+    // limits.
+    controller = std::make_unique<autodev::remote::control::ShmController>(
+        app_config.shm_bridge_name);
+    chassis_source =
+        std::make_unique<autodev::remote::sensors::ShmChassisSource>(
+            app_config.shm_bridge_name,
+            std::chrono::microseconds(
+                app_config.shm_chassis_poll_interval_us));
+  } else {
+    controller =
+        std::make_unique<autodev::remote::control::ApolloController>();
+    chassis_source =
+        std::make_unique<autodev::remote::sensors::CanBusChassisSource>();
+  }
   auto camera_source =
       std::make_unique<autodev::remote::sensors::V4L2CameraSource>();
-  auto chassis_source =
-      std::make_unique<autodev::remote::sensors::CanBusChassisSource>();
 
   // Create Connection Monitor only if heartbeat is configured
   std::unique_ptr<autodev::remote::network_manager::IConnectionMonitor>
@@ -1,18 +1,41 @@
 #ifndef VEHICLE_CLIENT_APP_H
 #define VEHICLE_CLIENT_APP_H
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "config/config_loader.h"
 #include "config/vehicle_config.h"
+#include "control/connection_health.h"
 #include "control/controller.h"
+#include "control/degradation_policy.h"
+#include "control/peer_role_manager.h"
+#include "metrics/metrics_registry.h"
+#include "metrics/prometheus_exporter.h"
 #include "sensors/camera.h"
 #include "sensors/chassis.h"
+#include "sensors/video_bitrate_policy.h"
+#include "webrtc/chunked_transfer.h"
+#include "webrtc/data_channel_registry.h"
+#include "webrtc/message_batcher.h"
 #include "webrtc/webrtc_manager.h"
 
+// Forward declare the Protobuf messages only the implementation parses
+namespace autodev {
+namespace remote {
+namespace control {
+class SessionRequest;
+}  // namespace control
+}  // namespace remote
+}  // namespace autodev
+
 namespace autodev {
 namespace remote {
 namespace vehicle {
@@ -64,6 +87,69 @@ class VehicleClientApp {
   std::unique_ptr<ICameraSource> cameraSource_;
   std::unique_ptr<IChassisSource> chassisSource_;
 
+  // Metrics (WebRTC connection statistics) and their HTTP endpoint
+  // (config_.metrics_port; not created when 0).
+  std::shared_ptr<autodev::remote::metrics::MetricsRegistry> metricsRegistry_;
+  std::unique_ptr<autodev::remote::metrics::PrometheusExporter>
+      metricsExporter_;
+
+  // Controller and observers among the connected peers, by the role claims
+  // of their signaling tokens. Only the controller's control messages are
+  // executed.
+  std::unique_ptr<PeerRoleManager> peerRoles_;
+
+  // Bandwidth adaptation of the camera stream (null when disabled). The
+  // camera is shared, so it follows the controller's estimate (the lowest
+  // of all peers while there is no controller); observers get the
+  // config_.sensors.video_preview_* limits on their own senders.
+  std::mutex videoAdaptationMutex_;
+  std::unique_ptr<autodev::remote::sensors::VideoBitratePolicy>
+      videoPolicy_;                              // Guarded by the mutex
+  std::map<std::string, double> peerBandwidth_;  // Guarded; bps by peer
+  // Scales the estimates while the video is degraded. Guarded by the mutex.
+  double videoBudgetScale_ = 1.0;
+
+  // Connection health of the peers, evaluated by the run loop, and the
+  // degradation of the vehicle from its controller's health.
+  struct PeerHealth {
+    explicit PeerHealth(std::chrono::milliseconds freeze_window)
+        : tracker(freeze_window) {}
+    ConnectionHealthTracker tracker;
+    std::shared_ptr<autodev::remote::metrics::Gauge> score;  // May be null
+  };
+  std::mutex healthMutex_;
+  // --- Guarded by healthMutex_ ---
+  std::map<std::string, PeerHealth> peerHealth_;
+  std::unique_ptr<DegradationPolicy> degradationPolicy_;  // Null: disabled
+  // Last controller the level applies to; kept while it is disconnected.
+  std::string degradationController_;
+  // Controller at the last evaluation (empty: none) and since when.
+  std::string evaluatedController_;
+  std::chrono::steady_clock::time_point controllerSince_;
+  // Start of the healthy period that ends a pull over; unset (epoch) when
+  // not in one.
+  std::chrono::steady_clock::time_point pullOverHealthySince_;
+  std::shared_ptr<autodev::remote::metrics::Gauge> degradationLevelGauge_;
+  // steady_clock time (ns since epoch) of the last executed control message.
+  // The interval to the previous one is recorded as
+  // vehicle_control_interval_seconds, or _during_transfer_seconds while a
+  // file is received, to show what a transfer costs the control channel.
+  std::atomic<int64_t> lastControlMessageNs_{0};
+
+  // Handlers of the received messages by DataChannel; set up in
+  // setupWebrtcManager, before any message arrives, and read-only after.
+  autodev::remote::webrtc::DataChannelDispatcher channelDispatcher_;
+
+  // Batches the telemetry messages (null when config_.telemetry_batching is
+  // off); runs between run() and stop().
+  std::unique_ptr<autodev::remote::webrtc::DataChannelMessageBatcher>
+      telemetryBatcher_;
+
+  // Stores the files sent on the file channel (null when
+  // config_.received_files_dir is empty); runs between run() and stop().
+  std::unique_ptr<autodev::remote::webrtc::ChunkedTransferReceiver>
+      fileReceiver_;
+
   // Internal setup methods (now simpler due to dependency injection)
   bool setupWebrtcManager();
   bool setupController();
@@ -73,11 +159,37 @@ class VehicleClientApp {
   void handlePeerConnected(const std::string& peer_id);
   void handlePeerDisconnected(const std::string& peer_id,
                               const std::string& reason);
-  void handleControlMessageReceived(const std::string& peer_id,
-                                    const std::vector<char>& message);
-  void handleTelemetryMessageReceived(const std::string& peer_id,
-                                      const std::vector<char>& message);
+  // message is a view of the receive buffer, valid during the call only.
+  void handleControlMessageReceived(
+      const std::string& peer_id,
+      autodev::remote::webrtc::DataChannelMessageView message);
+  void handleTelemetryMessageReceived(
+      const std::string& peer_id,
+      autodev::remote::webrtc::DataChannelMessageView message);
   void handleWebrtcError(const std::string& error_msg);
+  void handleBandwidthEstimate(const std::string& peer_id,
+                               double available_outgoing_bitrate_bps);
+  void handleSessionRequest(
+      const std::string& peer_id,
+      const autodev::remote::control::SessionRequest& request);
+  // Applies the current video target, or the observer limits, to the
+  // peer's video sender. videoAdaptationMutex_ MUST be held.
+  void applyVideoParametersLocked(const std::string& peer_id);
+  // Reapplies the video parameters of every peer after a role change.
+  void applyAllVideoParameters();
+  void handlePeerStats(
+      const std::string& peer_id,
+      const autodev::remote::webrtc::PeerConnectionStats& stats);
+  // Scores every peer and updates the degradation level. Called by the run
+  // loop once per second.
+  void evaluateConnectionHealth();
+  // Applies a new degradation level. healthMutex_ MUST be held.
+  void applyDegradationLevelLocked(DegradationLevel previous,
+                                   DegradationLevel level);
+  // Sends a telemetry message to the controller and, rate-limited, to the
+  // observers.
+  void sendTelemetry(const std::string& label,
+                     const std::vector<char>& message);
 
   // Handlers for Sensor events
   void handleCameraFrameCaptured(
@@ -0,0 +1,211 @@
+// Cost of one High priority DataChannel send: the string-keyed API
+// (IWebrtcManager::sendDataChannelMessage) against a ChannelHandle.
+//
+// WebrtcManagerImpl needs libwebrtc, so the string-keyed path is rebuilt
+// here step for step from the real pieces: the label's priority from the
+// DataChannelRegistry, DataChannelSendScheduler::submit, the manager lock
+// and peer map lookup with the metrics of sendDataChannelMessageNow, then
+// the PeerConnection lock and label map lookup of SendData. Both paths end
+// in the same fake endpoint (a lock and a byte count, standing in for
+// RTCDataChannel::Send), with 4 peers and 4 channels declared. The
+// endpoint alone is printed as the floor.
+//
+// Build, then run, from the repository root:
+//   g++ -std=c++17 -O2 -I. -o /tmp/channel_handle_benchmark
+//       webrtc/benchmarks/channel_handle_benchmark.cc
+//       webrtc/channel_handle.cc webrtc/data_channel_registry.cc
+//       webrtc/send_scheduler.cc metrics/static_metrics.cc
+//       metrics/metrics_registry.cc -lpthread
+//   /tmp/channel_handle_benchmark
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "metrics/static_metrics.h"
+#include "testing/benchmark.h"
+#include "webrtc/channel_handle.h"
+#include "webrtc/data_channel_registry.h"
+#include "webrtc/send_scheduler.h"
+
+namespace {
+
+using autodev::remote::testing::DoNotOptimize;
+using autodev::remote::testing::NanosPerOp;
+using autodev::remote::testing::PrintResult;
+using autodev::remote::webrtc::ChannelHandle;
+using autodev::remote::webrtc::ChannelId;
+using autodev::remote::webrtc::ChannelPriority;
+using autodev::remote::webrtc::DataChannelMessage;
+using autodev::remote::webrtc::DataChannelRegistry;
+using autodev::remote::webrtc::DataChannelSendScheduler;
+using autodev::remote::webrtc::DataChannelSpec;
+using autodev::remote::webrtc::IDataChannelEndpoint;
+using autodev::remote::webrtc::kUnknownChannelId;
+namespace metrics = autodev::remote::metrics;
+
+constexpr uint64_t kIterations = 5000000;
+const char* const kPeers[] = {"cockpit-1", "cockpit-2", "observer-1",
+                              "observer-2"};
+const char* const kLabels[] = {"control", "emergency", "telemetry",
+                               "video_meta"};
+
+// Stands in for RTCDataChannel::Send behind LibwebrtcDataChannelEndpoint.
+class FakeEndpoint : public IDataChannelEndpoint {
+ public:
+  bool isOpen() const override { return true; }
+  bool isDetached() const override { return false; }
+  uint64_t bufferedAmount() const override { return 0; }
+  bool send(const DataChannelMessage& data) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sentBytes_ += data.size();
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  uint64_t sentBytes_ = 0;  // Guarded by mutex_
+};
+
+// LibwebrtcPeerConnectionImpl::SendData: lock, label lookup, send.
+class FakePeerConnection {
+ public:
+  FakePeerConnection() {
+    for (const char* label : kLabels) {
+      channels_[label] = std::make_shared<FakeEndpoint>();
+    }
+  }
+
+  bool SendData(const std::string& label, const DataChannelMessage& data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = channels_.find(label);
+    if (it == channels_.end() || !it->second->isOpen()) return false;
+    return it->second->send(data);
+  }
+
+  std::shared_ptr<IDataChannelEndpoint> endpoint(const std::string& label) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return channels_[label];
+  }
+
+ private:
+  std::mutex mutex_;
+  // Guarded by mutex_
+  std::map<std::string, std::shared_ptr<FakeEndpoint>> channels_;
+};
+
+// WebrtcManagerImpl's string-keyed send path.
+class StringKeyedManager {
+ public:
+  StringKeyedManager() {
+    for (const char* label : kLabels) {
+      DataChannelSpec spec;
+      spec.label = label;
+      spec.priority = std::string(label) == "control" ||
+                              std::string(label) == "emergency"
+                          ? ChannelPriority::High
+                          : ChannelPriority::Low;
+      channels_.add(spec);
+    }
+    for (const char* peer : kPeers) {
+      peerConnections_[peer] = std::make_unique<FakePeerConnection>();
+    }
+    scheduler_ = std::make_unique<DataChannelSendScheduler>(
+        DataChannelSendScheduler::Config(),
+        [this](const std::string& peer_id, const std::string& label,
+               const DataChannelMessage& data) {
+          return sendDataChannelMessageNow(peer_id, label, data);
+        },
+        [](const std::string&) { return uint64_t{0}; });
+  }
+
+  bool sendDataChannelMessage(const std::string& peer_id,
+                              const std::string& channel_label,
+                              const DataChannelMessage& data) {
+    return scheduler_->submit(peer_id, channel_label,
+                              channelPriority(channel_label), data);
+  }
+
+  ChannelHandle acquireChannel(const std::string& peer_id,
+                               const std::string& channel_label) {
+    const ChannelId id = channels_.resolve(channel_label);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ChannelHandle(
+        peerConnections_[peer_id]->endpoint(channel_label),
+        channels_.spec(id).priority);
+  }
+
+ private:
+  ChannelPriority channelPriority(const std::string& label) const {
+    const ChannelId id = channels_.resolve(label);
+    return id != kUnknownChannelId ? channels_.spec(id).priority
+                                   : ChannelPriority::Low;
+  }
+
+  bool sendDataChannelMessageNow(const std::string& peer_id,
+                                 const std::string& channel_label,
+                                 const DataChannelMessage& data) {
+    metrics::ScopedTimer send_timer(
+        metrics::HistogramId::webrtc_dc_send_duration_seconds);
+    metrics::Record(metrics::HistogramId::webrtc_dc_message_size_bytes,
+                    data.size());
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_.load()) return false;
+    auto it = peerConnections_.find(peer_id);
+    if (it == peerConnections_.end() || !it->second) {
+      metrics::Increment(metrics::CounterId::webrtc_dc_send_failures_total);
+      return false;
+    }
+    const bool success = it->second->SendData(channel_label, data);
+    if (success) {
+      metrics::Increment(metrics::CounterId::webrtc_dc_messages_sent_total);
+      metrics::Increment(metrics::CounterId::webrtc_dc_sent_bytes_total,
+                         data.size());
+    } else {
+      metrics::Increment(metrics::CounterId::webrtc_dc_send_failures_total);
+    }
+    return success;
+  }
+
+  DataChannelRegistry channels_;
+  std::mutex mutex_;
+  std::atomic<bool> running_{true};
+  // Guarded by mutex_
+  std::map<std::string, std::unique_ptr<FakePeerConnection>> peerConnections_;
+  std::unique_ptr<DataChannelSendScheduler> scheduler_;
+};
+
+}  // namespace
+
+int main() {
+  StringKeyedManager manager;
+  const DataChannelMessage command(48);  // A serialized ControlCommand
+  const std::string peer = "observer-2";
+  const std::string label = "control";
+
+  PrintResult("string-keyed sendDataChannelMessage",
+              NanosPerOp(kIterations, [&] {
+                DoNotOptimize(
+                    manager.sendDataChannelMessage(peer, label, command));
+              }));
+
+  const ChannelHandle handle = manager.acquireChannel(peer, label);
+  if (!handle.valid() || handle.priority() != ChannelPriority::High) {
+    std::fprintf(stderr, "Failed to acquire the control channel\n");
+    return 1;
+  }
+  PrintResult("ChannelHandle::send", NanosPerOp(kIterations, [&] {
+                DoNotOptimize(handle.send(command));
+              }));
+
+  FakeEndpoint endpoint;
+  PrintResult("endpoint send alone (floor)", NanosPerOp(kIterations, [&] {
+                DoNotOptimize(endpoint.send(command));
+              }));
+  return 0;
+}
@@ -0,0 +1,264 @@
+// Control message latency while bulk (video-sized) DataChannel traffic
+// saturates the link, with and without DataChannelSendScheduler.
+//
+// The link is simulated: one FIFO send buffer (bufferedAmount) drained at a
+// fixed rate, i.e. the worst case where the transport does not reorder what
+// is already buffered. A producer offers 16 KB Low priority messages at
+// twice the link rate; another sends a 64 byte High priority control
+// message every 10 ms and the time each one takes to leave the link is
+// recorded. Without the scheduler the buffer, and with it the control
+// latency, grows for as long as the overload lasts; with it the buffer
+// stays near buffer_budget_bytes and control latency stays flat. The
+// scheduler releases queued messages on its fallback poll, or on the
+// link's low-threshold event (bufferedAmount dropping to half the budget,
+// as WebrtcManagerImpl sets it up) when that is enabled.
+//
+// Build, then run, from the repository root:
+//   g++ -std=c++17 -O2 -I. -o /tmp/send_scheduler_benchmark
+//       webrtc/benchmarks/send_scheduler_benchmark.cc
+//       webrtc/send_scheduler.cc metrics/static_metrics.cc
+//       metrics/metrics_registry.cc -lpthread
+//   /tmp/send_scheduler_benchmark
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "webrtc/send_scheduler.h"
+
+namespace {
+
+using autodev::remote::webrtc::ChannelPriority;
+using autodev::remote::webrtc::DataChannelSendScheduler;
+using Clock = std::chrono::steady_clock;
+
+constexpr double kLinkBytesPerSecond = 1000000.0;  // 8 Mbit/s
+constexpr size_t kVideoMessageBytes = 16 * 1024;
+constexpr size_t kControlMessageBytes = 64;
+constexpr auto kControlInterval = std::chrono::milliseconds(10);
+constexpr auto kRunTime = std::chrono::seconds(3);
+
+// A send buffer drained at kLinkBytesPerSecond by its own thread.
+class SimulatedLink {
+ public:
+  SimulatedLink() : thread_(&SimulatedLink::run, this) {}
+
+  ~SimulatedLink() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      running_ = false;
+    }
+    cv_.notify_all();
+    thread_.join();
+  }
+
+  // Called (on the link thread) when bufferedAmount drops from above
+  // threshold to at most it. Set before the first send.
+  void onBufferedAmountLow(uint64_t threshold, std::function<void()> handler) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lowThreshold_ = threshold;
+    onLow_ = std::move(handler);
+  }
+
+  bool send(size_t bytes, bool control) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      buffer_.push_back({bytes, control, Clock::now()});
+      bufferedBytes_ += bytes;
+    }
+    cv_.notify_one();
+    return true;
+  }
+
+  // Bytes that have left the link so far.
+  uint64_t sentBytes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sentBytes_;
+  }
+
+  uint64_t bufferedAmount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bufferedBytes_;
+  }
+
+  // (submit time since start in s, latency in ms) of every control message
+  // sent.
+  std::vector<std::pair<double, double>> controlLatencies() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return controlLatencies_;
+  }
+
+ private:
+  struct Message {
+    size_t bytes;
+    bool control;
+    Clock::time_point submitted;
+  };
+
+  void run() {
+    const Clock::time_point start = Clock::now();
+    Clock::time_point link_free = start;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [this] { return !running_ || !buffer_.empty(); });
+      if (!running_) return;
+      const Message message = buffer_.front();
+      lock.unlock();
+      // Serialization time on the wire.
+      link_free = std::max(link_free, Clock::now()) +
+                  std::chrono::duration_cast<Clock::duration>(
+                      std::chrono::duration<double>(message.bytes /
+                                                    kLinkBytesPerSecond));
+      std::this_thread::sleep_until(link_free);
+      const Clock::time_point sent = Clock::now();
+      lock.lock();
+      buffer_.pop_front();
+      const bool low = onLow_ && bufferedBytes_ > lowThreshold_ &&
+                       bufferedBytes_ - message.bytes <= lowThreshold_;
+      bufferedBytes_ -= message.bytes;
+      sentBytes_ += message.bytes;
+      if (low) {
+        lock.unlock();
+        onLow_();
+        lock.lock();
+      }
+      if (message.control) {
+        controlLatencies_.emplace_back(
+            std::chrono::duration<double>(message.submitted - start).count(),
+            std::chrono::duration<double, std::milli>(sent -
+                                                      message.submitted)
+                .count());
+      }
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Message> buffer_;  // Guarded by mutex_
+  uint64_t bufferedBytes_ = 0;  // Guarded by mutex_
+  uint64_t sentBytes_ = 0;      // Guarded by mutex_
+  // Guarded by mutex_
+  std::vector<std::pair<double, double>> controlLatencies_;
+  bool running_ = true;  // Guarded by mutex_
+  uint64_t lowThreshold_ = 0;     // Guarded by mutex_
+  std::function<void()> onLow_;  // Guarded by mutex_
+  std::thread thread_;
+};
+
+double Percentile(std::vector<double> values, double p) {
+  if (values.empty()) return 0.0;
+  const size_t index = std::min(
+      values.size() - 1, static_cast<size_t>(p * values.size()));
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+// budget_bytes == 0: no scheduler, every message goes straight to the link.
+void RunScenario(const char* name, bool video, uint64_t budget_bytes,
+                 bool low_event = false) {
+  SimulatedLink link;
+  const std::string peer = "cockpit";
+  std::unique_ptr<DataChannelSendScheduler> scheduler;
+  if (budget_bytes > 0) {
+    DataChannelSendScheduler::Config config;
+    config.buffer_budget_bytes = budget_bytes;
+    scheduler = std::make_unique<DataChannelSendScheduler>(
+        config,
+        [&](const std::string&, const std::string& label,
+            const DataChannelSendScheduler::DataChannelMessage& data) {
+          return link.send(data.size(), label == "control");
+        },
+        [&](const std::string&) { return link.bufferedAmount(); });
+    if (low_event) {
+      link.onBufferedAmountLow(budget_bytes / 2, [&scheduler] {
+        scheduler->notifyBufferedAmountLow();
+      });
+    }
+    scheduler->start();
+  }
+  auto submit = [&](const std::string& label, ChannelPriority priority,
+                    const DataChannelSendScheduler::DataChannelMessage& data) {
+    if (scheduler) return scheduler->submit(peer, label, priority, data);
+    return link.send(data.size(), label == "control");
+  };
+
+  std::atomic<bool> running{true};
+  std::thread video_thread;
+  if (video) {
+    video_thread = std::thread([&] {
+      const DataChannelSendScheduler::DataChannelMessage frame(
+          kVideoMessageBytes);
+      const auto interval = std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(kVideoMessageBytes /
+                                        (2.0 * kLinkBytesPerSecond)));
+      Clock::time_point next = Clock::now();
+      while (running.load()) {
+        submit("video", ChannelPriority::Low, frame);
+        next += interval;
+        std::this_thread::sleep_until(next);
+      }
+    });
+  }
+
+  const DataChannelSendScheduler::DataChannelMessage command(
+      kControlMessageBytes);
+  const Clock::time_point end = Clock::now() + kRunTime;
+  Clock::time_point next = Clock::now();
+  while (Clock::now() < end) {
+    submit("control", ChannelPriority::High, command);
+    next += kControlInterval;
+    std::this_thread::sleep_until(next);
+  }
+  running.store(false);
+  if (video_thread.joinable()) video_thread.join();
+  const uint64_t buffered_at_end = link.bufferedAmount();
+  const uint64_t sent_at_end = link.sentBytes();
+  if (scheduler) scheduler->stop();
+  // Let the last control messages out before reading the latencies.
+  std::this_thread::sleep_for(std::chrono::milliseconds(
+      static_cast<int64_t>(1000.0 * buffered_at_end / kLinkBytesPerSecond) +
+      50));
+
+  std::vector<double> all, first_second, last_second;
+  const double run_s = std::chrono::duration<double>(kRunTime).count();
+  for (const auto& [at_s, latency_ms] : link.controlLatencies()) {
+    all.push_back(latency_ms);
+    if (at_s < 1.0) first_second.push_back(latency_ms);
+    if (at_s >= run_s - 1.0 && at_s < run_s) last_second.push_back(latency_ms);
+  }
+  std::printf("%-34s p50 %7.1f  p99 %7.1f  max %7.1f ms | 1st s p50 %7.1f"
+              "  last s p50 %7.1f ms | buffered at end %7.0f KB | link busy "
+              "%5.1f%%\n",
+              name, Percentile(all, 0.5), Percentile(all, 0.99),
+              Percentile(all, 1.0), Percentile(first_second, 0.5),
+              Percentile(last_second, 0.5), buffered_at_end / 1024.0,
+              100.0 * sent_at_end / (kLinkBytesPerSecond * run_s));
+}
+
+}  // namespace
+
+int main() {
+  std::printf("link %.0f Mbit/s, video offered at 2x the link, control "
+              "every %lld ms, %lld s per case\n",
+              kLinkBytesPerSecond * 8 / 1e6,
+              static_cast<long long>(kControlInterval.count()),
+              static_cast<long long>(kRunTime.count()));
+  RunScenario("control only (idle link)", false, 0);
+  RunScenario("video, no scheduler", true, 0);
+  RunScenario("video, scheduler, 64 KB budget", true, 64 * 1024);
+  RunScenario("video, scheduler, 16 KB budget", true, 16 * 1024);
+  RunScenario("video, scheduler, 16 KB, low event", true, 16 * 1024,
+              true);
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include "webrtc/channel_handle.h"
+
+#include <utility>
+
+#include "metrics/static_metrics.h"
+
+namespace autodev {
+namespace remote {
+namespace webrtc {
+
+ChannelHandle::ChannelHandle(std::shared_ptr<IDataChannelEndpoint> endpoint,
+                             ChannelPriority priority,
+                             ScheduledSendFunction scheduled_send)
+    : endpoint_(std::move(endpoint)),
+      priority_(priority),
+      scheduledSend_(std::move(scheduled_send)) {}
+
+bool ChannelHandle::send(const DataChannelMessage& data) const {
+  if (!endpoint_) return false;
+  if (scheduledSend_) {
+    // Checked first: the scheduler's path goes through the manager.
+    if (endpoint_->isDetached()) {
+      metrics::Increment(metrics::CounterId::webrtc_dc_send_failures_total);
+      return false;
+    }
+    return scheduledSend_(data);
+  }
+  return sendNow(data);
+}
+
+bool ChannelHandle::trySend(const DataChannelMessage& data,
+                            uint64_t max_buffered_bytes) const {
+  if (!endpoint_) return false;
+  // Concurrent senders may both pass; the threshold is a soft limit.
+  if (endpoint_->bufferedAmount() + data.size() > max_buffered_bytes) {
+    metrics::Increment(metrics::CounterId::webrtc_dc_send_backpressure_total);
+    return false;
+  }
+  return sendNow(data);
+}
+
+bool ChannelHandle::sendNow(const DataChannelMessage& data) const {
+  // Same metrics as WebrtcManagerImpl::sendDataChannelMessageNow.
+  metrics::ScopedTimer send_timer(
+      metrics::HistogramId::webrtc_dc_send_duration_seconds);
+  metrics::Record(metrics::HistogramId::webrtc_dc_message_size_bytes,
+                  data.size());
+  const bool success = endpoint_->send(data);
+  if (success) {
+    metrics::Increment(metrics::CounterId::webrtc_dc_messages_sent_total);
+    metrics::Increment(metrics::CounterId::webrtc_dc_sent_bytes_total,
+                       data.size());
+  } else {
+    metrics::Increment(metrics::CounterId::webrtc_dc_send_failures_total);
+  }
+  return success;
+}
+
+}  // namespace webrtc
+}  // namespace remote
+}  // namespace autodev
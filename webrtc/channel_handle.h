@@ -0,0 +1,101 @@
+#ifndef CHANNEL_HANDLE_H
+#define CHANNEL_HANDLE_H
+
+#include <functional>
+#include <memory>
+
+#include "webrtc/channel_priority.h"
+#include "webrtc/data_channel_registry.h"
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace webrtc {
+
+// The sending side of one declared DataChannel of one PeerConnection,
+// created by the PeerConnection once per channel and kept for its lifetime:
+// a channel announced again by the peer is rebound to it, and Close()
+// detaches it for good. Held through a shared_ptr, so a detached endpoint
+// may outlive its PeerConnection (its sends just fail).
+class IDataChannelEndpoint {
+ public:
+  virtual ~IDataChannelEndpoint() = default;
+
+  // One atomic load each. MUST BE THREAD-SAFE.
+  virtual bool isOpen() const = 0;
+  // The PeerConnection was closed; the endpoint never opens again.
+  virtual bool isDetached() const = 0;
+
+  // Bytes queued on the channel and not yet sent (0 if not open).
+  // This method MUST BE THREAD-SAFE.
+  virtual uint64_t bufferedAmount() const = 0;
+
+  // Queues the message on the channel, without any lookup. Returns false if
+  // the channel is not open or its send buffer is full.
+  // This method MUST BE THREAD-SAFE.
+  virtual bool send(const DataChannelMessage& data) = 0;
+
+ protected:
+  IDataChannelEndpoint() = default;
+
+  // Prevent copying
+  IDataChannelEndpoint(const IDataChannelEndpoint&) = delete;
+  IDataChannelEndpoint& operator=(const IDataChannelEndpoint&) = delete;
+};
+
+// Send path to one DataChannel of one peer, acquired once with
+// IWebrtcManager::acquireChannel() instead of looking up the peer and the
+// label for every message. Copies share the endpoint.
+//
+// High priority channels send straight to the endpoint: no manager lock and
+// no map lookup. Lower priorities still go through the send scheduler, whose
+// queues keep them behind control traffic.
+//
+// A handle belongs to one connection: once expired() (the peer disconnected
+// or the manager stopped), acquire a new one. It must not outlive the
+// WebrtcManager it was acquired from.
+class ChannelHandle {
+ public:
+  // Sends through the scheduler (lower priorities); counts the message
+  // itself.
+  using ScheduledSendFunction = std::function<bool(const DataChannelMessage&)>;
+
+  ChannelHandle() = default;  // Invalid; send() fails
+  ChannelHandle(std::shared_ptr<IDataChannelEndpoint> endpoint,
+                ChannelPriority priority,
+                ScheduledSendFunction scheduled_send = nullptr);
+
+  bool valid() const { return endpoint_ != nullptr; }
+  bool isOpen() const { return endpoint_ && endpoint_->isOpen(); }
+  bool expired() const { return !endpoint_ || endpoint_->isDetached(); }
+  ChannelPriority priority() const { return priority_; }
+  uint64_t bufferedAmount() const {
+    return endpoint_ ? endpoint_->bufferedAmount() : 0;
+  }
+
+  // Returns false if the channel is not open (yet) or the message was
+  // rejected. MUST BE THREAD-SAFE (concurrent sends on copies or on the same
+  // handle are fine; assigning the handle is not).
+  bool send(const DataChannelMessage& data) const;
+
+  // Sends straight to the channel, whatever its priority, unless that would
+  // take its bufferedAmount above max_buffered_bytes: then fails at once
+  // (counted in webrtc_dc_send_backpressure_total) instead of queueing. For
+  // producers that adapt their rate (or drop stale data) to the link, e.g.
+  // with onBufferedAmountLow as the signal to resume.
+  bool trySend(const DataChannelMessage& data,
+               uint64_t max_buffered_bytes) const;
+
+ private:
+  bool sendNow(const DataChannelMessage& data) const;
+
+  std::shared_ptr<IDataChannelEndpoint> endpoint_;
+  ChannelPriority priority_ = ChannelPriority::Low;
+  ScheduledSendFunction scheduledSend_;  // Empty: direct send
+};
+
+}  // namespace webrtc
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // CHANNEL_HANDLE_H
@@ -0,0 +1,37 @@
+#ifndef CHANNEL_PRIORITY_H
+#define CHANNEL_PRIORITY_H
+
+#include <cstddef>
+
+namespace autodev {
+namespace remote {
+namespace webrtc {
+
+// Priority class of a DataChannel or of the outgoing video, highest last.
+// Maps 1:1 to the RTCPriorityType of WebRTC (RFC 8831/8837): libwebrtc uses
+// it for the SCTP stream scheduler and, with DSCP marking enabled, for the
+// DSCP code point of the packets (VeryLow CS1, Low DF, Medium AF42/AF41,
+// High EF/AF41 for data/video).
+enum class ChannelPriority { VeryLow = 0, Low, Medium, High };
+
+constexpr size_t kChannelPriorityCount = 4;
+
+inline const char* ChannelPriorityName(ChannelPriority priority) {
+  switch (priority) {
+    case ChannelPriority::VeryLow:
+      return "very-low";
+    case ChannelPriority::Low:
+      return "low";
+    case ChannelPriority::Medium:
+      return "medium";
+    case ChannelPriority::High:
+      return "high";
+  }
+  return "unknown";
+}
+
+}  // namespace webrtc
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // CHANNEL_PRIORITY_H
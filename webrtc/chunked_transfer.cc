@@ -0,0 +1,869 @@
+#include "webrtc/chunked_transfer.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include "metrics/static_metrics.h"
+
+namespace autodev {
+namespace remote {
+namespace webrtc {
+
+namespace {
+
+using DataChannelMessage = std::vector<char>;
+
+// --- CRC-32 tables ---
+
+struct Crc32Tables {
+  uint32_t t[8][256];
+};
+
+constexpr Crc32Tables MakeCrc32Tables() {
+  Crc32Tables tables{};
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+    }
+    tables.t[0][i] = crc;
+  }
+  // t[k][i]: the CRC of byte i followed by k zero bytes.
+  for (uint32_t i = 0; i < 256; ++i) {
+    for (int k = 1; k < 8; ++k) {
+      const uint32_t prev = tables.t[k - 1][i];
+      tables.t[k][i] = (prev >> 8) ^ tables.t[0][prev & 0xFF];
+    }
+  }
+  return tables;
+}
+
+constexpr Crc32Tables kCrc32Tables = MakeCrc32Tables();
+
+// --- Frame encoding ---
+
+void AppendU8(DataChannelMessage& out, uint8_t value) {
+  out.push_back(static_cast<char>(value));
+}
+
+void AppendU16(DataChannelMessage& out, uint16_t value) {
+  for (int i = 0; i < 2; ++i) out.push_back(static_cast<char>(value >> 8 * i));
+}
+
+void AppendU32(DataChannelMessage& out, uint32_t value) {
+  for (int i = 0; i < 4; ++i) out.push_back(static_cast<char>(value >> 8 * i));
+}
+
+void AppendU64(DataChannelMessage& out, uint64_t value) {
+  for (int i = 0; i < 8; ++i) out.push_back(static_cast<char>(value >> 8 * i));
+}
+
+DataChannelMessage MakeFrame(TransferFrameType type, uint32_t id,
+                             size_t body_size) {
+  DataChannelMessage frame;
+  frame.reserve(kTransferFrameHeaderSize + body_size);
+  frame.push_back(kTransferFrameMagic);
+  frame.push_back('T');
+  AppendU8(frame, kTransferFrameVersion);
+  AppendU8(frame, static_cast<uint8_t>(type));
+  AppendU32(frame, id);
+  return frame;
+}
+
+// Accept, Ack and Nack: an offset.
+DataChannelMessage MakeOffsetFrame(TransferFrameType type, uint32_t id,
+                                   uint64_t offset) {
+  DataChannelMessage frame = MakeFrame(type, id, 8);
+  AppendU64(frame, offset);
+  return frame;
+}
+
+DataChannelMessage MakeCompleteFrame(uint32_t id, TransferStatus status) {
+  DataChannelMessage frame = MakeFrame(TransferFrameType::Complete, id, 1);
+  AppendU8(frame, static_cast<uint8_t>(status));
+  return frame;
+}
+
+// Reads little endian integers from a frame's body; every read fails once
+// the body is too short.
+class FrameReader {
+ public:
+  FrameReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  bool readU8(uint8_t& value) { return read(value, 1); }
+  bool readU16(uint16_t& value) { return read(value, 2); }
+  bool readU32(uint32_t& value) { return read(value, 4); }
+  bool readU64(uint64_t& value) { return read(value, 8); }
+
+  const char* current() const { return data_ + offset_; }
+  size_t remaining() const { return size_ - offset_; }
+
+ private:
+  template <typename T>
+  bool read(T& value, size_t size) {
+    if (remaining() < size) return false;
+    value = 0;
+    for (size_t i = 0; i < size; ++i) {
+      value |= static_cast<T>(static_cast<uint8_t>(data_[offset_ + i]))
+               << 8 * i;
+    }
+    offset_ += size;
+    return true;
+  }
+
+  const char* data_;
+  size_t size_;
+  size_t offset_ = 0;
+};
+
+bool ParseHeader(const DataChannelMessage& frame, TransferFrameType& type,
+                 uint32_t& id) {
+  if (!IsTransferFrame(frame.data(), frame.size())) return false;
+  type = static_cast<TransferFrameType>(static_cast<uint8_t>(frame[3]));
+  FrameReader reader(frame.data() + 4, 4);
+  return reader.readU32(id);
+}
+
+std::string BaseName(const std::string& path) {
+  const size_t slash = path.find_last_of('/');
+  return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+// A plain file name: nothing that could leave the receiver's directory.
+bool IsSafeFileName(const std::string& name) {
+  return !name.empty() && name.size() <= kTransferMaxNameSize &&
+         name != "." && name != ".." &&
+         name.find('/') == std::string::npos &&
+         name.find('\0') == std::string::npos;
+}
+
+}  // namespace
+
+const char* TransferStatusName(TransferStatus status) {
+  switch (status) {
+    case TransferStatus::Ok:
+      return "ok";
+    case TransferStatus::ChecksumMismatch:
+      return "checksum mismatch";
+    case TransferStatus::Refused:
+      return "refused";
+    case TransferStatus::IoError:
+      return "I/O error";
+    case TransferStatus::Timeout:
+      return "timeout";
+    case TransferStatus::PeerGone:
+      return "peer gone";
+    case TransferStatus::Cancelled:
+      return "cancelled";
+  }
+  return "unknown";
+}
+
+bool IsTransferFrame(const char* data, size_t size) {
+  return size >= kTransferFrameHeaderSize && data[0] == kTransferFrameMagic &&
+         data[1] == 'T' &&
+         static_cast<uint8_t>(data[2]) == kTransferFrameVersion;
+}
+
+uint32_t Crc32(const void* data, size_t size, uint32_t crc) {
+  const auto* p = static_cast<const uint8_t*>(data);
+  const auto& t = kCrc32Tables.t;
+  crc = ~crc;
+  while (size >= 8) {
+    const uint32_t low = crc ^ (static_cast<uint32_t>(p[0]) |
+                                static_cast<uint32_t>(p[1]) << 8 |
+                                static_cast<uint32_t>(p[2]) << 16 |
+                                static_cast<uint32_t>(p[3]) << 24);
+    crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^
+          t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^ t[3][p[4]] ^
+          t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+    p += 8;
+    size -= 8;
+  }
+  while (size-- > 0) crc = t[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+// --- ChunkedTransferSender ---
+
+ChunkedTransferSender::ChunkedTransferSender(Config config,
+                                             TrySendFunction try_send)
+    : config_(std::move(config)), trySend_(std::move(try_send)) {}
+
+ChunkedTransferSender::~ChunkedTransferSender() { stop(); }
+
+void ChunkedTransferSender::start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (running_) return;
+  running_ = true;
+  thread_ = std::thread(&ChunkedTransferSender::threadMain, this);
+}
+
+void ChunkedTransferSender::stop() {
+  std::deque<Transfer> cancelled;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) return;
+    running_ = false;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) thread_.join();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancelled.swap(transfers_);
+  }
+  for (Transfer& transfer : cancelled) {
+    if (!transfer.done) {
+      transfer.done = true;
+      transfer.status = TransferStatus::Cancelled;
+    }
+    Report(transfer);
+  }
+}
+
+uint32_t ChunkedTransferSender::sendFile(const std::string& peer_id,
+                                         const std::string& path,
+                                         CompletionHandler on_complete,
+                                         const std::string& name) {
+  const std::string file_name = name.empty() ? BaseName(path) : name;
+  if (!IsSafeFileName(file_name)) {
+    std::cerr << "ChunkedTransferSender: Invalid file name '" << file_name
+              << "'." << std::endl;
+    return 0;
+  }
+  // Mapped without the lock: opening may wait on the disk.
+  auto file = std::make_unique<ipc::MappedFile>();
+  if (!file->open(path)) return 0;
+
+  uint32_t id;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      std::cerr << "ChunkedTransferSender: Not running; " << path
+                << " not sent." << std::endl;
+      return 0;
+    }
+    id = nextTransferId_++;
+    if (nextTransferId_ == 0) nextTransferId_ = 1;  // 0: no transfer
+
+    Transfer transfer;
+    transfer.id = id;
+    transfer.peer_id = peer_id;
+    transfer.name = file_name;
+    transfer.file = std::move(file);
+    transfer.on_complete = std::move(on_complete);
+    transfers_.push_back(std::move(transfer));
+    ++events_;
+  }
+  cv_.notify_all();
+  std::cout << "ChunkedTransferSender: Queued transfer " << id << " of "
+            << path << " to peer " << peer_id << "." << std::endl;
+  return id;
+}
+
+void ChunkedTransferSender::handleFrame(const std::string& peer_id,
+                                        const DataChannelMessage& frame) {
+  TransferFrameType type;
+  uint32_t id;
+  if (!ParseHeader(frame, type, id)) {
+    std::cerr << "ChunkedTransferSender: Malformed frame from peer "
+              << peer_id << "." << std::endl;
+    return;
+  }
+  FrameReader reader(frame.data() + kTransferFrameHeaderSize,
+                     frame.size() - kTransferFrameHeaderSize);
+  uint64_t offset = 0;
+  uint8_t status = 0;
+  const bool has_offset = reader.readU64(offset);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = std::find_if(transfers_.begin(), transfers_.end(),
+                         [&](const Transfer& transfer) {
+                           return transfer.id == id &&
+                                  transfer.peer_id == peer_id &&
+                                  !transfer.done;
+                         });
+  if (it == transfers_.end()) return;  // Ended already
+  Transfer& transfer = *it;
+  const uint64_t size = transfer.file->size();
+
+  switch (type) {
+    case TransferFrameType::Accept:
+      if (!has_offset || transfer.phase != Phase::Offering) return;
+      transfer.next_offset = std::min(offset, size);
+      transfer.acked_offset = transfer.next_offset;
+      transfer.released_offset = transfer.next_offset;
+      transfer.phase = Phase::Sending;
+      if (offset > 0) {
+        std::cout << "ChunkedTransferSender: Transfer " << id
+                  << " resumes at " << transfer.next_offset << " of " << size
+                  << " bytes." << std::endl;
+      }
+      break;
+    case TransferFrameType::Ack:
+      if (!has_offset || transfer.phase == Phase::Offering) return;
+      // Acks only move forward; chunks in flight stay sent.
+      transfer.acked_offset =
+          std::max(transfer.acked_offset, std::min(offset, size));
+      transfer.next_offset =
+          std::max(transfer.next_offset, transfer.acked_offset);
+      break;
+    case TransferFrameType::Nack:
+      if (!has_offset || transfer.phase == Phase::Offering) return;
+      // Resend from there (everything before it was received).
+      transfer.acked_offset = std::min(offset, size);
+      transfer.next_offset = transfer.acked_offset;
+      transfer.phase = Phase::Sending;
+      ++transfer.rewinds;
+      break;
+    case TransferFrameType::Complete:
+      // The status byte is where the offset would be.
+      reader = FrameReader(frame.data() + kTransferFrameHeaderSize,
+                           frame.size() - kTransferFrameHeaderSize);
+      if (!reader.readU8(status)) return;
+      finishLocked(transfer, static_cast<TransferStatus>(status));
+      break;
+    default:
+      return;  // Not sent by receivers
+  }
+  transfer.last_response = Clock::now();
+  ++events_;
+  cv_.notify_all();
+}
+
+void ChunkedTransferSender::notifyWritable(const std::string& peer_id) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (transfers_.empty() || transfers_.front().peer_id != peer_id) return;
+    ++events_;
+  }
+  cv_.notify_all();
+}
+
+void ChunkedTransferSender::removePeer(const std::string& peer_id) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Transfer& transfer : transfers_) {
+      if (transfer.peer_id == peer_id && !transfer.done) {
+        finishLocked(transfer, TransferStatus::PeerGone);
+      }
+    }
+    ++events_;
+  }
+  cv_.notify_all();
+}
+
+void ChunkedTransferSender::threadMain() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_) {
+    if (transfers_.empty()) {
+      cv_.wait(lock, [this] { return !running_ || !transfers_.empty(); });
+      continue;
+    }
+    if (transfers_.front().done) {
+      Transfer ended = std::move(transfers_.front());
+      transfers_.pop_front();
+      lock.unlock();
+      Report(ended);
+      lock.lock();
+      continue;
+    }
+    const uint64_t seen = events_;
+    const Clock::duration wait = stepLocked(lock);
+    if (wait > Clock::duration::zero()) {
+      cv_.wait_for(lock, wait,
+                   [this, seen] { return !running_ || events_ != seen; });
+    }
+  }
+}
+
+ChunkedTransferSender::Clock::duration ChunkedTransferSender::stepLocked(
+    std::unique_lock<std::mutex>& lock) {
+  // Only this thread removes transfers, so the reference stays valid while
+  // the lock is released; anything else may have ended it meanwhile.
+  Transfer& transfer = transfers_.front();
+  const ipc::MappedFile& file = *transfer.file;
+
+  switch (transfer.phase) {
+    case Phase::Checksumming: {
+      lock.unlock();
+      const uint32_t crc = Crc32(file.data(), file.size());
+      // Read again by the chunks, from the start or where the receiver
+      // resumes: keep only what the readahead maps anyway.
+      file.release(0, file.size());
+      lock.lock();
+      transfer.crc = crc;
+      if (!transfer.done) transfer.phase = Phase::Offering;
+      return Clock::duration::zero();
+    }
+
+    case Phase::Offering: {
+      if (transfer.offer_sent) return awaitResponseLocked(transfer);
+      const uint16_t name_size = static_cast<uint16_t>(transfer.name.size());
+      DataChannelMessage frame =
+          MakeFrame(TransferFrameType::Offer, transfer.id, 14 + name_size);
+      AppendU64(frame, file.size());
+      AppendU32(frame, transfer.crc);
+      AppendU16(frame, name_size);
+      frame.insert(frame.end(), transfer.name.begin(), transfer.name.end());
+      const std::string peer_id = transfer.peer_id;
+      lock.unlock();
+      const bool sent = trySend_(peer_id, frame);
+      lock.lock();
+      if (transfer.done) return Clock::duration::zero();
+      if (!sent) return config_.retry_interval;
+      transfer.offer_sent = true;
+      transfer.last_response = Clock::now();
+      return Clock::duration::zero();
+    }
+
+    case Phase::Sending: {
+      // Pages the receiver has are not read again.
+      if (transfer.acked_offset > transfer.released_offset) {
+        file.release(transfer.released_offset,
+                     transfer.acked_offset - transfer.released_offset);
+        transfer.released_offset = transfer.acked_offset;
+      }
+      if (transfer.next_offset >= file.size()) {
+        transfer.phase = Phase::Finishing;
+        return Clock::duration::zero();
+      }
+      if (transfer.next_offset - transfer.acked_offset >=
+          config_.window_bytes) {
+        return awaitResponseLocked(transfer);
+      }
+
+      const uint64_t offset = transfer.next_offset;
+      const size_t size = static_cast<size_t>(
+          std::min<uint64_t>(config_.chunk_bytes, file.size() - offset));
+      const char* data = file.data() + offset;
+      const uint32_t id = transfer.id;
+      const std::string peer_id = transfer.peer_id;
+      const uint64_t rewinds = transfer.rewinds;
+      lock.unlock();
+      // Reading the mapping may wait on the disk: without the lock.
+      DataChannelMessage frame =
+          MakeFrame(TransferFrameType::Chunk, id, 12 + size);
+      AppendU64(frame, offset);
+      AppendU32(frame, Crc32(data, size));
+      frame.insert(frame.end(), data, data + size);
+      const bool sent = trySend_(peer_id, frame);
+      lock.lock();
+      if (transfer.done) return Clock::duration::zero();
+      if (!sent) {
+        // Full: wait for notifyWritable() (or retry). A link that stays
+        // full times out like a silent receiver.
+        const Clock::duration left = awaitResponseLocked(transfer);
+        return std::min<Clock::duration>(left, config_.retry_interval);
+      }
+      metrics::Increment(metrics::CounterId::file_transfer_bytes_sent_total,
+                         size);
+      // Unless a Nack rewound the transfer meanwhile (possibly to this very
+      // chunk).
+      if (transfer.rewinds == rewinds) transfer.next_offset = offset + size;
+      return Clock::duration::zero();
+    }
+
+    case Phase::Finishing:
+      return awaitResponseLocked(transfer);
+  }
+  return Clock::duration::zero();
+}
+
+ChunkedTransferSender::Clock::duration
+ChunkedTransferSender::awaitResponseLocked(Transfer& transfer) {
+  const Clock::time_point deadline =
+      transfer.last_response + config_.response_timeout;
+  const Clock::time_point now = Clock::now();
+  if (now < deadline) return deadline - now;
+  finishLocked(transfer, TransferStatus::Timeout);
+  return Clock::duration::zero();
+}
+
+void ChunkedTransferSender::finishLocked(Transfer& transfer,
+                                         TransferStatus status) {
+  transfer.done = true;
+  transfer.status = status;
+  ++events_;
+}
+
+void ChunkedTransferSender::Report(const Transfer& transfer) {
+  if (transfer.status == TransferStatus::Ok) {
+    metrics::Increment(metrics::CounterId::file_transfers_completed_total);
+    std::cout << "ChunkedTransferSender: Transfer " << transfer.id << " ("
+              << transfer.name << ", " << transfer.file->size()
+              << " bytes) to peer " << transfer.peer_id << " complete."
+              << std::endl;
+  } else {
+    metrics::Increment(metrics::CounterId::file_transfers_failed_total);
+    std::cerr << "ChunkedTransferSender: Transfer " << transfer.id << " ("
+              << transfer.name << ") to peer " << transfer.peer_id
+              << " failed: " << TransferStatusName(transfer.status) << "."
+              << std::endl;
+  }
+  if (transfer.on_complete) transfer.on_complete(transfer.id, transfer.status);
+}
+
+// --- ChunkedTransferReceiver ---
+
+ChunkedTransferReceiver::ChunkedTransferReceiver(Config config,
+                                                 SendFunction send,
+                                                 CompletionHandler on_complete)
+    : config_(std::move(config)),
+      send_(std::move(send)),
+      onComplete_(std::move(on_complete)) {}
+
+ChunkedTransferReceiver::~ChunkedTransferReceiver() { stop(); }
+
+void ChunkedTransferReceiver::start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (running_) return;
+  running_ = true;
+  thread_ = std::thread(&ChunkedTransferReceiver::threadMain, this);
+}
+
+void ChunkedTransferReceiver::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) return;
+    running_ = false;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) thread_.join();
+  std::lock_guard<std::mutex> lock(mutex_);
+  incoming_.clear();
+  incomingBytes_ = 0;
+}
+
+void ChunkedTransferReceiver::handleFrame(const std::string& peer_id,
+                                          const DataChannelMessage& frame) {
+  if (frame.empty()) return;  // Reserved for removePeer()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) return;
+    if (incomingBytes_ + frame.size() > config_.max_queued_bytes) {
+      // The receiver notices the gap and asks for a resend (Nack).
+      std::cerr << "ChunkedTransferReceiver: Queue full, frame from peer "
+                << peer_id << " dropped." << std::endl;
+      return;
+    }
+    incomingBytes_ += frame.size();
+    incoming_.push_back(Incoming{peer_id, frame});
+  }
+  cv_.notify_one();
+}
+
+void ChunkedTransferReceiver::removePeer(const std::string& peer_id) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) return;
+    incoming_.push_back(Incoming{peer_id, {}});
+  }
+  cv_.notify_one();
+}
+
+void ChunkedTransferReceiver::threadMain() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this] { return !running_ || !incoming_.empty(); });
+    if (!running_) break;
+    Incoming item = std::move(incoming_.front());
+    incoming_.pop_front();
+    incomingBytes_ -= item.frame.size();
+    lock.unlock();
+    if (item.frame.empty()) {
+      closePeer(item.peer_id);
+    } else {
+      processFrame(item.peer_id, item.frame);
+    }
+    lock.lock();
+  }
+  lock.unlock();
+
+  // Partial files stay on disk, to be resumed.
+  for (auto& entry : files_) ::close(entry.second.fd);
+  files_.clear();
+  activeTransfers_.store(0, std::memory_order_relaxed);
+}
+
+void ChunkedTransferReceiver::processFrame(const std::string& peer_id,
+                                           const DataChannelMessage& frame) {
+  TransferFrameType type;
+  uint32_t id;
+  if (!ParseHeader(frame, type, id)) {
+    std::cerr << "ChunkedTransferReceiver: Malformed frame from peer "
+              << peer_id << "." << std::endl;
+    return;
+  }
+  const char* body = frame.data() + kTransferFrameHeaderSize;
+  const size_t body_size = frame.size() - kTransferFrameHeaderSize;
+  switch (type) {
+    case TransferFrameType::Offer:
+      handleOffer(peer_id, id, body, body_size);
+      break;
+    case TransferFrameType::Chunk:
+      handleChunk(peer_id, id, body, body_size);
+      break;
+    default:
+      break;  // Not sent by senders
+  }
+}
+
+void ChunkedTransferReceiver::handleOffer(const std::string& peer_id,
+                                          uint32_t id, const char* data,
+                                          size_t size) {
+  FrameReader reader(data, size);
+  uint64_t file_size;
+  uint32_t crc;
+  uint16_t name_size;
+  if (!reader.readU64(file_size) || !reader.readU32(crc) ||
+      !reader.readU16(name_size) || reader.remaining() != name_size) {
+    std::cerr << "ChunkedTransferReceiver: Malformed offer from peer "
+              << peer_id << "." << std::endl;
+    return;
+  }
+  const std::string name(reader.current(), name_size);
+  const FileKey key(peer_id, id);
+
+  auto existing = files_.find(key);
+  if (existing != files_.end()) {
+    // The offer was sent again: answer the same.
+    sendFrame(peer_id, MakeOffsetFrame(TransferFrameType::Accept, id,
+                                       existing->second.received));
+    return;
+  }
+
+  TransferStatus refusal = TransferStatus::Ok;
+  if (!IsSafeFileName(name)) {
+    std::cerr << "ChunkedTransferReceiver: Refused file name '" << name
+              << "' from peer " << peer_id << "." << std::endl;
+    refusal = TransferStatus::Refused;
+  } else if (file_size > config_.max_file_bytes) {
+    std::cerr << "ChunkedTransferReceiver: Refused " << name << " from peer "
+              << peer_id << ": " << file_size << " bytes is over the limit."
+              << std::endl;
+    refusal = TransferStatus::Refused;
+  }
+
+  PartialFile file;
+  file.name = name;
+  file.size = file_size;
+  file.expected_crc = crc;
+  if (refusal == TransferStatus::Ok) {
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), ".%08x-", crc);
+    file.part_path = config_.directory + "/" + name + suffix +
+                     std::to_string(file_size) + ".part";
+    file.fd = ::open(file.part_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC,
+                     0644);
+    struct stat st;
+    if (file.fd < 0 || ::fstat(file.fd, &st) != 0) {
+      std::cerr << "ChunkedTransferReceiver: Failed to open "
+                << file.part_path << ": " << std::strerror(errno)
+                << std::endl;
+      refusal = TransferStatus::IoError;
+    } else {
+      file.received = static_cast<uint64_t>(st.st_size);
+    }
+  }
+  if (refusal != TransferStatus::Ok) {
+    if (file.fd >= 0) ::close(file.fd);
+    sendFrame(peer_id, MakeCompleteFrame(id, refusal));
+    metrics::Increment(metrics::CounterId::file_transfers_failed_total);
+    if (onComplete_) onComplete_(peer_id, name, refusal);
+    return;
+  }
+
+  // Resuming: the CRC continues from what the partial file holds.
+  if (file.received > file.size) file.received = 0;
+  if (file.received > 0) {
+    ipc::MappedFile part;
+    if (part.open(file.part_path) && part.size() >= file.received) {
+      file.crc = Crc32(part.data(), file.received);
+    } else {
+      file.received = 0;
+    }
+  }
+  if (file.received == 0 && ::ftruncate(file.fd, 0) != 0) {
+    std::cerr << "ChunkedTransferReceiver: Failed to truncate "
+              << file.part_path << ": " << std::strerror(errno) << std::endl;
+  }
+
+  std::cout << "ChunkedTransferReceiver: Receiving " << name << " ("
+            << file_size << " bytes) from peer " << peer_id;
+  if (file.received > 0) std::cout << ", resuming at " << file.received;
+  std::cout << "." << std::endl;
+
+  const uint64_t received = file.received;
+  auto it = files_.emplace(key, std::move(file)).first;
+  activeTransfers_.fetch_add(1, std::memory_order_relaxed);
+  sendFrame(peer_id,
+            MakeOffsetFrame(TransferFrameType::Accept, id, received));
+  if (it->second.received == it->second.size) finishFile(it);
+}
+
+void ChunkedTransferReceiver::handleChunk(const std::string& peer_id,
+                                          uint32_t id, const char* data,
+                                          size_t size) {
+  auto it = files_.find(FileKey(peer_id, id));
+  if (it == files_.end()) return;  // Ended (or never accepted)
+  PartialFile& file = it->second;
+
+  FrameReader reader(data, size);
+  uint64_t offset;
+  uint32_t crc;
+  if (!reader.readU64(offset) || !reader.readU32(crc)) {
+    std::cerr << "ChunkedTransferReceiver: Malformed chunk from peer "
+              << peer_id << "." << std::endl;
+    return;
+  }
+  const char* chunk = reader.current();
+  const size_t chunk_size = reader.remaining();
+
+  if (offset != file.received) {
+    // Before it: a resend of what was written. After it: a chunk was lost
+    // or corrupted; the sender rewinds once asked.
+    if (offset > file.received && !file.nack_sent) {
+      sendFrame(peer_id,
+                MakeOffsetFrame(TransferFrameType::Nack, id, file.received));
+      file.nack_sent = true;
+    }
+    return;
+  }
+  if (chunk_size == 0 || chunk_size > file.size - file.received) {
+    std::cerr << "ChunkedTransferReceiver: Chunk of " << chunk_size
+              << " bytes at " << offset << " does not fit " << file.name
+              << "." << std::endl;
+    return;
+  }
+  if (Crc32(chunk, chunk_size) != crc) {
+    metrics::Increment(
+        metrics::CounterId::file_transfer_checksum_failures_total);
+    std::cerr << "ChunkedTransferReceiver: Chunk at " << offset << " of "
+              << file.name << " failed its CRC." << std::endl;
+    if (!file.nack_sent) {
+      sendFrame(peer_id,
+                MakeOffsetFrame(TransferFrameType::Nack, id, file.received));
+      file.nack_sent = true;
+    }
+    return;
+  }
+
+  size_t written = 0;
+  while (written < chunk_size) {
+    const ssize_t result =
+        ::pwrite(file.fd, chunk + written, chunk_size - written,
+                 static_cast<off_t>(offset + written));
+    if (result < 0 && errno == EINTR) continue;
+    if (result <= 0) {
+      std::cerr << "ChunkedTransferReceiver: Failed to write "
+                << file.part_path << ": " << std::strerror(errno)
+                << std::endl;
+      // Keep the part consistent with what was acknowledged.
+      if (::ftruncate(file.fd, static_cast<off_t>(file.received)) != 0) {
+        ::unlink(file.part_path.c_str());
+      }
+      endFile(it, TransferStatus::IoError);
+      return;
+    }
+    written += static_cast<size_t>(result);
+  }
+  file.nack_sent = false;
+  file.received += chunk_size;
+  file.crc = Crc32(chunk, chunk_size, file.crc);
+  file.unacked += chunk_size;
+  metrics::Increment(metrics::CounterId::file_transfer_bytes_received_total,
+                     chunk_size);
+
+  if (file.received == file.size) {
+    finishFile(it);
+  } else if (file.unacked >= config_.ack_interval_bytes) {
+    sendFrame(peer_id,
+              MakeOffsetFrame(TransferFrameType::Ack, id, file.received));
+    file.unacked = 0;
+  }
+}
+
+void ChunkedTransferReceiver::finishFile(
+    std::map<FileKey, PartialFile>::iterator it) {
+  PartialFile& file = it->second;
+  if (file.crc != file.expected_crc) {
+    metrics::Increment(
+        metrics::CounterId::file_transfer_checksum_failures_total);
+    std::cerr << "ChunkedTransferReceiver: " << file.name
+              << " failed its CRC; discarded." << std::endl;
+    ::unlink(file.part_path.c_str());  // Nothing in it is worth resuming
+    endFile(it, TransferStatus::ChecksumMismatch);
+    return;
+  }
+  const std::string path = config_.directory + "/" + file.name;
+  if (::fdatasync(file.fd) != 0 ||
+      ::rename(file.part_path.c_str(), path.c_str()) != 0) {
+    std::cerr << "ChunkedTransferReceiver: Failed to store " << path << ": "
+              << std::strerror(errno) << std::endl;
+    endFile(it, TransferStatus::IoError);
+    return;
+  }
+  ::close(file.fd);
+
+  const std::string peer_id = it->first.first;
+  const uint32_t id = it->first.second;
+  files_.erase(it);
+  activeTransfers_.fetch_sub(1, std::memory_order_relaxed);
+
+  sendFrame(peer_id, MakeCompleteFrame(id, TransferStatus::Ok));
+  metrics::Increment(metrics::CounterId::file_transfers_completed_total);
+  std::cout << "ChunkedTransferReceiver: Received " << path << " from peer "
+            << peer_id << "." << std::endl;
+  if (onComplete_) onComplete_(peer_id, path, TransferStatus::Ok);
+}
+
+void ChunkedTransferReceiver::endFile(
+    std::map<FileKey, PartialFile>::iterator it, TransferStatus status) {
+  const std::string peer_id = it->first.first;
+  const uint32_t id = it->first.second;
+  const std::string name = it->second.name;
+  ::close(it->second.fd);
+  files_.erase(it);
+  activeTransfers_.fetch_sub(1, std::memory_order_relaxed);
+
+  sendFrame(peer_id, MakeCompleteFrame(id, status));
+  metrics::Increment(metrics::CounterId::file_transfers_failed_total);
+  if (onComplete_) onComplete_(peer_id, name, status);
+}
+
+void ChunkedTransferReceiver::closePeer(const std::string& peer_id) {
+  for (auto it = files_.begin(); it != files_.end();) {
+    if (it->first.first != peer_id) {
+      ++it;
+      continue;
+    }
+    std::cout << "ChunkedTransferReceiver: Peer " << peer_id
+              << " gone; keeping " << it->second.received << " of "
+              << it->second.size << " bytes of " << it->second.name
+              << " to resume." << std::endl;
+    ::close(it->second.fd);
+    it = files_.erase(it);
+    activeTransfers_.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+void ChunkedTransferReceiver::sendFrame(const std::string& peer_id,
+                                        const DataChannelMessage& frame) {
+  if (!send_(peer_id, frame)) {
+    // The sender times out or resends (Offer) if it matters.
+    std::cerr << "ChunkedTransferReceiver: Failed to answer peer " << peer_id
+              << "." << std::endl;
+  }
+}
+
+}  // namespace webrtc
+}  // namespace remote
+}  // namespace autodev
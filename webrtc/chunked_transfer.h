@@ -0,0 +1,317 @@
+#ifndef CHUNKED_TRANSFER_H
+#define CHUNKED_TRANSFER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ipc/mapped_file.h"
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace webrtc {
+
+// --- Transfer format ---
+//
+// Large payloads (map tiles, log bundles, calibration files) go over a
+// dedicated low priority DataChannel in bounded chunks: SCTP sends a message
+// whole, so a control message then waits for at most one chunk on the link
+// instead of the whole payload. Every message of the channel is one frame
+// (integers little endian):
+//
+//   byte 0     kTransferFrameMagic (0x00)
+//   byte 1     'T'
+//   byte 2     kTransferFrameVersion
+//   byte 3     TransferFrameType
+//   bytes 4-7  transfer id (uint32, chosen by the sender)
+//   then, by type:
+//   Offer      uint64 size, uint32 CRC-32 of the file, uint16 name length,
+//              name (a plain file name)
+//   Accept     uint64 offset to start from (> 0: resumed)
+//   Chunk      uint64 offset, uint32 CRC-32 of the data, data
+//   Ack        uint64 bytes received and verified, from the start
+//   Nack       uint64 offset to resend from (a chunk failed its CRC)
+//   Complete   uint8 TransferStatus
+//
+// The receiver answers an Offer with Accept (or Complete to refuse it),
+// acknowledges chunks as it writes them and ends with Complete once the
+// file's CRC matched. The sender keeps at most window_bytes unacknowledged.
+// The receiver keeps a partial file (by name, size and CRC), so offering
+// the same file again, e.g. after a reconnection, resumes where it ended.
+
+constexpr char kTransferFrameMagic = 0x00;
+constexpr uint8_t kTransferFrameVersion = 1;
+constexpr size_t kTransferFrameHeaderSize = 8;
+constexpr size_t kTransferMaxNameSize = 255;
+
+enum class TransferFrameType : uint8_t {
+  Offer = 1,
+  Accept = 2,
+  Chunk = 3,
+  Ack = 4,
+  Nack = 5,
+  Complete = 6,
+};
+
+// How a transfer ended. The first four travel in Complete frames; the others
+// are only reported locally by the sender.
+enum class TransferStatus : uint8_t {
+  Ok = 0,
+  ChecksumMismatch = 1,  // The received file's CRC did not match
+  Refused = 2,           // Bad name, too large, or no receiver
+  IoError = 3,           // The receiver could not write the file
+  Timeout = 4,           // No answer from the receiver in time
+  PeerGone = 5,          // Disconnected; sending the file again resumes it
+  Cancelled = 6,         // The sender was stopped
+};
+
+const char* TransferStatusName(TransferStatus status);
+
+// True if the message is a transfer frame (of a supported version).
+bool IsTransferFrame(const char* data, size_t size);
+
+// CRC-32 (IEEE 802.3, the CRC of zlib and gzip) of [data, data + size),
+// continuing from crc: Crc32(b, n, Crc32(a, m)) is the CRC of a then b.
+// Table driven, 8 bytes per step (slicing-by-8).
+uint32_t Crc32(const void* data, size_t size, uint32_t crc = 0);
+
+// Streams files to peers, one transfer at a time, from the sender's thread.
+// Files are mapped (ipc::MappedFile) and sent in place: the only copy is
+// the chunk frame handed to the DataChannel. Sends fail fast when the
+// channel's buffer is full (see TrySendFunction) and are retried when the
+// channel drains, so the transfer never queues more than its buffer limit
+// in front of other traffic.
+class ChunkedTransferSender {
+ public:
+  using DataChannelMessage = std::vector<char>;
+
+  // Sends one frame on the transfer channel, unless its buffer is over a
+  // limit (e.g., IWebrtcManager::trySendDataChannelMessage); false: not
+  // sent, retried later. Called from the sender's thread, without its lock.
+  using TrySendFunction = std::function<bool(const std::string& peer_id,
+                                             const DataChannelMessage& frame)>;
+  // Called once per transfer from the sender's thread (or stop()).
+  using CompletionHandler =
+      std::function<void(uint32_t transfer_id, TransferStatus status)>;
+
+  struct Config {
+    // Payload bytes per chunk.
+    size_t chunk_bytes = 16 * 1024;
+    // Bytes sent and not yet acknowledged by the receiver.
+    uint64_t window_bytes = 256 * 1024;
+    // Retry interval while the channel's buffer is full, in case no
+    // notifyWritable() comes.
+    std::chrono::milliseconds retry_interval{10};
+    // A transfer fails (Timeout) without an answer from the receiver for
+    // this long while it waits for one.
+    std::chrono::milliseconds response_timeout{10000};
+  };
+
+  ChunkedTransferSender(Config config, TrySendFunction try_send);
+  ~ChunkedTransferSender();
+
+  // Starts/stops the sending thread. stop() ends the queued transfers
+  // (Cancelled); the receiver keeps what it got.
+  void start();
+  void stop();
+
+  // Maps the file and queues its transfer to the peer, as 'name' (the
+  // file's base name if empty). Returns the transfer id, or 0 if the file
+  // cannot be mapped or the sender is not running. MUST BE THREAD-SAFE.
+  uint32_t sendFile(const std::string& peer_id, const std::string& path,
+                    CompletionHandler on_complete,
+                    const std::string& name = "");
+
+  // A frame from the receiver (Accept, Ack, Nack, Complete). Parses it and
+  // wakes the thread; no I/O. MUST BE THREAD-SAFE.
+  void handleFrame(const std::string& peer_id, const DataChannelMessage& frame);
+
+  // The peer's transfer channel has room again (onBufferedAmountLow).
+  // MUST BE THREAD-SAFE.
+  void notifyWritable(const std::string& peer_id);
+
+  // Ends the peer's transfers (PeerGone). MUST BE THREAD-SAFE.
+  void removePeer(const std::string& peer_id);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  enum class Phase { Checksumming, Offering, Sending, Finishing };
+
+  struct Transfer {
+    uint32_t id = 0;
+    std::string peer_id;
+    std::string name;
+    std::unique_ptr<ipc::MappedFile> file;
+    CompletionHandler on_complete;
+    Phase phase = Phase::Checksumming;
+    uint32_t crc = 0;
+    bool offer_sent = false;
+    uint64_t next_offset = 0;   // Of the next chunk to send
+    uint64_t acked_offset = 0;  // Received and verified by the peer
+    uint64_t released_offset = 0;  // Pages unmapped up to here
+    uint64_t rewinds = 0;  // Nacks; a chunk sent meanwhile does not count
+    Clock::time_point last_response;  // Of the receiver (or the offer)
+    bool done = false;
+    TransferStatus status = TransferStatus::Ok;  // Once done
+  };
+
+  void threadMain();
+  // Advances the transfer at the front of the queue by one step (checksum,
+  // offer or chunk); returns how long to wait for an event before the next
+  // one. Called with the lock held; releases it around sends and
+  // checksumming.
+  Clock::duration stepLocked(std::unique_lock<std::mutex>& lock);
+  // Fails the transfer (Timeout) once the receiver did not answer for
+  // response_timeout; else returns the time left. mutex_ MUST be held.
+  Clock::duration awaitResponseLocked(Transfer& transfer);
+  // Marks a transfer done; the thread reports it. mutex_ MUST be held.
+  void finishLocked(Transfer& transfer, TransferStatus status);
+  // Logs and counts an ended transfer, and calls its handler. Called
+  // without the lock.
+  static void Report(const Transfer& transfer);
+
+  const Config config_;
+  const TrySendFunction trySend_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  // Front: the transfer in progress. Elements are only removed by the
+  // thread (deque references stay valid while others are appended).
+  std::deque<Transfer> transfers_;  // Guarded by mutex_
+  uint32_t nextTransferId_ = 1;     // Guarded by mutex_
+  // Incremented by everything the thread may wait for (frames,
+  // notifyWritable(), new or ended transfers), so none is missed while it
+  // sends without the lock. Guarded by mutex_.
+  uint64_t events_ = 0;
+  bool running_ = false;  // Guarded by mutex_
+  std::thread thread_;
+
+  // Prevent copying
+  ChunkedTransferSender(const ChunkedTransferSender&) = delete;
+  ChunkedTransferSender& operator=(const ChunkedTransferSender&) = delete;
+};
+
+// Receives files into a directory. Frames are handed to the receiver's
+// thread, which verifies and writes the chunks, so the caller (the WebRTC
+// network thread, which also delivers control messages) never waits on
+// the disk. Files are written as "<name>.<crc>-<size>.part" and renamed to
+// "<name>" once complete and verified.
+class ChunkedTransferReceiver {
+ public:
+  using DataChannelMessage = std::vector<char>;
+
+  // Sends one frame (Accept, Ack, Nack, Complete) back to the peer on the
+  // transfer channel. Called from the receiver's thread.
+  using SendFunction = std::function<bool(const std::string& peer_id,
+                                          const DataChannelMessage& frame)>;
+  // Called for every transfer that ends on the receiver's side (path: of
+  // the complete file, or the name offered). Receiver's thread.
+  using CompletionHandler =
+      std::function<void(const std::string& peer_id, const std::string& path,
+                         TransferStatus status)>;
+
+  struct Config {
+    std::string directory;                 // Must exist
+    uint64_t max_file_bytes = 4ULL << 30;  // Larger offers are refused
+    // An Ack is sent every this many bytes written; MUST be well below the
+    // sender's window_bytes.
+    uint64_t ack_interval_bytes = 64 * 1024;
+    // Frames waiting for the thread beyond this are dropped (the sender's
+    // window normally keeps far fewer in flight); the gap is resent.
+    size_t max_queued_bytes = 8 * 1024 * 1024;
+  };
+
+  ChunkedTransferReceiver(Config config, SendFunction send,
+                          CompletionHandler on_complete = nullptr);
+  ~ChunkedTransferReceiver();
+
+  // Starts/stops the writing thread. stop() closes the partial files; they
+  // are resumed when offered again.
+  void start();
+  void stop();
+
+  // Copies the frame to the receiver's thread. MUST BE THREAD-SAFE.
+  void handleFrame(const std::string& peer_id, const DataChannelMessage& frame);
+
+  // Closes the peer's partial files (kept for resuming).
+  // MUST BE THREAD-SAFE.
+  void removePeer(const std::string& peer_id);
+
+  // A transfer is in progress (accepted, not ended). One atomic load.
+  bool active() const {
+    return activeTransfers_.load(std::memory_order_relaxed) > 0;
+  }
+
+ private:
+  struct Incoming {
+    std::string peer_id;
+    DataChannelMessage frame;  // Empty: the peer was removed
+  };
+  struct PartialFile {
+    std::string name;
+    std::string part_path;
+    int fd = -1;
+    uint64_t size = 0;
+    uint32_t expected_crc = 0;
+    uint64_t received = 0;  // Contiguous bytes written
+    uint32_t crc = 0;       // Of the bytes received
+    uint64_t unacked = 0;   // Written since the last Ack
+    bool nack_sent = false;  // Waiting for the resend at 'received'
+  };
+  using FileKey = std::pair<std::string, uint32_t>;  // Peer, transfer id
+
+  void threadMain();
+  // Receiver's thread only, like files_.
+  void processFrame(const std::string& peer_id,
+                    const DataChannelMessage& frame);
+  void handleOffer(const std::string& peer_id, uint32_t id, const char* data,
+                   size_t size);
+  void handleChunk(const std::string& peer_id, uint32_t id, const char* data,
+                   size_t size);
+  // Verifies and renames a fully received file, answers Complete and forgets
+  // it.
+  void finishFile(std::map<FileKey, PartialFile>::iterator it);
+  // Ends a transfer without a file: answers Complete (status), reports it
+  // and forgets it; the partial file stays for resuming unless removed.
+  void endFile(std::map<FileKey, PartialFile>::iterator it,
+               TransferStatus status);
+  void closePeer(const std::string& peer_id);
+  void sendFrame(const std::string& peer_id, const DataChannelMessage& frame);
+
+  const Config config_;
+  const SendFunction send_;
+  const CompletionHandler onComplete_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Incoming> incoming_;  // Guarded by mutex_
+  size_t incomingBytes_ = 0;       // Guarded by mutex_
+  bool running_ = false;           // Guarded by mutex_
+  std::thread thread_;
+
+  std::map<FileKey, PartialFile> files_;  // Receiver's thread only
+  std::atomic<int> activeTransfers_{0};
+
+  // Prevent copying
+  ChunkedTransferReceiver(const ChunkedTransferReceiver&) = delete;
+  ChunkedTransferReceiver& operator=(const ChunkedTransferReceiver&) = delete;
+};
+
+}  // namespace webrtc
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // CHUNKED_TRANSFER_H
@@ -0,0 +1,41 @@
+#include "webrtc/data_channel_registry.h"
+
+namespace autodev {
+namespace remote {
+namespace webrtc {
+
+ChannelId DataChannelRegistry::add(DataChannelSpec spec) {
+  if (resolve(spec.label) != kUnknownChannelId) {
+    std::cerr << "DataChannelRegistry: DataChannel " << spec.label
+              << " declared twice." << std::endl;
+    return kUnknownChannelId;
+  }
+  if (specs_.size() >= kMaxDataChannels) {
+    std::cerr << "DataChannelRegistry: Too many DataChannels, " << spec.label
+              << " not declared (max " << kMaxDataChannels << ")."
+              << std::endl;
+    return kUnknownChannelId;
+  }
+  if (spec.reliability.max_retransmits >= 0 &&
+      spec.reliability.max_packet_lifetime_ms >= 0) {
+    std::cerr << "DataChannelRegistry: DataChannel " << spec.label
+              << " sets both max_retransmits and max_packet_lifetime_ms; "
+                 "using max_retransmits."
+              << std::endl;
+    spec.reliability.max_packet_lifetime_ms = -1;
+  }
+  specs_.push_back(std::move(spec));
+  return static_cast<ChannelId>(specs_.size() - 1);
+}
+
+// Linear: a handful of channels, and only called when a channel opens.
+ChannelId DataChannelRegistry::resolve(const std::string& label) const {
+  for (size_t i = 0; i < specs_.size(); ++i) {
+    if (specs_[i].label == label) return static_cast<ChannelId>(i);
+  }
+  return kUnknownChannelId;
+}
+
+}  // namespace webrtc
+}  // namespace remote
+}  // namespace autodev
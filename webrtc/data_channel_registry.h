@@ -0,0 +1,172 @@
+#ifndef DATA_CHANNEL_REGISTRY_H
+#define DATA_CHANNEL_REGISTRY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "metrics/static_metrics.h"
+#include "webrtc/channel_priority.h"
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace webrtc {
+
+using DataChannelMessage = std::vector<char>;
+
+// A received DataChannel message: the bytes of libwebrtc's receive buffer,
+// valid only for the duration of the call it is passed to. Handlers that
+// keep a message copy it (copy()).
+class DataChannelMessageView {
+ public:
+  DataChannelMessageView(const char* data, size_t size)
+      : data_(data), size_(size) {}
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  DataChannelMessage copy() const {
+    return DataChannelMessage(data_, data_ + size_);
+  }
+
+ private:
+  const char* data_;
+  size_t size_;
+};
+
+// Small integer id of a declared DataChannel: its index in the registry.
+// Labels are resolved to ids once, when a channel is created or announced
+// by the peer; messages carry the id.
+using ChannelId = uint8_t;
+constexpr ChannelId kUnknownChannelId = 0xFF;
+constexpr size_t kMaxDataChannels = 16;
+
+// SCTP delivery of a DataChannel (RTCDataChannelInit). At most one of
+// max_retransmits and max_packet_lifetime_ms may be set (>= 0); with
+// neither, the channel is reliable.
+struct ChannelReliability {
+  bool ordered = true;
+  int max_retransmits = -1;
+  int max_packet_lifetime_ms = -1;
+
+  static ChannelReliability Reliable() { return ChannelReliability(); }
+  // Latest-value traffic (e.g., telemetry): a lost message is not resent
+  // and does not hold back the following ones.
+  static ChannelReliability Unreliable(int max_retransmits = 0) {
+    ChannelReliability reliability;
+    reliability.ordered = false;
+    reliability.max_retransmits = max_retransmits;
+    return reliability;
+  }
+};
+
+struct DataChannelSpec {
+  std::string label;
+  ChannelPriority priority = ChannelPriority::Low;
+  ChannelReliability reliability;
+  // When the channel's bufferedAmount drops from above this to at most this,
+  // IWebrtcManager::onBufferedAmountLow is called (the RTCDataChannel
+  // bufferedamountlow event). 0: not reported.
+  uint64_t buffered_amount_low_threshold = 0;
+};
+
+// A declared DataChannel carrying messages of type Message: a Protobuf
+// message, or DataChannelMessage for raw bytes (e.g., batches).
+template <typename Message>
+struct Channel {
+  ChannelId id = kUnknownChannelId;
+  bool valid() const { return id != kUnknownChannelId; }
+};
+
+// The DataChannels of a connection, each declared once with its message
+// type, priority and reliability. Built during setup and not modified once
+// handed to the WebrtcManager, so it is read without locking.
+class DataChannelRegistry {
+ public:
+  DataChannelRegistry() = default;
+
+  // Returns an invalid channel (logged) if the label is declared already or
+  // the registry is full.
+  template <typename Message>
+  Channel<Message> declare(DataChannelSpec spec) {
+    return Channel<Message>{add(std::move(spec))};
+  }
+  ChannelId add(DataChannelSpec spec);
+
+  // kUnknownChannelId if the label is not declared.
+  ChannelId resolve(const std::string& label) const;
+
+  // id must be valid (< size()).
+  const DataChannelSpec& spec(ChannelId id) const { return specs_[id]; }
+  size_t size() const { return specs_.size(); }
+
+ private:
+  std::vector<DataChannelSpec> specs_;  // Indexed by ChannelId
+};
+
+// Routes received messages to the handler of their channel: an array index,
+// with no label compares. Handlers are registered during setup, before
+// messages are delivered; dispatch() only reads and MUST BE THREAD-SAFE.
+class DataChannelDispatcher {
+ public:
+  using RawHandler = std::function<void(const std::string& peer_id,
+                                        DataChannelMessageView message)>;
+
+  DataChannelDispatcher() = default;
+
+  // Raw bytes, for channels not carrying one Protobuf message per
+  // DataChannel message (a view of the receive buffer, see
+  // DataChannelMessageView).
+  void on(Channel<DataChannelMessage> channel, RawHandler handler) {
+    if (channel.valid()) handlers_[channel.id] = std::move(handler);
+  }
+
+  // Parses each message as Message; unparsable messages are counted and
+  // dropped.
+  template <typename Message>
+  void on(Channel<Message> channel,
+          std::function<void(const std::string& peer_id,
+                             const Message& message)>
+              handler) {
+    if (!channel.valid()) return;
+    handlers_[channel.id] = [handler = std::move(handler)](
+                                const std::string& peer_id,
+                                DataChannelMessageView data) {
+      Message message;
+      if (!message.ParseFromArray(data.data(), static_cast<int>(data.size()))) {
+        metrics::Increment(metrics::CounterId::webrtc_dc_parse_failures_total);
+        std::cerr << "DataChannelDispatcher: Failed to parse a message from "
+                  << peer_id << " (" << data.size() << " bytes)." << std::endl;
+        return;
+      }
+      handler(peer_id, message);
+    };
+  }
+
+  // Returns false if the channel has no handler.
+  bool dispatch(const std::string& peer_id, ChannelId channel,
+                DataChannelMessageView message) const {
+    if (channel >= kMaxDataChannels || !handlers_[channel]) return false;
+    handlers_[channel](peer_id, message);
+    return true;
+  }
+
+ private:
+  std::array<RawHandler, kMaxDataChannels> handlers_;
+
+  // Prevent copying
+  DataChannelDispatcher(const DataChannelDispatcher&) = delete;
+  DataChannelDispatcher& operator=(const DataChannelDispatcher&) = delete;
+};
+
+}  // namespace webrtc
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // DATA_CHANNEL_REGISTRY_H
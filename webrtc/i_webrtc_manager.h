@@ -6,8 +6,15 @@
 #include <string>
 #include <vector>
 
-// Forward declare necessary types if not included fully
-// struct VideoFrame; // If video handling is included in interface
+// libwebrtc receiver type used by the (Cockpit side) video track callback
+#include "webrtc/api/rtp_receiver_interface.h"
+#include "webrtc/api/scoped_refptr.h"
+
+#include "metrics/metrics_registry.h"  // autodev::remote::metrics::MetricsRegistry
+#include "webrtc/channel_handle.h"
+#include "webrtc/data_channel_registry.h"
+#include "webrtc/peer_connection_stats.h"
+#include "webrtc/video_send_parameters.h"
 
 namespace autodev {
 namespace remote {
@@ -74,17 +81,62 @@ class IWebrtcManager {
   // peer_id: The sender peer.
   // label: The label of the DataChannel the message was received on.
   // message: The raw received data (e.g., serialized protobuf).
+  // Opt-in: only when set does a message cost a copy of its bytes on top of
+  // OnChannelMessageHandler.
   // Implementations of this handler MUST BE THREAD-SAFE.
   using OnDataChannelMessageReceivedHandler =
       std::function<void(const std::string& peer_id, const std::string& label,
                          const DataChannelMessage& message)>;
 
-  // Optional: Called when a video track is received from a peer (Cockpit side).
+  // Like OnDataChannelMessageReceivedHandler, with the id of the channel in
+  // the DataChannelRegistry (see setDataChannels) instead of its label, for
+  // dispatch without label compares (DataChannelDispatcher). message is a
+  // view of the receive buffer, valid only during the call.
+  // Implementations of this handler MUST BE THREAD-SAFE.
+  using OnChannelMessageHandler =
+      std::function<void(const std::string& peer_id, ChannelId channel,
+                         DataChannelMessageView message)>;
+
+  // Called when the bufferedAmount of a peer's channel drops to its
+  // DataChannelSpec::buffered_amount_low_threshold: producers held back by
+  // trySendDataChannelMessage may resume. Called on the WebRTC network
+  // thread; implementations MUST BE THREAD-SAFE and return quickly.
+  using OnBufferedAmountLowHandler =
+      std::function<void(const std::string& peer_id, ChannelId channel,
+                         uint64_t buffered_amount)>;
+
+  // Called when a video track is received from a peer (Cockpit side).
   // peer_id: The sender peer.
-  // track: The WebRTC video track object. Needs WebRTC headers to define the
-  // type. using OnVideoTrackReceivedHandler = std::function<void(const
-  // std::string& peer_id, rtc::scoped_refptr<webrtc::VideoTrackInterface>
-  // track)>;
+  // receiver: The RTP receiver of the track. receiver->track() is the
+  // webrtc::VideoTrackInterface for decoded frames; the receiver also allows
+  // tapping the encoded frames before decoding.
+  // Called on the WebRTC signaling thread. Implementations MUST be thread-safe.
+  using OnVideoTrackReceivedHandler = std::function<void(
+      const std::string& peer_id,
+      rtc::scoped_refptr<::webrtc::RtpReceiverInterface> receiver)>;
+
+  // Called with the send bandwidth estimate of a peer (libwebrtc's
+  // availableOutgoingBitrate of the selected candidate pair), every
+  // stats poll. This is the budget the congestion controller allows for all
+  // media and DataChannel traffic to the peer.
+  // Called on the WebRTC signaling thread. Implementations MUST be thread-safe.
+  using OnBandwidthEstimateHandler = std::function<void(
+      const std::string& peer_id, double available_outgoing_bitrate_bps)>;
+
+  // Called with every stats report of a peer (polled every
+  // stats_interval_ms).
+  // Called on the WebRTC signaling thread. Implementations MUST be
+  // thread-safe.
+  using OnPeerStatsHandler = std::function<void(
+      const std::string& peer_id, const PeerConnectionStats& stats)>;
+
+  // Called with the role claim of a peer's token, as verified and forwarded
+  // by the signaling server, for every signaling message that carries one
+  // (before the message is processed, so before the peer connects).
+  // Called on the signaling client thread. Implementations MUST be
+  // thread-safe.
+  using OnPeerRoleClaimHandler =
+      std::function<void(const std::string& peer_id, const std::string& role)>;
 
   // --- Manager Lifecycle ---
 
@@ -138,6 +190,32 @@ class IWebrtcManager {
   virtual bool sendDataChannelMessageToAllPeers(
       const std::string& channel_label, const DataChannelMessage& data) = 0;
 
+  // Resolves a peer's declared DataChannel once, for senders of many
+  // messages (see ChannelHandle). May be called before the channel opens;
+  // the handle opens with it. Returns an invalid handle if the manager is
+  // not running, the peer is unknown or the label is not declared.
+  // This method MUST BE THREAD-SAFE.
+  virtual ChannelHandle acquireChannel(const std::string& peer_id,
+                                       const std::string& channel_label) = 0;
+
+  // --- Backpressure ---
+  // Bytes queued on a peer's DataChannel and not yet sent (the SCTP send
+  // buffer); 0 if the peer or channel is unknown or not open. Messages
+  // waiting in the send scheduler are not included.
+  // This method MUST BE THREAD-SAFE.
+  virtual uint64_t getBufferedAmount(const std::string& peer_id,
+                                     const std::string& channel_label) = 0;
+
+  // Sends at once if the channel's bufferedAmount stays at most
+  // max_buffered_bytes, and fails fast otherwise (no queueing, whatever the
+  // channel's priority): the caller drops or defers the message and adapts
+  // its rate, e.g. until onBufferedAmountLow. Returns false as well if the
+  // peer or channel is not ready. This method MUST BE THREAD-SAFE.
+  virtual bool trySendDataChannelMessage(const std::string& peer_id,
+                                         const std::string& channel_label,
+                                         const DataChannelMessage& data,
+                                         uint64_t max_buffered_bytes) = 0;
+
   // Optional: Add a video track for sending (Vehicle side).
   // track: The WebRTC video track object (created by the vehicle application,
   // e.g., from camera source). Returns true if the track was added successfully
@@ -150,9 +228,19 @@ class IWebrtcManager {
   // removeLocalVideoTrack(rtc::scoped_refptr<webrtc::VideoTrackInterface>
   // track) = 0;
 
+  // Applies encoder limits to the video sent to a peer (Vehicle side).
+  // Returns false if the peer is unknown or the parameters were rejected.
+  // This method MUST BE THREAD-SAFE.
+  virtual bool setVideoSendParameters(const std::string& peer_id,
+                                      const VideoSendParameters& params) = 0;
+
   // --- Registering Application Callbacks with the Manager ---
   // These methods should be called after init() and before start().
   // Passing a default-constructed std::function clears the handler.
+  // The message handlers (onChannelMessage, onDataChannelMessageReceived)
+  // are bound into each PeerConnection when it is created, so messages are
+  // delivered without locking; setting them later only affects later
+  // connections.
 
   virtual void onSignalingConnected(OnSignalingConnectedHandler handler) = 0;
   virtual void onSignalingDisconnected(
@@ -163,8 +251,32 @@ class IWebrtcManager {
   virtual void onPeerError(OnPeerErrorHandler handler) = 0;
   virtual void onDataChannelMessageReceived(
       OnDataChannelMessageReceivedHandler handler) = 0;
-  // Optional: virtual void onVideoTrackReceived(OnVideoTrackReceivedHandler
-  // handler) = 0;
+  virtual void onChannelMessage(OnChannelMessageHandler handler) = 0;
+  virtual void onBufferedAmountLow(OnBufferedAmountLowHandler handler) = 0;
+  virtual void onVideoTrackReceived(OnVideoTrackReceivedHandler handler) = 0;
+  // Setting a handler enables stats polling even without a metrics registry.
+  virtual void onBandwidthEstimate(OnBandwidthEstimateHandler handler) = 0;
+  virtual void onPeerRoleClaim(OnPeerRoleClaimHandler handler) = 0;
+  // Like onBandwidthEstimate, enables stats polling.
+  virtual void onPeerStats(OnPeerStatsHandler handler) = 0;
+
+  // --- Metrics ---
+  // Publishes the statistics of every PeerConnection (RTT, bandwidth
+  // estimate, loss, jitter buffer delay, frame and DataChannel counters),
+  // polled periodically, to this registry with a peer_id label. The series
+  // of a peer are removed when its connection is destroyed.
+  // Should be called before start(); nullptr stops publishing.
+  virtual void setMetricsRegistry(
+      std::shared_ptr<autodev::remote::metrics::MetricsRegistry> registry) = 0;
+
+  // --- DataChannels ---
+  // Declares the DataChannels of every connection: the offering side creates
+  // them with the declared priority and reliability, and received messages
+  // carry their channel's id. Without it, the control, telemetry and
+  // session channels of the manager's configuration are declared. Must be
+  // called before start(); returns false (and changes nothing) afterwards.
+  virtual bool setDataChannels(
+      std::shared_ptr<const DataChannelRegistry> channels) = 0;
 };
 
 }  // namespace webrtc
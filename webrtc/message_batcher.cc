@@ -0,0 +1,230 @@
+#include "webrtc/message_batcher.h"
+
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <utility>
+
+#include "metrics/static_metrics.h"
+
+namespace autodev {
+namespace remote {
+namespace webrtc {
+
+namespace {
+
+// Per message cost in SCTP that batching saves: the DATA chunk header and
+// the padding of the chunk to 4 bytes (RFC 9260, 3.3.1).
+constexpr int64_t kSctpDataChunkHeaderSize = 16;
+
+int64_t SctpChunkOverhead(size_t payload_size) {
+  return kSctpDataChunkHeaderSize +
+         static_cast<int64_t>((4 - payload_size % 4) % 4);
+}
+
+void AppendBatchHeader(std::vector<char>& buffer) {
+  buffer.push_back(kMessageBatchMagic);
+  buffer.push_back('B');
+  buffer.push_back(static_cast<char>(kMessageBatchVersion));
+  buffer.push_back(0);
+}
+
+void AppendRecord(std::vector<char>& buffer, const std::vector<char>& message) {
+  const size_t size = message.size();
+  buffer.push_back(static_cast<char>(size & 0xFF));
+  buffer.push_back(static_cast<char>((size >> 8) & 0xFF));
+  buffer.insert(buffer.end(), message.begin(), message.end());
+}
+
+}  // namespace
+
+// --- Batch format ---
+
+bool IsMessageBatch(const char* data, size_t size) {
+  return size >= kMessageBatchHeaderSize && data[0] == kMessageBatchMagic &&
+         data[1] == 'B' &&
+         static_cast<uint8_t>(data[2]) == kMessageBatchVersion;
+}
+
+bool ForEachBatchedMessage(
+    const char* data, size_t size,
+    const std::function<void(const char* message, size_t size)>& visit) {
+  if (!IsMessageBatch(data, size)) return false;
+  size_t offset = kMessageBatchHeaderSize;
+  while (offset < size) {
+    if (size - offset < kMessageBatchRecordHeaderSize) return false;
+    const size_t length =
+        static_cast<uint8_t>(data[offset]) |
+        (static_cast<size_t>(static_cast<uint8_t>(data[offset + 1])) << 8);
+    offset += kMessageBatchRecordHeaderSize;
+    if (size - offset < length) return false;
+    visit(data + offset, length);
+    offset += length;
+  }
+  return true;
+}
+
+// --- DataChannelMessageBatcher ---
+
+DataChannelMessageBatcher::DataChannelMessageBatcher(Config config,
+                                                     SendFunction send)
+    : config_(config), send_(std::move(send)) {}
+
+DataChannelMessageBatcher::~DataChannelMessageBatcher() { stop(); }
+
+void DataChannelMessageBatcher::start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (running_) return;
+  running_ = true;
+  thread_ = std::thread(&DataChannelMessageBatcher::threadMain, this);
+}
+
+void DataChannelMessageBatcher::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) return;
+    running_ = false;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) thread_.join();  // Sends what is pending
+}
+
+void DataChannelMessageBatcher::add(const std::string& label,
+                                    const DataChannelMessage& message) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!running_) {
+    lock.unlock();
+    send_(label, message);
+    return;
+  }
+
+  const size_t record_size = kMessageBatchRecordHeaderSize + message.size();
+  if (message.size() > kMessageBatchMaxRecordSize ||
+      kMessageBatchHeaderSize + record_size > config_.max_batch_bytes) {
+    // Too large to share a batch: send it alone, after what is pending.
+    closeBatchLocked(label);
+    if (message.empty() || message[0] != kMessageBatchMagic) {
+      ready_.push_back(ReadyMessage{label, message, 0});
+    } else if (message.size() <= kMessageBatchMaxRecordSize) {
+      ReadyMessage ready{label, {}, 1};
+      AppendBatchHeader(ready.message);
+      AppendRecord(ready.message, message);
+      ready_.push_back(std::move(ready));
+    } else {
+      std::cerr << "DataChannelMessageBatcher: Dropping a " << message.size()
+                << " byte message on " << label
+                << " that looks like a batch and is too large to wrap."
+                << std::endl;
+      return;
+    }
+    cv_.notify_one();
+    return;
+  }
+
+  auto it = open_.find(label);
+  if (it != open_.end() &&
+      it->second.buffer.size() + record_size > config_.max_batch_bytes) {
+    closeBatchLocked(label);
+    it = open_.end();
+  }
+  if (it == open_.end()) {
+    it = open_.emplace(label, OpenBatch{}).first;
+    it->second.buffer.reserve(config_.max_batch_bytes);
+    AppendBatchHeader(it->second.buffer);
+    it->second.deadline =
+        std::chrono::steady_clock::now() + config_.max_latency;
+  }
+  AppendRecord(it->second.buffer, message);
+  ++it->second.records;
+
+  // Full: no further record would fit.
+  if (it->second.buffer.size() + kMessageBatchRecordHeaderSize >=
+      config_.max_batch_bytes) {
+    closeBatchLocked(label);
+  }
+  // Wakes the thread for a ready batch or for the new deadline.
+  cv_.notify_one();
+}
+
+void DataChannelMessageBatcher::closeBatchLocked(const std::string& label) {
+  auto it = open_.find(label);
+  if (it == open_.end()) return;
+  OpenBatch& batch = it->second;
+  ReadyMessage ready{label, std::move(batch.buffer), batch.records};
+  // A batch of one goes out as the plain message, unless that would look
+  // like a batch.
+  const size_t first = kMessageBatchHeaderSize + kMessageBatchRecordHeaderSize;
+  if (ready.records == 1 && ready.message.size() > first &&
+      ready.message[first] != kMessageBatchMagic) {
+    ready.message.erase(ready.message.begin(), ready.message.begin() + first);
+    ready.records = 0;
+  }
+  ready_.push_back(std::move(ready));
+  open_.erase(it);
+}
+
+void DataChannelMessageBatcher::threadMain() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    // Close the batches whose latency budget is used up (all of them when
+    // stopping).
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = open_.begin(); it != open_.end();) {
+      const auto next = std::next(it);
+      if (!running_ || it->second.deadline <= now) closeBatchLocked(it->first);
+      it = next;
+    }
+
+    if (!ready_.empty()) {
+      std::deque<ReadyMessage> ready;
+      ready.swap(ready_);
+      lock.unlock();
+      for (const ReadyMessage& message : ready) sendReady(message);
+      lock.lock();
+      continue;
+    }
+    if (!running_) break;
+
+    if (open_.empty()) {
+      cv_.wait(lock);
+    } else {
+      auto deadline = open_.begin()->second.deadline;
+      for (const auto& [label, batch] : open_) {
+        if (batch.deadline < deadline) deadline = batch.deadline;
+      }
+      cv_.wait_until(lock, deadline);
+    }
+  }
+}
+
+void DataChannelMessageBatcher::sendReady(const ReadyMessage& ready) {
+  metrics::Record(metrics::HistogramId::webrtc_dc_batch_messages,
+                  ready.records == 0 ? 1 : ready.records);
+  if (ready.records > 0) {
+    // What the messages would have cost as separate DataChannel messages,
+    // against the batch.
+    int64_t saved = -SctpChunkOverhead(ready.message.size()) -
+                    static_cast<int64_t>(kMessageBatchHeaderSize);
+    ForEachBatchedMessage(ready.message.data(), ready.message.size(),
+                          [&saved](const char*, size_t size) {
+                            saved += SctpChunkOverhead(size) -
+                                     static_cast<int64_t>(
+                                         kMessageBatchRecordHeaderSize);
+                          });
+    metrics::Increment(metrics::CounterId::webrtc_dc_batches_sent_total);
+    metrics::Increment(metrics::CounterId::webrtc_dc_batched_messages_total,
+                       ready.records);
+    metrics::Increment(
+        metrics::CounterId::webrtc_dc_batch_messages_saved_total,
+        ready.records - 1);
+    if (saved > 0) {
+      metrics::Increment(metrics::CounterId::webrtc_dc_batch_bytes_saved_total,
+                         static_cast<uint64_t>(saved));
+    }
+  }
+  send_(ready.label, ready.message);
+}
+
+}  // namespace webrtc
+}  // namespace remote
+}  // namespace autodev
@@ -0,0 +1,131 @@
+#ifndef MESSAGE_BATCHER_H
+#define MESSAGE_BATCHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace webrtc {
+
+// --- Batch format ---
+//
+// A batch packs several small messages of one DataChannel into a single
+// DataChannel (SCTP) message:
+//
+//   byte 0     kMessageBatchMagic (0x00)
+//   byte 1     'B'
+//   byte 2     kMessageBatchVersion
+//   byte 3     reserved (0)
+//   records    uint16 length (little endian) followed by the message bytes,
+//              repeated until the end of the batch
+//
+// A non-empty Protobuf message never starts with 0x00 (field number 0 is
+// invalid), so receivers tell batches from plain messages by the first
+// bytes. The batcher wraps a plain message that does start with 0x00 in a
+// batch of one, so the check is unambiguous for any payload.
+
+constexpr char kMessageBatchMagic = 0x00;
+constexpr uint8_t kMessageBatchVersion = 1;
+constexpr size_t kMessageBatchHeaderSize = 4;
+constexpr size_t kMessageBatchRecordHeaderSize = 2;
+constexpr size_t kMessageBatchMaxRecordSize = 0xFFFF;
+
+// True if the message is a batch (of a supported version).
+bool IsMessageBatch(const char* data, size_t size);
+
+// Calls visit for every message of the batch, in order, with pointers into
+// the batch (no copies). Returns false on a malformed batch; the messages
+// before the malformed record have been visited then.
+bool ForEachBatchedMessage(
+    const char* data, size_t size,
+    const std::function<void(const char* message, size_t size)>& visit);
+
+// Packs small messages of each DataChannel label into batches that are sent
+// at the latest max_latency after their first message, or earlier when the
+// next message would not fit into max_batch_bytes.
+//
+// Separate tiny messages each cost an SCTP DATA chunk (16 bytes header plus
+// padding), a send call through the SCTP stack and, since libwebrtc sends
+// with SCTP_NODELAY, usually a packet of their own. A batch costs one of
+// each plus 4 bytes, and 2 bytes per message.
+//
+// All batches are sent from the batcher's thread in the order their
+// messages were added, so add() never blocks on the network.
+class DataChannelMessageBatcher {
+ public:
+  using DataChannelMessage = std::vector<char>;
+
+  // Sends one (batched or plain) message. Called from the batcher's thread,
+  // without its lock held.
+  using SendFunction = std::function<void(const std::string& label,
+                                          const DataChannelMessage& message)>;
+
+  struct Config {
+    std::chrono::milliseconds max_latency{5};
+    // Upper bound of a batch, header included. The default keeps a batch in
+    // a single SCTP packet (usrsctp uses a 1200 byte MTU in libwebrtc).
+    size_t max_batch_bytes = 1152;
+  };
+
+  DataChannelMessageBatcher(Config config, SendFunction send);
+  ~DataChannelMessageBatcher();
+
+  // Starts/stops the sending thread. stop() sends what is still pending.
+  void start();
+  void stop();
+
+  // Adds (copies) a message. Messages too large for a batch are sent alone,
+  // after the pending batch of their label. Without a running thread the
+  // message is sent at once. MUST BE THREAD-SAFE.
+  void add(const std::string& label, const DataChannelMessage& message);
+
+ private:
+  struct OpenBatch {
+    DataChannelMessage buffer;  // Header and records so far
+    size_t records = 0;
+    std::chrono::steady_clock::time_point deadline;
+  };
+  struct ReadyMessage {
+    std::string label;
+    DataChannelMessage message;
+    size_t records = 0;  // 0 for a message sent alone
+  };
+
+  void threadMain();
+  // Moves the label's open batch (if any) to ready_. mutex_ MUST be held.
+  void closeBatchLocked(const std::string& label);
+  // Sends one ready message and accounts for it. Called without mutex_.
+  void sendReady(const ReadyMessage& ready);
+
+  const Config config_;
+  const SendFunction send_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::map<std::string, OpenBatch> open_;  // Guarded by mutex_
+  std::deque<ReadyMessage> ready_;         // Guarded by mutex_; send order
+  bool running_ = false;                   // Guarded by mutex_
+  std::thread thread_;
+
+  // Prevent copying
+  DataChannelMessageBatcher(const DataChannelMessageBatcher&) = delete;
+  DataChannelMessageBatcher& operator=(const DataChannelMessageBatcher&) =
+      delete;
+};
+
+}  // namespace webrtc
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // MESSAGE_BATCHER_H
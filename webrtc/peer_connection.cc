@@ -10,8 +10,15 @@
 // #include "api/scoped_refptr.h"
 // #include "rtc_base/thread.h"
 // #include "rtc_base/ref_counted_object.h" // For observer implementation
+// #include "api/stats/rtc_stats_collector_callback.h" // For GetStats
+// #include "api/stats/rtcstats_objects.h" // RTC*Stats types read in OnStatsDelivered
 
+#include <algorithm>  // For std::max
+#include <array>      // For data_channel_endpoints_
+#include <atomic>     // For the endpoint state
 #include <iostream>
+#include <map>      // For data_channels_
+#include <memory>   // For the endpoints
 #include <mutex>    // For synchronization
 #include <string>   // For std::string
 #include <utility>  // For std::move
@@ -33,6 +40,136 @@ namespace autodev {
 namespace remote {
 namespace webrtc {
 
+// IDataChannelEndpoint of one declared DataChannel. The channel is rebound
+// and cleared under the endpoint's own mutex, which a send holds only for
+// the Send() call: no PeerConnection lock, no lookup. open_ follows the
+// channel state (set by its observer), so sends on a closed channel fail
+// without locking.
+class LibwebrtcDataChannelEndpoint : public IDataChannelEndpoint {
+ public:
+  LibwebrtcDataChannelEndpoint() = default;
+
+  bool isOpen() const override {
+    return open_.load(std::memory_order_acquire);
+  }
+  bool isDetached() const override {
+    return detached_.load(std::memory_order_acquire);
+  }
+
+  uint64_t bufferedAmount() const override {
+    if (!isOpen()) return 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    // buffered_amount() is thread-safe (atomic in the DataChannel proxy).
+    return channel_ ? channel_->buffered_amount() : 0;
+  }
+
+  bool send(const DataChannelMessage& data) override {
+    if (!isOpen()) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!channel_) return false;
+    // Send() copies the data; it fails when the channel's buffer is full.
+    return channel_->Send(::webrtc::DataBuffer(
+        rtc::CopyOnWriteBuffer(data.data(), data.size()), /*binary=*/true));
+  }
+
+  // Sends go to this channel from now on. Called with the PeerConnection's
+  // mutex held, after the channel's observer is registered (so no state
+  // change is missed).
+  void bind(rtc::scoped_refptr<::webrtc::DataChannelInterface> channel) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (detached_) return;
+    channel_ = std::move(channel);
+    open_ = channel_->state() == ::webrtc::DataChannelInterface::kOpen;
+  }
+
+  // Called by the bound channel's observer.
+  void setOpen(bool open) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!detached_) open_ = open;
+  }
+
+  void detach() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    channel_ = nullptr;
+    detached_ = true;
+    open_ = false;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  rtc::scoped_refptr<::webrtc::DataChannelInterface> channel_
+      GUARDED_BY(mutex_);
+  std::atomic<bool> open_{false};
+  std::atomic<bool> detached_{false};
+};
+
+// libwebrtc DataChannelObserver of one DataChannel. The channel's label is
+// resolved to its ChannelId once, when the observer is created; messages are
+// passed on with the id. Holds copies of the callbacks (set before any
+// channel exists), so a message takes no lock. Invoked on the network
+// thread.
+class DataChannelObserverAdapter : public ::webrtc::DataChannelObserver {
+ public:
+  DataChannelObserverAdapter(
+      rtc::scoped_refptr<::webrtc::DataChannelInterface> channel,
+      ChannelId id, const PeerConnectionCallbacks& callbacks,
+      std::shared_ptr<LibwebrtcDataChannelEndpoint> endpoint)
+      : channel_(std::move(channel)),
+        id_(id),
+        onOpened_(callbacks.onDataChannelOpened),
+        onClosed_(callbacks.onDataChannelClosed),
+        onMessage_(callbacks.onDataChannelMessage),
+        onBufferedAmountLow_(callbacks.onDataChannelBufferedAmountLow),
+        bufferedAmountLowThreshold_(
+            callbacks.bufferedAmountLowThreshold
+                ? callbacks.bufferedAmountLowThreshold(id)
+                : 0),
+        endpoint_(std::move(endpoint)) {}
+
+  void OnStateChange() override {
+    const auto state = channel_->state();
+    endpoint_->setOpen(state == ::webrtc::DataChannelInterface::kOpen);
+    switch (state) {
+      case ::webrtc::DataChannelInterface::kOpen:
+        if (onOpened_) onOpened_(channel_->label());
+        break;
+      case ::webrtc::DataChannelInterface::kClosed:
+        if (onClosed_) onClosed_(channel_->label());
+        break;
+      default:
+        break;
+    }
+  }
+
+  void OnMessage(const ::webrtc::DataBuffer& buffer) override {
+    if (!onMessage_) return;
+    // No copy: the handler gets a view of libwebrtc's buffer.
+    onMessage_(id_, DataChannelMessageView(buffer.data.cdata<char>(),
+                                           buffer.data.size()));
+  }
+
+  // Called when queued data was handed to SCTP (bufferedAmount decreased by
+  // sent_data_size).
+  void OnBufferedAmountChange(uint64_t sent_data_size) override {
+    if (bufferedAmountLowThreshold_ == 0 || !onBufferedAmountLow_) return;
+    const uint64_t buffered = channel_->buffered_amount();
+    if (buffered <= bufferedAmountLowThreshold_ &&
+        buffered + sent_data_size > bufferedAmountLowThreshold_) {
+      onBufferedAmountLow_(id_, buffered);
+    }
+  }
+
+ private:
+  const rtc::scoped_refptr<::webrtc::DataChannelInterface> channel_;
+  const ChannelId id_;
+  const std::function<void(const std::string&)> onOpened_;
+  const std::function<void(const std::string&)> onClosed_;
+  const std::function<void(ChannelId, DataChannelMessageView)> onMessage_;
+  const std::function<void(ChannelId, uint64_t)> onBufferedAmountLow_;
+  const uint64_t bufferedAmountLowThreshold_;  // 0: not reported
+  const std::shared_ptr<LibwebrtcDataChannelEndpoint> endpoint_;
+};
+
 // Define concrete PeerConnection implementation inheriting from IPeerConnection
 // This class will own the actual libwebrtc PeerConnectionInterface instance.
 class LibwebrtcPeerConnectionImpl
@@ -41,7 +178,8 @@ class LibwebrtcPeerConnectionImpl
                                      // object is also a libwebrtc observer
           webrtc::PeerConnectionObserver,
           webrtc::CreateSessionDescriptionObserver,
-          webrtc::SetSessionDescriptionObserver
+          webrtc::SetSessionDescriptionObserver,
+          webrtc::RTCStatsCollectorCallback  // For GetStats
           // ... other libwebrtc observer interfaces
           > {
  public:
@@ -82,6 +220,11 @@ class LibwebrtcPeerConnectionImpl
                           const std::string& sdp_mid,
                           int sdp_mline_index) override;
 
+  // Implement CreateDataChannel and GetDataChannelBufferedAmount.
+  // These methods MUST BE THREAD-SAFE.
+  bool CreateDataChannel(const DataChannelSpec& spec) override;
+  uint64_t GetDataChannelBufferedAmount() const override;
+
   // Implement SendData. This method MUST BE THREAD-SAFE.
   // Must marshal call to the DataChannel thread (usually signaling thread or
   // internal DC thread).
@@ -89,6 +232,17 @@ class LibwebrtcPeerConnectionImpl
                 const DataChannelMessage& data) override;
   bool SendData(const std::string& label, const std::string& data) override;
 
+  // Implement GetDataChannelEndpoint. This method MUST BE THREAD-SAFE.
+  std::shared_ptr<IDataChannelEndpoint> GetDataChannelEndpoint(
+      ChannelId id) override;
+
+  // Implement RequestStats. This method MUST BE THREAD-SAFE.
+  // The report is delivered to OnStatsDelivered on the signaling thread.
+  bool RequestStats() override;
+
+  // Implement SetVideoSendParameters. This method MUST BE THREAD-SAFE.
+  bool SetVideoSendParameters(const VideoSendParameters& params) override;
+
   // Implement AddLocalTrack (optional). Must marshal call to libwebrtc
   // signaling thread. bool AddLocalTrack(std::shared_ptr<IMediaTrack> track)
   // override; // Example
@@ -143,6 +297,8 @@ class LibwebrtcPeerConnectionImpl
                            const std::string& error_text) override;
   void OnValidationRemoteCandidateFailed(
       const cricket::Candidate& candidate) override;
+  // RTCStatsCollectorCallback: result of RequestStats(). Extracts the
+  // PeerConnectionStats and reports them via onStatsReport.
   void OnStatsDelivered(const rtc::scoped_refptr<const webrtc::RTCStatsReport>&
                             report) override;  // For getStats
   void OnAudioOrVideoTrack(
@@ -165,14 +321,8 @@ class LibwebrtcPeerConnectionImpl
   // void OnSetSessionDescriptionFailure(const std::string& error) override; //
   // Older API
 
-  // --- Implementation of libwebrtc DataChannelObserver (for each data channel)
-  // --- Need a way to store these observers or adapt them. This could be a
-  // separate class or internal lambda per channel. Example methods a
-  // DataChannelObserver would implement: void OnStateChange() override; //
-  // DataChannel state (connecting, open, closed) void OnMessage(const
-  // webrtc::DataBuffer& buffer) override; // Message received void
-  // OnBufferedAmountChange(uint64_t sent_data_bytes) override; // Sent bytes
-  // buffered
+  // DataChannel events are handled by a DataChannelObserverAdapter per
+  // channel (see registerDataChannelLocked).
 
  private:
   // Mutex to protect access to members that can be accessed from different
@@ -195,10 +345,27 @@ class LibwebrtcPeerConnectionImpl
   // Store the application's callbacks
   PeerConnectionCallbacks callbacks_ GUARDED_BY(mutex_);
 
-  // Map to store DataChannel instances, potentially keyed by label
-  // std::map<std::string, rtc::scoped_refptr<webrtc::DataChannelInterface>>
-  // data_channels_ GUARDED_BY(mutex_); Need to manage DataChannelObservers
-  // associated with these.
+  // DataChannel instances keyed by label (stored in CreateDataChannel and
+  // OnDataChannel; read for the bufferedAmount), and the observers of the
+  // declared ones. Observers are unregistered in Close().
+  std::map<std::string, rtc::scoped_refptr<webrtc::DataChannelInterface>>
+      data_channels_ GUARDED_BY(mutex_);
+  std::map<std::string, std::unique_ptr<DataChannelObserverAdapter>>
+      data_channel_observers_ GUARDED_BY(mutex_);
+  // Send endpoints of the declared channels, by ChannelId; created on first
+  // use and detached in Close().
+  std::array<std::shared_ptr<LibwebrtcDataChannelEndpoint>, kMaxDataChannels>
+      data_channel_endpoints_ GUARDED_BY(mutex_);
+  bool closed_ GUARDED_BY(mutex_) = false;  // Close() was called
+
+  // The endpoint of a declared channel, created if need be.
+  // mutex_ MUST be held.
+  std::shared_ptr<LibwebrtcDataChannelEndpoint> endpointLocked(ChannelId id);
+
+  // Stores the channel and, if its label is declared, observes it.
+  // mutex_ MUST be held.
+  void registerDataChannelLocked(
+      rtc::scoped_refptr<webrtc::DataChannelInterface> data_channel);
 
   // Helper to marshal a task to the signaling thread
   // bool PostTaskToSignalingThread(std::function<void()> task);
@@ -258,6 +425,10 @@ bool LibwebrtcPeerConnectionImpl::init(/* const RtcConfiguration& config, rtc::s
   // webrtc::PeerConnectionInterface::RTCConfiguration rtc_config;
   // // Populate rtc_config from provided config (ICE servers etc.)
   // rtc_config.ice_servers.push_back(...); // Populate ICE servers from config
+  // // Mark packets with the DSCP code point of their channel/video priority
+  // // (ChannelPriority). Until this creation is implemented, no packet is
+  // // DSCP-marked.
+  // rtc_config.set_dscp(true);
 
   // Create a PeerConnectionObserver adapter if this class doesn't inherit
   // directly or ensure this class inherits from PeerConnectionObserver as shown
@@ -449,6 +620,117 @@ bool LibwebrtcPeerConnectionImpl::AddRemoteCandidate(
   return true;  // Indicate successfully adding the candidate
 }
 
+namespace {
+
+::webrtc::Priority ToRtcPriority(ChannelPriority priority) {
+  switch (priority) {
+    case ChannelPriority::VeryLow:
+      return ::webrtc::Priority::kVeryLow;
+    case ChannelPriority::Low:
+      return ::webrtc::Priority::kLow;
+    case ChannelPriority::Medium:
+      return ::webrtc::Priority::kMedium;
+    case ChannelPriority::High:
+      return ::webrtc::Priority::kHigh;
+  }
+  return ::webrtc::Priority::kLow;
+}
+
+}  // namespace
+
+// Implementation of IPeerConnection::CreateDataChannel
+// This method MUST BE THREAD-SAFE.
+bool LibwebrtcPeerConnectionImpl::CreateDataChannel(
+    const DataChannelSpec& spec) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!rtc_peer_connection_) {
+    return false;
+  }
+  ::webrtc::DataChannelInit init;
+  init.priority = ToRtcPriority(spec.priority);
+  init.ordered = spec.reliability.ordered;
+  if (spec.reliability.max_retransmits >= 0) {
+    init.maxRetransmits = spec.reliability.max_retransmits;
+  } else if (spec.reliability.max_packet_lifetime_ms >= 0) {
+    init.maxRetransmitTime = spec.reliability.max_packet_lifetime_ms;
+  }
+  auto result =
+      rtc_peer_connection_->CreateDataChannelOrError(spec.label, &init);
+  if (!result.ok()) {
+    std::cerr << "LibwebrtcPeerConnectionImpl: Failed to create DataChannel "
+              << spec.label << ": " << result.error().message() << std::endl;
+    return false;
+  }
+  registerDataChannelLocked(result.MoveValue());
+  std::cout << "LibwebrtcPeerConnectionImpl: Created DataChannel "
+            << spec.label << " (priority "
+            << ChannelPriorityName(spec.priority)
+            << (spec.reliability.ordered ? ", ordered" : ", unordered")
+            << ")." << std::endl;
+  return true;
+}
+
+// mutex_ MUST be held.
+void LibwebrtcPeerConnectionImpl::registerDataChannelLocked(
+    rtc::scoped_refptr<webrtc::DataChannelInterface> data_channel) {
+  const std::string label = data_channel->label();
+  // A channel of the same label replaces the previous one.
+  auto previous = data_channels_.find(label);
+  if (previous != data_channels_.end() &&
+      data_channel_observers_.erase(label) > 0) {
+    previous->second->UnregisterObserver();
+  }
+  data_channels_[label] = data_channel;
+  const ChannelId id = callbacks_.resolveDataChannel
+                           ? callbacks_.resolveDataChannel(label)
+                           : kUnknownChannelId;
+  if (id == kUnknownChannelId) {
+    std::cout << "LibwebrtcPeerConnectionImpl: DataChannel " << label
+              << " is not declared; its messages are ignored." << std::endl;
+    return;
+  }
+  std::shared_ptr<LibwebrtcDataChannelEndpoint> endpoint = endpointLocked(id);
+  auto observer = std::make_unique<DataChannelObserverAdapter>(
+      data_channel, id, callbacks_, endpoint);
+  data_channel->RegisterObserver(observer.get());
+  data_channel_observers_[label] = std::move(observer);
+  endpoint->bind(data_channel);
+}
+
+// mutex_ MUST be held.
+std::shared_ptr<LibwebrtcDataChannelEndpoint>
+LibwebrtcPeerConnectionImpl::endpointLocked(ChannelId id) {
+  auto& endpoint = data_channel_endpoints_[id];
+  if (!endpoint) {
+    endpoint = std::make_shared<LibwebrtcDataChannelEndpoint>();
+    if (closed_) endpoint->detach();
+  }
+  return endpoint;
+}
+
+// Implementation of IPeerConnection::GetDataChannelEndpoint
+// This method MUST BE THREAD-SAFE.
+std::shared_ptr<IDataChannelEndpoint>
+LibwebrtcPeerConnectionImpl::GetDataChannelEndpoint(ChannelId id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (id >= kMaxDataChannels || closed_) return nullptr;
+  return endpointLocked(id);
+}
+
+// Implementation of IPeerConnection::GetDataChannelBufferedAmount
+// This method MUST BE THREAD-SAFE.
+uint64_t LibwebrtcPeerConnectionImpl::GetDataChannelBufferedAmount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t buffered = 0;
+  for (const auto& [label, channel] : data_channels_) {
+    // buffered_amount() is thread-safe (atomic in the DataChannel proxy).
+    if (channel && channel->state() == ::webrtc::DataChannelInterface::kOpen) {
+      buffered += channel->buffered_amount();
+    }
+  }
+  return buffered;
+}
+
 // Implementation of IPeerConnection::SendData
 // This method MUST BE THREAD-SAFE.
 bool LibwebrtcPeerConnectionImpl::SendData(const std::string& label,
@@ -456,41 +738,22 @@ bool LibwebrtcPeerConnectionImpl::SendData(const std::string& label,
   // This method is called by application threads (e.g., Command/Telemetry
   // Handlers via WebrtcManager). Acquire mutex to safely access the data
   // channel map/pointers and the underlying PC.
+  // The label lookup is per message; ChannelHandles send through the
+  // channel's endpoint instead.
   std::lock_guard<std::mutex> lock(mutex_);
-  // std::cout << "LibwebrtcPeerConnectionImpl::SendData called for label=" <<
-  // label << ", size=" << data.size() << std::endl; // Avoid spamming logs
-
-  if (!rtc_peer_connection_) {
-    // std::cerr << "LibwebrtcPeerConnectionImpl: Cannot send data, underlying
-    // PC not initialized." << std::endl;
-    // TODO: Report error via callbacks_->onError? Need to marshal.
+  if (!rtc_peer_connection_ || closed_) {
     return false;
   }
 
-  // Find the DataChannel by label
-  // rtc::scoped_refptr<webrtc::DataChannelInterface> data_channel =
-  // rtc_peer_connection_->LookupDataChannelByLabel(label);
-
-  // If DataChannel is found and its state is OPEN
-  // if (data_channel && data_channel->state() ==
-  // webrtc::DataChannelInterface::kOpen) { Create a libwebrtc DataBuffer
-  // webrtc::DataBuffer buffer(rtc::CopyOnWriteBuffer(data.data(), data.size()),
-  // false); // boolean is binary flag
-
-  // Send the data via the DataChannel
-  // bool sent = data_channel->Send(buffer); // Check return value
-
-  // return sent; // Return send status
-  // } else {
-  // DataChannel not found or not open
-  // std::cerr << "LibwebrtcPeerConnectionImpl: DataChannel '" << label << "'
-  // not found or not open." << std::endl;
-  // TODO: Report error via callbacks_->onError? Need to marshal.
-  return false;  // Indicate send failure
-                 // }
-                 // Dummy success for skeleton
-  // std::cout << "LibwebrtcPeerConnectionImpl: Simulating SendData success for
-  // label=" << label << std::endl; return true;
+  auto it = data_channels_.find(label);
+  if (it == data_channels_.end() || !it->second ||
+      it->second->state() != ::webrtc::DataChannelInterface::kOpen) {
+    // DataChannel not found or not open
+    return false;
+  }
+  // Send() copies the data; it fails when the channel's buffer is full.
+  return it->second->Send(::webrtc::DataBuffer(
+      rtc::CopyOnWriteBuffer(data.data(), data.size()), /*binary=*/true));
 }
 
 // Implementation of IPeerConnection::SendData (string overload)
@@ -501,6 +764,59 @@ bool LibwebrtcPeerConnectionImpl::SendData(const std::string& label,
   return SendData(label, binary_data);
 }
 
+// Implementation of IPeerConnection::RequestStats
+// This method MUST BE THREAD-SAFE.
+bool LibwebrtcPeerConnectionImpl::RequestStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!rtc_peer_connection_) {
+    return false;
+  }
+  // GetStats is asynchronous and thread-safe (proxied to the signaling
+  // thread); it holds a reference to the callback until OnStatsDelivered.
+  rtc_peer_connection_->GetStats(this);
+  return true;
+}
+
+// Implementation of IPeerConnection::SetVideoSendParameters
+// This method MUST BE THREAD-SAFE.
+bool LibwebrtcPeerConnectionImpl::SetVideoSendParameters(
+    const VideoSendParameters& params) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!rtc_peer_connection_) {
+    return false;
+  }
+  // RtpSender calls are proxied to the signaling thread (synchronously).
+  bool ok = true;
+  for (const auto& sender : rtc_peer_connection_->GetSenders()) {
+    if (sender->media_type() != cricket::MediaType::MEDIA_TYPE_VIDEO) {
+      continue;
+    }
+    webrtc::RtpParameters rtp_params = sender->GetParameters();
+    for (webrtc::RtpEncodingParameters& encoding : rtp_params.encodings) {
+      if (params.max_bitrate_bps > 0) {
+        encoding.max_bitrate_bps = static_cast<int>(params.max_bitrate_bps);
+      } else {
+        encoding.max_bitrate_bps.reset();
+      }
+      if (params.max_framerate > 0) {
+        encoding.max_framerate = static_cast<double>(params.max_framerate);
+      } else {
+        encoding.max_framerate.reset();
+      }
+      encoding.scale_resolution_down_by = params.scale_resolution_down_by;
+      encoding.network_priority = ToRtcPriority(params.network_priority);
+    }
+    webrtc::RTCError error = sender->SetParameters(rtp_params);
+    if (!error.ok()) {
+      std::cerr << "LibwebrtcPeerConnectionImpl: Failed to set video send "
+                   "parameters: "
+                << error.message() << std::endl;
+      ok = false;
+    }
+  }
+  return ok;
+}
+
 // Implementation of IPeerConnection::AddLocalTrack (optional)
 // bool LibwebrtcPeerConnectionImpl::AddLocalTrack(std::shared_ptr<IMediaTrack>
 // track) {
@@ -554,6 +870,17 @@ void LibwebrtcPeerConnectionImpl::Close() {
   std::lock_guard<std::mutex> lock(mutex_);
   std::cout << "LibwebrtcPeerConnectionImpl::Close called." << std::endl;
 
+  // No DataChannel events after Close() returns, and no sends through
+  // ChannelHandles.
+  for (const auto& [label, channel] : data_channels_) {
+    if (data_channel_observers_.count(label)) channel->UnregisterObserver();
+  }
+  data_channel_observers_.clear();
+  for (const auto& endpoint : data_channel_endpoints_) {
+    if (endpoint) endpoint->detach();
+  }
+  closed_ = true;
+
   if (rtc_peer_connection_) {
     // Call Close on the underlying libwebrtc PeerConnection instance.
     // This is an asynchronous operation. It triggers state changes (connecting
@@ -645,13 +972,29 @@ void LibwebrtcPeerConnectionImpl::OnAddTrack(
     rtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver,
     const std::vector<rtc::scoped_refptr<webrtc::MediaStreamInterface>>&
         streams) {
-  std::lock_guard<std::mutex> lock(mutex_);
   std::cout << "LibwebrtcPeerConnectionImpl: OnAddTrack" << std::endl;
-  // TODO: Get track from receiver (receiver->track())
-  // TODO: Check track type (video/audio)
-  // TODO: If it's a video track, and this is the Cockpit side,
-  //      invoke callbacks_->onVideoTrackReceived(peer_id, video_track); // Need
-  //      peer_id context, need to marshal
+  if (!receiver ||
+      receiver->media_type() != cricket::MediaType::MEDIA_TYPE_VIDEO) {
+    return;  // Only video is forwarded to the application
+  }
+  // Copy the handlers under the lock, invoke them without it so the
+  // application may call back into this PeerConnection.
+  std::function<void(rtc::scoped_refptr<::webrtc::RtpReceiverInterface>)>
+      on_add_video_receiver;
+  std::function<void(rtc::scoped_refptr<::webrtc::VideoTrackInterface>)>
+      on_add_video_track;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    on_add_video_receiver = callbacks_.onAddVideoReceiver;
+    on_add_video_track = callbacks_.onAddVideoTrack;
+  }
+  if (on_add_video_receiver) {
+    on_add_video_receiver(receiver);
+  }
+  if (on_add_video_track) {
+    on_add_video_track(rtc::scoped_refptr<::webrtc::VideoTrackInterface>(
+        static_cast<::webrtc::VideoTrackInterface*>(receiver->track().get())));
+  }
 }
 void LibwebrtcPeerConnectionImpl::OnRemoveTrack(
     rtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver) {
@@ -665,16 +1008,9 @@ void LibwebrtcPeerConnectionImpl::OnDataChannel(
   std::cout << "LibwebrtcPeerConnectionImpl: OnDataChannel: "
             << data_channel->label() << std::endl;
   // Called when the remote side creates a DataChannel.
-  // Store the data_channel and attach a DataChannelObserver to it.
-  // Need to implement DataChannelObserver methods (OnStateChange, OnMessage,
-  // etc.) data_channels_[data_channel->label()] = data_channel;
-  // data_channel->RegisterObserver(new RtcDataChannelObserverAdapter(this)); //
-  // Need adapter or this class implements observer
-
-  // TODO: Notify application that a DataChannel was created/opened?
-  // The onDataChannelOpened callback in PeerConnectionCallbacks might be better
-  // triggered by the DataChannelObserver's OnStateChange when the state becomes
-  // kOpen.
+  // Store the data_channel and observe it; its observer reports the open
+  // state and the messages.
+  registerDataChannelLocked(data_channel);
 }
 void LibwebrtcPeerConnectionImpl::OnRenegotiationNeeded() {
   std::lock_guard<std::mutex> lock(mutex_);
@@ -764,9 +1100,88 @@ void LibwebrtcPeerConnectionImpl::OnValidationRemoteCandidateFailed(
 }
 void LibwebrtcPeerConnectionImpl::OnStatsDelivered(
     const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  std::cout << "LibwebrtcPeerConnectionImpl: OnStatsDelivered" << std::endl;
-  // Optional: Process and report stats to the application.
+  if (!report) return;
+  // The report is immutable; extract the figures without holding mutex_.
+  PeerConnectionStats stats;
+
+  // RTT and bandwidth estimate of the candidate pair actually in use.
+  for (const auto* transport :
+       report->GetStatsOfType<::webrtc::RTCTransportStats>()) {
+    if (!transport->selected_candidate_pair_id.is_defined()) continue;
+    const ::webrtc::RTCStats* pair =
+        report->Get(*transport->selected_candidate_pair_id);
+    if (!pair || pair->type() != ::webrtc::RTCIceCandidatePairStats::kType) {
+      continue;
+    }
+    const auto& candidate_pair =
+        pair->cast_to<::webrtc::RTCIceCandidatePairStats>();
+    stats.rtt_ms =
+        candidate_pair.current_round_trip_time.ValueOrDefault(0.0) * 1000.0;
+    stats.available_outgoing_bitrate_bps =
+        candidate_pair.available_outgoing_bitrate.ValueOrDefault(0.0);
+    break;  // One transport (BUNDLE)
+  }
+
+  double jitter_buffer_delay_s = 0.0;
+  uint64_t jitter_buffer_emitted = 0;
+  for (const auto* inbound :
+       report->GetStatsOfType<::webrtc::RTCInboundRtpStreamStats>()) {
+    stats.packets_received += inbound->packets_received.ValueOrDefault(0);
+    stats.packets_lost += inbound->packets_lost.ValueOrDefault(0);
+    stats.jitter_ms = std::max(stats.jitter_ms,
+                               inbound->jitter.ValueOrDefault(0.0) * 1000.0);
+    jitter_buffer_delay_s += inbound->jitter_buffer_delay.ValueOrDefault(0.0);
+    jitter_buffer_emitted +=
+        inbound->jitter_buffer_emitted_count.ValueOrDefault(0);
+    stats.frames_decoded += inbound->frames_decoded.ValueOrDefault(0);
+    stats.frames_dropped += inbound->frames_dropped.ValueOrDefault(0);
+  }
+  if (jitter_buffer_emitted > 0) {
+    stats.jitter_buffer_delay_ms =
+        jitter_buffer_delay_s * 1000.0 / jitter_buffer_emitted;
+  }
+
+  for (const auto* outbound :
+       report->GetStatsOfType<::webrtc::RTCOutboundRtpStreamStats>()) {
+    stats.packets_sent += outbound->packets_sent.ValueOrDefault(0);
+    stats.frames_encoded += outbound->frames_encoded.ValueOrDefault(0);
+  }
+
+  // The peer's receiver reports (RTCP RR) on the media we send
+  for (const auto* remote :
+       report->GetStatsOfType<::webrtc::RTCRemoteInboundRtpStreamStats>()) {
+    stats.remote_fraction_lost = std::max(
+        stats.remote_fraction_lost, remote->fraction_lost.ValueOrDefault(0.0));
+    stats.remote_jitter_ms = std::max(
+        stats.remote_jitter_ms, remote->jitter.ValueOrDefault(0.0) * 1000.0);
+  }
+
+  for (const auto* channel :
+       report->GetStatsOfType<::webrtc::RTCDataChannelStats>()) {
+    stats.data_channel_bytes_sent += channel->bytes_sent.ValueOrDefault(0);
+    stats.data_channel_bytes_received +=
+        channel->bytes_received.ValueOrDefault(0);
+    stats.data_channel_messages_sent +=
+        channel->messages_sent.ValueOrDefault(0);
+    stats.data_channel_messages_received +=
+        channel->messages_received.ValueOrDefault(0);
+  }
+
+  // bufferedAmount is not part of the stats report; read it from the
+  // channels. Copy the handler under the lock, invoke it without it.
+  std::function<void(const PeerConnectionStats&)> on_stats_report;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [label, channel] : data_channels_) {
+      if (channel && channel->state() == ::webrtc::DataChannelInterface::kOpen) {
+        stats.data_channel_buffered_amount += channel->buffered_amount();
+      }
+    }
+    on_stats_report = callbacks_.onStatsReport;
+  }
+  if (on_stats_report) {
+    on_stats_report(stats);
+  }
 }
 void LibwebrtcPeerConnectionImpl::OnAudioOrVideoTrack(
     rtc::scoped_refptr<webrtc::MediaStreamTrackInterface> track,
@@ -839,36 +1254,6 @@ void LibwebrtcPeerConnectionImpl::OnSetSessionDescriptionComplete(
 // Implement older OnSetSessionDescriptionSuccess/Failure if needed based on
 // libwebrtc version
 
-// --- Implementation of libwebrtc DataChannelObserver ---
-// This would typically be a separate class or implemented internally per data
-// channel. Example methods: void
-// LibwebrtcPeerConnectionImpl::OnDataChannelStateChange(webrtc::DataChannelInterface::DataState
-// new_state) {
-//      std::lock_guard<std::mutex> lock(mutex_);
-//      std::cout << "LibwebrtcPeerConnectionImpl: DataChannel State Change: "
-//      << new_state << std::endl;
-//      // TODO: Map state and invoke callbacks_->onDataChannelOpened/Closed
-//      based on state
-//      // if (new_state == webrtc::DataChannelInterface::kOpen) {
-//      callbacks_.onDataChannelOpened(label); } // Need label context
-//      // if (new_state == webrtc::DataChannelInterface::kClosed) {
-//      callbacks_.onDataChannelClosed(label); } // Need label context
-//      // Need to marshal these calls.
-// }
-//
-// void LibwebrtcPeerConnectionImpl::OnDataChannelMessage(const
-// webrtc::DataBuffer& buffer) {
-//     std::lock_guard<std::mutex> lock(mutex_);
-//     std::cout << "LibwebrtcPeerConnectionImpl: DataChannel Message Received.
-//     Binary: " << buffer.binary << ", size: " << buffer.data.size() <<
-//     std::endl;
-//     // TODO: Get label context for this data channel
-//     // TODO: Copy data from buffer.data into a DataChannelMessage
-//     (std::vector<char>)
-//     // TODO: Invoke callbacks_->onDataChannelMessage(peer_id, label,
-//     message_data); // Need peer_id and label context, need to marshal
-// }
-
 // --- Helper to marshal a task to the signaling thread ---
 // bool
 // LibwebrtcPeerConnectionImpl::PostTaskToSignalingThread(std::function<void()>
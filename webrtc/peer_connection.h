@@ -7,7 +7,11 @@
 #include <vector>
 
 // Include the callback struct definition
+#include "channel_priority.h"
 #include "peer_connection_callbacks.h"
+#include "video_send_parameters.h"
+#include "webrtc/channel_handle.h"
+#include "webrtc/data_channel_registry.h"
 
 // Forward declare potential configuration struct
 // In a real system, this would be defined in a config header.
@@ -116,12 +120,18 @@ class IPeerConnection {
 
   // --- Data Channel Operations ---
 
-  // Creates a new DataChannel associated with this connection.
-  // label: The label for the DataChannel.
+  // Creates a new DataChannel associated with this connection (offering
+  // side). spec: Its label, RTCPriority and reliability; they are announced
+  // in the channel open message, so the answering side's sends on the
+  // channel use them too.
   // Returns true if the DataChannel creation was successfully initiated.
   // The DataChannel will open asynchronously, reported via onDataChannelOpened
-  // callback. virtual bool CreateDataChannel(const std::string& label) = 0; //
-  // Optional: If PC creates channels
+  // callback. This method MUST BE THREAD-SAFE.
+  virtual bool CreateDataChannel(const DataChannelSpec& spec) = 0;
+
+  // Bytes queued for sending on all open DataChannels of this connection
+  // (sum of bufferedAmount). This method MUST BE THREAD-SAFE.
+  virtual uint64_t GetDataChannelBufferedAmount() const = 0;
 
   // Sends data over a specific DataChannel associated with this connection.
   // Requires the DataChannel with 'label' to be opened (signaled by
@@ -135,6 +145,14 @@ class IPeerConnection {
   // Optional: Overload for sending string data
   virtual bool SendData(const std::string& label, const std::string& data) = 0;
 
+  // The send endpoint of the declared DataChannel 'id' (see ChannelHandle):
+  // created on first use, before the channel exists if need be, and bound to
+  // the channel when it is created or announced. The same endpoint is
+  // returned for the connection's lifetime. nullptr if the id is invalid or
+  // the connection is closed. This method MUST BE THREAD-SAFE.
+  virtual std::shared_ptr<IDataChannelEndpoint> GetDataChannelEndpoint(
+      ChannelId id) = 0;
+
   // --- Media Operations (Optional, if PC manages media tracks directly) ---
 
   // Adds a local media track (e.g., video or audio source from camera/mic) to
@@ -146,6 +164,12 @@ class IPeerConnection {
   // Removes a local media track from this connection.
   // virtual void RemoveLocalTrack(std::shared_ptr<IMediaTrack> track) = 0;
 
+  // Applies encoder limits to all video senders of this connection
+  // (RtpSender::SetParameters). Takes effect without renegotiation.
+  // Returns false if there is no underlying connection or a sender rejected
+  // the parameters. This method MUST BE THREAD-SAFE.
+  virtual bool SetVideoSendParameters(const VideoSendParameters& params) = 0;
+
   // --- Lifecycle Control ---
 
   // Closes the peer connection, releasing associated resources asynchronously.
@@ -164,6 +188,14 @@ class IPeerConnection {
   // Gets the current signaling state.
   virtual SignalingState GetSignalingState() const = 0;
 
+  // --- Statistics ---
+
+  // Requests the connection's statistics (libwebrtc GetStats). This is an
+  // asynchronous operation; the extracted figures are delivered via the
+  // onStatsReport callback in PeerConnectionCallbacks.
+  // Returns true if the request was issued. This method MUST BE THREAD-SAFE.
+  virtual bool RequestStats() = 0;
+
   // Optional: Check if a specific DataChannel is open/ready
   // virtual bool IsDataChannelOpen(const std::string& label) const = 0;
 
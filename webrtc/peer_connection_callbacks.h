@@ -8,11 +8,14 @@
 
 // Include definitions for state enums and DataChannelMessage
 #include "i_peer_connection.h"
+#include "webrtc/data_channel_registry.h"  // ChannelId
+#include "webrtc/peer_connection_stats.h"  // PeerConnectionStats
 
 // Include WebRTC specific types for media tracks if needed by callbacks (e.g.,
 // OnAddTrack) Requires including relevant libwebrtc headers or defining aliases
 // if not using raw libwebrtc types
 #include "webrtc/api/media_stream_interface.h"  // For webrtc::MediaStreamInterface, webrtc::VideoTrackInterface
+#include "webrtc/api/rtp_receiver_interface.h"  // For webrtc::RtpReceiverInterface
 #include "webrtc/rtc_base/scoped_refptr.h"  // For rtc::scoped_refptr
 // Note: Including these headers directly ties this struct to libwebrtc types.
 // An alternative is to use a more abstract representation of tracks, but this
@@ -81,14 +84,30 @@ struct PeerConnectionCallbacks {
   // DataChannel thread. label: The label of the closed DataChannel.
   std::function<void(const std::string& label)> onDataChannelClosed;
 
+  // Resolves the label of a DataChannel to its ChannelId, once, when the
+  // channel is created or announced by the remote peer. Messages of
+  // channels resolved to kUnknownChannelId are dropped.
+  std::function<ChannelId(const std::string& label)> resolveDataChannel;
+
   // Called when a message is received on a DataChannel.
-  // This callback is typically invoked on the WebRTC signaling thread or
-  // DataChannel thread. label: The label of the DataChannel the message arrived
-  // on. message: The received data (binary bytes).
-  std::function<void(const std::string& label,
-                     const DataChannelMessage& message)>
+  // This callback is invoked on the WebRTC network thread, once per message:
+  // it should take no locks and make no allocations.
+  // channel: The id of the DataChannel the message arrived on (see
+  // resolveDataChannel). message: The received data (binary bytes), a view
+  // of libwebrtc's buffer valid only during the call.
+  std::function<void(ChannelId channel, DataChannelMessageView message)>
       onDataChannelMessage;
 
+  // The bufferedAmount threshold of a declared channel below which
+  // onDataChannelBufferedAmountLow is called (0: never). Queried once per
+  // channel, with its id.
+  std::function<uint64_t(ChannelId channel)> bufferedAmountLowThreshold;
+
+  // Called when a channel's bufferedAmount drops from above its threshold
+  // to at most it. Invoked on the WebRTC network thread.
+  std::function<void(ChannelId channel, uint64_t buffered_amount)>
+      onDataChannelBufferedAmountLow;
+
   // Called when a remote media stream and/or track is added to the connection
   // (typically on Cockpit side). This callback is typically invoked on the
   // WebRTC signaling thread or media thread. track: The received video track.
@@ -99,11 +118,23 @@ struct PeerConnectionCallbacks {
   std::function<void(rtc::scoped_refptr<webrtc::VideoTrackInterface> track)>
       onAddVideoTrack;  // Added (Simplified for video)
 
+  // Called together with onAddVideoTrack with the RTP receiver that carries
+  // the remote video track (Cockpit side). The receiver gives access to the
+  // encoded frames (e.g., via SetDepacketizerToDecoderFrameTransformer) before
+  // they are decoded. Invoked on the WebRTC signaling thread.
+  std::function<void(rtc::scoped_refptr<::webrtc::RtpReceiverInterface>
+                         receiver)>
+      onAddVideoReceiver;
+
   // Called when the PeerConnection needs renegotiation (e.g., due to
   // adding/removing tracks). This callback is typically invoked on the WebRTC
   // signaling thread.
   std::function<void()> onRenegotiationNeeded;  // Added
 
+  // Called with the result of IPeerConnection::RequestStats().
+  // Invoked on the WebRTC signaling thread.
+  std::function<void(const PeerConnectionStats& stats)> onStatsReport;
+
   // Called when a significant error occurs specific to this PeerConnection or
   // its components. This callback is typically invoked on the WebRTC signaling
   // thread. error_msg: Description of the error.
@@ -122,7 +153,9 @@ struct PeerConnectionCallbacks {
         onDataChannelClosed({}),
         onDataChannelMessage({}),
         onAddVideoTrack({}),        // Initialize new member
+        onAddVideoReceiver({}),
         onRenegotiationNeeded({}),  // Initialize new member
+        onStatsReport({}),
         onError({}) {}
 
   // Copy constructor and assignment operator using default behavior
@@ -0,0 +1,50 @@
+#ifndef PEER_CONNECTION_STATS_H
+#define PEER_CONNECTION_STATS_H
+
+#include <cstdint>
+
+namespace autodev {
+namespace remote {
+namespace webrtc {
+
+// Key figures of one PeerConnection, extracted from a libwebrtc
+// RTCStatsReport (see IPeerConnection::RequestStats). Counters are totals
+// since the connection was created, summed over all streams/channels of
+// that kind. A value libwebrtc did not report stays 0.
+struct PeerConnectionStats {
+  // Selected ICE candidate pair
+  double rtt_ms = 0.0;                        // currentRoundTripTime
+  double available_outgoing_bitrate_bps = 0.0;
+
+  // Inbound RTP (received media)
+  int64_t packets_received = 0;
+  int64_t packets_lost = 0;  // May be negative with duplicates (per spec)
+  double jitter_ms = 0.0;    // Largest over the inbound streams
+  // jitterBufferDelay / jitterBufferEmittedCount, i.e. the average time a
+  // frame spent in the jitter buffer.
+  double jitter_buffer_delay_ms = 0.0;
+  uint64_t frames_decoded = 0;
+  uint64_t frames_dropped = 0;
+
+  // Outbound RTP (sent media)
+  uint64_t packets_sent = 0;
+  uint64_t frames_encoded = 0;
+
+  // Remote inbound RTP (the peer's receiver reports on the sent media)
+  double remote_fraction_lost = 0.0;  // 0..1; largest over the streams
+  double remote_jitter_ms = 0.0;      // Largest over the streams
+
+  // DataChannels
+  uint64_t data_channel_bytes_sent = 0;
+  uint64_t data_channel_bytes_received = 0;
+  uint64_t data_channel_messages_sent = 0;
+  uint64_t data_channel_messages_received = 0;
+  // Bytes queued for sending on the open DataChannels (bufferedAmount).
+  uint64_t data_channel_buffered_amount = 0;
+};
+
+}  // namespace webrtc
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // PEER_CONNECTION_STATS_H
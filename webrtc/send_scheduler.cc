@@ -0,0 +1,202 @@
+#include "webrtc/send_scheduler.h"
+
+#include <iostream>
+#include <utility>
+
+#include "metrics/static_metrics.h"
+
+namespace autodev {
+namespace remote {
+namespace webrtc {
+
+bool DataChannelSendScheduler::PeerQueues::empty() const {
+  for (const auto& queue : queues) {
+    if (!queue.empty()) return false;
+  }
+  return true;
+}
+
+DataChannelSendScheduler::DataChannelSendScheduler(
+    Config config, SendFunction send, BufferedAmountFunction buffered_amount)
+    : config_(config),
+      send_(std::move(send)),
+      bufferedAmount_(std::move(buffered_amount)) {}
+
+DataChannelSendScheduler::~DataChannelSendScheduler() { stop(); }
+
+void DataChannelSendScheduler::start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (running_) return;
+  running_ = true;
+  thread_ = std::thread(&DataChannelSendScheduler::threadMain, this);
+}
+
+void DataChannelSendScheduler::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) return;
+    running_ = false;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) thread_.join();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& [peer_id, peer] : peers_) {
+    for (const auto& queue : peer.queues) {
+      metrics::Increment(metrics::CounterId::webrtc_dc_messages_dropped_total,
+                         queue.size());
+    }
+  }
+  peers_.clear();
+}
+
+bool DataChannelSendScheduler::submit(const std::string& peer_id,
+                                      const std::string& label,
+                                      ChannelPriority priority,
+                                      const DataChannelMessage& data) {
+  // Control goes out at once; SCTP's own priority puts it ahead of whatever
+  // the (short) buffers still hold.
+  if (priority == ChannelPriority::High) {
+    return send_(peer_id, label, data);
+  }
+
+  // Not started: plain pass-through.
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = peers_.find(peer_id);
+    if (running_ && it != peers_.end() &&
+        (it->second.draining || !it->second.empty())) {
+      // Messages are waiting (or being sent); keep the order.
+      enqueueLocked(it->second, label, priority, data);
+      cv_.notify_one();
+      return true;
+    }
+  }
+
+  if (bufferedAmount_(peer_id) < config_.buffer_budget_bytes) {
+    return send_(peer_id, label, data);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+      enqueueLocked(peers_[peer_id], label, priority, data);
+      cv_.notify_one();
+      return true;
+    }
+  }
+  // Stopped meanwhile. Never send under mutex_: the manager calls
+  // removePeer() with its own lock held.
+  return send_(peer_id, label, data);
+}
+
+void DataChannelSendScheduler::removePeer(const std::string& peer_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = peers_.find(peer_id);
+  if (it == peers_.end()) return;
+  for (const auto& queue : it->second.queues) {
+    metrics::Increment(metrics::CounterId::webrtc_dc_messages_dropped_total,
+                       queue.size());
+  }
+  peers_.erase(it);
+}
+
+void DataChannelSendScheduler::notifyBufferedAmountLow() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bufferDrained_ = true;
+  }
+  cv_.notify_one();
+}
+
+void DataChannelSendScheduler::enqueueLocked(PeerQueues& peer,
+                                             const std::string& label,
+                                             ChannelPriority priority,
+                                             const DataChannelMessage& data) {
+  const size_t index = static_cast<size_t>(priority);
+  auto& queue = peer.queues[index];
+  peer.queued_bytes[index] += data.size();
+  queue.push_back(QueuedMessage{label, data, std::chrono::steady_clock::now()});
+  metrics::Increment(metrics::CounterId::webrtc_dc_messages_queued_total);
+
+  // Keep at least the newest message, however large.
+  while (peer.queued_bytes[index] > config_.queue_limit_bytes &&
+         queue.size() > 1) {
+    peer.queued_bytes[index] -= queue.front().data.size();
+    queue.pop_front();
+    metrics::Increment(metrics::CounterId::webrtc_dc_messages_dropped_total);
+  }
+}
+
+void DataChannelSendScheduler::threadMain() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_) {
+    std::vector<std::string> pending;
+    for (const auto& [peer_id, peer] : peers_) {
+      if (!peer.empty()) pending.push_back(peer_id);
+    }
+    if (pending.empty()) {
+      cv_.wait(lock, [this] {
+        if (!running_) return true;
+        for (const auto& [peer_id, peer] : peers_) {
+          if (!peer.empty()) return true;
+        }
+        return false;
+      });
+      continue;
+    }
+
+    // An event from now on means another round; one from before is served
+    // by this one.
+    bufferDrained_ = false;
+    lock.unlock();
+    for (const std::string& peer_id : pending) drainPeer(peer_id);
+    lock.lock();
+
+    // Whatever is left waits for the buffers to drain: the low-threshold
+    // event, or the poll for buffers that drain without one.
+    cv_.wait_for(lock, config_.poll_interval,
+                 [this] { return !running_ || bufferDrained_; });
+  }
+}
+
+void DataChannelSendScheduler::drainPeer(const std::string& peer_id) {
+  while (bufferedAmount_(peer_id) < config_.buffer_budget_bytes) {
+    QueuedMessage message;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = peers_.find(peer_id);
+      if (it == peers_.end()) return;  // Removed meanwhile
+      PeerQueues& peer = it->second;
+      // Highest priority first, FIFO within a priority.
+      size_t index = kChannelPriorityCount;
+      while (index > 0 && peer.queues[index - 1].empty()) --index;
+      if (index == 0) {
+        peers_.erase(it);  // Nothing left
+        return;
+      }
+      --index;
+      message = std::move(peer.queues[index].front());
+      peer.queues[index].pop_front();
+      peer.queued_bytes[index] -= message.data.size();
+      peer.draining = true;
+    }
+
+    metrics::RecordMicrosSince(
+        metrics::HistogramId::webrtc_dc_queue_delay_seconds,
+        message.queued_at);
+    if (!send_(peer_id, message.label, message.data)) {
+      std::cerr << "DataChannelSendScheduler: Failed to send a queued message "
+                   "to "
+                << peer_id << " on " << message.label << "." << std::endl;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = peers_.find(peer_id);
+  if (it != peers_.end()) it->second.draining = false;
+}
+
+}  // namespace webrtc
+}  // namespace remote
+}  // namespace autodev
@@ -0,0 +1,129 @@
+#ifndef SEND_SCHEDULER_H
+#define SEND_SCHEDULER_H
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "webrtc/channel_priority.h"
+
+// Use namespace for better organization
+namespace autodev {
+namespace remote {
+namespace webrtc {
+
+// Application-level send scheduler in front of the DataChannels of all
+// peers.
+//
+// SCTP priorities only order what is already in the DataChannel buffers; a
+// burst of telemetry handed to libwebrtc still sits in front of the next
+// control message. The scheduler keeps those buffers short instead: while a
+// peer's bufferedAmount (all its channels) is below buffer_budget_bytes,
+// messages go straight through; above it, messages below High priority wait
+// in per-priority queues and are released highest priority first as the
+// buffers drain. High priority (control) messages are never queued.
+//
+// Queues are bounded per peer and priority; when full, the oldest message
+// of that queue is dropped (queued telemetry is stale by then anyway).
+class DataChannelSendScheduler {
+ public:
+  using DataChannelMessage = std::vector<char>;
+
+  // Sends one message now. Called without the scheduler's lock held.
+  using SendFunction = std::function<bool(const std::string& peer_id,
+                                          const std::string& label,
+                                          const DataChannelMessage& data)>;
+  // Returns the bytes buffered on the peer's DataChannels. Called without
+  // the scheduler's lock held.
+  using BufferedAmountFunction =
+      std::function<uint64_t(const std::string& peer_id)>;
+
+  struct Config {
+    uint64_t buffer_budget_bytes = 64 * 1024;
+    size_t queue_limit_bytes = 1024 * 1024;  // Per peer and priority
+    // Queued messages are retried when notifyBufferedAmountLow() reports a
+    // draining buffer, and at least this often while the buffers stay full
+    // (a fallback poll of bufferedAmount, for buffers that drain without
+    // an event).
+    std::chrono::milliseconds poll_interval{5};
+  };
+
+  DataChannelSendScheduler(Config config, SendFunction send,
+                           BufferedAmountFunction buffered_amount);
+  ~DataChannelSendScheduler();
+
+  // Starts/stops the thread releasing queued messages. stop() drops what
+  // is still queued.
+  void start();
+  void stop();
+
+  // Sends or queues (copies) a message. Returns false only if a direct send
+  // failed; a queued message counts as accepted. MUST BE THREAD-SAFE.
+  bool submit(const std::string& peer_id, const std::string& label,
+              ChannelPriority priority, const DataChannelMessage& data);
+
+  // Drops the peer's queued messages (peer disconnected).
+  // MUST BE THREAD-SAFE.
+  void removePeer(const std::string& peer_id);
+
+  // A DataChannel's bufferedAmount dropped to its low threshold (the
+  // RTCDataChannel bufferedamountlow event): wakes the thread to release
+  // queued messages now instead of at the next poll. MUST BE THREAD-SAFE;
+  // returns at once (called on the WebRTC network thread).
+  void notifyBufferedAmountLow();
+
+ private:
+  struct QueuedMessage {
+    std::string label;
+    DataChannelMessage data;
+    std::chrono::steady_clock::time_point queued_at;
+  };
+  struct PeerQueues {
+    std::array<std::deque<QueuedMessage>, kChannelPriorityCount> queues;
+    std::array<size_t, kChannelPriorityCount> queued_bytes{};
+    // The scheduler thread is sending this peer's messages; direct sends
+    // wait their turn in the queue so order within a priority holds.
+    bool draining = false;
+
+    bool empty() const;
+  };
+
+  void threadMain();
+  // Sends the peer's queued messages while its buffers have room.
+  void drainPeer(const std::string& peer_id);
+  // Appends to a queue, dropping the oldest messages over the limit.
+  // mutex_ MUST be held.
+  void enqueueLocked(PeerQueues& peer, const std::string& label,
+                     ChannelPriority priority, const DataChannelMessage& data);
+
+  const Config config_;
+  const SendFunction send_;
+  const BufferedAmountFunction bufferedAmount_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::map<std::string, PeerQueues> peers_;  // Guarded by mutex_
+  bool running_ = false;                     // Guarded by mutex_
+  // A buffer drained since the thread last looked. Guarded by mutex_
+  bool bufferDrained_ = false;
+  std::thread thread_;
+
+  // Prevent copying
+  DataChannelSendScheduler(const DataChannelSendScheduler&) = delete;
+  DataChannelSendScheduler& operator=(const DataChannelSendScheduler&) =
+      delete;
+};
+
+}  // namespace webrtc
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // SEND_SCHEDULER_H
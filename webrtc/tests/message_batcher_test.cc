@@ -0,0 +1,208 @@
+// Test of the telemetry batch format and DataChannelMessageBatcher, with the
+// batcher's send function capturing what would go on the DataChannel:
+// - several small messages of a label go out as one batch, in order, and
+//   ForEachBatchedMessage gives them back unchanged;
+// - a batch of one goes out as the plain message;
+// - a plain message whose first byte is the 0x00 magic is wrapped in a
+//   batch of one (small or too large to share a batch), so a receiver never
+//   takes it for a batch itself;
+// - batches are split at max_batch_bytes;
+// - truncated records, a cut header and a foreign version are rejected.
+// The batches are closed by stop(); max_latency is long enough that no
+// deadline passes during the test.
+//
+// Build, then run, from the repository root:
+//   g++ -std=c++17 -O1 -g -I. -o /tmp/message_batcher_test
+//       webrtc/tests/message_batcher_test.cc webrtc/message_batcher.cc
+//       metrics/static_metrics.cc metrics/metrics_registry.cc -lpthread
+//   /tmp/message_batcher_test
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "testing/check.h"
+#include "webrtc/message_batcher.h"
+
+namespace {
+
+using autodev::remote::webrtc::DataChannelMessageBatcher;
+using autodev::remote::webrtc::ForEachBatchedMessage;
+using autodev::remote::webrtc::IsMessageBatch;
+using autodev::remote::webrtc::kMessageBatchHeaderSize;
+using autodev::remote::webrtc::kMessageBatchMagic;
+using autodev::remote::webrtc::kMessageBatchMaxRecordSize;
+using autodev::remote::webrtc::kMessageBatchRecordHeaderSize;
+using Message = std::vector<char>;
+
+const std::string kLabel = "telemetry";
+
+struct Sent {
+  std::string label;
+  Message message;
+};
+
+// Adds the messages to a running batcher, stops it (which sends what is
+// pending) and returns what it sent.
+std::vector<Sent> RunBatcher(const std::vector<Message>& messages,
+                             size_t max_batch_bytes = 1152) {
+  std::mutex mutex;
+  std::vector<Sent> sent;
+  DataChannelMessageBatcher::Config config;
+  config.max_latency = std::chrono::milliseconds(60000);
+  config.max_batch_bytes = max_batch_bytes;
+  DataChannelMessageBatcher batcher(
+      config, [&](const std::string& label, const Message& message) {
+        std::lock_guard<std::mutex> lock(mutex);
+        sent.push_back(Sent{label, message});
+      });
+  batcher.start();
+  for (const Message& message : messages) batcher.add(kLabel, message);
+  batcher.stop();
+  std::lock_guard<std::mutex> lock(mutex);
+  return sent;
+}
+
+// The messages of a received DataChannel message, as the cockpit unpacks
+// it: the records of a batch, or the message itself.
+std::vector<Message> Unpack(const Message& received) {
+  std::vector<Message> messages;
+  if (!IsMessageBatch(received.data(), received.size())) {
+    messages.push_back(received);
+    return messages;
+  }
+  CHECK(ForEachBatchedMessage(received.data(), received.size(),
+                              [&messages](const char* data, size_t size) {
+                                messages.emplace_back(data, data + size);
+                              }));
+  return messages;
+}
+
+Message Filled(size_t size, char first, char fill) {
+  Message message(size, fill);
+  if (size > 0) message[0] = first;
+  return message;
+}
+
+void TestBatchRoundTrip() {
+  const std::vector<Message> messages = {
+      Filled(10, 0x08, 'a'), Filled(1, 0x10, 'b'), Filled(200, 0x1a, 'c')};
+  const std::vector<Sent> sent = RunBatcher(messages);
+  CHECK(sent.size() == 1);
+  CHECK(sent[0].label == kLabel);
+  CHECK(IsMessageBatch(sent[0].message.data(), sent[0].message.size()));
+  size_t expected_size = kMessageBatchHeaderSize;
+  for (const Message& message : messages) {
+    expected_size += kMessageBatchRecordHeaderSize + message.size();
+  }
+  CHECK(sent[0].message.size() == expected_size);
+  CHECK(Unpack(sent[0].message) == messages);
+}
+
+void TestSingleRecordUnwrapped() {
+  const Message message = Filled(32, 0x08, 'x');
+  const std::vector<Sent> sent = RunBatcher({message});
+  CHECK(sent.size() == 1);
+  CHECK(sent[0].message == message);  // Plain, no batch header
+  CHECK(!IsMessageBatch(sent[0].message.data(), sent[0].message.size()));
+}
+
+void TestMagicMessageWrapped() {
+  // Looks exactly like a batch header followed by a record.
+  const Message lookalike = {kMessageBatchMagic, 'B', 1, 0, 1, 0, 0x42};
+  std::vector<Sent> sent = RunBatcher({lookalike});
+  CHECK(sent.size() == 1);
+  CHECK(sent[0].message.size() ==
+        kMessageBatchHeaderSize + kMessageBatchRecordHeaderSize +
+            lookalike.size());
+  CHECK(Unpack(sent[0].message) == std::vector<Message>{lookalike});
+
+  // Too large to share a batch: sent alone, still wrapped.
+  const Message large = Filled(300, kMessageBatchMagic, 'y');
+  sent = RunBatcher({large}, 128);
+  CHECK(sent.size() == 1);
+  CHECK(Unpack(sent[0].message) == std::vector<Message>{large});
+
+  // Too large to wrap: dropped rather than misread as a batch.
+  sent = RunBatcher({Filled(kMessageBatchMaxRecordSize + 1,
+                            kMessageBatchMagic, 'z')},
+                    128);
+  CHECK(sent.empty());
+
+  // An empty message has no first byte to unwrap to: it stays a batch of
+  // one empty record.
+  sent = RunBatcher({Message()}, 128);
+  CHECK(sent.size() == 1);
+  CHECK(Unpack(sent[0].message) == std::vector<Message>{Message()});
+}
+
+void TestBatchSplit() {
+  // Each record is 2 + 30 bytes: three fit into 4 + 96 <= 100, a fourth
+  // does not.
+  std::vector<Message> messages;
+  for (char i = 0; i < 7; ++i) messages.push_back(Filled(30, 0x08, 'a' + i));
+  const std::vector<Sent> sent = RunBatcher(messages, 100);
+  CHECK(sent.size() == 3);
+  std::vector<Message> received;
+  for (const Sent& batch : sent) {
+    CHECK(batch.message.size() <= 100);
+    for (Message& message : Unpack(batch.message)) {
+      received.push_back(std::move(message));
+    }
+  }
+  CHECK(received == messages);  // All of them, in order
+  CHECK(!IsMessageBatch(sent[2].message.data(), sent[2].message.size()));
+}
+
+void TestMalformedBatchesRejected() {
+  const std::vector<Message> messages = {Filled(10, 0x08, 'a'),
+                                         Filled(20, 0x08, 'b')};
+  const std::vector<Sent> sent = RunBatcher(messages);
+  CHECK(sent.size() == 1);
+  const Message& batch = sent[0].message;
+  const size_t first_record_end =
+      kMessageBatchHeaderSize + kMessageBatchRecordHeaderSize + 10;
+
+  // Every truncation that does not end on a record boundary fails, after
+  // visiting only the complete records before the cut.
+  for (size_t size = kMessageBatchHeaderSize + 1; size < batch.size();
+       ++size) {
+    if (size == first_record_end) continue;
+    size_t visited = 0;
+    const bool ok = ForEachBatchedMessage(
+        batch.data(), size, [&visited](const char*, size_t) { ++visited; });
+    CHECK(!ok);
+    CHECK(visited == (size > first_record_end ? 1u : 0u));
+  }
+
+  // A record longer than the rest of the batch.
+  Message overlong = batch;
+  overlong[kMessageBatchHeaderSize] = 11;
+  overlong.resize(first_record_end);
+  CHECK(!ForEachBatchedMessage(overlong.data(), overlong.size(),
+                               [](const char*, size_t) {}));
+
+  // A cut header, and a version this receiver does not know.
+  CHECK(!IsMessageBatch(batch.data(), kMessageBatchHeaderSize - 1));
+  CHECK(!ForEachBatchedMessage(batch.data(), kMessageBatchHeaderSize - 1,
+                               [](const char*, size_t) {}));
+  Message future = batch;
+  future[2] = 2;
+  CHECK(!IsMessageBatch(future.data(), future.size()));
+  CHECK(!ForEachBatchedMessage(future.data(), future.size(),
+                               [](const char*, size_t) {}));
+}
+
+}  // namespace
+
+int main() {
+  TestBatchRoundTrip();
+  TestSingleRecordUnwrapped();
+  TestMagicMessageWrapped();
+  TestBatchSplit();
+  TestMalformedBatchesRejected();
+  std::printf("message_batcher_test: OK\n");
+  return 0;
+}
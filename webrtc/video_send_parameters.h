@@ -0,0 +1,28 @@
+#ifndef VIDEO_SEND_PARAMETERS_H
+#define VIDEO_SEND_PARAMETERS_H
+
+#include <cstdint>
+
+#include "webrtc/channel_priority.h"
+
+namespace autodev {
+namespace remote {
+namespace webrtc {
+
+// Encoder limits applied to the outgoing video (the RTP encoding parameters
+// of every video sender, see IPeerConnection::SetVideoSendParameters).
+// 0 leaves a limit unset.
+struct VideoSendParameters {
+  uint32_t max_bitrate_bps = 0;
+  uint32_t max_framerate = 0;
+  double scale_resolution_down_by = 1.0;
+  // Relative to the DataChannels (pacing, and DSCP once PeerConnection
+  // creation enables marking); video yields to control by default.
+  ChannelPriority network_priority = ChannelPriority::Low;
+};
+
+}  // namespace webrtc
+}  // namespace remote
+}  // namespace autodev
+
+#endif  // VIDEO_SEND_PARAMETERS_H
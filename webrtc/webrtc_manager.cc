@@ -6,6 +6,7 @@
 // PeerConnection implementation
 
 // Include other necessary headers
+#include "metrics/static_metrics.h"       // Hot-path counters/histograms
 #include "signaling/signaling_message.h"  // SignalMessage definition
 // #include "config/webrtc_config.h" // Include actual config struct if used
 // #include "event_loop/event_loop_context.h" // Include event loop context
@@ -34,10 +35,39 @@ namespace autodev {
 namespace remote {
 namespace webrtc {
 
+namespace {
+
+// Low threshold of a channel's bufferedAmount: the declared one, or else
+// half the send scheduler's budget, so the draining of any channel wakes
+// the scheduler (see handlePeerDataChannelBufferedAmountLow).
+uint64_t BufferedAmountLowThreshold(const DataChannelRegistry& channels,
+                                    ChannelId channel,
+                                    uint64_t send_buffer_budget_bytes) {
+  const uint64_t declared =
+      channels.spec(channel).buffered_amount_low_threshold;
+  if (declared > 0) return declared;
+  return send_buffer_budget_bytes > 1 ? send_buffer_budget_bytes / 2 : 1;
+}
+
+}  // namespace
+
 // --- WebrtcManagerImpl Implementation ---
 
 WebrtcManagerImpl::WebrtcManagerImpl() : state_(AppState::Uninitialized) {
   std::cout << "WebrtcManagerImpl created." << std::endl;
+  channels_ = DefaultDataChannels(config_);
+  DataChannelSendScheduler::Config scheduler_config;
+  scheduler_config.buffer_budget_bytes = config_.send_buffer_budget_bytes;
+  scheduler_config.queue_limit_bytes = config_.send_queue_limit_bytes;
+  sendScheduler_ = std::make_unique<DataChannelSendScheduler>(
+      scheduler_config,
+      [this](const std::string& peer_id, const std::string& label,
+             const DataChannelMessage& data) {
+        return sendDataChannelMessageNow(peer_id, label, data);
+      },
+      [this](const std::string& peer_id) {
+        return peerBufferedAmount(peer_id);
+      });
   // libwebrtc initialization and thread creation should ideally happen BEFORE
   // this constructor, managed by the application or a dedicated wrapper,
   // and the factory/context passed into init().
@@ -127,6 +157,8 @@ bool WebrtcManagerImpl::start() {
 
   // Connect the signaling client - this is typically asynchronous
   signalingClient_->connect();
+  sendScheduler_->start();
+  startStatsPolling();
   std::cout << "WebrtcManagerImpl: start completed." << std::endl;
   return true;
 }
@@ -144,6 +176,11 @@ void WebrtcManagerImpl::stop() {
     }
   }
 
+  // The polling and scheduler threads take mutex_; join them before
+  // acquiring the lock.
+  stopStatsPolling();
+  sendScheduler_->stop();
+
   // Acquire lock while stopping resources managed by this class
   std::lock_guard<std::mutex> lock(mutex_);
   std::cout << "WebrtcManagerImpl: Stopping..." << std::endl;
@@ -167,6 +204,9 @@ void WebrtcManagerImpl::stop() {
   // WebRTC signaling thread is stopped or PeerConnection callbacks have a safe
   // way to check manager validity. For simplicity in skeleton, clear after
   // signaling disconnect.
+  for (auto const& [peer_id, pc] : peerConnections_) {
+    removePeerMetrics(peer_id);
+  }
   peerConnections_.clear();  // Release unique_ptrs
 
   // Disconnect signaling client - this is typically asynchronous
@@ -251,16 +291,35 @@ bool WebrtcManagerImpl::connectToPeer(const std::string& peer_id) {
     handlePeerDataChannelClosed(peer_id,
                                 label);  // This handler ACQUIRES mutex_
   };
-  pc_callbacks.onDataChannelMessage = [this, peer_id](
-                                          const std::string& label,
-                                          const DataChannelMessage& message) {
-    handlePeerDataChannelMessage(peer_id, label,
-                                 message);  // This handler ACQUIRES mutex_
-  };
+  pc_callbacks.resolveDataChannel =
+      [channels = channels_](const std::string& label) {
+        return channels->resolve(label);  // Lock-free (immutable registry)
+      };
+  pc_callbacks.onDataChannelMessage =
+      bindDataChannelMessageHandlers(peer_id);  // Lock-free per message
+  pc_callbacks.bufferedAmountLowThreshold =
+      [channels = channels_,
+       budget = config_.send_buffer_budget_bytes](ChannelId channel) {
+        return BufferedAmountLowThreshold(*channels, channel, budget);
+      };
+  pc_callbacks.onDataChannelBufferedAmountLow =
+      [this, peer_id](ChannelId channel, uint64_t buffered_amount) {
+        handlePeerDataChannelBufferedAmountLow(
+            peer_id, channel, buffered_amount);  // ACQUIRES mutex_
+      };
   pc_callbacks.onError = [this, peer_id](const std::string& error_msg) {
     handlePeerError(peer_id, error_msg);  // This handler ACQUIRES mutex_
   };
-  // TODO: Add VideoTrackReceived callback for Cockpit side
+  pc_callbacks.onStatsReport = [this,
+                                peer_id](const PeerConnectionStats& stats) {
+    handlePeerStatsReport(peer_id, stats);  // ACQUIRES mutex_
+  };
+  pc_callbacks.onAddVideoReceiver =
+      [this, peer_id](rtc::scoped_refptr<::webrtc::RtpReceiverInterface>
+                          receiver) {
+        invokeVideoTrackReceivedCallback(peer_id,
+                                         receiver);  // ACQUIRES mutex_
+      };
 
   // Create the PC instance using the factory method
   // This method is called from within the mutex_ lock.
@@ -273,6 +332,16 @@ bool WebrtcManagerImpl::connectToPeer(const std::string& peer_id) {
     return false;
   }
 
+  // The offering side creates the declared DataChannels; their priority
+  // and reliability travel in the channel open message to the peer.
+  for (size_t id = 0; id < channels_->size(); ++id) {
+    const DataChannelSpec& spec = channels_->spec(static_cast<ChannelId>(id));
+    if (!pc->CreateDataChannel(spec)) {
+      std::cerr << "WebrtcManagerImpl: Failed to create DataChannel "
+                << spec.label << " for " << peer_id << std::endl;
+    }
+  }
+
   // Store the new PC in the map
   peerConnections_[peer_id] = std::move(pc);
 
@@ -325,6 +394,19 @@ bool WebrtcManagerImpl::disconnectFromPeer(const std::string& peer_id,
 bool WebrtcManagerImpl::sendDataChannelMessage(const std::string& peer_id,
                                                const std::string& channel_label,
                                                const DataChannelMessage& data) {
+  return sendScheduler_->submit(peer_id, channel_label,
+                                channelPriority(channel_label), data);
+}
+
+// Sends immediately; called by the scheduler (directly or from its thread).
+// ACQUIRE mutex_.
+bool WebrtcManagerImpl::sendDataChannelMessageNow(
+    const std::string& peer_id, const std::string& channel_label,
+    const DataChannelMessage& data) {
+  metrics::ScopedTimer send_timer(
+      metrics::HistogramId::webrtc_dc_send_duration_seconds);
+  metrics::Record(metrics::HistogramId::webrtc_dc_message_size_bytes,
+                  data.size());
   // Acquire lock to safely access peerConnections_
   std::lock_guard<std::mutex> lock(mutex_);
 
@@ -347,6 +429,13 @@ bool WebrtcManagerImpl::sendDataChannelMessage(const std::string& peer_id,
     // std::cout << "WebrtcManagerImpl: Sent data to " << peer_id << " on label
     // " << channel_label << ", size=" << data.size() << (success ? "" : "
     // (failed)") << std::endl;
+    if (success) {
+      metrics::Increment(metrics::CounterId::webrtc_dc_messages_sent_total);
+      metrics::Increment(metrics::CounterId::webrtc_dc_sent_bytes_total,
+                         data.size());
+    } else {
+      metrics::Increment(metrics::CounterId::webrtc_dc_send_failures_total);
+    }
     return success;
   } else {
     // std::cerr << "WebrtcManagerImpl: Cannot send data, peer " << peer_id << "
@@ -354,6 +443,7 @@ bool WebrtcManagerImpl::sendDataChannelMessage(const std::string& peer_id,
     // callback? invokePeerErrorCallback(peer_id, "Attempted to send data to
     // unknown or invalid peer connection."); // Needs to acquire lock
     // internally
+    metrics::Increment(metrics::CounterId::webrtc_dc_send_failures_total);
     return false;
   }
 }
@@ -363,32 +453,157 @@ bool WebrtcManagerImpl::sendDataChannelMessage(const std::string& peer_id,
 // BE THREAD-SAFE.
 bool WebrtcManagerImpl::sendDataChannelMessageToAllPeers(
     const std::string& channel_label, const DataChannelMessage& data) {
-  // Acquire lock to safely iterate through peerConnections_
-  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::string> peer_ids;
+  {
+    // Acquire lock to safely iterate through peerConnections_
+    std::lock_guard<std::mutex> lock(mutex_);
 
-  // Check if state is Running
-  if (state_ != AppState::Running) {
-    // std::cerr << "WebrtcManagerImpl: Cannot broadcast data, manager is not
-    // running." << std::endl;
-    return false;
+    // Check if state is Running
+    if (state_ != AppState::Running) {
+      // std::cerr << "WebrtcManagerImpl: Cannot broadcast data, manager is
+      // not running." << std::endl;
+      return false;
+    }
+    for (auto const& [peer_id, pc] : peerConnections_) {
+      if (pc) peer_ids.push_back(peer_id);
+    }
   }
 
+  // Each peer is scheduled on its own: a congested link must not hold back
+  // the others. The scheduler takes mutex_ again to send.
+  const ChannelPriority priority = channelPriority(channel_label);
   bool any_sent = false;
-  // Iterate through all active peer connections
-  for (auto const& [peer_id, pc] : peerConnections_) {
-    if (pc) {  // Check if unique_ptr is not null
-      // Call SendData on each PeerConnection
-      // PeerConnection::SendData should be thread-safe.
-      bool sent = pc->SendData(channel_label, data);
-      if (sent) any_sent = true;
-      // Log or handle individual send failures if needed
-      // std::cout << "WebrtcManagerImpl: Broadcasted data to " << peer_id << "
-      // on label " << channel_label << (sent ? "" : " (failed)") << std::endl;
+  for (const std::string& peer_id : peer_ids) {
+    if (sendScheduler_->submit(peer_id, channel_label, priority, data)) {
+      any_sent = true;
     }
   }
   return any_sent;  // Return true if at least one message was sent successfully
 }
 
+// Implementation of IWebrtcManager::acquireChannel
+// MUST BE THREAD-SAFE. ACQUIRE mutex_.
+ChannelHandle WebrtcManagerImpl::acquireChannel(
+    const std::string& peer_id, const std::string& channel_label) {
+  const ChannelId id = channels_->resolve(channel_label);
+  if (id == kUnknownChannelId) {
+    std::cerr << "WebrtcManagerImpl: Cannot acquire DataChannel "
+              << channel_label << ", it is not declared." << std::endl;
+    return ChannelHandle();
+  }
+  const ChannelPriority priority = channels_->spec(id).priority;
+  std::shared_ptr<IDataChannelEndpoint> endpoint = peerEndpoint(peer_id, id);
+  if (!endpoint) return ChannelHandle();
+
+  // High priority messages skip the scheduler's queues anyway (see
+  // DataChannelSendScheduler::submit); the others keep going through them.
+  ChannelHandle::ScheduledSendFunction scheduled_send;
+  if (priority != ChannelPriority::High) {
+    scheduled_send = [this, peer_id, channel_label,
+                      priority](const DataChannelMessage& data) {
+      return sendScheduler_->submit(peer_id, channel_label, priority, data);
+    };
+  }
+  return ChannelHandle(std::move(endpoint), priority,
+                       std::move(scheduled_send));
+}
+
+// Implementation of IWebrtcManager::getBufferedAmount
+// MUST BE THREAD-SAFE. ACQUIRE mutex_.
+uint64_t WebrtcManagerImpl::getBufferedAmount(
+    const std::string& peer_id, const std::string& channel_label) {
+  const ChannelId id = channels_->resolve(channel_label);
+  if (id == kUnknownChannelId) return 0;
+  std::shared_ptr<IDataChannelEndpoint> endpoint = peerEndpoint(peer_id, id);
+  return endpoint ? endpoint->bufferedAmount() : 0;
+}
+
+// Implementation of IWebrtcManager::trySendDataChannelMessage
+// MUST BE THREAD-SAFE. ACQUIRE mutex_.
+bool WebrtcManagerImpl::trySendDataChannelMessage(
+    const std::string& peer_id, const std::string& channel_label,
+    const DataChannelMessage& data, uint64_t max_buffered_bytes) {
+  const ChannelId id = channels_->resolve(channel_label);
+  std::shared_ptr<IDataChannelEndpoint> endpoint =
+      id != kUnknownChannelId ? peerEndpoint(peer_id, id) : nullptr;
+  if (!endpoint) {
+    metrics::Increment(metrics::CounterId::webrtc_dc_send_failures_total);
+    return false;
+  }
+  // No scheduled send function: trySend never queues.
+  const ChannelHandle channel(std::move(endpoint),
+                              channels_->spec(id).priority);
+  return channel.trySend(data, max_buffered_bytes);
+}
+
+// ACQUIRE mutex_.
+std::shared_ptr<IDataChannelEndpoint> WebrtcManagerImpl::peerEndpoint(
+    const std::string& peer_id, ChannelId channel) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (state_ != AppState::Running) return nullptr;
+  auto it = peerConnections_.find(peer_id);
+  if (it == peerConnections_.end() || !it->second) return nullptr;
+  return it->second->GetDataChannelEndpoint(channel);
+}
+
+// Called by the send scheduler. ACQUIRE mutex_.
+uint64_t WebrtcManagerImpl::peerBufferedAmount(const std::string& peer_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = peerConnections_.find(peer_id);
+  if (it == peerConnections_.end() || !it->second) return 0;
+  return it->second->GetDataChannelBufferedAmount();
+}
+
+// channels_ and config_ are not modified after start(); no lock needed.
+ChannelPriority WebrtcManagerImpl::channelPriority(
+    const std::string& label) const {
+  const ChannelId id = channels_->resolve(label);
+  return id != kUnknownChannelId ? channels_->spec(id).priority
+                                 : config_.default_channel_priority;
+}
+
+std::shared_ptr<const DataChannelRegistry>
+WebrtcManagerImpl::DefaultDataChannels(const WebrtcConfig& config) {
+  auto channels = std::make_shared<DataChannelRegistry>();
+  for (const std::string& label :
+       {config.control_channel_label, config.telemetry_channel_label,
+        config.session_channel_label}) {
+    DataChannelSpec spec;
+    spec.label = label;
+    auto it = config.channel_priorities.find(label);
+    spec.priority = it != config.channel_priorities.end()
+                        ? it->second
+                        : config.default_channel_priority;
+    channels->add(std::move(spec));
+  }
+  return channels;
+}
+
+bool WebrtcManagerImpl::setDataChannels(
+    std::shared_ptr<const DataChannelRegistry> channels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (state_ == AppState::Running) {
+    std::cerr << "WebrtcManagerImpl: DataChannels must be declared before "
+                 "start()."
+              << std::endl;
+    return false;
+  }
+  channels_ = channels ? std::move(channels) : DefaultDataChannels(config_);
+  return true;
+}
+
+// Implementation of IWebrtcManager::setVideoSendParameters
+// MUST BE THREAD-SAFE.
+bool WebrtcManagerImpl::setVideoSendParameters(
+    const std::string& peer_id, const VideoSendParameters& params) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = peerConnections_.find(peer_id);
+  if (it == peerConnections_.end() || !it->second) {
+    return false;
+  }
+  return it->second->SetVideoSendParameters(params);
+}
+
 // Implementation of IWebrtcManager::onSignalingConnected etc. (Callback
 // registration) These methods are called by the application thread. They must
 // be thread-safe as the handlers might be read from different threads.
@@ -423,7 +638,41 @@ void WebrtcManagerImpl::onDataChannelMessageReceived(
   std::lock_guard<std::mutex> lock(mutex_);
   onDataChannelMessageReceivedHandler_ = handler;
 }
-// Optional: void WebrtcManagerImpl::onVideoTrackReceived(...) { ... }
+void WebrtcManagerImpl::onVideoTrackReceived(
+    OnVideoTrackReceivedHandler handler) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  onVideoTrackReceivedHandler_ = handler;
+}
+void WebrtcManagerImpl::onBandwidthEstimate(
+    OnBandwidthEstimateHandler handler) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  onBandwidthEstimateHandler_ = handler;
+}
+void WebrtcManagerImpl::onPeerRoleClaim(OnPeerRoleClaimHandler handler) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  onPeerRoleClaimHandler_ = handler;
+}
+void WebrtcManagerImpl::onPeerStats(OnPeerStatsHandler handler) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  onPeerStatsHandler_ = handler;
+}
+void WebrtcManagerImpl::onChannelMessage(OnChannelMessageHandler handler) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  onChannelMessageHandler_ = handler;
+}
+void WebrtcManagerImpl::onBufferedAmountLow(
+    OnBufferedAmountLowHandler handler) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  onBufferedAmountLowHandler_ = handler;
+}
+
+void WebrtcManagerImpl::setMetricsRegistry(
+    std::shared_ptr<autodev::remote::metrics::MetricsRegistry> registry) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Series of the previous registry are simply dropped with it.
+  peerMetrics_.clear();
+  metricsRegistry_ = std::move(registry);
+}
 
 // --- Internal Handlers for SignalingClient Events ---
 // These methods are called by the SignalingClient's thread. They must acquire
@@ -468,6 +717,10 @@ void WebrtcManagerImpl::handleSignalingError(const std::string& msg) {
 
 void WebrtcManagerImpl::handleSignalingMessage(const SignalMessage& message) {
   // Called by SignalingClient thread. ACQUIRE mutex_.
+  // The claim reaches the application before the message is processed (and
+  // outside mutex_, the handler may call back into the manager).
+  if (message.role) invokePeerRoleClaimCallback(message.from, *message.role);
+
   std::lock_guard<std::mutex> lock(mutex_);
   std::cout << "WebrtcManagerImpl: Received signal message from "
             << message.from
@@ -632,15 +885,34 @@ PeerConnection* WebrtcManagerImpl::getOrCreatePeerConnection(
   pc_callbacks.onDataChannelClosed = [this, peer_id](const std::string& label) {
     handlePeerDataChannelClosed(peer_id, label);  // ACQUIRES mutex_
   };
-  pc_callbacks.onDataChannelMessage = [this, peer_id](
-                                          const std::string& label,
-                                          const DataChannelMessage& message) {
-    handlePeerDataChannelMessage(peer_id, label, message);  // ACQUIRES mutex_
-  };
+  pc_callbacks.resolveDataChannel =
+      [channels = channels_](const std::string& label) {
+        return channels->resolve(label);  // Lock-free (immutable registry)
+      };
+  pc_callbacks.onDataChannelMessage =
+      bindDataChannelMessageHandlers(peer_id);  // Lock-free per message
+  pc_callbacks.bufferedAmountLowThreshold =
+      [channels = channels_,
+       budget = config_.send_buffer_budget_bytes](ChannelId channel) {
+        return BufferedAmountLowThreshold(*channels, channel, budget);
+      };
+  pc_callbacks.onDataChannelBufferedAmountLow =
+      [this, peer_id](ChannelId channel, uint64_t buffered_amount) {
+        handlePeerDataChannelBufferedAmountLow(
+            peer_id, channel, buffered_amount);  // ACQUIRES mutex_
+      };
   pc_callbacks.onError = [this, peer_id](const std::string& error_msg) {
     handlePeerError(peer_id, error_msg);  // ACQUIRES mutex_
   };
-  // TODO: Add OnAddStream/OnRemoveStream for media tracks (Cockpit side)
+  pc_callbacks.onStatsReport = [this,
+                                peer_id](const PeerConnectionStats& stats) {
+    handlePeerStatsReport(peer_id, stats);  // ACQUIRES mutex_
+  };
+  pc_callbacks.onAddVideoReceiver =
+      [this, peer_id](rtc::scoped_refptr<::webrtc::RtpReceiverInterface>
+                          receiver) {
+        invokeVideoTrackReceivedCallback(peer_id, receiver);  // ACQUIRES mutex_
+      };
   // TODO: Add OnDataChannel for receiving incoming DataChannels (Cockpit side)
 
   // Create the concrete PC instance using the factory method (Implemented
@@ -683,6 +955,10 @@ void WebrtcManagerImpl::destroyPeerConnection(const std::string& peer_id,
     // Remove from heartbeat tracking
     lastHeartbeatRxTime_.erase(peer_id);
     reconnectionAttemptCount_.erase(peer_id);
+    removePeerMetrics(peer_id);
+    sendScheduler_->removePeer(peer_id);
+    metrics::Increment(
+        metrics::CounterId::webrtc_peer_connections_destroyed_total);
 
     // Remove the unique_ptr from the map (this destroys the PeerConnection
     // object)
@@ -734,6 +1010,7 @@ std::
   // Dummy creation for skeleton
   auto pc_impl = std::make_unique<LibwebrtcPeerConnection>();  // Dummy instance
   pc_impl->SetCallbacks(callbacks);  // Set the provided callbacks
+  metrics::Increment(metrics::CounterId::webrtc_peer_connections_created_total);
 
   return std::move(pc_impl);  // Return the unique_ptr
 }
@@ -955,43 +1232,52 @@ void WebrtcManagerImpl::handlePeerDataChannelClosed(const std::string& peer_id,
   // TODO: Update internal state if tracking DataChannel status.
 }
 
-void WebrtcManagerImpl::handlePeerDataChannelMessage(
-    const std::string& peer_id, const std::string& label,
-    const DataChannelMessage& message) {
-  // Called by WebRTC signaling thread. ACQUIRE mutex_.
-  std::lock_guard<std::mutex> lock(mutex_);
-  // std::cout << "WebrtcManagerImpl: DataChannel message received for " <<
-  // peer_id << ", label=" << label << ", size=" << message.size() << std::endl;
+// Builds the onDataChannelMessage callback of a new PeerConnection, with the
+// message handlers and the channel registry bound in: a message takes no
+// lock, peer lookup or allocation. No peer check either: a removed peer's
+// DataChannel observers are detached with its PeerConnection. mutex_ MUST
+// be held.
+std::function<void(ChannelId, DataChannelMessageView)>
+WebrtcManagerImpl::bindDataChannelMessageHandlers(const std::string& peer_id) {
+  // The PeerConnection only passes on messages of declared channels; the
+  // application routes them by id (DataChannelDispatcher).
+  // TODO: Handle Heartbeat messages here (a declared heartbeat channel)
+  return [peer_id, channel_handler = onChannelMessageHandler_,
+          label_handler = onDataChannelMessageReceivedHandler_,
+          channels = channels_](ChannelId channel,
+                                DataChannelMessageView message) {
+    // Called by the WebRTC network thread.
+    metrics::Increment(metrics::CounterId::webrtc_dc_messages_received_total);
+    metrics::Increment(metrics::CounterId::webrtc_dc_received_bytes_total,
+                       message.size());
+    // TODO: Marshal to application thread if needed
+    // If the application's handler does significant work or interacts with
+    // UI (Cockpit), it MUST be marshalled to the application's event loop
+    // thread.
+    if (channel_handler) channel_handler(peer_id, channel, message);
+    // Opt-in label handler: copies the message.
+    if (label_handler && channel < channels->size()) {
+      label_handler(peer_id, channels->spec(channel).label, message.copy());
+    }
+  };
+}
 
-  // Check if the peer connection still exists
-  if (!peerConnections_.count(peer_id)) {
-    std::cout << "WebrtcManagerImpl: DataChannel message for non-existent peer "
-              << peer_id << std::endl;
-    return;
+void WebrtcManagerImpl::handlePeerDataChannelBufferedAmountLow(
+    const std::string& peer_id, ChannelId channel, uint64_t buffered_amount) {
+  // Called by the WebRTC network thread. ACQUIRE mutex_.
+  OnBufferedAmountLowHandler handler;
+  bool declared = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!peerConnections_.count(peer_id)) return;
+    handler = onBufferedAmountLowHandler_;
+    declared = channels_->spec(channel).buffered_amount_low_threshold > 0;
   }
-
-  // Check label and route message
-  // TODO: Use config values for labels
-  // if (label == config_.control_channel_label) {
-  if (label == "control") {  // Dummy check for skeleton
-    invokeDataChannelMessageReceivedCallback(peer_id, label,
-                                             message);  // Calls invoke helper
-  }
-  // else if (label == config_.telemetry_channel_label) { // Needs config
-  else if (label == "telemetry") {  // Dummy check for skeleton
-    // This might be loopback telemetry if the remote echoes it
-    // Assuming telemetry received here should also be routed to the app
-    invokeDataChannelMessageReceivedCallback(peer_id, label,
-                                             message);  // Calls invoke helper
-  }
-  // TODO: Handle Heartbeat messages here based on label/content
-  // else if (label == "heartbeat" && message == "ping") {
-  // handleReceivedHeartbeat(peer_id); }
-  else {
-    std::cout
-        << "WebrtcManagerImpl: Received message on unknown DataChannel label: "
-        << label << " from " << peer_id << std::endl;
-    // Log unexpected message
+  // Queued messages may go out now.
+  sendScheduler_->notifyBufferedAmountLow();
+  // The application only hears of the thresholds it declared.
+  if (handler && declared) {
+    handler(peer_id, channel, buffered_amount);
   }
 }
 
@@ -1124,8 +1410,8 @@ void WebrtcManagerImpl::checkForHeartbeatLoss() {
   }
 }
 
-// Updates lastHeartbeatRxTime_. Called by handleSignalingMessage or
-// handlePeerDataChannelMessage. ACQUIRE mutex_.
+// Updates lastHeartbeatRxTime_. Called by handleSignalingMessage. ACQUIRE
+// mutex_.
 void WebrtcManagerImpl::handleReceivedHeartbeat(const std::string& peer_id) {
   // Lock is assumed to be held by the caller handler.
   // std::lock_guard<std::mutex> lock(mutex_); // If called elsewhere, acquire
@@ -1138,6 +1424,156 @@ void WebrtcManagerImpl::handleReceivedHeartbeat(const std::string& peer_id) {
   }
 }
 
+// --- Connection Statistics ---
+
+void WebrtcManagerImpl::startStatsPolling() {
+  // Called from start() with mutex_ held; config_ is not modified after
+  // init().
+  if (config_.stats_interval_ms <= 0 || statsThread_.joinable()) return;
+  {
+    std::lock_guard<std::mutex> stats_lock(statsMutex_);
+    statsStopping_ = false;
+  }
+  statsThread_ = std::thread(&WebrtcManagerImpl::statsThreadMain, this);
+}
+
+void WebrtcManagerImpl::stopStatsPolling() {
+  {
+    std::lock_guard<std::mutex> stats_lock(statsMutex_);
+    statsStopping_ = true;
+  }
+  statsCv_.notify_all();
+  if (statsThread_.joinable()) statsThread_.join();
+}
+
+void WebrtcManagerImpl::statsThreadMain() {
+  const auto interval = std::chrono::milliseconds(config_.stats_interval_ms);
+  std::unique_lock<std::mutex> stats_lock(statsMutex_);
+  while (!statsCv_.wait_for(stats_lock, interval,
+                            [this] { return statsStopping_; })) {
+    stats_lock.unlock();
+    requestPeerStats();
+    stats_lock.lock();
+  }
+}
+
+// Called by the stats thread. ACQUIRE mutex_.
+void WebrtcManagerImpl::requestPeerStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!metricsRegistry_ && !onBandwidthEstimateHandler_ &&
+      !onPeerStatsHandler_) {
+    return;  // Nobody to publish to
+  }
+  for (auto const& [peer_id, pc] : peerConnections_) {
+    // Reports arrive asynchronously via onStatsReport
+    // (handlePeerStatsReport). A PC without an underlying connection yet
+    // just declines.
+    if (pc) pc->RequestStats();
+  }
+}
+
+// Called by WebRTC signaling thread. ACQUIRE mutex_.
+void WebrtcManagerImpl::handlePeerStatsReport(
+    const std::string& peer_id, const PeerConnectionStats& stats) {
+  OnBandwidthEstimateHandler bandwidth_handler;
+  OnPeerStatsHandler stats_handler;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // A late report for a destroyed connection must not re-create its series
+    // nor reach the application.
+    if (!peerConnections_.count(peer_id)) return;
+    publishPeerStats(peer_id, stats);
+    bandwidth_handler = onBandwidthEstimateHandler_;
+    stats_handler = onPeerStatsHandler_;
+  }
+  if (stats_handler) stats_handler(peer_id, stats);
+  // 0 until the candidate pair has an estimate (no media sent yet).
+  if (bandwidth_handler && stats.available_outgoing_bitrate_bps > 0.0) {
+    bandwidth_handler(peer_id, stats.available_outgoing_bitrate_bps);
+  }
+}
+
+// Publishes a report to metricsRegistry_. mutex_ is held by the caller.
+void WebrtcManagerImpl::publishPeerStats(const std::string& peer_id,
+                                         const PeerConnectionStats& stats) {
+  if (!metricsRegistry_) return;
+
+  auto it = peerMetrics_.find(peer_id);
+  if (it == peerMetrics_.end()) {
+    metrics::MetricsRegistry& registry = *metricsRegistry_;
+    const metrics::Labels labels = {{"peer_id", peer_id}};
+    PeerMetrics m;
+    m.round_trip_time = registry.gauge(
+        "webrtc_round_trip_time_seconds",
+        "Current RTT of the selected ICE candidate pair.", labels);
+    m.available_outgoing_bitrate = registry.gauge(
+        "webrtc_available_outgoing_bitrate_bits_per_second",
+        "Send bandwidth estimate of the selected ICE candidate pair.", labels);
+    m.packets_received = registry.counter(
+        "webrtc_packets_received_total", "Received RTP packets.", labels);
+    m.packets_lost = registry.counter(
+        "webrtc_packets_lost_total", "Lost inbound RTP packets.", labels);
+    m.packets_sent = registry.counter("webrtc_packets_sent_total",
+                                      "Sent RTP packets.", labels);
+    m.jitter = registry.gauge(
+        "webrtc_jitter_seconds",
+        "Inbound RTP interarrival jitter (largest stream).", labels);
+    m.jitter_buffer_delay = registry.gauge(
+        "webrtc_jitter_buffer_delay_seconds",
+        "Average time a received frame spent in the jitter buffer.", labels);
+    m.frames_encoded = registry.counter("webrtc_frames_encoded_total",
+                                        "Encoded video frames.", labels);
+    m.frames_decoded = registry.counter("webrtc_frames_decoded_total",
+                                        "Decoded video frames.", labels);
+    m.frames_dropped = registry.counter(
+        "webrtc_frames_dropped_total",
+        "Received video frames dropped before decoding.", labels);
+    m.data_channel_bytes_sent = registry.counter(
+        "webrtc_data_channel_sent_bytes_total",
+        "Payload bytes sent on DataChannels.", labels);
+    m.data_channel_bytes_received = registry.counter(
+        "webrtc_data_channel_received_bytes_total",
+        "Payload bytes received on DataChannels.", labels);
+    m.data_channel_messages_sent = registry.counter(
+        "webrtc_data_channel_sent_messages_total",
+        "Messages sent on DataChannels.", labels);
+    m.data_channel_messages_received = registry.counter(
+        "webrtc_data_channel_received_messages_total",
+        "Messages received on DataChannels.", labels);
+    m.data_channel_buffered = registry.gauge(
+        "webrtc_data_channel_buffered_bytes",
+        "Bytes queued for sending on open DataChannels (bufferedAmount).",
+        labels);
+    it = peerMetrics_.emplace(peer_id, std::move(m)).first;
+  }
+
+  const PeerMetrics& m = it->second;
+  m.round_trip_time->set(stats.rtt_ms / 1000.0);
+  m.available_outgoing_bitrate->set(stats.available_outgoing_bitrate_bps);
+  m.packets_received->set(static_cast<uint64_t>(stats.packets_received));
+  m.packets_lost->set(
+      static_cast<uint64_t>(std::max<int64_t>(stats.packets_lost, 0)));
+  m.packets_sent->set(stats.packets_sent);
+  m.jitter->set(stats.jitter_ms / 1000.0);
+  m.jitter_buffer_delay->set(stats.jitter_buffer_delay_ms / 1000.0);
+  m.frames_encoded->set(stats.frames_encoded);
+  m.frames_decoded->set(stats.frames_decoded);
+  m.frames_dropped->set(stats.frames_dropped);
+  m.data_channel_bytes_sent->set(stats.data_channel_bytes_sent);
+  m.data_channel_bytes_received->set(stats.data_channel_bytes_received);
+  m.data_channel_messages_sent->set(stats.data_channel_messages_sent);
+  m.data_channel_messages_received->set(stats.data_channel_messages_received);
+  m.data_channel_buffered->set(
+      static_cast<double>(stats.data_channel_buffered_amount));
+}
+
+// Removes the peer's series. mutex_ is held by the caller.
+void WebrtcManagerImpl::removePeerMetrics(const std::string& peer_id) {
+  if (peerMetrics_.erase(peer_id) > 0 && metricsRegistry_) {
+    metricsRegistry_->removeSeries("peer_id", peer_id);
+  }
+}
+
 // Tries to reconnect to a peer. ACQUIRE mutex_.
 void WebrtcManagerImpl::attemptReconnection(const std::string& peer_id) {
   std::lock_guard<std::mutex> lock(mutex_);
@@ -1238,24 +1674,30 @@ void WebrtcManagerImpl::invokePeerErrorCallback(const std::string& peer_id,
   }
 }
 
-void WebrtcManagerImpl::invokeDataChannelMessageReceivedCallback(
-    const std::string& peer_id, const std::string& label,
-    const DataChannelMessage& message) {
-  OnDataChannelMessageReceivedHandler handler;
+void WebrtcManagerImpl::invokeVideoTrackReceivedCallback(
+    const std::string& peer_id,
+    rtc::scoped_refptr<::webrtc::RtpReceiverInterface> receiver) {
+  OnVideoTrackReceivedHandler handler;
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    handler = onDataChannelMessageReceivedHandler_;
+    handler = onVideoTrackReceivedHandler_;
   }
   if (handler) {
-    // TODO: Marshal to application thread if needed
-    // If the application's handler does significant work or interacts with UI
-    // (Cockpit), it MUST be marshalled to the application's event loop thread.
-    handler(peer_id, label, message);
+    // Called on the WebRTC signaling thread; the application attaches sinks or
+    // frame transformers, which libwebrtc allows from this thread.
+    handler(peer_id, receiver);
   }
 }
 
-// Optional: void WebrtcManagerImpl::invokeVideoTrackReceivedCallback(...) { ...
-// }
+void WebrtcManagerImpl::invokePeerRoleClaimCallback(const std::string& peer_id,
+                                                    const std::string& role) {
+  OnPeerRoleClaimHandler handler;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    handler = onPeerRoleClaimHandler_;
+  }
+  if (handler) handler(peer_id, role);
+}
 
 // --- Other Internal Logic ---
 // ... Heartbeat and Reconnection implementation details ...
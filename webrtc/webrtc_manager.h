@@ -3,8 +3,11 @@
 
 #include "i_webrtc_manager.h"                  // Include the interface
 #include "signaling/signaling_client.h"        // Base SignalingClient interface
+#include "webrtc/data_channel_registry.h"      // DataChannelRegistry
 #include "webrtc/peer_connection.h"            // Base PeerConnection interface
 #include "webrtc/peer_connection_callbacks.h"  // Callbacks struct
+#include "webrtc/peer_connection_stats.h"      // PeerConnectionStats
+#include "webrtc/send_scheduler.h"             // DataChannelSendScheduler
 
 // Include configuration relevant to WebRTC/Signaling
 // Assuming a specific WebrtcConfig struct exists within config/
@@ -14,10 +17,12 @@
 
 #include <atomic>  // For state
 #include <chrono>  // For heartbeats
+#include <condition_variable>  // For the stats polling thread
 #include <map>
 #include <memory>  // unique_ptr, shared_ptr
 #include <mutex>   // For synchronization
 #include <string>
+#include <thread>  // Stats polling thread
 #include <vector>
 
 // Forward declare concrete implementations (managed by unique_ptr/factories)
@@ -40,8 +45,27 @@ struct WebrtcConfig {
   std::string client_id;                 // Local client ID
   std::vector<std::string> ice_servers;  // List of ICE servers (STUN/TURN)
   int heartbeat_interval_ms = 5000;      // Heartbeat interval (0 to disable)
+  int stats_interval_ms = 1000;  // GetStats polling interval (0 to disable)
   std::string control_channel_label = "control";
   std::string telemetry_channel_label = "telemetry";
+  // Cockpit -> vehicle requests switching a vehicle between preview and
+  // control mode (SessionRequest); opened with the others, so switching
+  // needs no renegotiation.
+  std::string session_channel_label = "session";
+  // Priority class of each DataChannel by label (RTCDataChannel priority
+  // and send scheduling; DSCP only once PeerConnection creation enables
+  // marking, see LibwebrtcPeerConnectionImpl::init) when the application
+  // declares no channels (see IWebrtcManager::setDataChannels); other
+  // labels get default_channel_priority.
+  std::map<std::string, ChannelPriority> channel_priorities = {
+      {"control", ChannelPriority::High},
+      {"telemetry", ChannelPriority::Medium},
+      {"session", ChannelPriority::High}};
+  ChannelPriority default_channel_priority = ChannelPriority::Low;
+  // Send scheduler: bufferedAmount per peer above which non-High messages
+  // are queued, and the queue bound per peer and priority.
+  uint64_t send_buffer_budget_bytes = 64 * 1024;
+  size_t send_queue_limit_bytes = 1024 * 1024;
   // ... other WebRTC related config
 };
 
@@ -93,10 +117,28 @@ class WebrtcManagerImpl : public IWebrtcManager {
       const std::string& channel_label,
       const DataChannelMessage& data) override;
 
+  // Resolves a peer's DataChannel for sending through a handle.
+  // This method MUST BE THREAD-SAFE.
+  ChannelHandle acquireChannel(const std::string& peer_id,
+                               const std::string& channel_label) override;
+
+  // Backpressure; these methods MUST BE THREAD-SAFE.
+  uint64_t getBufferedAmount(const std::string& peer_id,
+                             const std::string& channel_label) override;
+  bool trySendDataChannelMessage(const std::string& peer_id,
+                                 const std::string& channel_label,
+                                 const DataChannelMessage& data,
+                                 uint64_t max_buffered_bytes) override;
+
   // Optional video methods (implement if needed)
   // bool addLocalVideoTrack(...) override;
   // void removeLocalVideoTrack(...) override;
 
+  // Applies encoder limits to the video sent to a peer.
+  // This method MUST BE THREAD-SAFE.
+  bool setVideoSendParameters(const std::string& peer_id,
+                              const VideoSendParameters& params) override;
+
   // --- Implementation of Callback Registration Methods ---
   // These methods are called by the application to set the callbacks.
   // They must be thread-safe as they might be called from a different thread
@@ -109,7 +151,24 @@ class WebrtcManagerImpl : public IWebrtcManager {
   void onPeerError(OnPeerErrorHandler handler) override;
   void onDataChannelMessageReceived(
       OnDataChannelMessageReceivedHandler handler) override;
-  // Optional: void onVideoTrackReceived(...) override;
+  void onChannelMessage(OnChannelMessageHandler handler) override;
+  void onBufferedAmountLow(OnBufferedAmountLowHandler handler) override;
+  void onVideoTrackReceived(OnVideoTrackReceivedHandler handler) override;
+  void onBandwidthEstimate(OnBandwidthEstimateHandler handler) override;
+  void onPeerRoleClaim(OnPeerRoleClaimHandler handler) override;
+  void onPeerStats(OnPeerStatsHandler handler) override;
+
+  void setMetricsRegistry(
+      std::shared_ptr<autodev::remote::metrics::MetricsRegistry> registry)
+      override;
+
+  bool setDataChannels(
+      std::shared_ptr<const DataChannelRegistry> channels) override;
+
+  // The channels declared from a WebrtcConfig (control, telemetry, session;
+  // reliable and ordered), used when the application declares none.
+  static std::shared_ptr<const DataChannelRegistry> DefaultDataChannels(
+      const WebrtcConfig& config);
 
  protected:  // Use protected for internal helpers if subclasses might need
              // them, otherwise private
@@ -144,8 +203,12 @@ class WebrtcManagerImpl : public IWebrtcManager {
   OnPeerErrorHandler onPeerErrorHandler_ GUARDED_BY(mutex_);
   OnDataChannelMessageReceivedHandler onDataChannelMessageReceivedHandler_
       GUARDED_BY(mutex_);
-  // Optional: OnVideoTrackReceivedHandler onVideoTrackReceivedHandler_
-  // GUARDED_BY(mutex_);
+  OnChannelMessageHandler onChannelMessageHandler_ GUARDED_BY(mutex_);
+  OnBufferedAmountLowHandler onBufferedAmountLowHandler_ GUARDED_BY(mutex_);
+  OnVideoTrackReceivedHandler onVideoTrackReceivedHandler_ GUARDED_BY(mutex_);
+  OnBandwidthEstimateHandler onBandwidthEstimateHandler_ GUARDED_BY(mutex_);
+  OnPeerRoleClaimHandler onPeerRoleClaimHandler_ GUARDED_BY(mutex_);
+  OnPeerStatsHandler onPeerStatsHandler_ GUARDED_BY(mutex_);
 
   // State for heartbeats and reconnection logic (Access MUST be protected by
   // mutex_) Needs a timer mechanism integrated with the event loop.
@@ -156,6 +219,49 @@ class WebrtcManagerImpl : public IWebrtcManager {
   std::map<std::string, int> reconnectionAttemptCount_
       GUARDED_BY(mutex_);  // Track reconnection attempts per peer
 
+  // --- Connection statistics ---
+  // Registry series of one peer, looked up once when its first report
+  // arrives.
+  struct PeerMetrics {
+    std::shared_ptr<metrics::Gauge> round_trip_time;
+    std::shared_ptr<metrics::Gauge> available_outgoing_bitrate;
+    std::shared_ptr<metrics::Counter> packets_received;
+    std::shared_ptr<metrics::Counter> packets_lost;
+    std::shared_ptr<metrics::Counter> packets_sent;
+    std::shared_ptr<metrics::Gauge> jitter;
+    std::shared_ptr<metrics::Gauge> jitter_buffer_delay;
+    std::shared_ptr<metrics::Counter> frames_encoded;
+    std::shared_ptr<metrics::Counter> frames_decoded;
+    std::shared_ptr<metrics::Counter> frames_dropped;
+    std::shared_ptr<metrics::Counter> data_channel_bytes_sent;
+    std::shared_ptr<metrics::Counter> data_channel_bytes_received;
+    std::shared_ptr<metrics::Counter> data_channel_messages_sent;
+    std::shared_ptr<metrics::Counter> data_channel_messages_received;
+    std::shared_ptr<metrics::Gauge> data_channel_buffered;
+  };
+  std::shared_ptr<metrics::MetricsRegistry> metricsRegistry_
+      GUARDED_BY(mutex_);
+  std::map<std::string, PeerMetrics> peerMetrics_ GUARDED_BY(mutex_);
+
+  // Declared DataChannels. Set before start() (under mutex_) and not
+  // replaced afterwards, so the send and receive paths read it without
+  // locking; PeerConnection callbacks hold their own reference.
+  std::shared_ptr<const DataChannelRegistry> channels_;
+
+  // Orders DataChannel sends by channel priority when the buffers fill up.
+  // Created in the constructor, never replaced. Its thread takes mutex_
+  // (through sendDataChannelMessageNow/peerBufferedAmount); lock order:
+  // mutex_, then the scheduler's mutex.
+  std::unique_ptr<DataChannelSendScheduler> sendScheduler_;
+
+  // Polling thread; its own mutex so stop() can wake and join it without
+  // holding mutex_. Lock order: mutex_, then statsMutex_ (the thread
+  // releases statsMutex_ before it takes mutex_).
+  std::mutex statsMutex_;
+  std::condition_variable statsCv_;
+  bool statsStopping_ = false;  // Guarded by statsMutex_
+  std::thread statsThread_;
+
   // --- Internal Handlers (Called by SignalingClient or PeerConnection
   // Callbacks) --- These methods implement the core logic of the manager. These
   // methods are called from background threads (WebRTC/Signaling); MUST ACQUIRE
@@ -195,9 +301,9 @@ class WebrtcManagerImpl : public IWebrtcManager {
   void handlePeerDataChannelClosed(
       const std::string& peer_id,
       const std::string& label);  // Should handle channels closing
-  void handlePeerDataChannelMessage(
-      const std::string& peer_id, const std::string& label,
-      const DataChannelMessage& message);  // Routes messages based on label
+  void handlePeerDataChannelBufferedAmountLow(
+      const std::string& peer_id, ChannelId channel,
+      uint64_t buffered_amount);  // Called by the network thread
   void handlePeerError(
       const std::string& peer_id,
       const std::string& error_msg);  // Handles PC-specific errors
@@ -210,6 +316,11 @@ class WebrtcManagerImpl : public IWebrtcManager {
   PeerConnection* getOrCreatePeerConnection(const std::string& peer_id)
       REQUIRES(mutex_);
 
+  // The onDataChannelMessage callback of a new PeerConnection, with the
+  // current message handlers bound in (no lock per message).
+  std::function<void(ChannelId, DataChannelMessageView)>
+  bindDataChannelMessageHandlers(const std::string& peer_id) REQUIRES(mutex_);
+
   // Method to destroy a PeerConnection and clean up state. ACQUIRE mutex_.
   void destroyPeerConnection(const std::string& peer_id,
                              const std::string& reason) REQUIRES(mutex_);
@@ -241,6 +352,36 @@ class WebrtcManagerImpl : public IWebrtcManager {
   void checkForHeartbeatLoss()
       REQUIRES(mutex_);  // Checks last received times (ACQUIRE mutex_)
 
+  // Sends one DataChannel message now, bypassing the scheduler.
+  // ACQUIRE mutex_.
+  bool sendDataChannelMessageNow(const std::string& peer_id,
+                                 const std::string& channel_label,
+                                 const DataChannelMessage& data);
+  // The send endpoint of a peer's declared channel; nullptr if the manager
+  // is not running or the peer is unknown. ACQUIRE mutex_.
+  std::shared_ptr<IDataChannelEndpoint> peerEndpoint(const std::string& peer_id,
+                                                     ChannelId channel);
+  // Bytes buffered on the peer's DataChannels (0 if unknown). ACQUIRE mutex_.
+  uint64_t peerBufferedAmount(const std::string& peer_id);
+  ChannelPriority channelPriority(const std::string& label) const;
+
+  // Stats polling (runs every config_.stats_interval_ms while Running).
+  void startStatsPolling();
+  void stopStatsPolling() EXCLUDES(mutex_);  // Joins the thread
+  void statsThreadMain();
+  // Asks every PeerConnection for its stats. ACQUIRE mutex_.
+  void requestPeerStats();
+  // Publishes a report to metricsRegistry_ and onPeerStatsHandler_, and the
+  // bandwidth estimate to onBandwidthEstimateHandler_ (Called by WebRTC
+  // Signaling thread; ACQUIRE mutex_).
+  void handlePeerStatsReport(const std::string& peer_id,
+                             const PeerConnectionStats& stats);
+  // Updates the peer's registry series. mutex_ MUST be held.
+  void publishPeerStats(const std::string& peer_id,
+                        const PeerConnectionStats& stats) REQUIRES(mutex_);
+  // Removes the peer's series from the registry. mutex_ MUST be held.
+  void removePeerMetrics(const std::string& peer_id) REQUIRES(mutex_);
+
   void attemptReconnection(
       const std::string&
           peer_id);  // Tries to reconnect to a peer (ACQUIRE mutex_)
@@ -256,10 +397,11 @@ class WebrtcManagerImpl : public IWebrtcManager {
                                       const std::string& reason);
   void invokePeerErrorCallback(const std::string& peer_id,
                                const std::string& error_msg);
-  void invokeDataChannelMessageReceivedCallback(
-      const std::string& peer_id, const std::string& label,
-      const DataChannelMessage& message);
-  // Optional: void invokeVideoTrackReceivedCallback(...)
+  void invokeVideoTrackReceivedCallback(
+      const std::string& peer_id,
+      rtc::scoped_refptr<::webrtc::RtpReceiverInterface> receiver);
+  void invokePeerRoleClaimCallback(const std::string& peer_id,
+                                   const std::string& role);
 
  private:
   // Prevent copying and assignment - already in IWebrtcManager, but repeat here